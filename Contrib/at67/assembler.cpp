@@ -7,8 +7,18 @@
 #include <iterator>
 #include <algorithm>
 #include <cstdarg>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include <bitset>
 
 #ifndef STAND_ALONE
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
 #include "cpu.h"
 #include "editor.h"
 #endif
@@ -17,10 +27,26 @@
 #include "loader.h"
 #include "assembler.h"
 #include "expression.h"
+#include "mapping.h"
+#include "linker.h"
 
 
 #define BRANCH_ADJUSTMENT    2
 
+#define FNV_OFFSET_BASIS     0xCBF29CE484222325ull
+#define FNV_PRIME            0x00000100000001B3ull
+
+#define MACRO_MAX_DEPTH      64
+
+#define OPTIMISE_MAX_HOPS    16 // longest chain of BRAs a branch is redirected through
+
+#define NATIVE_SYS_ENTER     14 // cycles from vCPU's dispatch to the first instruction of a SYS function
+#define NATIVE_SYS_REENTER   3  // cycles of REENTER after the last instruction of a SYS function
+
+#define OPCODE_MAX_LENGTH    5
+#define OPCODE_HASH_SIZE     256
+#define OPCODE_HASH_MULT     0x000B3E9Fu
+
 
 namespace Assembler
 {
@@ -37,6 +63,7 @@ namespace Assembler
     {
         uint16_t _address;
         std::string _name;
+        uint16_t _sectionAddress = 0x0000; // start of its section, native code is assembled two bytes per ROM address from there
     };
 
     struct Equate
@@ -44,6 +71,7 @@ namespace Assembler
         bool _isCustomAddress;
         uint16_t _operand;
         std::string _name;
+        uint16_t _customAddress = 0x0000; // code placement, unaffected by object label biasing
     };
 
     struct Instruction
@@ -85,12 +113,58 @@ namespace Assembler
         std::vector<std::string> _lines;
     };
 
+    // Macro body tokenised once, each token knows the first parameter it matches and each line whether it starts with a label
+    struct MacroLine
+    {
+        bool _hasLabel = false;
+        std::vector<std::string> _tokens;
+        std::vector<int> _params;
+    };
+
+    struct MacroBody
+    {
+        bool _called = false;
+        bool _expanded = false;
+        std::vector<std::string> _labels;
+        std::vector<MacroLine> _lines;
+    };
+
+    // Token as a view into its source line
+    struct TokenSpan
+    {
+        size_t _start;
+        size_t _length;
+    };
+
     struct LineToken
     {
         bool _fromInclude = false;
-        int _includeLineNumber;
+        int _includeLineNumber = 0;
         std::string _text;
         std::string _includeName;
+        std::string _macroName; // innermost macro that the line was expanded from
+    };
+
+    // Source lines are tokenised and their opcodes looked up once, both passes iterate these
+    struct ParsedLine
+    {
+        bool _isGprintf = false;
+        bool _hasLabel = false;
+        int _lineIndex = 0;
+        int _opcodeIndex = 0;
+        InstructionType _instructionType = {0x00, 0x00, BadSize, vCpu};
+        Expression::ExpressionType _operandType = Expression::None;
+        int _operandTree = -1; // compiled on first use, an index into the context's expression trees
+        std::string _operand;
+        std::vector<std::string> _tokens;
+    };
+
+    // Pre-processed include file with its nested includes expanded, reused while the content hashes of it and its dependencies are unchanged
+    struct IncludeUnit
+    {
+        uint64_t _hash = 0;
+        std::vector<LineToken> _lineTokens;
+        std::vector<std::pair<std::string, uint64_t>> _dependencies;
     };
 
     struct Gprintf
@@ -105,7 +179,6 @@ namespace Assembler
             std::string _var;
         };
 
-        bool _displayed = false;
         uint16_t _address;
         int _lineNumber;
         std::string _lineToken;
@@ -115,25 +188,76 @@ namespace Assembler
     };
 
 
-    int _lineNumber;
+    // Everything that an assembly reads and writes, each thread assembles into its own context unless it sets another
+    struct Context
+    {
+        int _lineNumber = 0;
+
+        uint16_t _byteCount = 0;
+        uint16_t _callTable = DEFAULT_CALL_TABLE;
+        uint16_t _startAddress = DEFAULT_START_ADDRESS;
+        uint16_t _currentAddress = DEFAULT_START_ADDRESS;
+        uint16_t _sectionAddress = DEFAULT_START_ADDRESS;
+
+        // getNextAssembledByte() and checkInvalidAddress() progress
+        bool _isUserCode = false;
+        uint16_t _byteAddress = 0x0000;
+        uint16_t _byteCustomAddress = 0x0000;
+        uint16_t _pageCustomAddress = 0x0000;
+
+        std::string _includePath = "";
+
+        std::vector<Label> _labels;
+        std::vector<Equate> _equates;
+        std::unordered_map<std::string, int> _labelIndices;
+        std::unordered_map<std::string, int> _equateIndices;
+        std::vector<Instruction> _instructions;
+        std::vector<ByteCode> _byteCode;
+        std::vector<CallTableEntry> _callTableEntries;
+        std::vector<Gprintf> _gprintfs;
+
+        // Gprintfs by address, the bitmap keeps vCPU dispatch of addresses without gprintfs out of the hash map
+        std::bitset<0x10000> _gprintfAddresses;
+        std::unordered_map<uint16_t, std::vector<int>> _gprintfIndices;
+        uint16_t _gprintfVPC = 0x0000;
+
+        AssembleTimes _assembleTimes;
+
+        // Source lines of the last assembly and, for every line of its code pass, its index and its first instruction
+        std::vector<LineToken> _listingTokens;
+        std::vector<std::pair<int, int>> _listingLines;
+
+        std::vector<Expression::Tree> _expressionTrees;
+        std::unordered_map<std::string, int> _expressionIndices;
+        std::unordered_map<std::string, IncludeUnit> _includeUnits;
+
+        int _macroInstanceId = 0;
+        const std::vector<Macro>* _macros = nullptr;
+        std::vector<MacroBody> _macroBodies;
+        std::unordered_map<uint64_t, int> _macroIndices;
+
+        bool _optimise = false;
+        bool _objectMode = false;
+        std::vector<std::string> _imports;
+        std::vector<Linker::Reserve> _reserves;
+        std::string _badReserve;
+        std::function<void (void)> _labelBias;
+    };
 
-    uint16_t _byteCount = 0;
-    uint16_t _callTable = DEFAULT_CALL_TABLE;
-    uint16_t _startAddress = DEFAULT_START_ADDRESS;
-    uint16_t _currentAddress = _startAddress;
+    // Read only once initialise() has returned, shared by every context
+    std::vector<std::string> _reservedWords;
 
-    std::string _includePath = "";
+    thread_local Context _threadContext;
+    thread_local Context* _context = &_threadContext;
 
-    std::vector<Label> _labels;
-    std::vector<Equate> _equates;
-    std::vector<Instruction> _instructions;
-    std::vector<ByteCode> _byteCode;
-    std::vector<CallTableEntry> _callTableEntries;
-    std::vector<std::string> _reservedWords;
-    std::vector<Gprintf> _gprintfs;
+    Context* createContext(void) {return new Context;}
+    void destroyContext(Context* context) {delete context;}
+    void setContext(Context* context) {_context = (context) ? context : &_threadContext;}
 
-    uint16_t getStartAddress(void) {return _startAddress;}
-    void setIncludePath(const std::string& includePath) {_includePath = includePath;}
+    uint16_t getStartAddress(void) {return _context->_startAddress;}
+    const AssembleTimes& getAssembleTimes(void) {return _context->_assembleTimes;}
+    void setIncludePath(const std::string& includePath) {_context->_includePath = includePath;}
+    void setOptimise(bool optimise) {_context->_optimise = optimise;}
 
 
     void initialise(void)
@@ -147,27 +271,29 @@ namespace Assembler
         _reservedWords.push_back("%include");
         _reservedWords.push_back("%MACRO");
         _reservedWords.push_back("%ENDM");
+        _reservedWords.push_back("%IMPORT");
+        _reservedWords.push_back("%RESERVE");
         _reservedWords.push_back("gprintf");
     }
 
     // Returns true when finished
     bool getNextAssembledByte(ByteCode& byteCode, bool debug)
     {
-        static bool isUserCode = false;
+        bool& isUserCode = _context->_isUserCode;
 
-        if(_byteCount >= _byteCode.size())
+        if(_context->_byteCount >= _context->_byteCode.size())
         {
-            _byteCount = 0;
-            if(debug  &&  isUserCode) fprintf(stderr, "\n");
+            _context->_byteCount = 0;
+            if(debug  &&  isUserCode) Expression::print("\n");
             return true;
         }
 
-        static uint16_t address = 0x0000;
-        static uint16_t customAddress = 0x0000;
+        uint16_t& address = _context->_byteAddress;
+        uint16_t& customAddress = _context->_byteCustomAddress;
 
         // Get next byte
-        if(_byteCount == 0) address = _startAddress;
-        byteCode = _byteCode[_byteCount++];
+        if(_context->_byteCount == 0) address = _context->_startAddress;
+        byteCode = _context->_byteCode[_context->_byteCount++];
 
         // New section
         if(byteCode._isCustomAddress)
@@ -180,7 +306,7 @@ namespace Assembler
         isUserCode = !byteCode._isRomAddress  ||  (byteCode._isRomAddress  &&  customAddress >= USER_ROM_ADDRESS);
 
         // Seperate sections
-        if(debug  &&  byteCode._isCustomAddress  &&  isUserCode) fprintf(stderr, "\n");
+        if(debug  &&  byteCode._isCustomAddress  &&  isUserCode) Expression::print("\n");
 
         // 16bit for ROM, 8bit for RAM
         if(debug  &&  isUserCode)
@@ -189,97 +315,165 @@ namespace Assembler
             {
                 if((address & 0x0001) == 0x0000)
                 {
-                    fprintf(stderr, "Assembler::getNextAssembledByte() : ROM : %04X  %02X", customAddress + ((address & 0x00FF)>>1), byteCode._data);
+                    Expression::print("Assembler::getNextAssembledByte() : ROM : %04X  %02X", customAddress + ((address & 0x00FF)>>1), byteCode._data);
                 }
                 else
                 {
-                    fprintf(stderr, "%02X\n", byteCode._data);
+                    Expression::print("%02X\n", byteCode._data);
                 }
             }
             else
             {
-                fprintf(stderr, "Assembler::getNextAssembledByte() : RAM : %04X  %02X\n", address, byteCode._data);
+                Expression::print("Assembler::getNextAssembledByte() : RAM : %04X  %02X\n", address, byteCode._data);
             }
         }
         address++;
         return false;
     }    
 
-    InstructionType getOpcode(const std::string& input)
+    // Mnemonics are found with a perfect hash that is built and checked at compile time, lookups are case insensitive and never allocate
+    struct Mnemonic
     {
-        InstructionType instructionType = {0x00, 0x00, BadSize, vCpu};
-
-        std::string token = input;
-        Expression::strToUpper(token);
+        const char* _name;
+        InstructionType _instructionType;
+    };
 
+    constexpr Mnemonic _mnemonics[] =
+    {
         // Gigatron vCPU instructions
-        if(token == "ST")         {instructionType._opcode = 0x5E; instructionType._byteSize = TwoBytes;  }
-        else if(token == "STW")   {instructionType._opcode = 0x2B; instructionType._byteSize = TwoBytes;  }
-        else if(token == "STLW")  {instructionType._opcode = 0xEC; instructionType._byteSize = TwoBytes;  }
-        else if(token == "LD")    {instructionType._opcode = 0x1A; instructionType._byteSize = TwoBytes;  }
-        else if(token == "LDI")   {instructionType._opcode = 0x59; instructionType._byteSize = TwoBytes;  }
-        else if(token == "LDWI")  {instructionType._opcode = 0x11; instructionType._byteSize = ThreeBytes;}
-        else if(token == "LDW")   {instructionType._opcode = 0x21; instructionType._byteSize = TwoBytes;  }
-        else if(token == "LDLW")  {instructionType._opcode = 0xEE; instructionType._byteSize = TwoBytes;  }
-        else if(token == "ADDW")  {instructionType._opcode = 0x99; instructionType._byteSize = TwoBytes;  }
-        else if(token == "SUBW")  {instructionType._opcode = 0xB8; instructionType._byteSize = TwoBytes;  }
-        else if(token == "ADDI")  {instructionType._opcode = 0xE3; instructionType._byteSize = TwoBytes;  }
-        else if(token == "SUBI")  {instructionType._opcode = 0xE6; instructionType._byteSize = TwoBytes;  }
-        else if(token == "LSLW")  {instructionType._opcode = 0xE9; instructionType._byteSize = OneByte;   }
-        else if(token == "INC")   {instructionType._opcode = 0x93; instructionType._byteSize = TwoBytes;  }
-        else if(token == "ANDI")  {instructionType._opcode = 0x82; instructionType._byteSize = TwoBytes;  }
-        else if(token == "ANDW")  {instructionType._opcode = 0xF8; instructionType._byteSize = TwoBytes;  }
-        else if(token == "ORI")   {instructionType._opcode = 0x88; instructionType._byteSize = TwoBytes;  }
-        else if(token == "ORW")   {instructionType._opcode = 0xFA; instructionType._byteSize = TwoBytes;  }
-        else if(token == "XORI")  {instructionType._opcode = 0x8C; instructionType._byteSize = TwoBytes;  }
-        else if(token == "XORW")  {instructionType._opcode = 0xFC; instructionType._byteSize = TwoBytes;  }
-        else if(token == "PEEK")  {instructionType._opcode = 0xAD; instructionType._byteSize = OneByte;   }
-        else if(token == "DEEK")  {instructionType._opcode = 0xF6; instructionType._byteSize = OneByte;   }
-        else if(token == "POKE")  {instructionType._opcode = 0xF0; instructionType._byteSize = TwoBytes;  }
-        else if(token == "DOKE")  {instructionType._opcode = 0xF3; instructionType._byteSize = TwoBytes;  }
-        else if(token == "LUP")   {instructionType._opcode = 0x7F; instructionType._byteSize = TwoBytes;  }
-        else if(token == "BRA")   {instructionType._opcode = 0x90; instructionType._byteSize = TwoBytes;  }
-        else if(token == "CALL")  {instructionType._opcode = 0xCF; instructionType._byteSize = TwoBytes;  }
-        else if(token == "RET")   {instructionType._opcode = 0xFF; instructionType._byteSize = OneByte;   }
-        else if(token == "PUSH")  {instructionType._opcode = 0x75; instructionType._byteSize = OneByte;   }
-        else if(token == "POP")   {instructionType._opcode = 0x63; instructionType._byteSize = OneByte;   }
-        else if(token == "ALLOC") {instructionType._opcode = 0xDF; instructionType._byteSize = TwoBytes;  }
-        else if(token == "SYS")   {instructionType._opcode = 0xB4; instructionType._byteSize = TwoBytes;  }
-        else if(token == "DEF")   {instructionType._opcode = 0xCD; instructionType._byteSize = TwoBytes;  }
+        {"ST",    {0x5E, 0x00, TwoBytes,   vCpu}},
+        {"STW",   {0x2B, 0x00, TwoBytes,   vCpu}},
+        {"STLW",  {0xEC, 0x00, TwoBytes,   vCpu}},
+        {"LD",    {0x1A, 0x00, TwoBytes,   vCpu}},
+        {"LDI",   {0x59, 0x00, TwoBytes,   vCpu}},
+        {"LDWI",  {0x11, 0x00, ThreeBytes, vCpu}},
+        {"LDW",   {0x21, 0x00, TwoBytes,   vCpu}},
+        {"LDLW",  {0xEE, 0x00, TwoBytes,   vCpu}},
+        {"ADDW",  {0x99, 0x00, TwoBytes,   vCpu}},
+        {"SUBW",  {0xB8, 0x00, TwoBytes,   vCpu}},
+        {"ADDI",  {0xE3, 0x00, TwoBytes,   vCpu}},
+        {"SUBI",  {0xE6, 0x00, TwoBytes,   vCpu}},
+        {"LSLW",  {0xE9, 0x00, OneByte,    vCpu}},
+        {"INC",   {0x93, 0x00, TwoBytes,   vCpu}},
+        {"ANDI",  {0x82, 0x00, TwoBytes,   vCpu}},
+        {"ANDW",  {0xF8, 0x00, TwoBytes,   vCpu}},
+        {"ORI",   {0x88, 0x00, TwoBytes,   vCpu}},
+        {"ORW",   {0xFA, 0x00, TwoBytes,   vCpu}},
+        {"XORI",  {0x8C, 0x00, TwoBytes,   vCpu}},
+        {"XORW",  {0xFC, 0x00, TwoBytes,   vCpu}},
+        {"PEEK",  {0xAD, 0x00, OneByte,    vCpu}},
+        {"DEEK",  {0xF6, 0x00, OneByte,    vCpu}},
+        {"POKE",  {0xF0, 0x00, TwoBytes,   vCpu}},
+        {"DOKE",  {0xF3, 0x00, TwoBytes,   vCpu}},
+        {"LUP",   {0x7F, 0x00, TwoBytes,   vCpu}},
+        {"BRA",   {0x90, 0x00, TwoBytes,   vCpu}},
+        {"CALL",  {0xCF, 0x00, TwoBytes,   vCpu}},
+        {"RET",   {0xFF, 0x00, OneByte,    vCpu}},
+        {"PUSH",  {0x75, 0x00, OneByte,    vCpu}},
+        {"POP",   {0x63, 0x00, OneByte,    vCpu}},
+        {"ALLOC", {0xDF, 0x00, TwoBytes,   vCpu}},
+        {"SYS",   {0xB4, 0x00, TwoBytes,   vCpu}},
+        {"DEF",   {0xCD, 0x00, TwoBytes,   vCpu}},
 
         // Gigatron vCPU branch instructions
-        else if(token == "BEQ")   {instructionType._opcode = 0x35; instructionType._branch = 0x3F; instructionType._byteSize = ThreeBytes;}
-        else if(token == "BNE")   {instructionType._opcode = 0x35; instructionType._branch = 0x72; instructionType._byteSize = ThreeBytes;}
-        else if(token == "BLT")   {instructionType._opcode = 0x35; instructionType._branch = 0x50; instructionType._byteSize = ThreeBytes;}
-        else if(token == "BGT")   {instructionType._opcode = 0x35; instructionType._branch = 0x4D; instructionType._byteSize = ThreeBytes;}
-        else if(token == "BLE")   {instructionType._opcode = 0x35; instructionType._branch = 0x56; instructionType._byteSize = ThreeBytes;}
-        else if(token == "BGE")   {instructionType._opcode = 0x35; instructionType._branch = 0x53; instructionType._byteSize = ThreeBytes;}
+        {"BEQ",   {0x35, 0x3F, ThreeBytes, vCpu}},
+        {"BNE",   {0x35, 0x72, ThreeBytes, vCpu}},
+        {"BLT",   {0x35, 0x50, ThreeBytes, vCpu}},
+        {"BGT",   {0x35, 0x4D, ThreeBytes, vCpu}},
+        {"BLE",   {0x35, 0x56, ThreeBytes, vCpu}},
+        {"BGE",   {0x35, 0x53, ThreeBytes, vCpu}},
 
         // Reserved assembler opcodes
-        else if(token == "DB")    {instructionType._byteSize = TwoBytes;   instructionType._opcodeType = ReservedDB; }
-        else if(token == "DW")    {instructionType._byteSize = ThreeBytes; instructionType._opcodeType = ReservedDW; }
-        else if(token == "DBR")   {instructionType._byteSize = TwoBytes;   instructionType._opcodeType = ReservedDBR;}
-        else if(token == "DWR")   {instructionType._byteSize = ThreeBytes; instructionType._opcodeType = ReservedDWR;}
-                                                                           
-        // Gigatron native instructions                                    
-        else if(token == ".LD")   {instructionType._opcode = 0x00; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".NOP")  {instructionType._opcode = 0x02; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".ANDA") {instructionType._opcode = 0x20; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".ORA")  {instructionType._opcode = 0x40; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".XORA") {instructionType._opcode = 0x60; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".ADDA") {instructionType._opcode = 0x80; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".SUBA") {instructionType._opcode = 0xA0; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".ST")   {instructionType._opcode = 0xC0; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".JMP")  {instructionType._opcode = 0xE0; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".BGT")  {instructionType._opcode = 0xE4; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".BLT")  {instructionType._opcode = 0xE8; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".BNE")  {instructionType._opcode = 0xEC; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".BEQ")  {instructionType._opcode = 0xF0; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".BGE")  {instructionType._opcode = 0xF4; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".BLE")  {instructionType._opcode = 0xF8; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-        else if(token == ".BRA")  {instructionType._opcode = 0xFC; instructionType._byteSize = TwoBytes; instructionType._opcodeType = Native;}
-
-        return instructionType;
+        {"DB",    {0x00, 0x00, TwoBytes,   ReservedDB}},
+        {"DW",    {0x00, 0x00, ThreeBytes, ReservedDW}},
+        {"DBR",   {0x00, 0x00, TwoBytes,   ReservedDBR}},
+        {"DWR",   {0x00, 0x00, ThreeBytes, ReservedDWR}},
+
+        // Gigatron native instructions
+        {".LD",   {0x00, 0x00, TwoBytes,   Native}},
+        {".NOP",  {0x02, 0x00, TwoBytes,   Native}},
+        {".ANDA", {0x20, 0x00, TwoBytes,   Native}},
+        {".ORA",  {0x40, 0x00, TwoBytes,   Native}},
+        {".XORA", {0x60, 0x00, TwoBytes,   Native}},
+        {".ADDA", {0x80, 0x00, TwoBytes,   Native}},
+        {".SUBA", {0xA0, 0x00, TwoBytes,   Native}},
+        {".ST",   {0xC0, 0x00, TwoBytes,   Native}},
+        {".JMP",  {0xE0, 0x00, TwoBytes,   Native}},
+        {".BGT",  {0xE4, 0x00, TwoBytes,   Native}},
+        {".BLT",  {0xE8, 0x00, TwoBytes,   Native}},
+        {".BNE",  {0xEC, 0x00, TwoBytes,   Native}},
+        {".BEQ",  {0xF0, 0x00, TwoBytes,   Native}},
+        {".BGE",  {0xF4, 0x00, TwoBytes,   Native}},
+        {".BLE",  {0xF8, 0x00, TwoBytes,   Native}},
+        {".BRA",  {0xFC, 0x00, TwoBytes,   Native}}
+    };
+
+    constexpr int _numMnemonics = int(sizeof(_mnemonics) / sizeof(Mnemonic));
+
+    struct OpcodeTable
+    {
+        uint8_t _slots[OPCODE_HASH_SIZE]; // index + 1 into _mnemonics, 0 is an empty slot
+    };
+
+    constexpr char upperChar(char chr)
+    {
+        return (chr >= 'a'  &&  chr <= 'z') ? char(chr - ('a' - 'A')) : chr;
+    }
+
+    constexpr size_t mnemonicLength(const char* name)
+    {
+        size_t length = 0;
+        while(name[length]) length++;
+        return length;
+    }
+
+    constexpr uint8_t hashMnemonic(const char* name, size_t length)
+    {
+        uint32_t hash = 0;
+        for(size_t i=0; i<length; i++) hash = hash*31 + uint8_t(upperChar(name[i]));
+        return uint8_t((hash * OPCODE_HASH_MULT) >> 24);
+    }
+
+    constexpr OpcodeTable buildOpcodeTable(void)
+    {
+        OpcodeTable table = {};
+        for(int i=0; i<_numMnemonics; i++) table._slots[hashMnemonic(_mnemonics[i]._name, mnemonicLength(_mnemonics[i]._name))] = uint8_t(i + 1);
+        return table;
+    }
+
+    constexpr OpcodeTable _opcodeTable = buildOpcodeTable();
+
+    constexpr bool isPerfectHash(void)
+    {
+        for(int i=0; i<_numMnemonics; i++)
+        {
+            if(mnemonicLength(_mnemonics[i]._name) > OPCODE_MAX_LENGTH) return false;
+            if(_opcodeTable._slots[hashMnemonic(_mnemonics[i]._name, mnemonicLength(_mnemonics[i]._name))] != i + 1) return false;
+        }
+
+        return true;
+    }
+
+    static_assert(isPerfectHash(), "Assembler : mnemonic hash collision, change OPCODE_HASH_MULT");
+
+    InstructionType getOpcode(const std::string& input)
+    {
+        InstructionType instructionType = {0x00, 0x00, BadSize, vCpu};
+
+        size_t length = input.size();
+        if(length == 0  ||  length > OPCODE_MAX_LENGTH) return instructionType;
+
+        int slot = _opcodeTable._slots[hashMnemonic(input.c_str(), length)];
+        if(slot == 0) return instructionType;
+
+        const char* name = _mnemonics[slot - 1]._name;
+        for(size_t i=0; i<length; i++)
+        {
+            if(name[i] == 0  ||  upperChar(input[i]) != name[i]) return instructionType;
+        }
+        if(name[length] != 0) return instructionType;
+
+        return _mnemonics[slot - 1]._instructionType;
     }
 
     void preProcessExpression(const std::vector<std::string>& tokens, int tokenIndex, std::string& input, bool stripWhiteSpace)
@@ -300,85 +494,91 @@ namespace Assembler
         if(stripWhiteSpace) input.erase(remove_if(input.begin(), input.end(), isspace), input.end());
     }
 
-    size_t findSymbol(const std::string& input, const std::string& symbol, size_t pos = 0)
+    bool searchEquate(const std::string& token, Equate& equate)
     {
-        const char* separators = "+-*/().,!?;#'\"[] \t\n\r";
-        const size_t len = input.length();
-        if (pos >= len)
-            return std::string::npos;
-        for(;;) {
-            size_t sep = input.find_first_of(separators, pos);
-            bool eos = (sep == std::string::npos);
-            size_t end = eos ? len : sep;
-            if (input.substr(pos, end-pos) == symbol)
-                return pos;
-            else if (eos)
-                return std::string::npos;
-            pos = sep+1;
-        }
-        return std::string::npos;   // unreachable
+        auto it = _context->_equateIndices.find(token);
+        if(it == _context->_equateIndices.end()) return false;
+
+        equate = _context->_equates[it->second];
+        return true;
     }
 
-    bool applyEquatesToExpression(std::string& expression, const std::vector<Equate>& equates)
+    bool searchLabel(const std::string& token, Label& label)
     {
-        bool modified = false;
-        for(int i=0; i<equates.size(); i++) {
-            for (;;) {
-                size_t pos = findSymbol(expression, equates[i]._name);
-                if (pos == std::string::npos)
-                    break;  // not found
-                modified = true;
-                expression.replace(pos, equates[i]._name.size(), std::to_string(equates[i]._operand));
-            }
-        }
-        return modified;
+        auto it = _context->_labelIndices.find(token);
+        if(it == _context->_labelIndices.end()) return false;
+
+        label = _context->_labels[it->second];
+        return true;
     }
 
-    bool applyLabelsToExpression(std::string& expression, const std::vector<Label>& labels, bool nativeCode)
+    void addEquate(const Equate& equate)
     {
-        bool modified = false;
-        for(int i=0; i<labels.size(); i++) {
-            for (;;) {
-                size_t pos = findSymbol(expression, labels[i]._name);
-                if (pos == std::string::npos)
-                    break;  // not found
-                modified = true;
-                uint16_t address = (nativeCode) ? labels[i]._address >>1 : labels[i]._address;
-                expression.replace(pos, labels[i]._name.size(), std::to_string(address));
-            }
-        }
-        return modified;
+        _context->_equateIndices[equate._name] = int(_context->_equates.size());
+        _context->_equates.push_back(equate);
+    }
+
+    void addLabel(const Label& label)
+    {
+        _context->_labelIndices[label._name] = int(_context->_labels.size());
+        _context->_labels.push_back(label);
     }
 
-    uint16_t evaluateExpression(std::string input, bool nativeCode)
-    { 
-        // Replace equates
-        applyEquatesToExpression(input, _equates);
+    uint16_t getNativeAddress(const Label& label)
+    {
+        return uint16_t(label._sectionAddress + ((label._address - label._sectionAddress) >>1));
+    }
 
-        // Replace labels
-        applyLabelsToExpression(input, _labels, nativeCode);
+    // Expressions are compiled once per assembly into trees of symbol references, failed compiles aren't kept so that every
+    // line they appear on is reported
+    int compileExpression(const std::string& input)
+    {
+        auto it = _context->_expressionIndices.find(input);
+        if(it != _context->_expressionIndices.end()) return it->second;
 
-        // Strip white space
-        input.erase(remove_if(input.begin(), input.end(), isspace), input.end());
+        Expression::Tree tree;
+        if(!Expression::compile(input, tree, _context->_lineNumber)) return -1;
 
-        // Parse expression and return with a result
-        return Expression::parse((char*)input.c_str(), _lineNumber);
+        int index = int(_context->_expressionTrees.size());
+        _context->_expressionTrees.push_back(std::move(tree));
+        _context->_expressionIndices[input] = index;
+        return index;
     }
 
-    bool searchEquate(const std::string& token, Equate& equate)
+    // Equates take precedence over labels, unknown symbols are reported and evaluate to zero
+    uint16_t evaluateExpression(int treeIndex, bool nativeCode)
     {
-        bool success = false;
-        for(int i=0; i<_equates.size(); i++)
+        auto resolver = [nativeCode](const std::string& symbol, uint16_t& value)
         {
-            if(_equates[i]._name == token)
+            auto equate = _context->_equateIndices.find(symbol);
+            if(equate != _context->_equateIndices.end())
             {
-                equate = _equates[i];
-                success = true;
-                break;
+                value = _context->_equates[equate->second]._operand;
+                return true;
             }
-        }
 
-        return success;
+            auto label = _context->_labelIndices.find(symbol);
+            if(label != _context->_labelIndices.end())
+            {
+                value = (nativeCode) ? getNativeAddress(_context->_labels[label->second]) : _context->_labels[label->second]._address;
+                return true;
+            }
+
+            return false;
+        };
+
+        uint16_t value;
+        Expression::evaluate(_context->_expressionTrees[treeIndex], resolver, value, _context->_lineNumber);
+        return value;
+    }
+
+    bool evaluateExpression(const std::string& input, bool nativeCode, uint16_t& value)
+    {
+        int treeIndex = compileExpression(input);
+        if(treeIndex == -1) return false;
+
+        value = evaluateExpression(treeIndex, nativeCode);
+        return true;
     }
 
     bool evaluateEquateOperand(const std::string& token, Equate& equate)
@@ -386,11 +586,7 @@ namespace Assembler
         // Expression equates
         Expression::ExpressionType expressionType = Expression::isExpression(token);
         if(expressionType == Expression::Invalid) return false;
-        if(expressionType == Expression::Valid)
-        {
-            equate._operand = evaluateExpression(token, false);
-            return true;
-        }
+        if(expressionType == Expression::Valid) return evaluateExpression(token, false, equate._operand);
 
         // Check for existing equate
         return searchEquate(token, equate);
@@ -429,13 +625,14 @@ namespace Assembler
                 // Reserved word, (equate), _callTable_
                 if(tokens[0] == "_callTable_")
                 {
-                    _callTable = equate._operand;
+                    _context->_callTable = equate._operand;
                 }
                 // Reserved word, (equate), _startAddress_
                 else if(tokens[0] == "_startAddress_")
                 {
-                    _startAddress = equate._operand;
-                    _currentAddress = _startAddress;
+                    _context->_startAddress = equate._operand;
+                    _context->_currentAddress = _context->_startAddress;
+                    _context->_sectionAddress = _context->_startAddress;
                 }
 #ifndef STAND_ALONE
                 // Disable upload of the current assembler module
@@ -464,9 +661,9 @@ namespace Assembler
                 {
                     // Check for duplicate
                     equate._name = tokens[0];
-                    if(searchEquate(tokens[0], equate)) return Duplicate;
+                    if(_context->_equateIndices.find(tokens[0]) != _context->_equateIndices.end()) return Duplicate;
 
-                    _equates.push_back(equate);
+                    addEquate(equate);
                 }
             }
             else if(parse == CodePass)
@@ -479,32 +676,12 @@ namespace Assembler
         return Failed;
     }
 
-    bool searchLabel(const std::string& token, Label& label)
-    {
-        bool success = false;
-        for(int i=0; i<_labels.size(); i++)
-        {
-            if(token == _labels[i]._name)
-            {
-                success = true;
-                label = _labels[i];
-                break;
-            }
-        }
-
-        return success;
-    }
-
     bool evaluateLabelOperand(const std::string& token, Label& label)
     {
         // Expression labels
         Expression::ExpressionType expressionType = Expression::isExpression(token);
         if(expressionType == Expression::Invalid) return false;
-        if(expressionType == Expression::Valid)
-        {
-            label._address = evaluateExpression(token, false);
-            return true;
-        }
+        if(expressionType == Expression::Valid) return evaluateExpression(token, false, label._address);
 
         // Check for existing label
         return searchLabel(token, label);
@@ -528,6 +705,46 @@ namespace Assembler
         return evaluateLabelOperand(token, label);
     }
 
+    // Operands of compound instructions are individual tokens, everything else is the concatenated remainder of the line
+    const std::string& getOperand(const ParsedLine& parsedLine, bool compoundInstruction)
+    {
+        int operandIndex = parsedLine._opcodeIndex + 1;
+        if(!compoundInstruction  ||  operandIndex >= int(parsedLine._tokens.size())) return parsedLine._operand;
+
+        return parsedLine._tokens[operandIndex];
+    }
+
+    // Expression operands are compiled the first time a pass evaluates them and their tree is kept in the line, so no pass
+    // re-parses them
+    bool evaluateOperandTree(ParsedLine& parsedLine, uint16_t& value)
+    {
+        if(parsedLine._operandTree == -1) parsedLine._operandTree = compileExpression(parsedLine._operand);
+        if(parsedLine._operandTree == -1) return false;
+
+        value = evaluateExpression(parsedLine._operandTree, false);
+        return true;
+    }
+
+    bool evaluateEquateOperand(ParsedLine& parsedLine, bool compoundInstruction, Equate& equate)
+    {
+        if(compoundInstruction) return evaluateEquateOperand(getOperand(parsedLine, true), equate);
+
+        if(parsedLine._operandType == Expression::Invalid) return false;
+        if(parsedLine._operandType == Expression::Valid) return evaluateOperandTree(parsedLine, equate._operand);
+
+        return searchEquate(parsedLine._operand, equate);
+    }
+
+    bool evaluateLabelOperand(ParsedLine& parsedLine, bool compoundInstruction, Label& label)
+    {
+        if(compoundInstruction) return evaluateLabelOperand(getOperand(parsedLine, true), label);
+
+        if(parsedLine._operandType == Expression::Invalid) return false;
+        if(parsedLine._operandType == Expression::Valid) return evaluateOperandTree(parsedLine, label._address);
+
+        return searchLabel(parsedLine._operand, label);
+    }
+
     EvaluateResult EvaluateLabels(const std::vector<std::string>& tokens, ParseType parse, int tokenIndex)
     {
         if(parse == MnemonicPass) 
@@ -538,23 +755,21 @@ namespace Assembler
                 if(tokens[tokenIndex] == _reservedWords[i]) return Reserved;
             }
             
-            Label label;
-            if(searchLabel(tokens[tokenIndex], label)) return Duplicate;
+            if(_context->_labelIndices.find(tokens[tokenIndex]) != _context->_labelIndices.end()) return Duplicate;
 
             // Check equates for a custom start address
-            for(int i=0; i<_equates.size(); i++)
+            auto it = _context->_equateIndices.find(tokens[tokenIndex]);
+            if(it != _context->_equateIndices.end())
             {
-                if(_equates[i]._name == tokens[tokenIndex])
-                {
-                    _equates[i]._isCustomAddress = true;
-                    _currentAddress = _equates[i]._operand;
-                    break;
-                }
+                _context->_equates[it->second]._isCustomAddress = true;
+                _context->_equates[it->second]._customAddress = _context->_equates[it->second]._operand;
+                _context->_currentAddress = _context->_equates[it->second]._operand;
+                _context->_sectionAddress = _context->_currentAddress;
             }
 
             // Normal labels
-            label = {_currentAddress, tokens[tokenIndex]};
-            _labels.push_back(label);
+            Label label = {_context->_currentAddress, tokens[tokenIndex], _context->_sectionAddress};
+            addLabel(label);
         }
         else if(parse == CodePass)
         {
@@ -579,7 +794,7 @@ namespace Assembler
                 for(int j=1; j<token.size(); j++) // First instruction was created by callee
                 {
                     Instruction inst = {instruction._isRomAddress, false, OneByte, uint8_t(token[j]), 0x00, 0x00, 0x0000, instruction._opcodeType};
-                    _instructions.push_back(inst);
+                    _context->_instructions.push_back(inst);
                 }
             }
             dbSize += int(token.size()) - 1; // First instruction was created by callee
@@ -600,7 +815,7 @@ namespace Assembler
                     for(int j=0; j<token.size(); j++)
                     {
                         Instruction inst = {instruction._isRomAddress, false, OneByte, uint8_t(token[j]), 0x00, 0x00, 0x0000, instruction._opcodeType};
-                        _instructions.push_back(inst);
+                        _context->_instructions.push_back(inst);
                     }
                 }
                 dbSize += int(token.size());
@@ -633,7 +848,7 @@ namespace Assembler
                         // Normal expression
                         if(Expression::isExpression(tokens[i]) == Expression::Valid)
                         {
-                            operand = uint8_t(Expression::parse((char*)tokens[i].c_str(), _lineNumber));
+                            operand = uint8_t(Expression::parse((char*)tokens[i].c_str(), _context->_lineNumber));
                             success = true;
                         }
                         else
@@ -646,7 +861,7 @@ namespace Assembler
                 if(createInstruction)
                 {
                     Instruction inst = {instruction._isRomAddress, false, OneByte, operand, 0x00, 0x00, 0x0000, instruction._opcodeType};
-                    _instructions.push_back(inst);
+                    _context->_instructions.push_back(inst);
                 }
                 dbSize++;
             }
@@ -690,7 +905,7 @@ namespace Assembler
                     // Normal expression
                     if(Expression::isExpression(tokens[i]) == Expression::Valid)
                     {
-                        operand = Expression::parse((char*)tokens[i].c_str(), _lineNumber);
+                        operand = Expression::parse((char*)tokens[i].c_str(), _context->_lineNumber);
                         success = true;
                     }
                     else
@@ -703,7 +918,7 @@ namespace Assembler
             if(createInstruction)
             {
                 Instruction inst = {instruction._isRomAddress, false, TwoBytes, uint8_t(operand & 0x00FF), uint8_t((operand & 0xFF00) >>8), 0x00, 0x0000,  instruction._opcodeType};
-                _instructions.push_back(inst);
+                _context->_instructions.push_back(inst);
             }
             dwSize += 2;
         }
@@ -718,14 +933,17 @@ namespace Assembler
         if(expressionType == Expression::Valid)
         {
             // Parse expression and return with a result
-            operand = uint8_t(evaluateExpression(token, true));
+            uint16_t value;
+            if(!evaluateExpression(token, true, value)) return false;
+
+            operand = uint8_t(value);
             return true;
         }
 
         Label label;
         if(searchLabel(token, label))
         {
-            operand = uint8_t((label._address >>1) & 0x00FF);
+            operand = uint8_t(getNativeAddress(label) & 0x00FF);
             return true;
         }
 
@@ -911,7 +1129,7 @@ namespace Assembler
                 byteCode._isCustomAddress = instruction._isCustomAddress;
                 byteCode._data = instruction._opcode;
                 byteCode._address = instruction._address;
-                _byteCode.push_back(byteCode);
+                _context->_byteCode.push_back(byteCode);
             }
             break;
 
@@ -921,13 +1139,13 @@ namespace Assembler
                 byteCode._isCustomAddress = instruction._isCustomAddress;
                 byteCode._data = instruction._opcode;
                 byteCode._address = instruction._address;
-                _byteCode.push_back(byteCode);
+                _context->_byteCode.push_back(byteCode);
 
                 byteCode._isRomAddress = instruction._isRomAddress;
                 byteCode._isCustomAddress = false;
                 byteCode._data = instruction._operand0;
                 byteCode._address = 0x0000;
-                _byteCode.push_back(byteCode);
+                _context->_byteCode.push_back(byteCode);
             }
             break;
 
@@ -937,19 +1155,19 @@ namespace Assembler
                 byteCode._isCustomAddress = instruction._isCustomAddress;
                 byteCode._data = instruction._opcode;
                 byteCode._address = instruction._address;
-                _byteCode.push_back(byteCode);
+                _context->_byteCode.push_back(byteCode);
 
                 byteCode._isRomAddress = instruction._isRomAddress;
                 byteCode._isCustomAddress = false;
                 byteCode._data = instruction._operand0;
                 byteCode._address = 0x0000;
-                _byteCode.push_back(byteCode);
+                _context->_byteCode.push_back(byteCode);
 
                 byteCode._isRomAddress = instruction._isRomAddress;
                 byteCode._isCustomAddress = false;
                 byteCode._data = instruction._operand1;
                 byteCode._address = 0x0000;
-                _byteCode.push_back(byteCode);
+                _context->_byteCode.push_back(byteCode);
             }
             break;
         }
@@ -961,50 +1179,50 @@ namespace Assembler
         ByteCode byteCode;
         uint16_t segmentOffset = 0x0000;
         uint16_t segmentAddress = 0x0000;
-        for(int i=0; i<_instructions.size(); i++)
+        for(int i=0; i<_context->_instructions.size(); i++)
         {
             // Segment RAM instructions into 256 byte pages for .gt1 file format
-            if(!_instructions[i]._isRomAddress)
+            if(!_context->_instructions[i]._isRomAddress)
             {
                 // Save start of segment
-                if(_instructions[i]._isCustomAddress)
+                if(_context->_instructions[i]._isCustomAddress)
                 {
                     segmentOffset = 0x0000;
-                    segmentAddress = _instructions[i]._address;
+                    segmentAddress = _context->_instructions[i]._address;
                 }
 
                 // Force a new segment, (this could fail if an instruction straddles a page boundary, but
                 // the page boundary crossing detection logic will stop the assembler before we get here)
-                if(!_instructions[i]._isCustomAddress  &&  segmentOffset % 256 == 0)
+                if(!_context->_instructions[i]._isCustomAddress  &&  segmentOffset % 256 == 0)
                 {
-                    _instructions[i]._isCustomAddress = true;
-                    _instructions[i]._address = segmentAddress + segmentOffset;
+                    _context->_instructions[i]._isCustomAddress = true;
+                    _context->_instructions[i]._address = segmentAddress + segmentOffset;
                 }
 
-                segmentOffset += _instructions[i]._byteSize;
+                segmentOffset += _context->_instructions[i]._byteSize;
             }
 
-            packByteCode(_instructions[i], byteCode);
+            packByteCode(_context->_instructions[i], byteCode);
         }
 
         // Append call table
-        if(_callTable  &&  _callTableEntries.size())
+        if(_context->_callTable  &&  _context->_callTableEntries.size())
         {
             // _callTable grows downwards, pointer is 2 bytes below the bottom of the table by the time we get here
-            for(int i=int(_callTableEntries.size())-1; i>=0; i--)
+            for(int i=int(_context->_callTableEntries.size())-1; i>=0; i--)
             {
-                int end = int(_callTableEntries.size()) - 1;
+                int end = int(_context->_callTableEntries.size()) - 1;
                 byteCode._isRomAddress = false;
                 byteCode._isCustomAddress = (i == end) ?  true : false;
-                byteCode._data = _callTableEntries[i]._address & 0x00FF;
-                byteCode._address = _callTable + (end-i)*2 + 2;
-                _byteCode.push_back(byteCode);
+                byteCode._data = _context->_callTableEntries[i]._address & 0x00FF;
+                byteCode._address = _context->_callTable + (end-i)*2 + 2;
+                _context->_byteCode.push_back(byteCode);
 
                 byteCode._isRomAddress = false;
                 byteCode._isCustomAddress = false;
-                byteCode._data = (_callTableEntries[i]._address & 0xFF00) >>8;
-                byteCode._address = _callTable + (end-i)*2 + 3;
-                _byteCode.push_back(byteCode);
+                byteCode._data = (_context->_callTableEntries[i]._address & 0xFF00) >>8;
+                byteCode._address = _context->_callTable + (end-i)*2 + 3;
+                _context->_byteCode.push_back(byteCode);
             }
         }
     }
@@ -1021,14 +1239,14 @@ namespace Assembler
                (start >= GIGA_CH2_WAV_A  &&  start <= GIGA_CH2_OSC_H)  ||  (end >= GIGA_CH2_WAV_A  &&  end <= GIGA_CH2_OSC_H)  ||
                (start >= GIGA_CH3_WAV_A  &&  start <= GIGA_CH3_OSC_H)  ||  (end >= GIGA_CH3_WAV_A  &&  end <= GIGA_CH3_OSC_H))
             {
-                fprintf(stderr, "Assembler::assemble() : Warning, audio channel boundary compromised : 0x%04X <-> 0x%04X\nAssembler::assemble() : '%s'\nAssembler::assemble() : in '%s' on line %d\n", start, end, lineToken._text.c_str(), filename.c_str(), lineNumber+1);
+                Expression::print("Assembler::assemble() : Warning, audio channel boundary compromised : 0x%04X <-> 0x%04X\nAssembler::assemble() : '%s'\nAssembler::assemble() : in '%s' on line %d\n", start, end, lineToken._text.c_str(), filename.c_str(), lineNumber+1);
             }
         }
 
         // Check for page boundary crossings
         if(parse == CodePass  &&  (instruction._opcodeType == vCpu || instruction._opcodeType == Native))
         {
-            static uint16_t customAddress = 0x0000;
+            uint16_t& customAddress = _context->_pageCustomAddress;
             if(instruction._isCustomAddress) customAddress = instruction._address;
 
             uint16_t oldAddress = (instruction._isRomAddress) ? customAddress + ((currentAddress & 0x00FF)>>1) : currentAddress;
@@ -1036,7 +1254,7 @@ namespace Assembler
             uint16_t newAddress = (instruction._isRomAddress) ? customAddress + ((currentAddress & 0x00FF)>>1) : currentAddress;
             if((oldAddress >>8) != (newAddress >>8))
             {
-                fprintf(stderr, "Assembler::assemble() : Page boundary compromised : %04X : %04X : '%s' : in '%s' on line %d\n", oldAddress, newAddress, lineToken._text.c_str(), filename.c_str(), lineNumber+1);
+                Expression::print("Assembler::assemble() : Page boundary compromised : %04X : %04X : '%s' : in '%s' on line %d\n", oldAddress, newAddress, lineToken._text.c_str(), filename.c_str(), lineNumber+1);
                 return false;
             }
         }
@@ -1062,257 +1280,366 @@ namespace Assembler
         return result;
     }
 
-    std::vector<std::string> tokeniseLine(std::string& line)
+    // Tokens are delimited by white space, quoted strings are single tokens that keep their quotes, unterminated strings are dropped
+    // Same set as " \n\r\f\t\v", embedded nulls count as white space
+    bool isWhiteSpace(char chr)
     {
-        std::string token = "";
-        bool delimiterStart = true;
-        bool stringStart = false;
-        enum DelimiterState {WhiteSpace, Quotes};
-        DelimiterState delimiterState = WhiteSpace;
-        std::vector<std::string> tokens;
+        return chr == 0  ||  chr == ' '  ||  (chr >= '\t'  &&  chr <= '\r');
+    }
+
+    void tokeniseLine(const std::string& line, std::vector<TokenSpan>& spans)
+    {
+        spans.clear();
 
-        for(int i=0; i<=line.size(); i++)
+        size_t start = 0, length = line.size();
+        while(start < length)
         {
-            // End of line is a delimiter for white space
-            if(i == line.size())
+            // Skip white space
+            char chr = line[start];
+            if(isWhiteSpace(chr))
             {
-                if(delimiterState != Quotes)
-                {
-                    delimiterState = WhiteSpace;
-                    delimiterStart = false;
-                }
-                else
-                {
-                    break;
-                }
+                start++;
+                continue;
             }
-            else
+
+            // Scan to the end of the token, quotes switch off white space delimiting until the next quote
+            bool quotes = false, closed = false;
+            size_t end = start;
+            for(; end<length; end++)
             {
-                // White space delimiters
-                if(strchr(" \n\r\f\t\v", line[i]))
+                chr = line[end];
+                if(quotes)
                 {
-                    if(delimiterState != Quotes)
+                    if(chr == '\''  ||  chr == '"')
                     {
-                        delimiterState = WhiteSpace;
-                        delimiterStart = false;
+                        closed = true;
+                        end++;
+                        break;
                     }
                 }
-                // String delimiters
-                else if(strchr("\'\"", line[i]))
+                else if(isWhiteSpace(chr))
                 {
-                    delimiterState = Quotes;
-                    stringStart = !stringStart;
-                }
-            }
-
-            // Build token
-            switch(delimiterState)
-            {
-                case WhiteSpace:
-                {
-                    // Don't save delimiters
-                    if(delimiterStart)
-                    {
-                        if(!strchr(" \n\r\f\t\v", line[i])) token += line[i];
-                    }
-                    else
-                    {
-                        if(token.size()) tokens.push_back(token);
-                        delimiterStart = true;
-                        token = "";
-                    }
+                    break;
                 }
-                break;
-
-                case Quotes:
+                else if(chr == '\''  ||  chr == '"')
                 {
-                    // Save delimiters as well as chars
-                    if(stringStart)
-                    {
-                        token += line[i];
-                    }
-                    else
-                    {
-                        token += line[i];
-                        tokens.push_back(token);
-                        delimiterState = WhiteSpace;
-                        stringStart = false;
-                        token = "";
-                    }
+                    quotes = true;
                 }
-                break;
             }
+
+            // Unterminated strings are dropped
+            if(quotes  &&  !closed) break;
+
+            spans.push_back({start, end - start});
+            start = end;
         }
+    }
+
+    std::vector<std::string> tokeniseLine(const std::string& line)
+    {
+        std::vector<TokenSpan> spans;
+        spans.reserve(8);
+        tokeniseLine(line, spans);
+
+        std::vector<std::string> tokens;
+        tokens.reserve(spans.size());
+        for(int i=0; i<int(spans.size()); i++) tokens.push_back(line.substr(spans[i]._start, spans[i]._length));
 
         return tokens;
     }
 
+    uint64_t hashData(const uint8_t* data, size_t size)
+    {
+        uint64_t hash = FNV_OFFSET_BASIS;
+        for(size_t i=0; i<size; i++)
+        {
+            hash ^= data[i];
+            hash *= FNV_PRIME;
+        }
+
+        return hash;
+    }
+
+    bool hashFile(const std::string& filepath, uint64_t& hash)
+    {
+        Mapping::File file;
+        if(!Mapping::mapFile(filepath, file)) return false;
+
+        hash = hashData(file._data, file._size);
+        Mapping::unmapFile(file);
+        return true;
+    }
+
+    bool isIncludeUnitCurrent(const IncludeUnit& includeUnit, uint64_t hash)
+    {
+        if(includeUnit._hash != hash) return false;
+
+        for(int i=0; i<int(includeUnit._dependencies.size()); i++)
+        {
+            uint64_t dependencyHash;
+            if(!hashFile(includeUnit._dependencies[i].first, dependencyHash)  ||  dependencyHash != includeUnit._dependencies[i].second) return false;
+        }
+
+        return true;
+    }
+
+    bool preProcess(const std::string& filename, std::vector<LineToken>& lineTokens, bool doMacros);
+
     bool handleInclude(const std::vector<std::string>& tokens, const std::string& lineToken, int lineIndex, std::vector<LineToken>& includeLineTokens)
     {
         // Check include syntax
         if(tokens.size() != 2)
         {
-            fprintf(stderr, "Assembler::handleInclude() : Bad %%include statement : '%s' : on line %d\n", lineToken.c_str(), lineIndex);
+            Expression::print("Assembler::handleInclude() : Bad %%include statement : '%s' : on line %d\n", lineToken.c_str(), lineIndex);
             return false;
         }
 
-        std::string filepath = _includePath + tokens[1];
+        std::string filepath = _context->_includePath + tokens[1];
         std::replace( filepath.begin(), filepath.end(), '\\', '/');
-        std::ifstream infile(filepath);
-        if(!infile.is_open())
+        Mapping::File file;
+        if(!Mapping::mapFile(filepath, file))
         {
-            fprintf(stderr, "Assembler::handleInclude() : Failed to open file : '%s'\n", filepath.c_str());
+            Expression::print("Assembler::handleInclude() : Failed to open file : '%s'\n", filepath.c_str());
             return false;
         }
 
-        // Collect lines from include file
-        int lineNumber = lineIndex;
-        while(!infile.eof())
+        // Unchanged include files and their dependencies come straight from the cache
+        uint64_t hash = hashData(file._data, file._size);
+        auto it = _context->_includeUnits.find(filepath);
+        if(it != _context->_includeUnits.end()  &&  isIncludeUnitCurrent(it->second, hash))
         {
-            LineToken includeLineToken = {true, lineNumber++ - lineIndex, "", filepath};
-            std::getline(infile, includeLineToken._text);
+            Mapping::unmapFile(file);
+            includeLineTokens = it->second._lineTokens;
+            return true;
+        }
+
+        // Collect lines from include file, a trailing new line produces a trailing empty line
+        const char* text = (const char*)file._data;
+        size_t start = 0;
+        for(int lineNumber=0;; lineNumber++)
+        {
+            size_t end = start;
+            while(end < file._size  &&  text[end] != '\n') end++;
+
+            LineToken includeLineToken = {true, lineNumber, std::string(&text[start], end - start), filepath, ""};
             includeLineTokens.push_back(includeLineToken);
 
-            if(!infile.good() &&  !infile.eof())
+            if(end >= file._size) break;
+            start = end + 1;
+        }
+        Mapping::unmapFile(file);
+
+        // Recursively include everything in order
+        if(!preProcess(filepath, includeLineTokens, false))
+        {
+            Expression::print("Assembler::preProcess() : Bad include file : '%s'\n", tokens[1].c_str());
+            return false;
+        }
+
+        // Nested includes are recorded with the hashes they were expanded from
+        IncludeUnit includeUnit;
+        includeUnit._hash = hash;
+        includeUnit._lineTokens = includeLineTokens;
+        for(int i=0; i<int(includeLineTokens.size()); i++)
+        {
+            const std::string& includeName = includeLineTokens[i]._includeName;
+            if(includeName == filepath) continue;
+
+            bool found = false;
+            for(int j=0; j<int(includeUnit._dependencies.size()); j++)
             {
-                fprintf(stderr, "Assembler::handleInclude() : Bad lineToken : '%s' : in '%s' on line %d\n", includeLineToken._text.c_str(), filepath.c_str(), lineNumber - lineIndex);
-                return false;
+                if(includeUnit._dependencies[j].first == includeName) {found = true; break;}
             }
+            if(!found) includeUnit._dependencies.push_back(std::make_pair(includeName, _context->_includeUnits[includeName]._hash));
         }
+        _context->_includeUnits[filepath] = std::move(includeUnit);
 
         return true;
     }
 
-    bool handleMacros(const std::vector<Macro>& macros, std::vector<LineToken>& lineTokens)
+    void compileMacro(const Macro& macro, MacroBody& macroBody)
     {
-        // Incomplete macros
-        for(int i=0; i<macros.size(); i++)
+        macroBody._lines.resize(macro._lines.size());
+        for(int ml=0; ml<int(macro._lines.size()); ml++)
         {
-            if(!macros[i]._complete)
+            MacroLine& macroLine = macroBody._lines[ml];
+            macroLine._tokens = tokeniseLine(macro._lines[ml]);
+            macroLine._params.resize(macroLine._tokens.size(), -1);
+
+            // Save labels
+            macroLine._hasLabel = (macro._lines[ml].find_first_not_of("  \n\r\f\t\v") == 0  &&  macroLine._tokens.size());
+            if(macroLine._hasLabel) macroBody._labels.push_back(macroLine._tokens[0]);
+
+            for(int mt=0; mt<int(macroLine._tokens.size()); mt++)
             {
-                fprintf(stderr, "Assembler::handleMacros() : Bad macro : missing 'ENDM' : in '%s' : on line %d\n", macros[i]._filename.c_str(), macros[i]._fileStartLine);
-                return false;
+                for(int p=0; p<int(macro._params.size()); p++)
+                {
+                    if(macroLine._tokens[mt] == macro._params[p]) {macroLine._params[mt] = p; break;}
+                }
             }
         }
+    }
 
-        // Delete original macros
-        int prevMacrosSize = 0;
-        for(int i=0; i<macros.size(); i++)
+    int findMacroCall(const std::string& text, const std::vector<TokenSpan>& spans, int& tokenIndex)
+    {
+        for(int t=0; t<int(spans.size()); t++)
+        {
+            uint64_t hash = hashData((const uint8_t*)&text[spans[t]._start], spans[t]._length);
+            auto it = _context->_macroIndices.find(hash);
+            if(it == _context->_macroIndices.end()) continue;
+
+            const Macro& macro = (*_context->_macros)[it->second];
+            if(text.compare(spans[t]._start, spans[t]._length, macro._name) != 0) continue;
+
+            // Calls without enough parameters are left as they are
+            _context->_macroBodies[it->second]._called = true;
+            if(spans.size() - t > macro._params.size())
+            {
+                tokenIndex = t;
+                return it->second;
+            }
+        }
+
+        return -1;
+    }
+
+    bool expandMacroLine(const LineToken& lineToken, std::vector<LineToken>& lineTokens, int depth)
+    {
+        // Lines containing only white space are passed through
+        std::vector<TokenSpan> spans;
+        tokeniseLine(lineToken._text, spans);
+
+        int t = 0;
+        int m = (spans.size()) ? findMacroCall(lineToken._text, spans, t) : -1;
+        if(m == -1)
+        {
+            lineTokens.push_back(lineToken);
+            return true;
+        }
+
+        const Macro& macro = (*_context->_macros)[m];
+        if(depth >= MACRO_MAX_DEPTH)
         {
-            lineTokens.erase(lineTokens.begin() + macros[i]._startLine - prevMacrosSize, lineTokens.begin() + macros[i]._endLine + 1 - prevMacrosSize);
-            prevMacrosSize += macros[i]._endLine - macros[i]._startLine + 1;
+            Expression::print("Assembler::expandMacroLine() : Macros nested too deeply : '%s' : in '%s' : on line %d\n", macro._name.c_str(), macro._filename.c_str(), macro._fileStartLine);
+            return false;
         }
 
-        // Find and expand macro
-        int macroInstanceId = 0;
-        for(int m=0; m<macros.size(); m++)
+        MacroBody& macroBody = _context->_macroBodies[m];
+        macroBody._expanded = true;
+        _context->_assembleTimes._macroExpansions++;
+
+        std::vector<std::string> args;
+        for(int p=0; p<int(macro._params.size()); p++) args.push_back(lineToken._text.substr(spans[t + 1 + p]._start, spans[t + 1 + p]._length));
+
+        std::string instanceId = std::to_string(_context->_macroInstanceId++);
+        for(int ml=0; ml<int(macroBody._lines.size()); ml++)
         {
-            bool macroMissing = true;
-            bool macroMissingParams = true;
-            Macro macro = macros[m];
+            const MacroLine& macroLine = macroBody._lines[ml];
+
+            // New macro line using any existing label
+            LineToken macroLineToken = {false, 0, "", "", macro._name};
+            if(t > 0  &&  ml == 0) macroLineToken._text = lineToken._text.substr(spans[0]._start, spans[0]._length);
 
-            for(auto itLine=lineTokens.begin(); itLine!=lineTokens.end();)
+            for(int mt=0; mt<int(macroLine._tokens.size()); mt++)
             {
-                // Lines containing only white space are skipped
-                LineToken lineToken = *itLine;
-                size_t nonWhiteSpace = lineToken._text.find_first_not_of("  \n\r\f\t\v");
-                if(nonWhiteSpace == std::string::npos)
+                // Don't prefix macro labels with a space
+                if(!macroLine._hasLabel  ||  mt != 0) macroLineToken._text += " ";
+
+                // Replace parameters, substituted arguments can themselves match later parameters
+                int p = macroLine._params[mt];
+                if(p == -1)
                 {
-                    ++itLine;
+                    macroLineToken._text += macroLine._tokens[mt];
                     continue;
                 }
 
-                // Tokenise current line
-                std::vector<std::string> tokens = tokeniseLine(lineToken._text);
-
-                // Find macro
-                bool macroSuccess = false;
-                for(int t=0; t<tokens.size(); t++)
+                const std::string* token = &args[p];
+                for(p++; p<int(args.size()); p++)
                 {
-                    if(tokens[t] == macro._name)
-                    {
-                        macroMissing = false;
-                        if(tokens.size() - t > macro._params.size())
-                        {
-                            macroMissingParams = false;
-                            std::vector<std::string> labels;
-                            std::vector<LineToken> macroLines;
-
-                            // Create substitute lines
-                            for(int ml=0; ml<macro._lines.size(); ml++)
-                            {
-                                // Tokenise macro line
-                                std::vector<std::string> mtokens =  tokeniseLine(macro._lines[ml]);
-
-                                // Save labels
-                                size_t nonWhiteSpace = macro._lines[ml].find_first_not_of("  \n\r\f\t\v");
-                                if(nonWhiteSpace == 0) labels.push_back(mtokens[0]);
+                    if(*token == macro._params[p]) token = &args[p];
+                }
+                macroLineToken._text += *token;
+            }
 
-                                // Replace parameters
-                                for(int mt=0; mt<mtokens.size(); mt++)
-                                {
-                                    for(int p=0; p<macro._params.size(); p++)
-                                    {
-                                        if(mtokens[mt] == macro._params[p]) mtokens[mt] = tokens[t + 1 + p];
-                                    }
-                                }
+            // Each instance of a macro's labels are made unique
+            for(int i=0; i<int(macroBody._labels.size()); i++)
+            {
+                size_t labelFoundPos = macroLineToken._text.find(macroBody._labels[i]);
+                if(labelFoundPos != std::string::npos) macroLineToken._text.insert(labelFoundPos + macroBody._labels[i].size(), instanceId);
+            }
 
-                                // New macro line using any existing label
-                                LineToken macroLine = {false, 0, "", ""};
-                                macroLine._text = (t > 0  &&  ml == 0) ? tokens[0] : "";
+            // Macro lines can call other macros
+            if(!expandMacroLine(macroLineToken, lineTokens, depth + 1)) return false;
+        }
 
-                                // Append to macro line
-                                for(int mt=0; mt<mtokens.size(); mt++)
-                                {
-                                    // Don't prefix macro labels with a space
-                                    if(nonWhiteSpace != 0  ||  mt != 0) macroLine._text += " ";
+        return true;
+    }
 
-                                    macroLine._text += mtokens[mt];
-                                }
+    // Single pass over the source, macro definitions are dropped and calls are expanded recursively into a new line buffer
+    bool handleMacros(const std::vector<Macro>& macros, std::vector<LineToken>& lineTokens)
+    {
+        // Incomplete macros
+        for(int i=0; i<macros.size(); i++)
+        {
+            if(!macros[i]._complete)
+            {
+                Expression::print("Assembler::handleMacros() : Bad macro : missing 'ENDM' : in '%s' : on line %d\n", macros[i]._filename.c_str(), macros[i]._fileStartLine);
+                return false;
+            }
+        }
 
-                                macroLines.push_back(macroLine);
-                            }
+        auto expandStart = std::chrono::steady_clock::now();
 
-                            // Insert substitute lines
-                            for(int ml=0; ml<macro._lines.size(); ml++)
-                            {
-                                // Delete macro caller
-                                if(ml == 0) itLine = lineTokens.erase(itLine);
+        _context->_macroInstanceId = 0;
+        _context->_assembleTimes._macroExpansions = 0;
+        _context->_macros = &macros;
+        _context->_macroIndices.clear();
+        _context->_macroBodies.clear();
+        _context->_macroBodies.resize(macros.size());
+        for(int m=0; m<int(macros.size()); m++)
+        {
+            _context->_macroIndices[hashData((const uint8_t*)macros[m]._name.c_str(), macros[m]._name.size())] = m;
+            compileMacro(macros[m], _context->_macroBodies[m]);
+        }
 
-                                // Each instance of a macro's labels are made unique
-                                for(int i=0; i<labels.size(); i++)
-                                {
-                                    size_t labelFoundPos = macroLines[ml]._text.find(labels[i]);
-                                    if(labelFoundPos != std::string::npos) macroLines[ml]._text.insert(labelFoundPos + labels[i].size(), std::to_string(macroInstanceId));
-                                }
+        std::vector<LineToken> expandedLineTokens;
+        expandedLineTokens.reserve(lineTokens.size());
 
-                                // Insert macro lines
-                                itLine = lineTokens.insert(itLine, macroLines[ml]);
-                                ++itLine;
-                            }
+        bool success = true;
+        int macroIndex = 0;
+        for(int i=0; i<int(lineTokens.size())  &&  success; i++)
+        {
+            // Delete original macros
+            if(macroIndex < int(macros.size())  &&  i == macros[macroIndex]._startLine)
+            {
+                i = macros[macroIndex++]._endLine;
+                continue;
+            }
 
-                            macroInstanceId++;
-                            macroSuccess = true;
-                        }
-                    }
-                }
+            success = expandMacroLine(lineTokens[i], expandedLineTokens, 0);
+        }
+        _context->_macros = nullptr;
 
-                if(!macroSuccess) ++itLine;
-            }
+        _context->_assembleTimes._expandMacros = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - expandStart).count();
+        if(!success) return false;
 
-            if(macroMissing)
+        for(int m=0; m<int(macros.size()); m++)
+        {
+            if(!_context->_macroBodies[m]._called)
             {
-                fprintf(stderr, "Assembler::handleMacros() : Warning, macro is never called : '%s' : in '%s' : on line %d\n", macro._name.c_str(), macro._filename.c_str(), macro._fileStartLine);
+                Expression::print("Assembler::handleMacros() : Warning, macro is never called : '%s' : in '%s' : on line %d\n", macros[m]._name.c_str(), macros[m]._filename.c_str(), macros[m]._fileStartLine);
                 continue;
             }
 
-            if(macroMissingParams)
+            if(!_context->_macroBodies[m]._expanded)
             {
-                fprintf(stderr, "Assembler::handleMacros() : Missing macro parameters : '%s' : in '%s' : on line %d\n", macro._name.c_str(), macro._filename.c_str(), macro._fileStartLine);
+                Expression::print("Assembler::handleMacros() : Missing macro parameters : '%s' : in '%s' : on line %d\n", macros[m]._name.c_str(), macros[m]._filename.c_str(), macros[m]._fileStartLine);
                 return false;
             }
         }
 
+        lineTokens.swap(expandedLineTokens);
+
         return true;
     }
 
@@ -1324,7 +1651,7 @@ namespace Assembler
         // Check macro syntax
         if(tokens.size() < 2)
         {
-            fprintf(stderr, "Assembler::handleMacroStart() : Bad macro : missing name : in '%s' : on line %d\n", macroFileName.c_str(), lineNumber);
+            Expression::print("Assembler::handleMacroStart() : Bad macro : missing name : in '%s' : on line %d\n", macroFileName.c_str(), lineNumber);
             return false;
         }                    
 
@@ -1347,7 +1674,7 @@ namespace Assembler
         {
             if(macro._name == macros[i]._name)
             {
-                fprintf(stderr, "Assembler::handleMacroEnd() : Bad macro : duplicate name : '%s' : in '%s' : on line %d\n", macro._name.c_str(), macro._filename.c_str(), macro._fileStartLine);
+                Expression::print("Assembler::handleMacroEnd() : Bad macro : duplicate name : '%s' : in '%s' : on line %d\n", macro._name.c_str(), macro._filename.c_str(), macro._fileStartLine);
                 return false;
             }
         }
@@ -1388,8 +1715,9 @@ namespace Assembler
             bool includeFound = false;
             int lineIndex = int(itLine - lineTokens.begin()) + 1;
 
-            // Tokenise current line
-            std::vector<std::string> tokens = tokeniseLine(lineToken._text);
+            // Only pre-processor commands and macro bodies need tokenising here, the assembler passes tokenise everything once later
+            std::vector<std::string> tokens;
+            if(buildingMacro  ||  lineToken._text.find('%') != std::string::npos) tokens = tokeniseLine(lineToken._text);
 
             // Valid pre-processor commands
             if(tokens.size() > 0)
@@ -1402,13 +1730,6 @@ namespace Assembler
                     std::vector<LineToken> includeLineTokens;
                     if(!handleInclude(tokens, lineToken._text, lineIndex, includeLineTokens)) return false;
 
-                    // Recursively include everything in order
-                    if(!preProcess(filename, includeLineTokens, false))
-                    {
-                        fprintf(stderr, "Assembler::preProcess() : Bad include file : '%s'\n", tokens[1].c_str());
-                        return false;
-                    }
-
                     // Remove original include line and replace with include text
                     itLine = lineTokens.erase(itLine);
                     itLine = lineTokens.insert(itLine, includeLineTokens.begin(), includeLineTokens.end());
@@ -1530,15 +1851,15 @@ namespace Assembler
                         std::vector<std::string> variables = tokenise(variableText, ',');
                         parseGprintfFormat(formatText, variables, vars, subs);
 
-                        Gprintf gprintf = {false, _currentAddress, lineNumber, lineToken, formatText, vars, subs};
-                        _gprintfs.push_back(gprintf);
+                        Gprintf gprintf = {_context->_currentAddress, lineNumber, lineToken, formatText, vars, subs};
+                        _context->_gprintfs.push_back(gprintf);
                     }
 
                     return true;
                 }
             }
 
-            fprintf(stderr, "Assembler::createGprintf() : Bad gprintf format : '%s' : on line %d\n", lineToken.c_str(), lineNumber);
+            Expression::print("Assembler::createGprintf() : Bad gprintf format : '%s' : on line %d\n", lineToken.c_str(), lineNumber);
             return false;
         }
 
@@ -1547,23 +1868,23 @@ namespace Assembler
 
     bool parseGprintfs(void)
     {
-        for(int i = 0; i<_gprintfs.size(); i++)
+        for(int i = 0; i<_context->_gprintfs.size(); i++)
         {
-            for(int j = 0; j<_gprintfs[i]._vars.size(); j++)
+            for(int j = 0; j<_context->_gprintfs[i]._vars.size(); j++)
             {
                 bool success = false;
                 uint16_t data = 0x0000;
-                std::string token = _gprintfs[i]._vars[j]._var;
+                std::string token = _context->_gprintfs[i]._vars[j]._var;
         
                 // Strip white space
                 token.erase(remove_if(token.begin(), token.end(), isspace), token.end());
-                _gprintfs[i]._vars[j]._var = token;
+                _context->_gprintfs[i]._vars[j]._var = token;
 
                 // Check for indirection
                 size_t asterisk = token.find_first_of("*");
                 if(asterisk != std::string::npos)
                 {
-                    _gprintfs[i]._vars[j]._indirect = true;
+                    _context->_gprintfs[i]._vars[j]._indirect = true;
                     token = token.substr(asterisk+1);
                 }
 
@@ -1590,7 +1911,7 @@ namespace Assembler
                     {
                         if(Expression::isExpression(token) == Expression::Valid)
                         {
-                            data = Expression::parse((char*)token.c_str(), _lineNumber);
+                            data = Expression::parse((char*)token.c_str(), _context->_lineNumber);
                             success = true;
                         }
                     }
@@ -1598,31 +1919,77 @@ namespace Assembler
 
                 if(!success)
                 {
-                    fprintf(stderr, "Assembler::parseGprintfs() : Error in gprintf(), missing label or equate : '%s' : in '%s' on line %d\n", token.c_str(), _gprintfs[i]._lineToken.c_str(), _gprintfs[i]._lineNumber);
-                    _gprintfs.erase(_gprintfs.begin() + i);
+                    Expression::print("Assembler::parseGprintfs() : Error in gprintf(), missing label or equate : '%s' : in '%s' on line %d\n", token.c_str(), _context->_gprintfs[i]._lineToken.c_str(), _context->_gprintfs[i]._lineNumber);
+                    _context->_gprintfs.erase(_context->_gprintfs.begin() + i);
                     return false;
                 }
 
-                _gprintfs[i]._vars[j]._data = data;
+                _context->_gprintfs[i]._vars[j]._data = data;
             }
+
+            uint16_t address = _context->_gprintfs[i]._address;
+            _context->_gprintfAddresses.set(address);
+            _context->_gprintfIndices[address].push_back(i);
         }
 
         return true;
     }
 
 #ifndef STAND_ALONE
-    bool getGprintfString(int index, std::string& gstring)
+    // Variables of a gprintf as they were when vCPU dispatched its address, strings are copied out of RAM
+    struct GprintfEntry
+    {
+        const Gprintf* _gprintf;
+        std::vector<uint16_t> _data;
+        std::vector<std::string> _strings;
+    };
+
+    // Formats and prints gprintfs off the emulation thread, it is never destroyed so that exit can't tear it down under the logger
+    struct GprintfLogger
+    {
+        bool _printing = false;
+        std::mutex _mutex;
+        std::condition_variable _queued;
+        std::condition_variable _drained;
+        std::deque<GprintfEntry> _entries;
+        std::thread _thread;
+    };
+
+    GprintfLogger* _gprintfLogger = nullptr;
+
+
+    void getGprintfEntry(const Gprintf& gprintf, GprintfEntry& entry)
+    {
+        entry._gprintf = &gprintf;
+        entry._data.resize(gprintf._vars.size());
+        entry._strings.resize(gprintf._vars.size());
+
+        for(int i=0; i<gprintf._vars.size(); i++)
+        {
+            // Strings are always indirect and assume that length is first byte
+            if(gprintf._vars[i]._type == Gprintf::Str)
+            {
+                uint16_t data = gprintf._vars[i]._data;
+                uint8_t length = Cpu::getRAM(data) & 0xFF; // maximum length of 256
+                for(int j=0; j<length; j++) entry._strings[i].push_back(char(Cpu::getRAM(data + j + 1)));
+                continue;
+            }
+
+            // Use indirection if required
+            entry._data[i] = (gprintf._vars[i]._indirect) ? Cpu::getRAM(gprintf._vars[i]._data) | (Cpu::getRAM(gprintf._vars[i]._data+1) <<8) : gprintf._vars[i]._data;
+        }
+    }
+
+    bool getGprintfString(const GprintfEntry& entry, std::string& gstring)
     {
-        const Gprintf& gprintf = _gprintfs[index % _gprintfs.size()];
+        const Gprintf& gprintf = *entry._gprintf;
         gstring = gprintf._format;
    
         size_t subIndex = 0;
         for(int i=0; i<gprintf._vars.size(); i++)
         {
             char token[256];
-
-            // Use indirection if required
-            uint16_t data = (gprintf._vars[i]._indirect) ? Cpu::getRAM(gprintf._vars[i]._data) | (Cpu::getRAM(gprintf._vars[i]._data+1) <<8) : gprintf._vars[i]._data;
+            uint16_t data = entry._data[i];
             
             // Maximum field width of 16 digits
             uint8_t width = gprintf._vars[i]._width % 17;
@@ -1635,16 +2002,7 @@ namespace Assembler
                 case Gprintf::Int: fieldWidth += "d"; sprintf(token, fieldWidth.c_str(), data); break;
                 case Gprintf::Oct: fieldWidth += "o"; sprintf(token, fieldWidth.c_str(), data); break;
                 case Gprintf::Hex: fieldWidth += "x"; sprintf(token, fieldWidth.c_str(), data); break;
-
-                // Strings are always indirect and assume that length is first byte
-                case Gprintf::Str:
-                {
-                    data = gprintf._vars[i]._data;
-                    uint8_t length = Cpu::getRAM(data) & 0xFF; // maximum length of 256
-                    for(int j=0; j<length; j++) token[j] = Cpu::getRAM(data + j + 1);
-                    token[length] = 0;
-                }
-                break;
+                case Gprintf::Str: strcpy(token, entry._strings[i].c_str());                   break;
 
                 case Gprintf::Bin:
                 {
@@ -1669,199 +2027,801 @@ namespace Assembler
         return true;
     }
 
-    void printGprintfStrings(void)
+    void logGprintfs(void)
+    {
+        GprintfLogger& logger = *_gprintfLogger;
+        std::unique_lock<std::mutex> lock(logger._mutex);
+
+        for(;;)
+        {
+            logger._queued.wait(lock, [&logger](){return !logger._entries.empty();});
+            GprintfEntry entry = std::move(logger._entries.front());
+            logger._entries.pop_front();
+            logger._printing = true;
+            lock.unlock();
+
+            std::string gstring;
+            getGprintfString(entry, gstring);
+            Expression::print("gprintf() : address $%04X : '%s'\n", entry._gprintf->_address, gstring.c_str());
+
+            lock.lock();
+            logger._printing = false;
+            if(logger._entries.empty()) logger._drained.notify_all();
+        }
+    }
+
+    void queueGprintf(GprintfEntry& entry)
+    {
+        if(_gprintfLogger == nullptr)
+        {
+            _gprintfLogger = new GprintfLogger;
+            _gprintfLogger->_thread = std::thread(logGprintfs);
+            _gprintfLogger->_thread.detach();
+        }
+
+        std::lock_guard<std::mutex> lock(_gprintfLogger->_mutex);
+        _gprintfLogger->_entries.push_back(std::move(entry));
+        _gprintfLogger->_queued.notify_one();
+    }
+
+    // Queued entries point into _gprintfs, so they must be printed before it changes
+    void flushGprintfs(void)
+    {
+        if(_gprintfLogger == nullptr) return;
+
+        std::unique_lock<std::mutex> lock(_gprintfLogger->_mutex);
+        _gprintfLogger->_drained.wait(lock, [](){return _gprintfLogger->_entries.empty()  &&  !_gprintfLogger->_printing;});
+    }
+
+    // vCPU dispatch calls this with the address of every instruction it is about to execute, only a new vPC can trigger gprintfs
+    void printGprintfStrings(uint16_t vPC)
+    {
+        if(vPC == _context->_gprintfVPC) return;
+        _context->_gprintfVPC = vPC;
+
+        if(!_context->_gprintfAddresses.test(vPC)) return;
+
+        const std::vector<int>& indices = _context->_gprintfIndices[vPC];
+        for(int i=0; i<int(indices.size()); i++)
+        {
+            GprintfEntry entry;
+            getGprintfEntry(_context->_gprintfs[indices[i]], entry);
+            queueGprintf(entry);
+        }
+    }
+#endif
+
+    void clearAssembler(void)
+    {
+#ifndef STAND_ALONE
+        flushGprintfs();
+#endif
+
+        _context->_byteCode.clear();
+        _context->_labels.clear();
+        _context->_equates.clear();
+        _context->_labelIndices.clear();
+        _context->_equateIndices.clear();
+        _context->_instructions.clear();
+        _context->_callTableEntries.clear();
+        _context->_gprintfs.clear();
+        _context->_gprintfAddresses.reset();
+        _context->_gprintfIndices.clear();
+        _context->_gprintfVPC = 0x0000;
+        _context->_imports.clear();
+        _context->_reserves.clear();
+        _context->_badReserve.clear();
+        _context->_listingTokens.clear();
+        _context->_listingLines.clear();
+        _context->_expressionTrees.clear();
+        _context->_expressionIndices.clear();
+    }
+
+    void parseLines(const std::vector<LineToken>& lineTokens, std::vector<ParsedLine>& parsedLines)
     {
-        if(_gprintfs.size())
+        parsedLines.clear();
+        parsedLines.reserve(lineTokens.size());
+
+        for(int i=0; i<int(lineTokens.size()); i++)
         {
-            uint16_t vPC = (Cpu::getRAM(0x0017) <<8) | Cpu::getRAM(0x0016);
+            // Lines containing only white space are skipped
+            const std::string& text = lineTokens[i]._text;
+            size_t nonWhiteSpace = text.find_first_not_of("  \n\r\f\t\v");
+            if(nonWhiteSpace == std::string::npos) continue;
+
+            ParsedLine parsedLine;
+            parsedLine._lineIndex = i;
+            parsedLine._tokens = tokeniseLine(text);
+            const std::vector<std::string>& tokens = parsedLine._tokens;
+
+            // Comments
+            if(tokens.size() > 0  &&  tokens[0].find_first_of(";#") != std::string::npos) continue;
 
-            for(int i=0; i<_gprintfs.size(); i++)
+            // Imported symbols are resolved by the linker, reserved RAM is RAM the linker must not place sections into
+            if(tokens.size() > 0  &&  tokens[0].size()  &&  tokens[0][0] == '%')
             {
-                if(vPC == _gprintfs[i]._address)
+                std::string command = tokens[0];
+                if(Expression::strToUpper(command) == "%IMPORT")
                 {
-                    // Emulator can cycle many times for one CPU cycle, so make sure gprintf is displayed only once
-                    if(!_gprintfs[i]._displayed)
+                    for(int j=1; j<int(tokens.size())  &&  tokens[j].find_first_of(";#") == std::string::npos; j++) _context->_imports.push_back(tokens[j]);
+                    continue;
+                }
+                if(Expression::strToUpper(command) == "%RESERVE")
+                {
+                    // %RESERVE <address> <size> <optional count> <optional stride>
+                    uint16_t values[4] = {0x0000, 0x0000, 1, 0x0000};
+                    int numValues = 0;
+                    bool valid = true;
+                    for(int j=1; j<int(tokens.size())  &&  tokens[j].find_first_of(";#") == std::string::npos; j++)
+                    {
+                        if(numValues == 4  ||  !Expression::stringToU16(tokens[j], values[numValues++])) valid = false;
+                    }
+                    if(!valid  ||  numValues < 2  ||  numValues == 3)
                     {
-                        std::string gstring;
-                        getGprintfString(i, gstring);
-                        fprintf(stderr, "gprintf() : address $%04X : '%s'\n", _gprintfs[i]._address, gstring.c_str());
-                        _gprintfs[i]._displayed = true;
+                        if(_context->_badReserve.empty()) _context->_badReserve = text;
+                        continue;
                     }
+
+                    for(int j=0; j<values[2]; j++) _context->_reserves.push_back({uint16_t(values[0] + j*values[3]), values[1]});
+                    continue;
                 }
-                else
+            }
+
+            const char* gprintf = "GPRINTF";
+            parsedLine._isGprintf = (std::search(text.begin(), text.end(), gprintf, gprintf + 7, [](char a, char b) {return toupper((unsigned char)a) == b;}) != text.end());
+
+            // Labels and equates, equates don't have an opcode
+            parsedLine._hasLabel = (nonWhiteSpace == 0);
+            if(parsedLine._hasLabel  &&  tokens.size() > 1)
+            {
+                if(tokens[1] == "EQU"  ||  tokens[1] == "equ")
                 {
-                    _gprintfs[i]._displayed = false;;
+                    parsedLines.push_back(std::move(parsedLine));
+                    continue;
                 }
+
+                parsedLine._opcodeIndex = 1;
+            }
+
+            // Bad opcodes are reported by the passes, so that errors still appear in source order
+            if(parsedLine._opcodeIndex < int(tokens.size()))
+            {
+                parsedLine._instructionType = getOpcode(tokens[parsedLine._opcodeIndex]);
+                preProcessExpression(tokens, parsedLine._opcodeIndex + 1, parsedLine._operand, false);
+                parsedLine._operandType = Expression::isExpression(parsedLine._operand);
             }
+
+            parsedLines.push_back(std::move(parsedLine));
         }
     }
-#endif
 
-    void clearAssembler(void)
+    bool isInstructionLine(const ParsedLine& parsedLine)
     {
-        _byteCode.clear();
-        _labels.clear();
-        _equates.clear();
-        _instructions.clear();
-        _callTableEntries.clear();
-        _gprintfs.clear();
+        return !parsedLine._isGprintf  &&  parsedLine._opcodeIndex < int(parsedLine._tokens.size())  &&  parsedLine._instructionType._byteSize != BadSize;
     }
 
-    bool assemble(const std::string& filename, uint16_t startAddress)
+    bool isVcpuOpcode(const ParsedLine& parsedLine, uint8_t opcode)
     {
-        std::ifstream infile(filename);
-        if(!infile.is_open())
-        {
-            fprintf(stderr, "Assembler::assemble() : Failed to open file : '%s'\n", filename.c_str());
-            return false;
-        }
+        return isInstructionLine(parsedLine)  &&  parsedLine._instructionType._opcodeType == vCpu  &&  parsedLine._instructionType._opcode == opcode;
+    }
 
-        _callTable = 0x0000;
-        _startAddress = startAddress;
-        _currentAddress = _startAddress;
-        clearAssembler();
+    void setOpcode(ParsedLine& parsedLine, const std::string& mnemonic)
+    {
+        parsedLine._instructionType = getOpcode(mnemonic);
+        parsedLine._tokens[parsedLine._opcodeIndex] = mnemonic;
+    }
 
-#ifndef STAND_ALONE
-        Loader::disableUploads(false);
-#endif
+    void setOperand(ParsedLine& parsedLine, const std::string& operand)
+    {
+        parsedLine._tokens.resize(parsedLine._opcodeIndex + 1);
+        if(operand.size()) parsedLine._tokens.push_back(operand);
+        parsedLine._operand = operand;
+        parsedLine._operandType = Expression::isExpression(operand);
+        parsedLine._operandTree = -1;
+    }
 
-        // Get file
-        int numLines = 0;
-        LineToken lineToken;
-        std::vector<LineToken> lineTokens;
-        while(!infile.eof())
+    // Peephole optimiser, rewrites parsed lines before the passes so that labels, branches, the call table and gprintfs are all assembled from the result.
+    // Only lines without labels are removed or resized and lines directly behind a gprintf are never removed, so every label and gprintf stays in
+    // front of the same instruction; patterns never span a label, a gprintf or any other line. System variables below 0x30 are never assumed to hold
+    // what was last written to them
+    void optimiseLines(std::vector<ParsedLine>& parsedLines)
+    {
+        // Operands that are numbers or equates of numbers
+        std::unordered_map<std::string, uint16_t> literals;
+        std::unordered_set<std::string> equates;
+        for(int i=0; i<int(parsedLines.size()); i++)
         {
-            std::getline(infile, lineToken._text);
-            lineTokens.push_back(lineToken);
+            const std::vector<std::string>& tokens = parsedLines[i]._tokens;
+            if(tokens.size() < 2  ||  (tokens[1] != "EQU"  &&  tokens[1] != "equ")) continue;
 
-            if(!infile.good()  &&  !infile.eof())
+            uint16_t value;
+            equates.insert(tokens[0]);
+            if(tokens.size() > 2  &&  Expression::stringToU16(tokens[2], value)) literals[tokens[0]] = value;
+        }
+        auto getLiteral = [&literals](const std::string& operand, uint16_t& value) -> bool
+        {
+            auto it = literals.find(operand);
+            if(it != literals.end())
             {
-                fprintf(stderr, "Assembler::assemble() : Bad lineToken : '%s' : in '%s' : on line %d\n", lineToken._text.c_str(), filename.c_str(), numLines+1);
-                return false;
+                value = it->second;
+                return true;
             }
 
-            numLines++;
-        }
-
-        // Pre-processor
-        if(!preProcess(filename, lineTokens, true)) return false;
-
-        numLines = int(lineTokens.size());
+            return Expression::stringToU16(operand, value);
+        };
+        auto isVariable = [&getLiteral](const std::string& operand) -> bool
+        {
+            uint16_t value;
+            return !getLiteral(operand, value)  ||  value >= 0x0030;
+        };
 
-        // The mnemonic pass we evaluate all the equates and labels, the code pass is for the opcodes and operands
-        for(int parse=MnemonicPass; parse<NumParseTypes; parse++)
+        // Every rewrite removes bytes or shortens a chain of branches, so this terminates
+        for(bool changed=true; changed;)
         {
-            for(_lineNumber=0; _lineNumber<numLines; _lineNumber++)
+            // Instruction line of each label, label only lines label the next instruction line
+            std::unordered_map<std::string, int> labelLines;
+            for(int i=int(parsedLines.size())-1, next=-1; i>=0; i--)
             {
-                lineToken = lineTokens[_lineNumber];
+                const ParsedLine& parsedLine = parsedLines[i];
+                if(isInstructionLine(parsedLine)) next = i;
+                if(parsedLine._hasLabel  &&  parsedLine._tokens.size()  &&  parsedLine._instructionType._byteSize != BadSize) labelLines[parsedLine._tokens[0]] = i;
+                else if(parsedLine._hasLabel  &&  parsedLine._tokens.size() == 1  &&  next >= 0) labelLines[parsedLine._tokens[0]] = next;
+            }
 
-                // Lines containing only white space are skipped
-                size_t nonWhiteSpace = lineToken._text.find_first_not_of("  \n\r\f\t\v");
-                if(nonWhiteSpace == std::string::npos) continue;
+            changed = false;
+            for(int i=0; i<int(parsedLines.size())  &&  !changed; i++)
+            {
+                ParsedLine& line = parsedLines[i];
+                if(!isInstructionLine(line)  ||  line._instructionType._opcodeType != vCpu) continue;
 
-                int tokenIndex = 0;
+                // Following lines that can be removed or rewritten
+                ParsedLine* next = (i + 1 < int(parsedLines.size())  &&  isInstructionLine(parsedLines[i + 1])  &&  !parsedLines[i + 1]._hasLabel) ? &parsedLines[i + 1] : nullptr;
+                ParsedLine* after = (next  &&  i + 2 < int(parsedLines.size())  &&  isInstructionLine(parsedLines[i + 2])  &&  !parsedLines[i + 2]._hasLabel) ? &parsedLines[i + 2] : nullptr;
+                bool removable = !line._hasLabel  &&  (i == 0  ||  !parsedLines[i - 1]._isGprintf);
 
-                // Tokenise current line
-                std::vector<std::string> tokens = tokeniseLine(lineToken._text);
+                uint8_t opcode = line._instructionType._opcode;
+                int removeLine = -1, savedBytes = 0;
+                switch(opcode)
+                {
+                    // STW x, LDW x : STW x, STW x : vAC and x already hold the same value
+                    case 0x2B:
+                    {
+                        if(next  &&  next->_operand == line._operand  &&  (isVcpuOpcode(*next, 0x2B)  ||  (isVcpuOpcode(*next, 0x21)  &&  isVariable(line._operand))))
+                        {
+                            removeLine = i + 1;
+                        }
+                        // STW x, LDI n, ADDW x : STW x, ADDI n
+                        else if(after  &&  isVcpuOpcode(*next, 0x59)  &&  isVcpuOpcode(*after, 0x99)  &&  after->_operand == line._operand  &&  isVariable(line._operand))
+                        {
+                            setOpcode(*next, "ADDI");
+                            removeLine = i + 2;
+                        }
+                    }
+                    break;
 
-                // Comments
-                if(tokens.size() > 0  &&  tokens[0].find_first_of(";#") != std::string::npos) continue;
+                    // LDW x, STW x : x already holds vAC
+                    case 0x21:
+                    {
+                        if(next  &&  isVcpuOpcode(*next, 0x2B)  &&  next->_operand == line._operand  &&  isVariable(line._operand)) removeLine = i + 1;
+                    }
+                    break;
 
-                // Gprintf lines are skipped
-                if(createGprintf(ParseType(parse), lineToken._text, _lineNumber+1)) continue;
+                    // LDWI n, (n < 0x0100) : LDI n
+                    case 0x11:
+                    {
+                        uint16_t value;
+                        if(!line._hasLabel  &&  getLiteral(line._operand, value)  &&  value < 0x0100)
+                        {
+                            setOpcode(line, "LDI");
+                            savedBytes = 1;
+                            changed = true;
+                        }
+                    }
+                    break;
 
-                // Starting address, labels and equates
-                if(nonWhiteSpace == 0)
-                {
-                    if(tokens.size() >= 2)
+                    // Branches to the next instruction are removed, branches to a chain of BRAs branch to the end of the chain, BRA to RET is RET
+                    case 0x35:
+                    case 0x90:
                     {
-                        EvaluateResult result = evaluateEquates(tokens, (ParseType)parse);
-                        if(result == NotFound)
+                        auto label = labelLines.find(line._operand);
+                        if(label == labelLines.end()) break;
+
+                        // A label named after an equate starts a section at the equate's address, so the instruction behind it doesn't follow the branch
+                        int target = label->second, following = i + 1;
+                        bool contiguous = true;
+                        for(; following < int(parsedLines.size()); following++)
                         {
-                            fprintf(stderr, "Assembler::assemble() : Missing equate : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _lineNumber+1);
-                            return false;
+                            const ParsedLine& parsedLine = parsedLines[following];
+                            if(parsedLine._hasLabel  &&  parsedLine._tokens.size()  &&  equates.find(parsedLine._tokens[0]) != equates.end()) contiguous = false;
+                            if(isInstructionLine(parsedLine)  ||  parsedLine._isGprintf) break;
                         }
-                        else if(result == Duplicate)
+
+                        std::string operand = line._operand;
+                        int final = target;
+                        for(int hops=0; final >= 0  &&  isVcpuOpcode(parsedLines[final], 0x90); hops++)
                         {
-                            fprintf(stderr, "Assembler::assemble() : Duplicate equate : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _lineNumber+1);
-                            return false;
+                            auto next = labelLines.find(parsedLines[final]._operand);
+                            operand = parsedLines[final]._operand;
+                            final = (next != labelLines.end()  &&  hops < OPTIMISE_MAX_HOPS) ? next->second : -1;
                         }
-                        // Skip equate lines
-                        else if(result == Success) 
+
+                        if(target == following  &&  contiguous  &&  removable)
                         {
-                            continue;
+                            removeLine = i;
                         }
-                            
-                        // Labels
-                        result = EvaluateLabels(tokens, (ParseType)parse, tokenIndex);
-                        if(result == Reserved)
+                        else if(final >= 0  &&  operand != line._operand)
                         {
-                            fprintf(stderr, "Assembler::assemble() : Can't use a reserved word in a label : '%s' : in '%s' on line %d\n", tokens[tokenIndex].c_str(), filename.c_str(), _lineNumber+1);
-                            return false;
+                            setOperand(line, operand);
+                            changed = true;
                         }
-                        else if(result == Duplicate)
+                        else if(opcode == 0x90  &&  isVcpuOpcode(parsedLines[target], 0xFF)  &&  !line._hasLabel)
                         {
-                            fprintf(stderr, "Assembler::assemble() : Duplicate label : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _lineNumber+1);
-                            return false;
+                            setOpcode(line, "RET");
+                            setOperand(line, "");
+                            savedBytes = 1;
+                            changed = true;
                         }
                     }
+                    break;
 
-                    // On to the next token even if we failed with this one
-                    if(tokens.size() > 1) tokenIndex++;
+                    default: break;
                 }
 
-                // Opcode
-                bool operandValid = false;
-                InstructionType instructionType = getOpcode(tokens[tokenIndex++]);
-                uint8_t opcode = instructionType._opcode;
-                uint8_t branch = instructionType._branch;
-                int outputSize = instructionType._byteSize;
-                uint16_t additionalSize = 0;
-                OpcodeType opcodeType = instructionType._opcodeType;
-                Instruction instruction = {false, false, ByteSize(outputSize), opcode, 0x00, 0x00, _currentAddress, opcodeType};
-
-                if(outputSize == BadSize)
+                if(removeLine >= 0)
                 {
-                    fprintf(stderr, "Assembler::assemble() : Bad Opcode : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _lineNumber+1);
-                    return false;
+                    savedBytes += parsedLines[removeLine]._instructionType._byteSize;
+                    parsedLines.erase(parsedLines.begin() + removeLine);
+                    changed = true;
                 }
 
-                // Compound instructions that require a Mnemonic pass
-                bool compoundInstruction = false;
-                if(opcodeType == ReservedDB  ||  opcodeType == ReservedDBR)
-                {
-                    compoundInstruction = true;
-                    if(parse == MnemonicPass)
-                    {
-                        outputSize = OneByte; // first instruction has already been parsed
-                        if(tokenIndex + 1 < tokens.size())
-                        {
-                            if(!handleDefineByte(tokens, tokenIndex, instruction, false, outputSize))
-                            {
-                                fprintf(stderr, "Assembler::assemble() : Bad DB data : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _lineNumber+1);
-                                return false;
-                            }
-                        }
-                    }
-                }
-                else if(opcodeType == ReservedDW  ||  opcodeType == ReservedDWR)
+                if(changed)
                 {
-                    compoundInstruction = true;
-                    if(parse == MnemonicPass)
-                    {
-                        outputSize = TwoBytes; // first instruction has already been parsed
-                        if(tokenIndex + 1 < tokens.size())
-                        {
-                            if(!handleDefineWord(tokens, tokenIndex, instruction, false, outputSize))
-                            {
-                                fprintf(stderr, "Assembler::assemble() : Bad DW data : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _lineNumber+1);
-                                return false;
-                            }
-                        }
-                    }
+                    _context->_assembleTimes._optimisations++;
+                    _context->_assembleTimes._optimisedBytes += savedBytes;
                 }
-                
-                if(parse == CodePass)
+            }
+
+            if(!changed) break;
+        }
+    }
+
+    // Cycles from a native instruction to the end of every path through the code that follows it
+    struct NativePaths
+    {
+        bool _hasExit = false;    // false for paths that only loop back
+        bool _isBounded = true;   // false if a path loops
+        bool _isResolved = true;  // false if a path takes a computed jump or runs off the end of the code
+        bool _isReported = true;  // false if a path doesn't return its ticks with a LD in the delay slot of its last jump
+        int _best = 0;
+        int _worst = 0;
+        int _minSlack = 0;        // cycles returned in AC minus cycles to the end of the path
+        int _maxSlack = 0;
+    };
+
+    struct NativeRoutine
+    {
+        int _budget = 0; // SYS_Name_NN declares NN cycles
+        uint16_t _address;
+        std::string _name;
+        NativePaths _paths;
+    };
+
+    // ROM address to opcode and operand
+    typedef std::unordered_map<uint16_t, std::pair<uint8_t, uint8_t>> NativeCode;
+
+    // Native instructions by ROM address and the ROM addresses of their assembled addresses
+    void getNativeCode(NativeCode& code, std::unordered_map<uint16_t, uint16_t>& romAddresses)
+    {
+        uint16_t sectionAddress = _context->_startAddress;
+        for(int i=0; i<int(_context->_instructions.size()); i++)
+        {
+            const Instruction& instruction = _context->_instructions[i];
+            if(instruction._isCustomAddress) sectionAddress = instruction._address;
+            if(instruction._opcodeType != Native) continue;
+
+            uint16_t romAddress = uint16_t(sectionAddress + ((instruction._address - sectionAddress) >>1));
+            code[romAddress] = std::make_pair(instruction._opcode, instruction._operand0);
+            romAddresses[instruction._address] = romAddress;
+        }
+    }
+
+    struct NativeWalk
+    {
+        std::unordered_map<uint64_t, NativePaths> _paths;
+        std::unordered_map<uint64_t, bool> _active;
+    };
+
+    void addNativePaths(NativePaths& paths, const NativePaths& next)
+    {
+        paths._isBounded = paths._isBounded  &&  next._isBounded;
+        paths._isResolved = paths._isResolved  &&  next._isResolved;
+        paths._isReported = paths._isReported  &&  next._isReported;
+        if(!next._hasExit) return;
+
+        if(!paths._hasExit)
+        {
+            paths._hasExit = true;
+            paths._best = next._best;
+            paths._worst = next._worst;
+            paths._minSlack = next._minSlack;
+            paths._maxSlack = next._maxSlack;
+            return;
+        }
+
+        paths._best = std::min(paths._best, next._best);
+        paths._worst = std::max(paths._worst, next._worst);
+        paths._minSlack = std::min(paths._minSlack, next._minSlack);
+        paths._maxSlack = std::max(paths._maxSlack, next._maxSlack);
+    }
+
+    // Executes the instruction at address with Y holding y, (-1 if unknown), and continues at next, every instruction takes one cycle and the
+    // instruction after a jump, (its delay slot), always executes. Paths end when they leave the assembled code, (e.g. JMP Y,REENTER), far jumps
+    // are followed when Y was loaded with a constant, loops are found by revisiting a state of the current path
+    NativePaths getNativePaths(const NativeCode& code, uint16_t address, uint16_t next, int y, NativeWalk& walk)
+    {
+        uint64_t key = address | (uint64_t(next) <<16) | (uint64_t(y + 1) <<32);
+        auto memo = walk._paths.find(key);
+        if(memo != walk._paths.end()) return memo->second;
+
+        NativePaths paths;
+        if(walk._active[key])
+        {
+            paths._isBounded = false;
+            return paths;
+        }
+
+        auto it = code.find(address);
+        if(it == code.end())
+        {
+            paths._isResolved = false;
+            return paths;
+        }
+
+        walk._active[key] = true;
+
+        uint8_t opcode = it->second.first;
+        uint8_t operand = it->second.second;
+        int ins = opcode >>5;
+        int mod = (opcode >>2) & 7;
+        int bus = opcode & 3;
+
+        NativePaths after;
+        if(ins != 7)
+        {
+            // LD d,Y is how far jumps are set up
+            if(mod == 5) y = (ins == 0  &&  bus == D) ? operand : -1;
+
+            if(code.find(next) != code.end())
+            {
+                after = getNativePaths(code, next, uint16_t(next + 1), y, walk);
+            }
+            // Leaving the code, AC returns the negative of the ticks of the whole SYS call
+            else
+            {
+                after._hasExit = true;
+                after._isResolved = (next != uint16_t(address + 1));
+                after._isReported = (opcode == 0x00);
+                after._minSlack = after._maxSlack = -2 * int8_t(operand);
+            }
+        }
+        else
+        {
+            uint16_t page = next & 0xFF00;
+            if(bus != D  ||  (mod == 0  &&  y < 0)  ||  code.find(next) == code.end())
+            {
+                // Computed jump, only its delay slot is counted
+                after._hasExit = true;
+                after._isResolved = false;
+                after._isReported = false;
+                after._best = after._worst = (code.find(next) != code.end()) ? 1 : 0;
+            }
+            else if(mod == 0)
+            {
+                after = getNativePaths(code, next, uint16_t((y <<8) | operand), y, walk);
+            }
+            else
+            {
+                after = getNativePaths(code, next, page | operand, y, walk);
+                if(mod != 7) addNativePaths(after, getNativePaths(code, next, uint16_t(next + 1), y, walk));
+            }
+        }
+
+        addNativePaths(paths, after);
+        if(paths._hasExit)
+        {
+            paths._best++;
+            paths._worst++;
+            paths._minSlack--;
+            paths._maxSlack--;
+        }
+
+        walk._active[key] = false;
+        walk._paths[key] = paths;
+        return paths;
+    }
+
+    // Native routines start at labels that no native branch targets, SYS functions are timed from vCPU's dispatch to the end of REENTER and must
+    // return exactly the ticks that they take
+    void analyseNativeCode(void)
+    {
+        NativeCode code;
+        std::unordered_map<uint16_t, uint16_t> romAddresses;
+        getNativeCode(code, romAddresses);
+        if(code.size() == 0) return;
+
+        std::unordered_map<uint16_t, bool> targets;
+        for(auto it=code.begin(); it!=code.end(); ++it)
+        {
+            uint8_t opcode = it->second.first;
+            if((opcode >>5) == 7  &&  ((opcode >>2) & 7) != 0  &&  (opcode & 3) == D) targets[uint16_t(((it->first + 1) & 0xFF00) | it->second.second)] = true;
+        }
+
+        std::vector<NativeRoutine> routines;
+        for(int i=0; i<int(_context->_labels.size()); i++)
+        {
+            auto it = romAddresses.find(_context->_labels[i]._address);
+            if(it == romAddresses.end()  ||  getNativeAddress(_context->_labels[i]) != it->second) continue;
+
+            NativeRoutine routine;
+            routine._address = it->second;
+            routine._name = _context->_labels[i]._name;
+
+            size_t suffix = routine._name.find_last_of('_');
+            bool isSys = routine._name.find("SYS_") == 0  &&  suffix != std::string::npos  &&  suffix + 1 < routine._name.size()  &&
+                         routine._name.find_first_not_of("0123456789", suffix + 1) == std::string::npos;
+            if(isSys) routine._budget = atoi(routine._name.c_str() + suffix + 1);
+            if(!isSys  &&  targets.find(routine._address) != targets.end()) continue;
+
+            routines.push_back(routine);
+        }
+        if(routines.size() == 0) return;
+
+        std::sort(routines.begin(), routines.end(), [](const NativeRoutine& a, const NativeRoutine& b) {return a._address < b._address;});
+
+        NativeWalk walk;
+        Expression::print("\n************************************************************\n");
+        Expression::print("* Native routine           : Address :  Best  : Worst : Budget\n");
+        Expression::print("************************************************************\n");
+        for(int i=0; i<int(routines.size()); i++)
+        {
+            NativeRoutine& routine = routines[i];
+            routine._paths = getNativePaths(code, routine._address, uint16_t(routine._address + 1), -1, walk);
+
+            int overhead = (routine._budget) ? NATIVE_SYS_ENTER + NATIVE_SYS_REENTER : 0;
+            int best = routine._paths._best + overhead;
+            int worst = routine._paths._worst + overhead;
+            std::string name = (routine._name.size() > 24) ? routine._name.substr(0, 21) + "..." : routine._name;
+            Expression::print("* %-24s : 0x%04x  : %5d  ", name.c_str(), routine._address, best);
+            if(routine._paths._isBounded) Expression::print(": %5d ", worst); else Expression::print(":  loop ");
+            if(routine._budget) Expression::print(": %5d\n", routine._budget); else Expression::print(":     -\n");
+        }
+        Expression::print("************************************************************\n");
+
+        for(int i=0; i<int(routines.size()); i++)
+        {
+            const NativeRoutine& routine = routines[i];
+            const NativePaths& paths = routine._paths;
+            const char* name = routine._name.c_str();
+            if(!paths._isResolved) Expression::print("Assembler::analyseNativeCode() : Warning, '%s' has a computed jump or runs off the end of the code, its cycles are only to there\n", name);
+            if(!routine._budget) continue;
+
+            int worst = paths._worst + NATIVE_SYS_ENTER + NATIVE_SYS_REENTER;
+            if(!paths._isBounded)
+            {
+                Expression::print("Assembler::analyseNativeCode() : Warning, '%s' loops, SYS functions must return within their budget of %d cycles\n", name, routine._budget);
+            }
+            else if(worst > routine._budget)
+            {
+                Expression::print("Assembler::analyseNativeCode() : Warning, '%s' takes up to %d cycles, over its budget of %d cycles\n", name, worst, routine._budget);
+            }
+
+            // Slack is the returned ticks, in cycles, minus the cycles of the path, it must be the SYS overhead for every path
+            int overhead = NATIVE_SYS_ENTER + NATIVE_SYS_REENTER;
+            if(!paths._isReported)
+            {
+                Expression::print("Assembler::analyseNativeCode() : Warning, '%s' doesn't return its ticks with LD in the delay slot of its last jump on every path\n", name);
+            }
+            else if(paths._hasExit  &&  (paths._minSlack != overhead  ||  paths._maxSlack != overhead))
+            {
+                if(paths._minSlack < overhead) Expression::print("Assembler::analyseNativeCode() : Warning, '%s' returns %d cycles fewer than it takes on a path\n", name, overhead - paths._minSlack);
+                if(paths._maxSlack > overhead) Expression::print("Assembler::analyseNativeCode() : Warning, '%s' returns %d cycles more than it takes on a path\n", name, paths._maxSlack - overhead);
+            }
+        }
+    }
+
+    bool assemble(const std::string& filename, uint16_t startAddress)
+    {
+        std::ifstream infile(filename);
+        if(!infile.is_open())
+        {
+            Expression::print("Assembler::assemble() : Failed to open file : '%s'\n", filename.c_str());
+            return false;
+        }
+
+        _context->_callTable = 0x0000;
+        _context->_startAddress = startAddress;
+        _context->_currentAddress = _context->_startAddress;
+        _context->_sectionAddress = _context->_startAddress;
+        clearAssembler();
+
+#ifndef STAND_ALONE
+        Loader::disableUploads(false);
+#endif
+
+        // Get file
+        int numLines = 0;
+        LineToken lineToken;
+        std::vector<LineToken> lineTokens;
+        while(!infile.eof())
+        {
+            std::getline(infile, lineToken._text);
+            lineTokens.push_back(lineToken);
+
+            if(!infile.good()  &&  !infile.eof())
+            {
+                Expression::print("Assembler::assemble() : Bad lineToken : '%s' : in '%s' : on line %d\n", lineToken._text.c_str(), filename.c_str(), numLines+1);
+                return false;
+            }
+
+            numLines++;
+        }
+
+        // Pre-processor
+        auto preProcessStart = std::chrono::steady_clock::now();
+        if(!preProcess(filename, lineTokens, true)) return false;
+
+        // Tokenise every line once
+        auto parseStart = std::chrono::steady_clock::now();
+        std::vector<ParsedLine> parsedLines;
+        parseLines(lineTokens, parsedLines);
+        _context->_assembleTimes._optimisations = 0;
+        _context->_assembleTimes._optimisedBytes = 0;
+        if(_context->_optimise) optimiseLines(parsedLines);
+
+        // Imports are placeholder labels at 0x0000 that the linker resolves
+        if(_context->_imports.size()  &&  !_context->_objectMode)
+        {
+            Expression::print("Assembler::assemble() : '%s' imports '%s' : it must be assembled as an object and linked\n", filename.c_str(), _context->_imports[0].c_str());
+            return false;
+        }
+        if(_context->_badReserve.size())
+        {
+            Expression::print("Assembler::assemble() : Bad %%RESERVE, expected <address> <size> <optional count> <optional stride> : '%s' : in '%s'\n", _context->_badReserve.c_str(), filename.c_str());
+            return false;
+        }
+        for(int i=0; i<int(_context->_imports.size()); i++)
+        {
+            if(_context->_labelIndices.find(_context->_imports[i]) != _context->_labelIndices.end())
+            {
+                Expression::print("Assembler::assemble() : Duplicate import : '%s' : in '%s'\n", _context->_imports[i].c_str(), filename.c_str());
+                return false;
+            }
+
+            Label label = {0x0000, _context->_imports[i]};
+            addLabel(label);
+        }
+
+        // The mnemonic pass we evaluate all the equates and labels, the code pass is for the opcodes and operands
+        auto passStart = std::chrono::steady_clock::now();
+        _context->_assembleTimes._preProcess = std::chrono::duration<double, std::milli>(parseStart - preProcessStart).count();
+        _context->_assembleTimes._parse = std::chrono::duration<double, std::milli>(passStart - parseStart).count();
+        for(int parse=MnemonicPass; parse<NumParseTypes; parse++)
+        {
+            if(parse == CodePass)
+            {
+                auto codeStart = std::chrono::steady_clock::now();
+                _context->_assembleTimes._mnemonicPass = std::chrono::duration<double, std::milli>(codeStart - passStart).count();
+                passStart = codeStart;
+
+                if(_context->_labelBias) _context->_labelBias();
+            }
+
+            for(int i=0; i<int(parsedLines.size()); i++)
+            {
+                ParsedLine& parsedLine = parsedLines[i];
+                const std::vector<std::string>& tokens = parsedLine._tokens;
+                _context->_lineNumber = parsedLine._lineIndex;
+                const LineToken& lineToken = lineTokens[_context->_lineNumber];
+                if(parse == CodePass) _context->_listingLines.push_back(std::make_pair(_context->_lineNumber, int(_context->_instructions.size())));
+
+                int tokenIndex = 0;
+
+                // Gprintf lines are skipped
+                if(parsedLine._isGprintf  &&  createGprintf(ParseType(parse), lineToken._text, _context->_lineNumber+1)) continue;
+
+                // Starting address, labels and equates
+                if(parsedLine._hasLabel)
+                {
+                    if(tokens.size() >= 2)
+                    {
+                        EvaluateResult result = evaluateEquates(tokens, (ParseType)parse);
+                        if(result == NotFound)
+                        {
+                            Expression::print("Assembler::assemble() : Missing equate : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _context->_lineNumber+1);
+                            return false;
+                        }
+                        else if(result == Duplicate)
+                        {
+                            Expression::print("Assembler::assemble() : Duplicate equate : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _context->_lineNumber+1);
+                            return false;
+                        }
+                        // Skip equate lines
+                        else if(result == Success) 
+                        {
+                            continue;
+                        }
+                            
+                        // Labels
+                        result = EvaluateLabels(tokens, (ParseType)parse, tokenIndex);
+                        if(result == Reserved)
+                        {
+                            Expression::print("Assembler::assemble() : Can't use a reserved word in a label : '%s' : in '%s' on line %d\n", tokens[tokenIndex].c_str(), filename.c_str(), _context->_lineNumber+1);
+                            return false;
+                        }
+                        else if(result == Duplicate)
+                        {
+                            Expression::print("Assembler::assemble() : Duplicate label : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _context->_lineNumber+1);
+                            return false;
+                        }
+                    }
+
+                    // On to the next token even if we failed with this one
+                    if(tokens.size() > 1) tokenIndex++;
+                }
+
+                // Opcode
+                bool operandValid = false;
+                InstructionType instructionType = parsedLine._instructionType;
+                tokenIndex++;
+                uint8_t opcode = instructionType._opcode;
+                uint8_t branch = instructionType._branch;
+                int outputSize = instructionType._byteSize;
+                uint16_t additionalSize = 0;
+                OpcodeType opcodeType = instructionType._opcodeType;
+                Instruction instruction = {false, false, ByteSize(outputSize), opcode, 0x00, 0x00, _context->_currentAddress, opcodeType};
+
+                if(outputSize == BadSize)
+                {
+                    Expression::print("Assembler::assemble() : Bad Opcode : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _context->_lineNumber+1);
+                    return false;
+                }
+
+                // Compound instructions that require a Mnemonic pass
+                bool compoundInstruction = false;
+                if(opcodeType == ReservedDB  ||  opcodeType == ReservedDBR)
+                {
+                    compoundInstruction = true;
+                    if(parse == MnemonicPass)
+                    {
+                        outputSize = OneByte; // first instruction has already been parsed
+                        if(tokenIndex + 1 < tokens.size())
+                        {
+                            if(!handleDefineByte(tokens, tokenIndex, instruction, false, outputSize))
+                            {
+                                Expression::print("Assembler::assemble() : Bad DB data : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _context->_lineNumber+1);
+                                return false;
+                            }
+                        }
+                    }
+                }
+                else if(opcodeType == ReservedDW  ||  opcodeType == ReservedDWR)
+                {
+                    compoundInstruction = true;
+                    if(parse == MnemonicPass)
+                    {
+                        outputSize = TwoBytes; // first instruction has already been parsed
+                        if(tokenIndex + 1 < tokens.size())
+                        {
+                            if(!handleDefineWord(tokens, tokenIndex, instruction, false, outputSize))
+                            {
+                                Expression::print("Assembler::assemble() : Bad DW data : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _context->_lineNumber+1);
+                                return false;
+                            }
+                        }
+                    }
+                }
+                
+                if(parse == CodePass)
                 {
                     // Native NOP
                     if(opcodeType == Native  &&  opcode == 0x02)
@@ -1871,27 +2831,25 @@ namespace Assembler
                     // Missing operand
                     else if((outputSize == TwoBytes  ||  outputSize == ThreeBytes)  &&  tokens.size() <= tokenIndex)
                     {
-                        fprintf(stderr, "Assembler::assemble() : Missing operand/s : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _lineNumber+1);
+                        Expression::print("Assembler::assemble() : Missing operand/s : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _context->_lineNumber+1);
                         return false;
                     }
 
                     // First instruction inherits start address
-                    if(_instructions.size() == 0)
+                    if(_context->_instructions.size() == 0)
                     {
-                        instruction._address = _startAddress;
+                        instruction._address = _context->_startAddress;
                         instruction._isCustomAddress = true;
-                        _currentAddress = _startAddress;
+                        _context->_currentAddress = _context->_startAddress;
                     }
 
                     // Custom address
-                    for(int i=0; i<_equates.size(); i++)
+                    auto it = _context->_equateIndices.find(tokens[0]);
+                    if(it != _context->_equateIndices.end()  &&  _context->_equates[it->second]._isCustomAddress)
                     {
-                        if(_equates[i]._name == tokens[0]  &&  _equates[i]._isCustomAddress)
-                        {
-                            instruction._address = _equates[i]._operand;
-                            instruction._isCustomAddress = true;
-                            _currentAddress = _equates[i]._operand;
-                        }
+                        instruction._address = _context->_equates[it->second]._customAddress;
+                        instruction._isCustomAddress = true;
+                        _context->_currentAddress = _context->_equates[it->second]._customAddress;
                     }
 
                     // Operand
@@ -1899,8 +2857,8 @@ namespace Assembler
                     {
                         case OneByte:
                         {
-                            _instructions.push_back(instruction);
-                            if(!checkInvalidAddress(ParseType(parse), _currentAddress, outputSize, instruction, lineToken, filename, _lineNumber)) return false;
+                            _context->_instructions.push_back(instruction);
+                            if(!checkInvalidAddress(ParseType(parse), _context->_currentAddress, outputSize, instruction, lineToken, filename, _context->_lineNumber)) return false;
                         }
                         break;
 
@@ -1913,33 +2871,33 @@ namespace Assembler
                             {
                                 // Search for branch label
                                 Label label;
-                                if(evaluateLabelOperand(tokens, tokenIndex, label, false))
+                                if(evaluateLabelOperand(parsedLine, false, label))
                                 {
                                     operandValid = true;
                                     operand = uint8_t(label._address) - BRANCH_ADJUSTMENT;
                                 }
                                 else
                                 {
-                                    fprintf(stderr, "Assembler::assemble() : Label missing : '%s' : in '%s' on line %d\n", tokens[tokenIndex].c_str(), filename.c_str(), _lineNumber+1);
+                                    Expression::print("Assembler::assemble() : Label missing : '%s' : in '%s' on line %d\n", tokens[tokenIndex].c_str(), filename.c_str(), _context->_lineNumber+1);
                                     return false;
                                 }
                             }
                             // CALL
-                            else if(opcodeType == vCpu  &&  opcode == 0xCF  &&  _callTable)
+                            else if(opcodeType == vCpu  &&  opcode == 0xCF  &&  _context->_callTable)
                             {
                                 // Search for call label
                                 Label label;
-                                if(evaluateLabelOperand(tokens, tokenIndex, label, false))
+                                if(evaluateLabelOperand(parsedLine, false, label))
                                 {
                                     // Search for address
                                     bool newLabel = true;
                                     uint16_t address = uint16_t(label._address);
-                                    for(int i=0; i<_callTableEntries.size(); i++)
+                                    for(int i=0; i<_context->_callTableEntries.size(); i++)
                                     {
-                                        if(_callTableEntries[i]._address == address)
+                                        if(_context->_callTableEntries[i]._address == address)
                                         {
                                             operandValid = true;
-                                            operand = _callTableEntries[i]._operand;
+                                            operand = _context->_callTableEntries[i]._operand;
                                             newLabel = false;
                                             break;
                                         }
@@ -1949,15 +2907,15 @@ namespace Assembler
                                     if(newLabel)
                                     {
                                         operandValid = true;
-                                        operand = uint8_t(_callTable & 0x00FF);
+                                        operand = uint8_t(_context->_callTable & 0x00FF);
                                         CallTableEntry entry = {operand, address};
-                                        _callTableEntries.push_back(entry);
-                                        _callTable -= 0x0002;
+                                        _context->_callTableEntries.push_back(entry);
+                                        _context->_callTable -= 0x0002;
                                     }
                                 }
                                 else
                                 {
-                                    fprintf(stderr, "Assembler::assemble() : Label missing : '%s' : in '%s' on line %d\n", tokens[tokenIndex].c_str(), filename.c_str(), _lineNumber+1);
+                                    Expression::print("Assembler::assemble() : Label missing : '%s' : in '%s' on line %d\n", tokens[tokenIndex].c_str(), filename.c_str(), _context->_lineNumber+1);
                                     return false;
                                 }
                             }
@@ -1980,12 +2938,12 @@ namespace Assembler
                                         operand = uint8_t(tokens[tokenIndex][quote1+1]);
                                     }
                                     // Search equates
-                                    else if(operandValid = evaluateEquateOperand(tokens, tokenIndex, equate, compoundInstruction))
+                                    else if(operandValid = evaluateEquateOperand(parsedLine, compoundInstruction, equate))
                                     {
                                         operand = uint8_t(equate._operand);
                                     }
                                     // Search labels
-                                    else if(operandValid = evaluateLabelOperand(tokens, tokenIndex, label, compoundInstruction))
+                                    else if(operandValid = evaluateLabelOperand(parsedLine, compoundInstruction, label))
                                     {
                                         operand = uint8_t(label._address);
                                     }
@@ -1993,12 +2951,12 @@ namespace Assembler
                                     {
                                         std::string input;
                                         preProcessExpression(tokens, tokenIndex, input, true);
-                                        operand = uint8_t(Expression::parse((char*)input.c_str(), _lineNumber));
+                                        operand = uint8_t(Expression::parse((char*)input.c_str(), _context->_lineNumber));
                                         operandValid = true;
                                     }
                                     else if(!operandValid)
                                     {
-                                        fprintf(stderr, "Assembler::assemble() : Label/Equate error : '%s' : in '%s' on line %d\n", tokens[tokenIndex].c_str(), filename.c_str(), _lineNumber+1);
+                                        Expression::print("Assembler::assemble() : Label/Equate error : '%s' : in '%s' on line %d\n", tokens[tokenIndex].c_str(), filename.c_str(), _context->_lineNumber+1);
                                         return false;
                                     }
                                 }
@@ -2011,7 +2969,7 @@ namespace Assembler
                                 {
                                     if(!handleNativeInstruction(tokens, tokenIndex, opcode, operand))
                                     {
-                                        fprintf(stderr, "Assembler::assemble() : Native instruction is malformed : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _lineNumber+1);
+                                        Expression::print("Assembler::assemble() : Native instruction is malformed : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _context->_lineNumber+1);
                                         return false;
                                     }
                                 }
@@ -2019,8 +2977,8 @@ namespace Assembler
                                 instruction._isRomAddress = true;
                                 instruction._opcode = opcode;
                                 instruction._operand0 = uint8_t(operand & 0x00FF);
-                                _instructions.push_back(instruction);
-                                if(!checkInvalidAddress(ParseType(parse), _currentAddress, outputSize, instruction, lineToken, filename, _lineNumber)) return false;
+                                _context->_instructions.push_back(instruction);
+                                if(!checkInvalidAddress(ParseType(parse), _context->_currentAddress, outputSize, instruction, lineToken, filename, _context->_lineNumber)) return false;
 
 #ifndef STAND_ALONE
                                 uint16_t add = instruction._address>>1;
@@ -2028,7 +2986,7 @@ namespace Assembler
                                 uint8_t ope = Cpu::getROM(add, 1);
                                 if(instruction._opcode != opc  ||  instruction._operand0 != ope)
                                 {
-                                    fprintf(stderr, "Assembler::assemble() : ROM Native instruction mismatch  : 0x%04X : ASM=0x%02X%02X : ROM=0x%02X%02X : on line %d\n", add, instruction._opcode, instruction._operand0, opc, ope, _lineNumber+1);
+                                    Expression::print("Assembler::assemble() : ROM Native instruction mismatch  : 0x%04X : ASM=0x%02X%02X : ROM=0x%02X%02X : on line %d\n", add, instruction._opcode, instruction._operand0, opc, ope, _context->_lineNumber+1);
 
                                     // Fix mismatched instruction?
                                     //instruction._opcode = opc;
@@ -2045,26 +3003,26 @@ namespace Assembler
                                 instruction._isRomAddress = (opcodeType == ReservedDBR) ? true : false;
                                 instruction._byteSize = ByteSize(outputSize);
                                 instruction._opcode = uint8_t(operand & 0x00FF);
-                                _instructions.push_back(instruction);
+                                _context->_instructions.push_back(instruction);
     
                                 // Push any remaining operands
                                 if(tokenIndex + 1 < tokens.size())
                                 {
                                     if(!handleDefineByte(tokens, tokenIndex, instruction, true, outputSize))
                                     {
-                                        fprintf(stderr, "Assembler::assemble() : Bad DB data : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _lineNumber+1);
+                                        Expression::print("Assembler::assemble() : Bad DB data : '%s' : in '%s' on line %d\n", lineToken._text.c_str(), filename.c_str(), _context->_lineNumber+1);
                                         return false;
                                     }
                                 }
 
-                                if(!checkInvalidAddress(ParseType(parse), _currentAddress, outputSize, instruction, lineToken, filename, _lineNumber)) return false;
+                                if(!checkInvalidAddress(ParseType(parse), _context->_currentAddress, outputSize, instruction, lineToken, filename, _context->_lineNumber)) return false;
                             }
                             // Normal instructions
                             else
                             {
                                 instruction._operand0 = operand;
-                                _instructions.push_back(instruction);
-                                if(!checkInvalidAddress(ParseType(parse), _currentAddress, outputSize, instruction, lineToken, filename, _lineNumber)) return false;
+                                _context->_instructions.push_back(instruction);
+                                if(!checkInvalidAddress(ParseType(parse), _context->_currentAddress, outputSize, instruction, lineToken, filename, _context->_lineNumber)) return false;
                             }
                         }
                         break;
@@ -2077,20 +3035,20 @@ namespace Assembler
                                 // Search for branch label
                                 Label label;
                                 uint8_t operand = 0x00;
-                                if(evaluateLabelOperand(tokens, tokenIndex, label, false))
+                                if(evaluateLabelOperand(parsedLine, false, label))
                                 {
                                     operand = uint8_t(label._address) - BRANCH_ADJUSTMENT;
                                 }
                                 else
                                 {
-                                    fprintf(stderr, "Assembler::assemble() : Label missing : '%s' : in '%s' on line %d\n", tokens[tokenIndex].c_str(), filename.c_str(), _lineNumber+1);
+                                    Expression::print("Assembler::assemble() : Label missing : '%s' : in '%s' on line %d\n", tokens[tokenIndex].c_str(), filename.c_str(), _context->_lineNumber+1);
                                     return false;
                                 }
 
                                 instruction._operand0 = branch;
                                 instruction._operand1 = operand & 0x00FF;
-                                _instructions.push_back(instruction);
-                                if(!checkInvalidAddress(ParseType(parse), _currentAddress, outputSize, instruction, lineToken, filename, _lineNumber)) return false;
+                                _context->_instructions.push_back(instruction);
+                                if(!checkInvalidAddress(ParseType(parse), _context->_currentAddress, outputSize, instruction, lineToken, filename, _context->_lineNumber)) return false;
                             }
                             // All other 3 byte instructions
                             else
@@ -2103,12 +3061,12 @@ namespace Assembler
                                     Equate equate;
 
                                     // Search equates
-                                    if(operandValid = evaluateEquateOperand(tokens, tokenIndex, equate, compoundInstruction))
+                                    if(operandValid = evaluateEquateOperand(parsedLine, compoundInstruction, equate))
                                     {
                                         operand = equate._operand;
                                     }
                                     // Search labels
-                                    else if(operandValid = evaluateLabelOperand(tokens, tokenIndex, label, compoundInstruction))
+                                    else if(operandValid = evaluateLabelOperand(parsedLine, compoundInstruction, label))
                                     {
                                         operand = label._address;
                                     }
@@ -2116,12 +3074,12 @@ namespace Assembler
                                     {
                                         std::string input;
                                         preProcessExpression(tokens, tokenIndex, input, true);
-                                        operand = Expression::parse((char*)input.c_str(), _lineNumber);
+                                        operand = Expression::parse((char*)input.c_str(), _context->_lineNumber);
                                         operandValid = true;
                                     }
                                     else if(!operandValid)
                                     {
-                                        fprintf(stderr, "Assembler::assemble() : Label/Equate error : '%s' : in '%s' on line %d\n", tokens[tokenIndex].c_str(), filename.c_str(), _lineNumber+1);
+                                        Expression::print("Assembler::assemble() : Label/Equate error : '%s' : in '%s' on line %d\n", tokens[tokenIndex].c_str(), filename.c_str(), _context->_lineNumber+1);
                                         return false;
                                     }
                                 }
@@ -2135,19 +3093,19 @@ namespace Assembler
                                     instruction._byteSize = ByteSize(outputSize);
                                     instruction._opcode   = uint8_t(operand & 0x00FF);
                                     instruction._operand0 = uint8_t((operand & 0xFF00) >>8);
-                                    _instructions.push_back(instruction);
+                                    _context->_instructions.push_back(instruction);
 
                                     // Push any remaining operands
                                     if(tokenIndex + 1 < tokens.size()) handleDefineWord(tokens, tokenIndex, instruction, true, outputSize);
-                                    if(!checkInvalidAddress(ParseType(parse), _currentAddress, outputSize, instruction, lineToken, filename, _lineNumber)) return false;
+                                    if(!checkInvalidAddress(ParseType(parse), _context->_currentAddress, outputSize, instruction, lineToken, filename, _context->_lineNumber)) return false;
                                 }
                                 // Normal instructions
                                 else
                                 {
                                     instruction._operand0 = uint8_t(operand & 0x00FF);
                                     instruction._operand1 = uint8_t((operand & 0xFF00) >>8);
-                                    _instructions.push_back(instruction);
-                                    if(!checkInvalidAddress(ParseType(parse), _currentAddress, instruction._byteSize, instruction, lineToken, filename, _lineNumber)) return false;
+                                    _context->_instructions.push_back(instruction);
+                                    if(!checkInvalidAddress(ParseType(parse), _context->_currentAddress, instruction._byteSize, instruction, lineToken, filename, _context->_lineNumber)) return false;
                                 }
                             }
                         }
@@ -2155,16 +3113,560 @@ namespace Assembler
                     }
                 }
 
-                _currentAddress += outputSize;
+                _context->_currentAddress += outputSize;
             }              
         }
 
+        _context->_assembleTimes._codePass = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - passStart).count();
+
         // Pack byte code buffer from instruction buffer
         packByteCodeBuffer();
 
         // Parse gprintf labels, equates and expressions
         if(!parseGprintfs()) return false;
 
+        // Cycle budgets of native code
+        if(!_context->_objectMode) analyseNativeCode();
+
+        _context->_listingTokens = std::move(lineTokens);
+
+        return true;
+    }
+
+    // vCPU cycles from NEXT to NEXT as documented in each ROM's source, (Core/ROMvN.py), SYS takes the cycles that its operand declares
+    struct VcpuCycles
+    {
+        uint8_t _opcode;
+        int _cycles[NumRomVersions];
+    };
+
+    const VcpuCycles _vcpuCycles[] =
+    {
+        {0x5E, {16, 16, 16}}, // ST
+        {0x2B, {20, 20, 20}}, // STW
+        {0xEC, {26, 26, 26}}, // STLW
+        {0x1A, {18, 18, 18}}, // LD
+        {0x59, {16, 16, 16}}, // LDI
+        {0x11, {20, 20, 20}}, // LDWI
+        {0x21, {20, 20, 20}}, // LDW
+        {0xEE, {26, 26, 26}}, // LDLW
+        {0x99, {28, 28, 28}}, // ADDW
+        {0xB8, {28, 28, 28}}, // SUBW
+        {0xE3, {28, 28, 28}}, // ADDI
+        {0xE6, {28, 28, 28}}, // SUBI
+        {0xE9, {28, 28, 28}}, // LSLW
+        {0x93, {16, 16, 16}}, // INC
+        {0x82, {16, 16, 16}}, // ANDI
+        {0xF8, {28, 28, 28}}, // ANDW
+        {0x88, {14, 14, 14}}, // ORI
+        {0xFA, {28, 28, 28}}, // ORW
+        {0x8C, {14, 14, 14}}, // XORI
+        {0xFC, {26, 26, 26}}, // XORW
+        {0xAD, {26, 26, 26}}, // PEEK
+        {0xF6, {28, 28, 28}}, // DEEK
+        {0xF0, {28, 28, 28}}, // POKE
+        {0xF3, {28, 28, 28}}, // DOKE
+        {0x7F, {26, 26, 26}}, // LUP
+        {0x90, {14, 14, 14}}, // BRA
+        {0x35, {28, 28, 28}}, // Bcc
+        {0xCF, {26, 26, 26}}, // CALL
+        {0xFF, {16, 16, 16}}, // RET
+        {0x75, {26, 26, 26}}, // PUSH
+        {0x63, {26, 26, 26}}, // POP
+        {0xDF, {14, 14, 14}}, // ALLOC
+        {0xCD, {18, 18, 18}}, // DEF
+    };
+
+    const char* _romVersionNames[NumRomVersions] = {"ROMv1", "ROMv2", "ROMv3"};
+
+    bool getRomVersion(const std::string& name, RomVersion& romVersion)
+    {
+        for(int i=0; i<NumRomVersions; i++)
+        {
+            std::string upper = name, version = _romVersionNames[i];
+            if(Expression::strToUpper(upper) != Expression::strToUpper(version)) continue;
+
+            romVersion = RomVersion(i);
+            return true;
+        }
+
+        return false;
+    }
+
+    // Native instructions take one cycle, data takes none
+    int getInstructionCycles(const Instruction& instruction, RomVersion romVersion)
+    {
+        if(instruction._opcodeType == Native) return 1;
+        if(instruction._opcodeType != vCpu) return 0;
+
+        // SYS operand is 270 - cycles/2, it never takes less than the slowest instruction
+        if(instruction._opcode == 0xB4) return std::max(28, 2*((270 - instruction._operand0) & 0xFF));
+
+        for(int i=0; i<int(sizeof(_vcpuCycles)/sizeof(VcpuCycles)); i++)
+        {
+            if(_vcpuCycles[i]._opcode == instruction._opcode) return _vcpuCycles[i]._cycles[romVersion];
+        }
+
+        return 0;
+    }
+
+    void getInstructionBytes(const Instruction& instruction, std::vector<uint8_t>& bytes)
+    {
+        bytes.push_back(instruction._opcode);
+        if(instruction._byteSize >= TwoBytes) bytes.push_back(instruction._operand0);
+        if(instruction._byteSize >= ThreeBytes) bytes.push_back(instruction._operand1);
+    }
+
+    std::string getListingText(const LineToken& lineToken)
+    {
+        std::string text = lineToken._text;
+        size_t end = text.find_last_not_of(" \t\r\n");
+        text = (end == std::string::npos) ? "" : text.substr(0, end + 1);
+
+        // Macro and include origin
+        char origin[256] = "";
+        if(lineToken._macroName.size()) snprintf(origin, sizeof(origin), "    [macro %s]", lineToken._macroName.c_str());
+        else if(lineToken._fromInclude) snprintf(origin, sizeof(origin), "    ['%s' line %d]", lineToken._includeName.c_str(), lineToken._includeLineNumber + 1);
+        return text + origin;
+    }
+
+    // Every source line of the last assembly with the address, bytes and cycles of what it assembled to, ROM code is listed at its ROM addresses,
+    // two bytes per address
+    bool saveListing(const std::string& filename, RomVersion romVersion)
+    {
+        std::ofstream outfile(filename, std::ios::out);
+        if(!outfile.is_open())
+        {
+            Expression::print("Assembler::saveListing() : failed to open '%s'\n", filename.c_str());
+            return false;
+        }
+
+        char row[64];
+        outfile << "; Listing : vCPU cycles for " << _romVersionNames[romVersion] << "\n";
+        outfile << "; Address  Bytes      Cycles  Source\n";
+
+        uint16_t address = _context->_startAddress;
+        uint16_t sectionAddress = _context->_startAddress;
+        for(int i=0; i<int(_context->_listingLines.size()); i++)
+        {
+            int line = _context->_listingLines[i].first;
+            int first = _context->_listingLines[i].second;
+            int last = (i + 1 < int(_context->_listingLines.size())) ? _context->_listingLines[i + 1].second : int(_context->_instructions.size());
+
+            // Lines that only hold labels, equates or comments
+            std::string text = getListingText(_context->_listingTokens[line]);
+            if(first == last)
+            {
+                outfile << std::string(30, ' ') << text << "\n";
+                continue;
+            }
+
+            // Instructions of the line, continuation rows hold the rest of its bytes
+            for(int j=first; j<last; j++)
+            {
+                const Instruction& instruction = _context->_instructions[j];
+                if(instruction._isCustomAddress) address = sectionAddress = instruction._address;
+
+                std::vector<uint8_t> bytes;
+                getInstructionBytes(instruction, bytes);
+                uint16_t listed = (instruction._isRomAddress) ? uint16_t(sectionAddress + ((address - sectionAddress) >>1)) : address;
+                address += uint16_t(bytes.size());
+
+                std::string hex;
+                for(int k=0; k<int(bytes.size()); k++)
+                {
+                    snprintf(row, sizeof(row), "%02X ", bytes[k]);
+                    hex += row;
+                }
+
+                int cycles = getInstructionCycles(instruction, romVersion);
+                if(cycles) snprintf(row, sizeof(row), "  0x%04X   %-9s %5d   ", listed, hex.c_str(), cycles);
+                else       snprintf(row, sizeof(row), "  0x%04X   %-9s         ", listed, hex.c_str());
+                outfile << row << ((j == first) ? text : "") << "\n";
+            }
+        }
+
+        // Call table, it grows downwards from _callTable_
+        for(int i=int(_context->_callTableEntries.size())-1; i>=0; i--)
+        {
+            int end = int(_context->_callTableEntries.size()) - 1;
+            snprintf(row, sizeof(row), "  0x%04X   %02X %02X             ", _context->_callTable + (end-i)*2 + 2, _context->_callTableEntries[i]._address & 0x00FF, (_context->_callTableEntries[i]._address & 0xFF00) >>8);
+            outfile << row << "; call table : 0x" << std::hex << std::uppercase << _context->_callTableEntries[i]._address << std::dec << "\n";
+        }
+
+        return true;
+    }
+
+    // Labels and equates of the last assembly, in address order, native labels at their ROM addresses
+    bool saveSymbolMap(const std::string& filename)
+    {
+        std::ofstream outfile(filename, std::ios::out);
+        if(!outfile.is_open())
+        {
+            Expression::print("Assembler::saveSymbolMap() : failed to open '%s'\n", filename.c_str());
+            return false;
+        }
+
+        NativeCode code;
+        std::unordered_map<uint16_t, uint16_t> romAddresses;
+        getNativeCode(code, romAddresses);
+
+        struct Symbol
+        {
+            uint16_t _address;
+            const char* _type;
+            std::string _name;
+        };
+
+        std::vector<Symbol> labels, equates;
+        for(int i=0; i<int(_context->_labels.size()); i++)
+        {
+            auto it = romAddresses.find(_context->_labels[i]._address);
+            bool isNative = (it != romAddresses.end()  &&  getNativeAddress(_context->_labels[i]) == it->second);
+            labels.push_back({(isNative) ? it->second : _context->_labels[i]._address, (isNative) ? "rom" : "ram", _context->_labels[i]._name});
+        }
+        for(int i=0; i<int(_context->_equates.size()); i++) equates.push_back({_context->_equates[i]._operand, "equate", _context->_equates[i]._name});
+
+        auto byAddress = [](const Symbol& a, const Symbol& b) {return (a._address != b._address) ? a._address < b._address : a._name < b._name;};
+        std::sort(labels.begin(), labels.end(), byAddress);
+        std::sort(equates.begin(), equates.end(), byAddress);
+        labels.insert(labels.end(), equates.begin(), equates.end());
+
+        char row[32];
+        outfile << "; Symbol map\n";
+        outfile << "; Address  Type    Name\n";
+        for(int i=0; i<int(labels.size()); i++)
+        {
+            snprintf(row, sizeof(row), "  0x%04X   %-7s ", labels[i]._address, labels[i]._type);
+            outfile << row << labels[i]._name << "\n";
+        }
+
+        return true;
+    }
+
+    struct ObjectSection
+    {
+        bool _isCode = false;
+        bool _isAbsolute = false;
+        uint16_t _start;
+        uint16_t _end;
+    };
+
+    struct ObjectSite
+    {
+        Linker::RelocationType _type;
+        int _section;
+        uint16_t _address;
+        int _width;
+    };
+
+    int findObjectSection(const std::vector<ObjectSection>& sections, uint16_t address)
+    {
+        for(int i=0; i<int(sections.size()); i++)
+        {
+            if(address >= sections[i]._start  &&  address < sections[i]._end) return i;
+        }
+
+        // Labels that follow the last byte of a section
+        for(int i=0; i<int(sections.size()); i++)
+        {
+            if(address == sections[i]._end) return i;
+        }
+
+        return -1;
+    }
+
+    // Sections are runs of contiguous RAM, each instruction operand that can hold an address is a potential relocation site
+    bool getObjectLayout(std::vector<ObjectSection>& sections, std::vector<ObjectSite>& sites, std::vector<uint8_t>& bytes)
+    {
+        sections.clear();
+        sites.clear();
+        bytes.clear();
+
+        uint16_t address = _context->_startAddress;
+        for(int i=0; i<int(_context->_instructions.size()); i++)
+        {
+            const Instruction& instruction = _context->_instructions[i];
+            if(instruction._isRomAddress)
+            {
+                Expression::print("Assembler::assembleObject() : ROM code and data can't be linked, at 0x%04X\n", instruction._address);
+                return false;
+            }
+
+            if(instruction._isCustomAddress) address = instruction._address;
+            if(sections.size() == 0  ||  sections.back()._end != address)
+            {
+                ObjectSection section;
+                section._start = address;
+                section._end = address;
+                sections.push_back(section);
+            }
+
+            int section = int(sections.size()) - 1;
+            bool isCode = (instruction._opcodeType == vCpu);
+            if(isCode) sections.back()._isCode = true;
+
+            uint8_t data[3] = {instruction._opcode, instruction._operand0, instruction._operand1};
+            for(int j=0; j<instruction._byteSize; j++) bytes.push_back(data[j]);
+
+            // Word operands of LDWI, CALL tables and DW, byte operands of everything else, branches only ever replace their low byte
+            if(instruction._opcodeType == ReservedDW)
+            {
+                sites.push_back({Linker::Word, section, address, 2});
+            }
+            else if(instruction._opcodeType == ReservedDB)
+            {
+                sites.push_back({Linker::Byte, section, address, 1});
+            }
+            else if(isCode  &&  instruction._byteSize == TwoBytes)
+            {
+                sites.push_back({(instruction._opcode == 0x90) ? Linker::Branch : Linker::Byte, section, uint16_t(address + 1), 1});
+            }
+            else if(isCode  &&  instruction._byteSize == ThreeBytes)
+            {
+                if(instruction._opcode == 0x35)
+                {
+                    sites.push_back({Linker::Branch, section, uint16_t(address + 2), 1});
+                }
+                else
+                {
+                    sites.push_back({Linker::Word, section, uint16_t(address + 1), 2});
+                }
+            }
+
+            address += instruction._byteSize;
+            sections.back()._end = address;
+        }
+
+        // Call table entries are label addresses, the table itself is appended below _callTable when the code is packed
+        if(_context->_callTable  &&  _context->_callTableEntries.size())
+        {
+            ObjectSection section;
+            section._start = _context->_callTable + 2;
+            section._end = uint16_t(section._start + _context->_callTableEntries.size()*2);
+            sections.push_back(section);
+
+            for(int i=int(_context->_callTableEntries.size())-1; i>=0; i--)
+            {
+                uint16_t entry = uint16_t(section._start + (int(_context->_callTableEntries.size()) - 1 - i)*2);
+                sites.push_back({Linker::Word, int(sections.size()) - 1, entry, 2});
+                bytes.push_back(uint8_t(_context->_callTableEntries[i]._address & 0x00FF));
+                bytes.push_back(uint8_t((_context->_callTableEntries[i]._address & 0xFF00) >>8));
+            }
+        }
+
+        // Zero page and page 1 are never moved
+        for(int i=0; i<int(sections.size()); i++) sections[i]._isAbsolute = (sections[i]._start < 0x0200);
+
+        for(int i=0; i<int(sections.size()); i++)
+        {
+            if(sections[i]._isCode  &&  (sections[i]._start >>8) != ((sections[i]._end - 1) >>8))
+            {
+                Expression::print("Assembler::assembleObject() : Code section 0x%04X <-> 0x%04X crosses a page boundary\n", sections[i]._start, sections[i]._end - 1);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Code sections can be split between two vCPU instructions that no branch or DEF spans, after BRA or RET nothing falls through, anywhere else
+    // the next instruction must overwrite vAC so that the linker's LDWI/STW vPC trampoline is free to use it
+    void getObjectCuts(const std::vector<ObjectSection>& sections, std::vector<std::vector<Linker::Cut>>& cuts)
+    {
+        struct Code
+        {
+            uint16_t _address;
+            uint8_t _opcode;
+            bool _isCode;
+        };
+
+        std::vector<Code> codes;
+        uint16_t address = _context->_startAddress;
+        for(int i=0; i<int(_context->_instructions.size()); i++)
+        {
+            const Instruction& instruction = _context->_instructions[i];
+            if(instruction._isCustomAddress) address = instruction._address;
+            codes.push_back({address, instruction._opcode, instruction._opcodeType == vCpu});
+            address += instruction._byteSize;
+        }
+
+        // Address ranges spanned by branches, BRA and Bcc land on their operand + 2, DEF on its operand
+        std::vector<std::pair<uint16_t, uint16_t>> spans;
+        for(int i=0; i<int(_context->_instructions.size()); i++)
+        {
+            const Instruction& instruction = _context->_instructions[i];
+            if(!codes[i]._isCode) continue;
+
+            uint8_t lo;
+            switch(instruction._opcode)
+            {
+                case 0x35: lo = uint8_t(instruction._operand1 + 2); break;
+                case 0x90: lo = uint8_t(instruction._operand0 + 2); break;
+                case 0xCD: lo = instruction._operand0;              break;
+                default: continue;
+            }
+
+            uint16_t target = (codes[i]._address & 0xFF00) | lo;
+            spans.push_back(std::make_pair(std::min(codes[i]._address, target), std::max(codes[i]._address, target)));
+        }
+
+        cuts.clear();
+        cuts.resize(sections.size());
+        for(int i=1; i<int(codes.size()); i++)
+        {
+            if(!codes[i - 1]._isCode  ||  !codes[i]._isCode) continue;
+
+            int section = findObjectSection(sections, codes[i]._address);
+            if(section < 0  ||  !sections[section]._isCode  ||  sections[section]._isAbsolute  ||  codes[i]._address <= sections[section]._start  ||  codes[i - 1]._address < sections[section]._start) continue;
+
+            bool spanned = false;
+            for(int j=0; j<int(spans.size())  &&  !spanned; j++) spanned = (codes[i]._address > spans[j].first  &&  codes[i]._address <= spans[j].second);
+            if(spanned) continue;
+
+            bool fallThrough = (codes[i - 1]._opcode != 0x90  &&  codes[i - 1]._opcode != 0xFF);
+            bool loadsVac = (codes[i]._opcode == 0x11  ||  codes[i]._opcode == 0x1A  ||  codes[i]._opcode == 0x21  ||  codes[i]._opcode == 0x59);
+            if(fallThrough  &&  !loadsVac) continue;
+
+            cuts[section].push_back({uint16_t(codes[i]._address - sections[section]._start), fallThrough});
+        }
+    }
+
+    // The source is assembled three times, sections below 0x0200 are absolute and keep their addresses, labels in section or import n are biased by (n+1)*0x0101 and then by (n+1)*0x0100,
+    // operands that move by exactly those amounts are relocations against n, any other movement can't be relocated
+    bool assembleObject(const std::string& filename, Linker::Object& object)
+    {
+        const uint16_t biasScales[2] = {0x0101, 0x0100};
+
+        std::vector<ObjectSection> sections;
+        std::vector<ObjectSite> sites;
+        std::vector<uint8_t> bytes[3];
+        std::vector<int> labelTargets;
+        std::vector<std::vector<Linker::Cut>> cuts;
+
+        _context->_objectMode = true;
+        _context->_labelBias = nullptr;
+        bool success = assemble(filename, DEFAULT_START_ADDRESS);
+        if(success) success = getObjectLayout(sections, sites, bytes[0]);
+        if(success) getObjectCuts(sections, cuts);
+
+        int numTargets = int(sections.size() + _context->_imports.size());
+        if(success  &&  numTargets > OBJECT_MAX_TARGETS)
+        {
+            Expression::print("Assembler::assembleObject() : '%s' has %d sections and imports, maximum is %d\n", filename.c_str(), numTargets, OBJECT_MAX_TARGETS);
+            success = false;
+        }
+
+        if(success)
+        {
+            object = Linker::Object();
+            object._name = filename;
+            object._imports = _context->_imports;
+            object._reserves = _context->_reserves;
+
+            for(int i=0; i<int(_context->_labels.size()); i++)
+            {
+                auto import = std::find(_context->_imports.begin(), _context->_imports.end(), _context->_labels[i]._name);
+                int target = (import != _context->_imports.end()) ? int(sections.size() + (import - _context->_imports.begin())) : findObjectSection(sections, _context->_labels[i]._address);
+                labelTargets.push_back((target >= 0  &&  target < int(sections.size())  &&  sections[target]._isAbsolute) ? -1 : target);
+
+                if(target >= 0  &&  target < int(sections.size()))
+                {
+                    object._exports.push_back({uint16_t(target), uint16_t(_context->_labels[i]._address - sections[target]._start), _context->_labels[i]._name});
+                }
+            }
+
+            int entrySection = findObjectSection(sections, _context->_startAddress);
+            object._entrySection = uint16_t(std::max(entrySection, 0));
+            object._entryOffset = (entrySection >= 0) ? uint16_t(_context->_startAddress - sections[entrySection]._start) : 0;
+        }
+
+        for(int bias=0; bias<2  &&  success; bias++)
+        {
+            _context->_labelBias = [&]()
+            {
+                for(int i=0; i<int(_context->_labels.size())  &&  i<int(labelTargets.size()); i++)
+                {
+                    if(labelTargets[i] >= 0) _context->_labels[i]._address += uint16_t((labelTargets[i] + 1) * biasScales[bias]);
+                }
+
+                // Custom address equates are the addresses of their sections
+                for(int i=0; i<int(_context->_equates.size()); i++)
+                {
+                    int target = (_context->_equates[i]._isCustomAddress) ? findObjectSection(sections, _context->_equates[i]._customAddress) : -1;
+                    if(target >= 0  &&  !sections[target]._isAbsolute) _context->_equates[i]._operand += uint16_t((target + 1) * biasScales[bias]);
+                }
+            };
+
+            std::vector<ObjectSection> biasedSections;
+            std::vector<ObjectSite> biasedSites;
+            success = assemble(filename, DEFAULT_START_ADDRESS)  &&  getObjectLayout(biasedSections, biasedSites, bytes[bias + 1]);
+            if(success  &&  (biasedSites.size() != sites.size()  ||  bytes[bias + 1].size() != bytes[0].size()))
+            {
+                Expression::print("Assembler::assembleObject() : '%s' changes size with its label values, it can't be relocated\n", filename.c_str());
+                success = false;
+            }
+        }
+
+        _context->_labelBias = nullptr;
+        _context->_objectMode = false;
+        if(!success) return false;
+
+        // Section data
+        int offset = 0;
+        for(int i=0; i<int(sections.size()); i++)
+        {
+            Linker::Section section;
+            section._isCode = sections[i]._isCode;
+            section._isAbsolute = sections[i]._isAbsolute;
+            section._address = sections[i]._start;
+            section._cuts = cuts[i];
+            section._data.assign(bytes[0].begin() + offset, bytes[0].begin() + offset + (sections[i]._end - sections[i]._start));
+            object._sections.push_back(section);
+            offset += sections[i]._end - sections[i]._start;
+        }
+
+        // Relocations
+        for(int i=0; i<int(sites.size()); i++)
+        {
+            const ObjectSite& site = sites[i];
+            int index = site._address - sections[site._section]._start;
+            for(int j=0; j<site._section; j++) index += sections[j]._end - sections[j]._start;
+
+            uint16_t deltas[2];
+            for(int bias=0; bias<2; bias++)
+            {
+                uint16_t value = bytes[0][index], biased = bytes[bias + 1][index];
+                if(site._width == 2)
+                {
+                    value |= bytes[0][index + 1] <<8;
+                    biased |= bytes[bias + 1][index + 1] <<8;
+                }
+                deltas[bias] = (site._width == 2) ? uint16_t(biased - value) : uint8_t(biased - value);
+            }
+            if(deltas[0] == 0  &&  deltas[1] == 0) continue;
+
+            // High bytes move by n+1 under both biases, under the first the low byte of the label can also carry into them
+            bool isHiByte = (site._type == Linker::Byte  &&  deltas[1] != 0  &&  (deltas[0] == deltas[1]  ||  deltas[0] == uint8_t(deltas[1] + 1)));
+            int target = (site._width == 2) ? (deltas[0] / biasScales[0]) - 1 : ((isHiByte) ? deltas[1] - 1 : deltas[0] - 1);
+            bool valid = (site._width == 2) ? (deltas[0] == (target + 1) * biasScales[0]  &&  deltas[1] == (target + 1) * biasScales[1]) : (deltas[1] == 0  ||  isHiByte);
+            if(!valid  ||  target < 0  ||  target >= numTargets)
+            {
+                Expression::print("Assembler::assembleObject() : Operand at 0x%04X in '%s' can't be relocated, only labels plus or minus constants and low or high bytes of labels can\n", site._address, filename.c_str());
+                return false;
+            }
+
+            // The linker keeps the section at the same offset within a page, an import's address isn't known until it is linked
+            if(isHiByte  &&  target >= int(sections.size()))
+            {
+                Expression::print("Assembler::assembleObject() : Operand at 0x%04X in '%s' can't be relocated, high bytes of imports can't be\n", site._address, filename.c_str());
+                return false;
+            }
+
+            Linker::RelocationType type = (isHiByte) ? Linker::HiByte : site._type;
+            object._relocations.push_back({type, uint16_t(site._section), uint16_t(site._address - sections[site._section]._start), uint16_t(target)});
+        }
+
         return true;
     }
 }
@@ -2,6 +2,7 @@
 #define ASSEMBLER_H
 
 #include <stdint.h>
+#include <string>
 
 
 #define DEFAULT_START_ADDRESS  0x0200
@@ -10,8 +11,15 @@
 #define USER_ROM_ADDRESS  0x0B00 // pictures in ROM v1
 
 
+namespace Linker
+{
+    struct Object;
+}
+
 namespace Assembler
 {
+    enum RomVersion {ROMv1=0, ROMv2, ROMv3, NumRomVersions};
+
     struct ByteCode
     {
         bool _isRomAddress;
@@ -20,17 +28,42 @@ namespace Assembler
         uint16_t _address;
     };
 
+    struct AssembleTimes
+    {
+        double _preProcess = 0.0;
+        double _parse = 0.0;
+        double _mnemonicPass = 0.0;
+        double _codePass = 0.0;
+        double _expandMacros = 0.0; // part of pre-process
+        int _macroExpansions = 0;
+        int _optimisations = 0;     // peephole rewrites
+        int _optimisedBytes = 0;    // bytes saved by them
+    };
+
+
+    // Assemblies use the calling thread's current context, every thread starts with its own, setContext(nullptr) returns to it
+    struct Context;
+    Context* createContext(void);
+    void destroyContext(Context* context);
+    void setContext(Context* context);
 
     uint16_t getStartAddress(void);
+    const AssembleTimes& getAssembleTimes(void);
     void setIncludePath(const std::string& includePath);
+    void setOptimise(bool optimise);
 
     void initialise(void);
     void clearAssembler(void);
     bool getNextAssembledByte(ByteCode& byteCode, bool debug=false);
     bool assemble(const std::string& filename, uint16_t startAddress=DEFAULT_START_ADDRESS);
+    bool assembleObject(const std::string& filename, Linker::Object& object);
+
+    bool getRomVersion(const std::string& name, RomVersion& romVersion);
+    bool saveListing(const std::string& filename, RomVersion romVersion=ROMv3);
+    bool saveSymbolMap(const std::string& filename);
 
 #ifndef STAND_ALONE
-    void printGprintfStrings(void);
+    void printGprintfStrings(uint16_t vPC);
 #endif
 }
 
@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
+#include <vector>
 #include <algorithm>
 
 #include "cpu.h"
@@ -12,14 +13,51 @@
 #include <SDL.h>
 
 
+#define MAX_SCORE_COMMANDS  0x10000
+
+
 namespace Audio
 {
+    // Segments keep the Gigatron addresses that gtmidi generated them for, so that segment and pattern commands can be followed
+    struct ScoreSegment
+    {
+        const uint8_t* _data;
+        uint16_t _address;
+        uint16_t _size;
+    };
+
+    struct Score
+    {
+        std::vector<ScoreSegment> _segments;
+        bool _compact;
+    };
+
+    struct Player
+    {
+        uint16_t _address = 0x0000;
+        uint16_t _return = 0x0000;
+        uint16_t _patternEnd = 0x0000;
+        uint16_t _channel = 0;
+        uint32_t _delay = 0;
+        uint8_t _frameCount = 0;
+    };
+
+
     int _scoreIndex = 0;
     SDL_AudioDeviceID _audioDevice = 1;
 
-    uint8_t* _score[] = {(uint8_t*)musicMidi00};
-    uint8_t* _scorePtr = (uint8_t*)_score[_scoreIndex];
+    // gtmidi format 2 output, (C/C++), every segment of a score must be listed, headers from before encodings and addresses were
+    // output are played as a single raw segment that stops at its first Segment command
+    std::vector<Score> _scores =
+    {
+#if defined(musicMidiEncoding)  &&  defined(musicMidi00Address)
+        {{{musicMidi00, musicMidi00Address, sizeof(musicMidi00)}}, musicMidiEncoding == 1},
+#else
+        {{{musicMidi00, 0x0000, sizeof(musicMidi00)}}, false},
+#endif
+    };
 
+    Player _player;
 
     void initialise(void)
     {
@@ -70,82 +108,217 @@ namespace Audio
         }
     }
 
+    void resetPlayer(void)
+    {
+        _player = Player();
+        _player._address = _scores[_scoreIndex]._segments[0]._address;
+        _player._frameCount = Cpu::getRAM(GIGA_FRAME_COUNT);
+    }
+
     void nextScore(void)
     {
         resetChannels();
 
-        if(++_scoreIndex >= 1) _scoreIndex = 0;
-        _scorePtr = (uint8_t*)_score[_scoreIndex];
+        if(++_scoreIndex >= int(_scores.size())) _scoreIndex = 0;
+        resetPlayer();
     }
 
-    void playMusic(void)
+    bool getScoreByte(uint8_t& data)
     {
-        if(!Editor::getStartMusic()) return;
-
-        static bool firstTime = true;
-        if(firstTime == true)
+        const Score& score = _scores[_scoreIndex];
+        for(int i=0; i<int(score._segments.size()); i++)
         {
-            firstTime = false;
-            resetChannels();            
+            const ScoreSegment& segment = score._segments[i];
+            if(_player._address >= segment._address  &&  _player._address < segment._address + segment._size)
+            {
+                data = segment._data[_player._address++ - segment._address];
+                return true;
+            }
+        }
 
-            // Signed -31 to +31 sine wave
-            //for(int i=0; i<64; i++)
-            //{
-            //    Cpu::setRAM(0x700+i, int8_t(sinf(float(i) / 64.0f * 2.0f* 3.141529f)*31.0f));
-            //}
+        fprintf(stderr, "Audio::getScoreByte() : address 0x%04x is outside of score %d\n", _player._address, _scoreIndex);
+        return false;
+    }
+
+    void startNote(uint8_t channel, uint8_t note)
+    {
+        uint16_t key = Cpu::getROM16((note - 10)*2 - 2 + GIGA_NOTES_TABLE, 1);
+        Cpu::setRAM(GIGA_CH0_KEY_L + channel*GIGA_CHANNEL_OFFSET, uint8_t(key & 0x00FF));
+        Cpu::setRAM(GIGA_CH0_KEY_H + channel*GIGA_CHANNEL_OFFSET, uint8_t((key & 0xFF00) >>8));
+    }
+
+    void stopNote(uint8_t channel)
+    {
+        Cpu::setRAM(GIGA_CH0_KEY_L + channel*GIGA_CHANNEL_OFFSET, 0x00);
+        Cpu::setRAM(GIGA_CH0_KEY_H + channel*GIGA_CHANNEL_OFFSET, 0x00);
+    }
+
+    bool playRawCommand(void)
+    {
+        uint8_t command, data0, data1;
+        if(!getScoreByte(command)) return false;
+
+        // Delay n frames where n = 8bit value
+        if((command & 0x80) == 0)
+        {
+            _player._delay = command;
+            return true;
         }
 
-        static int16_t midiDelay = 0;
-        static uint64_t prevFrameCounter = 0;
-        double frameTime = double(SDL_GetPerformanceCounter() - prevFrameCounter) / double(SDL_GetPerformanceFrequency());
-        if(frameTime > VSYNC_TIMING_60)
+        uint8_t channel = command & (GIGA_SOUND_CHANNELS - 1);  // spec supports up to 16 channels, Gigatron supports 4
+        switch(command & 0xF0)
         {
-            prevFrameCounter = SDL_GetPerformanceCounter();        
-            if(midiDelay)
+            // Start note
+            case 0x90:
             {
-                midiDelay--; 
-                frameTime = 0.0;
+                if(!getScoreByte(data0)) return false;
+                startNote(channel, data0);
+            }
+            break;
+
+            // Stop note
+            case 0x80: stopNote(channel); break;
 
-                // Start audio
-                Cpu::setRAM(GIGA_SOUND_TIMER, 0x01);
+            // Segment command
+            case 0xD0:
+            {
+                if(!getScoreByte(data0)  ||  !getScoreByte(data1)) return false;
+                _player._address = (data1 <<8) | data0;
             }
+            break;
+
+            default: break;
+        }
+
+        return true;
+    }
+
+    // See Contrib/at67/midi/README.md for the compact stream, patterns are LZ style back references to earlier parts of the stream
+    bool playCompactCommand(void)
+    {
+        if(_player._patternEnd  &&  _player._address == _player._patternEnd)
+        {
+            _player._address = _player._return;
+            _player._patternEnd = 0x0000;
+        }
+
+        uint8_t command, data0, data1, data2;
+        if(!getScoreByte(command)) return false;
+
+        // Note on the running channel
+        if(command < 0x80)
+        {
+            startNote(uint8_t(_player._channel), command);
+            _player._channel = (_player._channel + 1) & (GIGA_SOUND_CHANNELS - 1);
+            return true;
         }
 
-        while(midiDelay == 0)
+        switch(command)
         {
-            uint8_t command = *_scorePtr++;
-            if(command & 0x80)
+            // Note off channel mask
+            case 0x80: case 0x81: case 0x82: case 0x83: case 0x84: case 0x85: case 0x86: case 0x87:
+            case 0x88: case 0x89: case 0x8A: case 0x8B: case 0x8C: case 0x8D: case 0x8E: case 0x8F:
             {
-                // Start note
-                if((command & 0xF0) == 0x90)
+                for(uint8_t i=0; i<GIGA_SOUND_CHANNELS; i++)
                 {
-                    uint8_t channel = command & (GIGA_SOUND_CHANNELS - 1);  // spec supports up to 16 channels, Gigatron supports 4
-                    uint16_t note = *_scorePtr++;
-                    note = (note - 10) * 2 - 2;
-                    note = Cpu::getROM16(note + 0x0900, 1);
-                    Cpu::setRAM(GIGA_CH0_KEY_L + channel*GIGA_CHANNEL_OFFSET, uint8_t(note & 0x00FF));
-                    Cpu::setRAM(GIGA_CH0_KEY_H + channel*GIGA_CHANNEL_OFFSET, uint8_t((note & 0xFF00)>>8));
+                    if(command & (1 <<i)) stopNote(i);
                 }
-                // Stop note
-                else if((command & 0xF0) == 0x80)
+            }
+            break;
+
+            // Segment
+            case 0xD0:
+            {
+                if(!getScoreByte(data0)  ||  !getScoreByte(data1)) return false;
+                _player._address = (data1 <<8) | data0;
+            }
+            break;
+
+            // Pattern, patterns never contain patterns
+            case 0xD1:
+            {
+                if(!getScoreByte(data0)  ||  !getScoreByte(data1)  ||  !getScoreByte(data2)) return false;
+                _player._return = _player._address;
+                _player._address = (data1 <<8) | data0;
+                _player._patternEnd = _player._address + data2;
+            }
+            break;
+
+            // Long delay, 7 bits per byte, most significant first
+            case 0xE0:
+            {
+                do
                 {
-                    uint8_t channel = command & (GIGA_SOUND_CHANNELS - 1);  // spec supports up to 16 channels, Gigatron supports 4
-                    Cpu::setRAM(GIGA_CH0_KEY_L + channel*GIGA_CHANNEL_OFFSET, 0x00);
-                    Cpu::setRAM(GIGA_CH0_KEY_H + channel*GIGA_CHANNEL_OFFSET, 0x00);
+                    if(!getScoreByte(data0)) return false;
+                    _player._delay = (_player._delay <<7) | (data0 & 0x7F);
                 }
-                // Segment command
-                else if((command & 0xF0) == 0xD0)
+                while(data0 & 0x80);
+            }
+            break;
+
+            default:
+            {
+                // Running channel
+                if(command < 0xA0)
                 {
-                    uint16_t segment = *_scorePtr++;
-                    segment |= (((*_scorePtr++) <<8) & 0xFF00);
-                    _scorePtr = (uint8_t*)segment;
+                    _player._channel = command & (GIGA_SOUND_CHANNELS - 1);
+                }
+                // Delay 1 to 48 frames
+                else if(command < 0xD0)
+                {
+                    _player._delay = command - 0x9F;
+                }
+                else
+                {
+                    fprintf(stderr, "Audio::playCompactCommand() : unknown command 0x%02x at 0x%04x in score %d\n", command, _player._address - 1, _scoreIndex);
+                    return false;
                 }
             }
-            // Delay n milliseconds where n = 8bit value
-            else
+            break;
+        }
+
+        return true;
+    }
+
+    void playMusic(void)
+    {
+        if(!Editor::getStartMusic()) return;
+
+        static bool firstTime = true;
+        if(firstTime == true)
+        {
+            firstTime = false;
+            resetChannels();
+            resetPlayer();
+
+            // Signed -31 to +31 sine wave
+            //for(int i=0; i<64; i++)
+            //{
+            //    Cpu::setRAM(0x700+i, int8_t(sinf(float(i) / 64.0f * 2.0f* 3.141529f)*31.0f));
+            //}
+        }
+
+        // Timed by emulated frames, not the host's clock, so playback keeps pace with the emulation whatever its speed
+        uint8_t frames = Cpu::getRAM(GIGA_FRAME_COUNT) - _player._frameCount;
+        if(frames == 0) return;
+        _player._frameCount += frames;
+
+        // Keep pumping soundTimer, so that global sound stays alive
+        Cpu::setRAM(GIGA_SOUND_TIMER, 0x01);
+
+        _player._delay = (_player._delay > frames) ? _player._delay - frames : 0;
+
+        // A score without delays would never return
+        for(int i=0; _player._delay == 0; i++)
+        {
+            bool played = (_scores[_scoreIndex]._compact) ? playCompactCommand() : playRawCommand();
+            if(!played  ||  i == MAX_SCORE_COMMANDS)
             {
-                midiDelay = command;
+                if(played) fprintf(stderr, "Audio::playMusic() : score %d has no delays\n", _scoreIndex);
+                resetChannels();
+                Editor::setStartMusic(false);
+                return;
             }
         }
     }
-}
\ No newline at end of file
+}
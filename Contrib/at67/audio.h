@@ -2,7 +2,9 @@
 #define AUDIO_H
 
 
+#define GIGA_FRAME_COUNT     0x000E
 #define GIGA_SOUND_TIMER     0x002C
+#define GIGA_NOTES_TABLE     0x0900
 #define GIGA_SOUND_CHANNELS  4
 #define GIGA_CHANNEL_OFFSET  0x0100
 
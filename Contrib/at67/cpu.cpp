@@ -7,11 +7,13 @@
 #include <algorithm>
 
 #include "cpu.h"
+#include "mapping.h"
 
 #ifndef STAND_ALONE
 #include <SDL.h>
 #include "editor.h"
 #include "timing.h"
+#include "assembler.h"
 #include "graphics.h"
 #include "gigatron_0x1c.h"
 #endif
@@ -49,6 +51,7 @@ namespace Cpu
     uint16_t getBaseFreeRAM(void) {return _baseFreeRAM;}
     uint16_t getFreeRAM(void) {return _freeRAM;}
     uint8_t* getPtrToROM(int& romSize) {romSize = sizeof(_ROM); return (uint8_t*)_ROM;}
+    InternalGt1 getInternalGt1(InternalGt1Id gt1Id) {return _internalGt1s[gt1Id];}
 
     void setFreeRAM(uint16_t freeRAM) {_freeRAM = freeRAM;}
 
@@ -156,50 +159,52 @@ namespace Cpu
         for(int i=minLength; i<MAX_TITLE_CHARS; i++) _ROM[ROM_TITLE_ADDRESS + i][ROM_DATA] = ' ';
     }
 
-    void patchSplitGt1IntoRom(const std::string& splitGt1path, const std::string& splitGt1name, uint16_t startAddress, InternalGt1Id gt1Id)
+    void patchMenuIntoRom(const std::string& menuName, uint16_t startAddress, InternalGt1Id gt1Id)
     {
-        size_t filelength = 0;
-        char filebuffer[RAM_SIZE];
-
-        std::ifstream romfile_ti(splitGt1path + "_ti", std::ios::binary | std::ios::in);
-        if(!romfile_ti.is_open()) fprintf(stderr, "Cpu::patchTetrisIntoRomTest() : failed to open %s ROM file.\n", std::string(splitGt1path + "_ti").c_str());
-        romfile_ti.seekg (0, romfile_ti.end); filelength = romfile_ti.tellg(); romfile_ti.seekg (0, romfile_ti.beg);
-        romfile_ti.read(filebuffer, filelength);
-        if(romfile_ti.eof() || romfile_ti.bad() || romfile_ti.fail()) fprintf(stderr, "Cpu::patchTetrisIntoRomTest() : failed to read %s ROM file.\n", std::string(splitGt1path + "_ti").c_str());
-        for(int i=0; i<filelength; i++) _ROM[startAddress + i][ROM_INST] = filebuffer[i];
-
-        std::ifstream romfile_td(splitGt1path + "_td", std::ios::binary | std::ios::in);
-        if(!romfile_td.is_open()) fprintf(stderr, "Cpu::patchTetrisIntoRomTest() : failed to open %s ROM file.\n", std::string(splitGt1path + "_td").c_str());
-        romfile_td.seekg (0, romfile_td.end); filelength = romfile_td.tellg(); romfile_td.seekg (0, romfile_td.beg);
-        romfile_td.read(filebuffer, filelength);
-        if(romfile_td.eof() || romfile_td.bad() || romfile_td.fail()) fprintf(stderr, "Cpu::patchTetrisIntoRomTest() : failed to read %s ROM file.\n", std::string(splitGt1path + "_td").c_str());
-        for(int i=0; i<filelength; i++) _ROM[startAddress + i][ROM_DATA] = filebuffer[i];
-
-        // Replace internal gt1 menu option with split gt1
+        // Replace internal gt1 menu option with a gt1 stored in ROM at startAddress
         _ROM[_internalGt1s[gt1Id]._patch + 0][ROM_DATA] = startAddress & 0x00FF;
         _ROM[_internalGt1s[gt1Id]._patch + 1][ROM_DATA] = (startAddress & 0xFF00) >>8;
 
-        // Replace internal gt1 menu option name with split gt1 name
-        int minLength = std::min(uint8_t(splitGt1name.size()), _internalGt1s[gt1Id]._length);
-        for(int i=0; i<minLength; i++) _ROM[_internalGt1s[gt1Id]._string + i][ROM_DATA] = splitGt1name[i];
+        // Replace internal gt1 menu option name
+        int minLength = std::min(uint8_t(menuName.size()), _internalGt1s[gt1Id]._length);
+        for(int i=0; i<minLength; i++) _ROM[_internalGt1s[gt1Id]._string + i][ROM_DATA] = menuName[i];
         for(int i=minLength; i<_internalGt1s[gt1Id]._length; i++) _ROM[_internalGt1s[gt1Id]._string + i][ROM_DATA] = ' ';
     }
 
+    void patchSplitGt1IntoRom(const std::string& splitGt1path, const std::string& splitGt1name, uint16_t startAddress, InternalGt1Id gt1Id)
+    {
+        // Both halves are mapped and copied straight into the ROM, no intermediate buffer
+        Mapping::File romfile_ti, romfile_td;
+        if(!Mapping::mapFile(splitGt1path + "_ti", romfile_ti)  ||  !Mapping::mapFile(splitGt1path + "_td", romfile_td))
+        {
+            fprintf(stderr, "Cpu::patchSplitGt1IntoRom() : failed to open %s ROM files.\n", splitGt1path.c_str());
+            Mapping::unmapFile(romfile_ti);
+            return;
+        }
 
-#ifndef STAND_ALONE
-    int64_t getClock(void) {return _clock;}
-    uint8_t getIN(void) {return _IN;}
-    uint8_t getXOUT(void) {return _XOUT;}
-    uint8_t getRAM(uint16_t address) {return _RAM[address & (RAM_SIZE-1)];}
-    uint8_t getROM(uint16_t address, int page) {return _ROM[address & (ROM_SIZE-1)][page & 0x01];}
-    uint16_t getRAM16(uint16_t address) {return _RAM[address & (RAM_SIZE-1)] | (_RAM[(address+1) & (RAM_SIZE-1)]<<8);}
-    uint16_t getROM16(uint16_t address, int page) {return _ROM[address & (ROM_SIZE-1)][page & 0x01] | (_ROM[(address+1) & (ROM_SIZE-1)][page & 0x01]<<8);}
-    float getvCpuUtilisation(void) {return _vCpuUtilisation;}
+        if(romfile_ti._size != romfile_td._size  ||  startAddress + romfile_ti._size > ROM_SIZE)
+        {
+            fprintf(stderr, "Cpu::patchSplitGt1IntoRom() : bad sizes %d and %d for %s ROM files at 0x%04X.\n", int(romfile_ti._size), int(romfile_td._size), splitGt1path.c_str(), startAddress);
+            Mapping::unmapFile(romfile_ti);
+            Mapping::unmapFile(romfile_td);
+            return;
+        }
 
+        for(int i=0; i<int(romfile_ti._size); i++)
+        {
+            _ROM[startAddress + i][ROM_INST] = romfile_ti._data[i];
+            _ROM[startAddress + i][ROM_DATA] = romfile_td._data[i];
+        }
+
+        Mapping::unmapFile(romfile_ti);
+        Mapping::unmapFile(romfile_td);
+
+        patchMenuIntoRom(splitGt1name, startAddress, gt1Id);
+    }
 
-    void setClock(int64_t clock) {_clock = clock;}
-    void setIN(uint8_t in) {_IN = in;}
-    void setXOUT(uint8_t xout) {_XOUT = xout;}
+
+    uint8_t getRAM(uint16_t address) {return _RAM[address & (RAM_SIZE-1)];}
+    uint16_t getRAM16(uint16_t address) {return _RAM[address & (RAM_SIZE-1)] | (_RAM[(address+1) & (RAM_SIZE-1)]<<8);}
 
     void setRAM(uint16_t address, uint8_t data)
     {
@@ -210,12 +215,6 @@ namespace Cpu
         _RAM[address & (RAM_SIZE-1)] = data;
     }
 
-    void setROM(uint16_t base, uint16_t address, uint8_t data)
-    {
-        uint16_t offset = (address - base) / 2;
-        _ROM[base + offset][address & 0x01] = data;
-    }
-
     void setRAM16(uint16_t address, uint16_t data)
     {
         // Constant "0" and "1" are stored here
@@ -226,6 +225,103 @@ namespace Cpu
         _RAM[(address+1) & (RAM_SIZE-1)] = uint8_t((data & 0xFF00)>>8);
     }
 
+    State cycle(const State& S)
+    {
+        State T = S; // New state is old state unless something changes
+    
+        T._IR = _ROM[S._PC][ROM_INST]; // Instruction Fetch
+        T._D  = _ROM[S._PC][ROM_DATA];
+    
+        int ins = S._IR >> 5;       // Instruction
+        int mod = (S._IR >> 2) & 7; // Addressing mode (or condition)
+        int bus = S._IR&3;          // Busmode
+        int W = (ins == 6);        // Write instruction?
+        int J = (ins == 7);        // Jump instruction?
+    
+        uint8_t lo=S._D, hi=0, *to=NULL; // Mode Decoder
+        int incX=0;
+        if(!J)
+        {
+            switch (mod)
+            {
+                #define E(p) (W?0:p) // Disable _AC and _OUT loading during _RAM write
+                case 0: to=E(&T._AC);                            break;
+                case 1: to=E(&T._AC); lo=S._X;                   break;
+                case 2: to=E(&T._AC);         hi=S._Y;           break;
+                case 3: to=E(&T._AC); lo=S._X; hi=S._Y;          break;
+                case 4: to=  &T._X;                              break;
+                case 5: to=  &T._Y;                              break;
+                case 6: to=E(&T._OUT);                           break;
+                case 7: to=E(&T._OUT); lo=S._X; hi=S._Y; incX=1; break;
+            }
+        }
+
+        uint16_t addr = (hi << 8) | lo;
+        int B = S._undef; // Data Bus
+        switch(bus)
+        {
+            case 0: B=S._D;                              break;
+            case 1: if (!W) B = _RAM[addr&(RAM_SIZE-1)]; break;
+            case 2: B=S._AC;                             break;
+            case 3: B=_IN;                               break;
+        }
+
+        if(W) _RAM[addr&(RAM_SIZE-1)] = B; // Random Access Memory
+
+        uint8_t ALU; // Arithmetic and Logic Unit
+        switch(ins)
+        {
+            case 0: ALU =        B; break; // LD
+            case 1: ALU = S._AC & B; break; // ANDA
+            case 2: ALU = S._AC | B; break; // ORA
+            case 3: ALU = S._AC ^ B; break; // XORA
+            case 4: ALU = S._AC + B; break; // ADDA
+            case 5: ALU = S._AC - B; break; // SUBA
+            case 6: ALU = S._AC;     break; // ST
+            case 7: ALU = -S._AC;    break; // Bcc/JMP
+        }
+
+        if(to) *to = ALU; // Load value into register
+        if(incX) T._X = S._X + 1; // Increment _X
+
+        T._PC = S._PC + 1; // Next instruction
+        if(J)
+        {
+            if(mod != 0) // Conditional branch within page
+            {
+                int cond = (S._AC>>7) + 2*(S._AC==0);
+                if (mod & (1 << cond)) // 74153
+                T._PC = (S._PC & 0xff00) | B;
+            }
+            else
+            {
+                T._PC = (S._Y << 8) | B; // Unconditional far jump
+            }
+        }
+
+        return T;
+    }
+
+
+#ifndef STAND_ALONE
+    int64_t getClock(void) {return _clock;}
+    uint8_t getIN(void) {return _IN;}
+    uint8_t getXOUT(void) {return _XOUT;}
+    uint8_t getROM(uint16_t address, int page) {return _ROM[address & (ROM_SIZE-1)][page & 0x01];}
+    uint16_t getROM16(uint16_t address, int page) {return _ROM[address & (ROM_SIZE-1)][page & 0x01] | (_ROM[(address+1) & (ROM_SIZE-1)][page & 0x01]<<8);}
+    float getvCpuUtilisation(void) {return _vCpuUtilisation;}
+
+
+    void setClock(int64_t clock) {_clock = clock;}
+    void setIN(uint8_t in) {_IN = in;}
+    void setXOUT(uint8_t xout) {_XOUT = xout;}
+
+    void setROM(uint16_t base, uint16_t address, uint8_t data)
+    {
+        uint16_t offset = (address - base) / 2;
+        _ROM[base + offset][address & 0x01] = data;
+    }
+
     void setROM16(uint16_t base, uint16_t address, uint16_t data)
     {
         uint16_t offset = (address - base) / 2;
@@ -381,83 +477,6 @@ namespace Cpu
         }
     }
 
-    State cycle(const State& S)
-    {
-        State T = S; // New state is old state unless something changes
-    
-        T._IR = _ROM[S._PC][ROM_INST]; // Instruction Fetch
-        T._D  = _ROM[S._PC][ROM_DATA];
-    
-        int ins = S._IR >> 5;       // Instruction
-        int mod = (S._IR >> 2) & 7; // Addressing mode (or condition)
-        int bus = S._IR&3;          // Busmode
-        int W = (ins == 6);        // Write instruction?
-        int J = (ins == 7);        // Jump instruction?
-    
-        uint8_t lo=S._D, hi=0, *to=NULL; // Mode Decoder
-        int incX=0;
-        if(!J)
-        {
-            switch (mod)
-            {
-                #define E(p) (W?0:p) // Disable _AC and _OUT loading during _RAM write
-                case 0: to=E(&T._AC);                            break;
-                case 1: to=E(&T._AC); lo=S._X;                   break;
-                case 2: to=E(&T._AC);         hi=S._Y;           break;
-                case 3: to=E(&T._AC); lo=S._X; hi=S._Y;          break;
-                case 4: to=  &T._X;                              break;
-                case 5: to=  &T._Y;                              break;
-                case 6: to=E(&T._OUT);                           break;
-                case 7: to=E(&T._OUT); lo=S._X; hi=S._Y; incX=1; break;
-            }
-        }
-
-        uint16_t addr = (hi << 8) | lo;
-        int B = S._undef; // Data Bus
-        switch(bus)
-        {
-            case 0: B=S._D;                              break;
-            case 1: if (!W) B = _RAM[addr&(RAM_SIZE-1)]; break;
-            case 2: B=S._AC;                             break;
-            case 3: B=_IN;                               break;
-        }
-
-        if(W) _RAM[addr&(RAM_SIZE-1)] = B; // Random Access Memory
-
-        uint8_t ALU; // Arithmetic and Logic Unit
-        switch(ins)
-        {
-            case 0: ALU =        B; break; // LD
-            case 1: ALU = S._AC & B; break; // ANDA
-            case 2: ALU = S._AC | B; break; // ORA
-            case 3: ALU = S._AC ^ B; break; // XORA
-            case 4: ALU = S._AC + B; break; // ADDA
-            case 5: ALU = S._AC - B; break; // SUBA
-            case 6: ALU = S._AC;     break; // ST
-            case 7: ALU = -S._AC;    break; // Bcc/JMP
-        }
-
-        if(to) *to = ALU; // Load value into register
-        if(incX) T._X = S._X + 1; // Increment _X
-
-        T._PC = S._PC + 1; // Next instruction
-        if(J)
-        {
-            if(mod != 0) // Conditional branch within page
-            {
-                int cond = (S._AC>>7) + 2*(S._AC==0);
-                if (mod & (1 << cond)) // 74153
-                T._PC = (S._PC & 0xff00) | B;
-            }
-            else
-            {
-                T._PC = (S._Y << 8) | B; // Unconditional far jump
-            }
-        }
-
-        return T;
-    }
-
     void reset(bool coldBoot)
     {
         // Cold boot
@@ -472,12 +491,16 @@ namespace Cpu
         setClock(CLOCK_RESET);
     }
 
-    // Counts maximum and used vCPU instruction slots available per frame
+    // Counts maximum and used vCPU instruction slots available per frame, dispatch also triggers gprintfs
     void vCpuUsage(State& S)
     {
         if(S._PC == ROM_VCPU_DISPATCH)
         {
             uint16_t vPC = (getRAM(0x0017) <<8) |getRAM(0x0016);
+
+            // Gprintfs
+            Assembler::printGprintfStrings(vPC);
+
             if(vPC < Editor::getCpuUsageAddressA()  ||  vPC > Editor::getCpuUsageAddressB()) _vCpuInstPerFrame++;
             _vCpuInstPerFrameMax++;
 
@@ -63,6 +63,7 @@ namespace Cpu
     uint16_t getBaseFreeRAM(void);
     uint16_t getFreeRAM(void);
     uint8_t* getPtrToROM(int& romSize);
+    InternalGt1 getInternalGt1(InternalGt1Id gt1Id);
 
     void setFreeRAM(uint16_t freeRAM);
 
@@ -72,29 +73,33 @@ namespace Cpu
     void patchScanlineModeVideoB(void);
     void patchScanlineModeVideoC(void);
     void patchTitleIntoRom(const std::string& title);
+    void patchMenuIntoRom(const std::string& menuName, uint16_t startAddress, InternalGt1Id gt1Id);
     void patchSplitGt1IntoRom(const std::string& splitGt1path, const std::string& splitGt1name, uint16_t startAddress, InternalGt1Id gt1Id);
 
+    uint8_t getRAM(uint16_t address);
+    uint16_t getRAM16(uint16_t address);
+
+    void setRAM(uint16_t address, uint8_t data);
+    void setRAM16(uint16_t address, uint16_t data);
+
+    State cycle(const State& S);
+
 #ifndef STAND_ALONE
     int64_t getClock(void);
     uint8_t getIN(void);
     uint8_t getXOUT(void);
-    uint8_t getRAM(uint16_t address);
     uint8_t getROM(uint16_t address, int page);
-    uint16_t getRAM16(uint16_t address);
     uint16_t getROM16(uint16_t address, int page);
     float getvCpuUtilisation(void);
 
     void setClock(int64_t clock);
     void setIN(uint8_t in);
     void setXOUT(uint8_t xout);
-    void setRAM(uint16_t address, uint8_t data);
     void setROM(uint16_t base, uint16_t address, uint8_t data);
-    void setRAM16(uint16_t address, uint16_t data);
     void setROM16(uint16_t base, uint16_t address, uint16_t data);
     void setScanlineMode(ScanlineMode scanlineMode);
 
     void initialise(State& S);
-    State cycle(const State& S);
     void reset(bool coldBoot=false);
     void vCpuUsage(State& S);
 #endif
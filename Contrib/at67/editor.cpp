@@ -684,6 +684,7 @@ namespace Editor
 
         else if(_sdlKeyCode == _inputKeys["Quit"])
         {
+            Loader::shutdown();
             SDL_Quit();
             exit(0);
         }
@@ -872,9 +873,6 @@ namespace Editor
     // Debug mode, handles it's own input and rendering
     bool singleStepDebug(void)
     {
-        // Gprintfs
-        Assembler::printGprintfStrings();
-
         // Single step
         if(_singleStep)
         {
@@ -976,6 +974,7 @@ namespace Editor
                 case SDL_KEYUP:      handleKeyUp();           break;
                 case SDL_QUIT: 
                 {
+                    Loader::shutdown();
                     SDL_Quit();
                     exit(0);
                 }
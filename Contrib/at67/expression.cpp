@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
 #include <string>
 #include <algorithm>
 
@@ -8,18 +9,25 @@
 
 namespace Expression
 {
-    char* _expressionToParse;
-    char* _expression;
+    // Parser state is per thread, so that assemblers on different threads can evaluate expressions concurrently
+    thread_local char* _expressionToParse;
+    thread_local char* _expression;
 
     bool _binaryChars[256]      = {false};
     bool _octalChars[256]       = {false};
     bool _decimalChars[256]     = {false};
     bool _hexaDecimalChars[256] = {false};
+    bool _symbolChars[256]      = {false};
 
-    int _lineNumber = 0;
+    thread_local int _lineNumber = 0;
+    thread_local Tree* _tree = nullptr;
+    thread_local bool _compiled = true;
 
+    // Messages go to stderr unless the calling thread collects them
+    thread_local std::string* _output = nullptr;
 
-    uint16_t expression(void);
+
+    int expression(void);
 
 
     void initialise(void)
@@ -28,6 +36,41 @@ namespace Expression
         bool* o = _octalChars;       o['0']=1; o['1']=1; o['2']=1; o['3']=1; o['4']=1; o['5']=1; o['6']=1; o['7']=1;
         bool* d = _decimalChars;     d['0']=1; d['1']=1; d['2']=1; d['3']=1; d['4']=1; d['5']=1; d['6']=1; d['7']=1; d['8']=1; d['9']=1;
         bool* h = _hexaDecimalChars; h['0']=1; h['1']=1; h['2']=1; h['3']=1; h['4']=1; h['5']=1; h['6']=1; h['7']=1; h['8']=1; h['9']=1; h['A']=1; h['B']=1; h['C']=1; h['D']=1; h['E']=1; h['F']=1;
+
+        // Symbols are delimited by operators, punctuation and white space
+        const char* separators = "+-*/().,!?;#'\"[] \t\n\r\v\f";
+        for(int i=1; i<256; i++) _symbolChars[i] = true;
+        for(int i=0; separators[i]; i++) _symbolChars[uint8_t(separators[i])] = false;
+    }
+
+    void setOutput(std::string* output)
+    {
+        _output = output;
+    }
+
+    void print(const char* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        if(_output == nullptr)
+        {
+            vfprintf(stderr, format, args);
+            va_end(args);
+            return;
+        }
+
+        va_list sizeArgs;
+        va_copy(sizeArgs, args);
+        int length = vsnprintf(nullptr, 0, format, sizeArgs);
+        va_end(sizeArgs);
+        if(length > 0)
+        {
+            size_t start = _output->size();
+            _output->resize(start + length + 1);
+            vsnprintf(&(*_output)[start], length + 1, format, args);
+            _output->resize(start + length);
+        }
+        va_end(args);
     }
 
     ExpressionType isExpression(const std::string& input)
@@ -39,6 +82,11 @@ namespace Expression
         return None;
     }
 
+    bool isSymbolChar(char chr)
+    {
+        return _symbolChars[uint8_t(chr)];
+    }
+
     std::string& strToUpper(std::string& s)
     {
         std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) {return toupper(c);} );
@@ -159,26 +207,81 @@ namespace Expression
         return stringToU16(valueStr, value);
     }
 
-    uint16_t factor(void)
+    uint16_t applyOperator(Node::Type type, uint16_t left, uint16_t right)
+    {
+        switch(type)
+        {
+            case Node::Negate: return uint16_t(-left);
+            case Node::Add:    return uint16_t(left + right);
+            case Node::Sub:    return uint16_t(left - right);
+            case Node::Mul:    return uint16_t(left * right);
+            case Node::Div:
+            {
+                if(right == 0)
+                {
+                    print("Expression::applyOperator() : Division by zero in '%s' on line %d\n", _expressionToParse, _lineNumber + 1);
+                    return 0;
+                }
+                return uint16_t(left / right);
+            }
+
+            default: break;
+        }
+
+        return left;
+    }
+
+    int addNumber(uint16_t value)
+    {
+        Node node;
+        node._value = value;
+        _tree->_nodes.push_back(node);
+        return int(_tree->_nodes.size()) - 1;
+    }
+
+    // Operators on constant children are evaluated immediately, children are always the last nodes built so they are simply replaced
+    int addOperator(Node::Type type, int left, int right=-1)
+    {
+        std::vector<Node>& nodes = _tree->_nodes;
+        if(nodes[left]._type == Node::Number  &&  (right == -1  ||  nodes[right]._type == Node::Number))
+        {
+            uint16_t value = applyOperator(type, nodes[left]._value, (right == -1) ? 0 : nodes[right]._value);
+            nodes.resize(left);
+            return addNumber(value);
+        }
+
+        Node node;
+        node._type = type;
+        node._left = left;
+        node._right = right;
+        nodes.push_back(node);
+        return int(nodes.size()) - 1;
+    }
+
+    int factor(void)
     {
         uint16_t value = 0;
         if((peek() >= '0'  &&  peek() <= '9')  ||  peek() == '$')
         {
             if(!number(value))
             {
-                fprintf(stderr, "Expression::factor() : Bad numeric data in '%s' on line %d\n", _expressionToParse, _lineNumber + 1);
+                print("Expression::factor() : Bad numeric data in '%s' on line %d\n", _expressionToParse, _lineNumber + 1);
+                _compiled = false;
                 value = 0;
             }
-            return value;
+            return addNumber(value);
         }
         else if(peek() == '(')
         {
             get();
-            uint16_t result = expression();
+            size_t start = _tree->_nodes.size();
+            int result = expression();
             if(peek() != ')')
             {
-                fprintf(stderr, "Expression::factor() : Expecting ')' : found '%c' in '%s' on line %d\n", peek(), _expressionToParse, _lineNumber + 1);
-                result = 0;
+                print("Expression::factor() : Expecting ')' : found '%c' in '%s' on line %d\n", peek(), _expressionToParse, _lineNumber + 1);
+                _compiled = false;
+                _tree->_nodes.resize(start);
+                result = addNumber(0);
             }
             get();
             return result;
@@ -186,41 +289,116 @@ namespace Expression
         else if(peek() == '-')
         {
             get();
-            return -factor();
+            return addOperator(Node::Negate, factor());
+        }
+        else if(peek()  &&  isSymbolChar(peek()))
+        {
+            Node node;
+            node._type = Node::Symbol;
+            while(peek()  &&  isSymbolChar(peek())) node._symbol.push_back(get());
+            _tree->_nodes.push_back(node);
+            return int(_tree->_nodes.size()) - 1;
         }
 
-        fprintf(stderr, "Expression::factor() : Unknown character '%c' in '%s' on line %d\n", peek(), _expressionToParse, _lineNumber + 1);
-        return 0;
+        print("Expression::factor() : Unknown character '%c' in '%s' on line %d\n", peek(), _expressionToParse, _lineNumber + 1);
+        _compiled = false;
+        return addNumber(0);
     }
 
-    uint16_t term(void)
+    int term(void)
     {
-        uint16_t result = factor();
+        int result = factor();
         while(peek() == '*'  ||  peek() == '/')
         {
-            (get() == '*') ? result *= factor() : result /= factor();
+            Node::Type type = (get() == '*') ? Node::Mul : Node::Div;
+            result = addOperator(type, result, factor());
         }
 
         return result;
     }
 
-    uint16_t expression(void)
+    int expression(void)
     {
-        uint16_t result = term();
+        int result = term();
         while(peek() == '+' || peek() == '-')
         {
-            (get() == '+') ? result += term() : result -= term();
+            Node::Type type = (get() == '+') ? Node::Add : Node::Sub;
+            result = addOperator(type, result, term());
         }
 
         return result;
     }
 
-    uint16_t parse(char* expressionToParse, int lineNumber)
+    bool compile(const std::string& input, Tree& tree, int lineNumber)
     {
-        _expressionToParse = expressionToParse;
-        _expression = expressionToParse;
+        tree = Tree();
+        tree._text = input;
+        tree._text.erase(std::remove_if(tree._text.begin(), tree._text.end(), isspace), tree._text.end());
+
+        _tree = &tree;
+        _compiled = true;
+        _expressionToParse = &tree._text[0];
+        _expression = _expressionToParse;
         _lineNumber = lineNumber;
 
-        return expression();
+        tree._root = expression();
+        _tree = nullptr;
+
+        return _compiled;
+    }
+
+    bool evaluateNode(const Tree& tree, int index, const SymbolResolver& resolver, uint16_t& value)
+    {
+        const Node& node = tree._nodes[index];
+        switch(node._type)
+        {
+            case Node::Number: value = node._value; return true;
+
+            case Node::Symbol:
+            {
+                if(resolver  &&  resolver(node._symbol, value)) return true;
+
+                print("Expression::evaluate() : Unknown symbol '%s' in '%s' on line %d\n", node._symbol.c_str(), tree._text.c_str(), _lineNumber + 1);
+                value = 0;
+                return false;
+            }
+
+            default: break;
+        }
+
+        uint16_t left = 0, right = 0;
+        bool success = evaluateNode(tree, node._left, resolver, left);
+        if(node._right != -1) success &= evaluateNode(tree, node._right, resolver, right);
+
+        _expressionToParse = (char*)tree._text.c_str();
+        value = applyOperator(node._type, left, right);
+        return success;
+    }
+
+    bool evaluate(const Tree& tree, const SymbolResolver& resolver, uint16_t& value, int lineNumber)
+    {
+        _lineNumber = lineNumber;
+
+        value = 0;
+        if(tree._root == -1) return false;
+
+        // Expressions with unknown symbols evaluate to zero
+        if(!evaluateNode(tree, tree._root, resolver, value))
+        {
+            value = 0;
+            return false;
+        }
+
+        return true;
+    }
+
+    uint16_t parse(char* expressionToParse, int lineNumber)
+    {
+        Tree tree;
+        compile(std::string(expressionToParse), tree, lineNumber);
+
+        uint16_t value;
+        evaluate(tree, nullptr, value, lineNumber);
+        return value;
     }
-}
\ No newline at end of file
+}
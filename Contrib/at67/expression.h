@@ -1,16 +1,48 @@
 #ifndef EXPRESSION_H
 #define EXPRESSION_H
 
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <functional>
+
 
 namespace Expression
 {
     enum ExpressionType {Invalid=-1, None, Valid};
     enum NumericType {BadBase=-1, Decimal, HexaDecimal, Octal, Binary};
 
+    struct Node
+    {
+        enum Type {Number=0, Symbol, Negate, Add, Sub, Mul, Div};
+
+        Type _type = Number;
+        uint16_t _value = 0;
+        int _left = -1;
+        int _right = -1;
+        std::string _symbol;
+    };
+
+    // Compiled expression, constant sub-trees are folded into single number nodes when compiled
+    struct Tree
+    {
+        int _root = -1;
+        std::string _text;
+        std::vector<Node> _nodes;
+    };
+
+    // Returns false for unknown symbols
+    typedef std::function<bool (const std::string& symbol, uint16_t& value)> SymbolResolver;
+
 
     void initialise(void);
 
+    // Collects the calling thread's messages, from expressions and the assembler, into output instead of stderr, nullptr restores stderr
+    void setOutput(std::string* output);
+    void print(const char* format, ...);
+
     ExpressionType isExpression(const std::string& input);
+    bool isSymbolChar(char chr);
 
     std::string& strToUpper(std::string& s);
 
@@ -18,6 +50,8 @@ namespace Expression
     bool stringToU8(const std::string& token, uint8_t& result);
     bool stringToU16(const std::string& token, uint16_t& result);
 
+    bool compile(const std::string& input, Tree& tree, int lineNumber);
+    bool evaluate(const Tree& tree, const SymbolResolver& resolver, uint16_t& value, int lineNumber);
     uint16_t parse(char* expressionToParse, int lineNumber);
 }
 
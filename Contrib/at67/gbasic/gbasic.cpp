@@ -0,0 +1,1744 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#include "../editor.h"
+#include "gbexpr.h"
+#include "gbasic.h"
+
+
+namespace GBasic
+{
+    // Runtime routines are leaf code unless they call other routines, which they do through address slots in zero page,
+    // inputs are set by the caller, state keeps its value between calls, everything else is scratch that is free between calls
+    struct Routine
+    {
+        std::string _name;
+        std::vector<std::string> _calls;
+        std::vector<std::string> _inputs;
+        std::vector<std::string> _state;
+        std::vector<std::pair<std::string, int>> _vars;
+        std::vector<Instruction> _code;
+    };
+
+    struct ForLoop
+    {
+        std::string _var;
+        std::string _label;
+        std::string _end;
+        int _step;
+    };
+
+
+    std::map<std::string, int> _opcodeSizes;
+    std::vector<Routine> _routines;
+
+    std::string _filename;
+    int _lineNumber = 0;
+    int _labelIndex = 0;
+    int _temps = 0;
+
+    Block* _block = nullptr;
+    std::vector<Block> _blocks;
+    std::vector<Block> _data;
+    std::vector<Region> _regions;
+    std::vector<ForLoop> _forLoops;
+
+    std::vector<std::string> _vars;
+    std::vector<std::pair<std::string, int>> _zeroPage;
+    std::map<std::string, uint16_t> _zeroPageAddresses;
+    std::set<std::string> _usedRoutines;
+    std::map<std::string, std::string> _strings;
+    std::set<int> _lines;
+    std::vector<std::pair<int, int>> _targets;
+    std::map<std::string, std::string> _aliases;
+
+    std::map<std::string, int> _varWeights;
+    std::map<std::string, int> _scratch;
+    std::map<std::string, std::set<std::string>> _interference;
+    std::vector<std::string> _spills;
+
+
+    void initialise(void)
+    {
+        const char* bytes1[] = {"PEEK", "DEEK", "LSLW", "RET", "PUSH", "POP"};
+        const char* bytes2[] = {"LD", "LDW", "STW", "ST", "LDI", "ADDW", "ADDI", "SUBW", "SUBI", "ANDI", "ANDW", "ORI", "ORW", "XORI", "XORW",
+                                "INC", "CALL", "POKE", "DOKE", "LUP", "SYS", "BRA", "ALLOC"};
+        const char* bytes3[] = {"LDWI", "BEQ", "BNE", "BLT", "BGT", "BLE", "BGE"};
+        for(auto opcode : bytes1) _opcodeSizes[opcode] = 1;
+        for(auto opcode : bytes2) _opcodeSizes[opcode] = 2;
+        for(auto opcode : bytes3) _opcodeSizes[opcode] = 3;
+
+        _routines.clear();
+        _routines.push_back({"gosub", {}, {}, {}, {}, {
+            {"gosub",           "PUSH",   "",                  "return address to the stack, vAC is the target line"},
+            {"",                "CALL",   "vAC",               ""}}});
+
+        _routines.push_back({"cls", {}, {}, {"_cursorXY"}, {}, {
+            {"cls",             "LDWI",   "SYS_VDrawBits_134", ""},
+            {"",                "STW",    "giga_sysFn",        ""},
+            {"",                "LDI",    "0x00",              ""},
+            {"",                "STW",    "giga_sysArg0",      "background and foreground colours"},
+            {"",                "ST",     "giga_sysArg2",      ""},
+            {"",                "LDWI",   "giga_vram",         ""},
+            {"",                "STW",    "_cursorXY",         ""},
+            {"",                "STW",    "giga_sysArg4",      ""},
+            {"cls_loop",        "SYS",    "0xCB",              "8 vertical pixels, 270 - 134/2 = 0xCB"},
+            {"",                "INC",    "giga_sysArg4",      ""},
+            {"",                "LD",     "giga_sysArg4",      ""},
+            {"",                "SUBI",   "giga_xres",         ""},
+            {"",                "BLT",    "cls_loop",          ""},
+            {"",                "ST",     "giga_sysArg4",      "x = 0"},
+            {"",                "LD",     "giga_sysArg5",      ""},
+            {"",                "ADDI",   "0x08",              ""},
+            {"",                "ST",     "giga_sysArg5",      ""},
+            {"",                "SUBI",   "0x80",              ""},
+            {"",                "BLT",    "cls_loop",          ""},
+            {"",                "RET",    "",                  ""}}});
+
+        _routines.push_back({"newLine", {}, {}, {"_cursorXY"}, {}, {
+            {"newLine",         "LDI",    "0x00",              ""},
+            {"",                "ST",     "_cursorXY",         ""},
+            {"",                "LD",     "_cursorXY+1",       ""},
+            {"",                "ADDI",   "0x08",              ""},
+            {"",                "ST",     "_cursorXY+1",       ""},
+            {"",                "SUBI",   "0x80",              ""},
+            {"",                "BLT",    "newLine_clear",     ""},
+            {"",                "LDI",    "0x08",              "wrap around to the top of the screen"},
+            {"",                "ST",     "_cursorXY+1",       ""},
+            {"newLine_clear",   "LDWI",   "SYS_VDrawBits_134", ""},
+            {"",                "STW",    "giga_sysFn",        ""},
+            {"",                "LDI",    "0x00",              ""},
+            {"",                "STW",    "giga_sysArg0",      ""},
+            {"",                "ST",     "giga_sysArg2",      ""},
+            {"",                "LDW",    "_cursorXY",         ""},
+            {"",                "STW",    "giga_sysArg4",      ""},
+            {"newLine_loop",    "SYS",    "0xCB",              "clear the new row"},
+            {"",                "INC",    "giga_sysArg4",      ""},
+            {"",                "LD",     "giga_sysArg4",      ""},
+            {"",                "SUBI",   "giga_xres",         ""},
+            {"",                "BLT",    "newLine_loop",      ""},
+            {"",                "RET",    "",                  ""}}});
+
+        _routines.push_back({"printChar", {"newLine"}, {}, {"_cursorXY"}, {{"_pcFont", 2}, {"_pcSlice", 2}, {"_pcCount", 1}}, {
+            {"printChar",       "SUBI",   "32",                "(char - 32)*5 + 0x0700"},
+            {"",                "STW",    "_pcFont",           ""},
+            {"",                "LSLW",   "",                  ""},
+            {"",                "LSLW",   "",                  ""},
+            {"",                "ADDW",   "_pcFont",           ""},
+            {"",                "STW",    "_pcSlice",          ""},
+            {"",                "LDW",    "_pcFont",           ""},
+            {"",                "SUBI",   "50",                ""},
+            {"",                "BLT",    "printChar_text32",  ""},
+            {"",                "LDI",    "0x06",              "chars 82+ start on the next page"},
+            {"",                "ADDW",   "_pcSlice",          ""},
+            {"",                "STW",    "_pcSlice",          ""},
+            {"printChar_text32","LDWI",   "giga_text32",       ""},
+            {"",                "ADDW",   "_pcSlice",          ""},
+            {"",                "STW",    "_pcSlice",          ""},
+            {"",                "LDWI",   "SYS_VDrawBits_134", ""},
+            {"",                "STW",    "giga_sysFn",        ""},
+            {"",                "LDWI",   "0x3F00",            "white on black"},
+            {"",                "STW",    "giga_sysArg0",      ""},
+            {"",                "LDW",    "_cursorXY",         ""},
+            {"",                "STW",    "giga_sysArg4",      ""},
+            {"",                "LDI",    "0x05",              ""},
+            {"",                "ST",     "_pcCount",          ""},
+            {"printChar_slice", "LDW",    "_pcSlice",          ""},
+            {"",                "LUP",    "0x00",              "get ROM slice"},
+            {"",                "ST",     "giga_sysArg2",      ""},
+            {"",                "SYS",    "0xCB",              "8 vertical pixels, 270 - 134/2 = 0xCB"},
+            {"",                "INC",    "_pcSlice",          ""},
+            {"",                "INC",    "giga_sysArg4",      ""},
+            {"",                "LD",     "_pcCount",          ""},
+            {"",                "SUBI",   "0x01",              ""},
+            {"",                "ST",     "_pcCount",          ""},
+            {"",                "BGT",    "printChar_slice",   ""},
+            {"",                "SYS",    "0xCB",              "the SYS call shifted the slice out, blank column"},
+            {"",                "LD",     "_cursorXY",         ""},
+            {"",                "ADDI",   "0x06",              ""},
+            {"",                "ST",     "_cursorXY",         ""},
+            {"",                "SUBI",   std::to_string(GBASIC_PRINT_COLUMNS*6), ""},
+            {"",                "BGE",    "printChar_wrap",    ""},
+            {"",                "RET",    "",                  ""},
+            {"printChar_wrap",  "PUSH",   "",                  ""},
+            {"",                "CALL",   "_newLine",          ""},
+            {"",                "POP",    "",                  ""},
+            {"",                "RET",    "",                  ""}}});
+
+        _routines.push_back({"printText", {"printChar"}, {}, {}, {{"_ptText", 2}, {"_ptCount", 1}}, {
+            {"printText",       "PUSH",   "",                  "vAC points to a length prefixed string"},
+            {"",                "STW",    "_ptText",           ""},
+            {"",                "PEEK",   "",                  ""},
+            {"",                "BEQ",    "printText_done",    "empty string"},
+            {"",                "ST",     "_ptCount",          ""},
+            {"printText_loop",  "INC",    "_ptText",           "strings never cross a page"},
+            {"",                "LDW",    "_ptText",           ""},
+            {"",                "PEEK",   "",                  ""},
+            {"",                "CALL",   "_printChar",        ""},
+            {"",                "LD",     "_ptCount",          ""},
+            {"",                "SUBI",   "0x01",              ""},
+            {"",                "ST",     "_ptCount",          ""},
+            {"",                "BGT",    "printText_loop",    ""},
+            {"printText_done",  "POP",    "",                  ""},
+            {"",                "RET",    "",                  ""}}});
+
+        _routines.push_back({"printDigit", {"printChar"}, {}, {}, {{"_piValue", 2}, {"_piDivisor", 2}, {"_piDigit", 1}, {"_piZeros", 2}}, {
+            {"printDigit",      "STW",    "_piDivisor",        ""},
+            {"",                "LDI",    "48",                ""},
+            {"",                "ST",     "_piDigit",          ""},
+            {"printDigit_loop", "LDW",    "_piValue",          ""},
+            {"",                "SUBW",   "_piDivisor",        ""},
+            {"",                "BLT",    "printDigit_done",   ""},
+            {"",                "STW",    "_piValue",          ""},
+            {"",                "INC",    "_piDigit",          ""},
+            {"",                "BRA",    "printDigit_loop",   ""},
+            {"printDigit_done", "LD",     "_piDigit",          ""},
+            {"",                "SUBI",   "48",                ""},
+            {"",                "ORW",    "_piZeros",          ""},
+            {"",                "BEQ",    "printDigit_skip",   "leading zero"},
+            {"",                "STW",    "_piZeros",          ""},
+            {"",                "PUSH",   "",                  ""},
+            {"",                "LD",     "_piDigit",          ""},
+            {"",                "CALL",   "_printChar",        ""},
+            {"",                "POP",    "",                  ""},
+            {"printDigit_skip", "RET",    "",                  ""}}});
+
+        _routines.push_back({"printInt", {"printChar", "printDigit"}, {}, {}, {{"_piValue", 2}, {"_piZeros", 2}}, {
+            {"printInt",        "PUSH",   "",                  ""},
+            {"",                "STW",    "_piValue",          ""},
+            {"",                "BGE",    "printInt_pos",      ""},
+            {"",                "LDI",    "45",                "'-'"},
+            {"",                "CALL",   "_printChar",        ""},
+            {"",                "LDI",    "0x00",              ""},
+            {"",                "SUBW",   "_piValue",          "-32768 stays 0x8000, printDigit's SUBW 10000 still takes it to 22768"},
+            {"",                "STW",    "_piValue",          ""},
+            {"printInt_pos",    "LDI",    "0x00",              ""},
+            {"",                "STW",    "_piZeros",          ""},
+            {"",                "LDWI",   "10000",             ""},
+            {"",                "CALL",   "_printDigit",       ""},
+            {"",                "LDWI",   "1000",              ""},
+            {"",                "CALL",   "_printDigit",       ""},
+            {"",                "LDI",    "100",               ""},
+            {"",                "CALL",   "_printDigit",       ""},
+            {"",                "LDI",    "10",                ""},
+            {"",                "CALL",   "_printDigit",       ""},
+            {"",                "LD",     "_piValue",          "units are always printed"},
+            {"",                "ADDI",   "48",                ""},
+            {"",                "CALL",   "_printChar",        ""},
+            {"",                "POP",    "",                  ""},
+            {"",                "RET",    "",                  ""}}});
+
+        _routines.push_back({"multiply", {}, {"_mathX", "_mathY"}, {}, {{"_mathX", 2}, {"_mathY", 2}, {"_mathRem", 2}, {"_mathBit", 2}}, {
+            {"multiply",        "LDI",    "0x00",              "vAC = mathX * mathY, shift and add"},
+            {"",                "STW",    "_mathRem",          ""},
+            {"",                "LDI",    "0x01",              ""},
+            {"",                "STW",    "_mathBit",          ""},
+            {"multiply_loop",   "LDW",    "_mathY",            ""},
+            {"",                "ANDW",   "_mathBit",          ""},
+            {"",                "BEQ",    "multiply_skip",     ""},
+            {"",                "LDW",    "_mathRem",          ""},
+            {"",                "ADDW",   "_mathX",            ""},
+            {"",                "STW",    "_mathRem",          ""},
+            {"multiply_skip",   "LDW",    "_mathX",            ""},
+            {"",                "LSLW",   "",                  ""},
+            {"",                "STW",    "_mathX",            ""},
+            {"",                "LDW",    "_mathBit",          ""},
+            {"",                "LSLW",   "",                  ""},
+            {"",                "STW",    "_mathBit",          ""},
+            {"",                "BNE",    "multiply_loop",     ""},
+            {"",                "LDW",    "_mathRem",          ""},
+            {"",                "RET",    "",                  ""}}});
+
+        _routines.push_back({"divideU", {}, {"_mathX", "_mathY"}, {}, {{"_mathX", 2}, {"_mathY", 2}, {"_mathRem", 2}, {"_mathBit", 2}}, {
+            {"divideU",         "LDI",    "0x00",              "mathX = mathX / mathY, mathRem = mathX % mathY, unsigned"},
+            {"",                "STW",    "_mathRem",          ""},
+            {"",                "LDI",    "16",                ""},
+            {"",                "ST",     "_mathBit",          ""},
+            {"divideU_loop",    "LDW",    "_mathRem",          ""},
+            {"",                "LSLW",   "",                  ""},
+            {"",                "STW",    "_mathRem",          ""},
+            {"",                "LDW",    "_mathX",            ""},
+            {"",                "BGE",    "divideU_shift",     ""},
+            {"",                "INC",    "_mathRem",          "top bit of mathX into mathRem"},
+            {"divideU_shift",   "LSLW",   "",                  ""},
+            {"",                "STW",    "_mathX",            ""},
+            {"",                "LDW",    "_mathRem",          ""},
+            {"",                "SUBW",   "_mathY",            "mathRem < 2*mathY, so the sign is the unsigned compare"},
+            {"",                "BLT",    "divideU_next",      ""},
+            {"",                "STW",    "_mathRem",          ""},
+            {"",                "INC",    "_mathX",            "quotient bit"},
+            {"divideU_next",    "LD",     "_mathBit",          ""},
+            {"",                "SUBI",   "0x01",              ""},
+            {"",                "ST",     "_mathBit",          ""},
+            {"",                "BGT",    "divideU_loop",      ""},
+            {"",                "RET",    "",                  ""}}});
+
+        _routines.push_back({"divide", {"divideU"}, {"_mathX", "_mathY"}, {}, {{"_mathX", 2}, {"_mathY", 2}, {"_mathRem", 2}, {"_mathSign", 1}}, {
+            {"divide",          "PUSH",   "",                  "vAC = mathX / mathY, mathRem = mathX % mathY, signed"},
+            {"",                "LDI",    "0x00",              ""},
+            {"",                "ST",     "_mathSign",         ""},
+            {"",                "LDW",    "_mathX",            ""},
+            {"",                "BGE",    "divide_x",          ""},
+            {"",                "LDI",    "0x00",              ""},
+            {"",                "SUBW",   "_mathX",            ""},
+            {"",                "STW",    "_mathX",            ""},
+            {"",                "LDI",    "0x03",              "negate quotient and remainder"},
+            {"",                "ST",     "_mathSign",         ""},
+            {"divide_x",        "LDW",    "_mathY",            ""},
+            {"",                "BGE",    "divide_y",          ""},
+            {"",                "LDI",    "0x00",              ""},
+            {"",                "SUBW",   "_mathY",            ""},
+            {"",                "STW",    "_mathY",            ""},
+            {"",                "LD",     "_mathSign",         ""},
+            {"",                "XORI",   "0x01",              "negate quotient"},
+            {"",                "ST",     "_mathSign",         ""},
+            {"divide_y",        "CALL",   "_divideU",          ""},
+            {"",                "POP",    "",                  ""},
+            {"",                "LD",     "_mathSign",         ""},
+            {"",                "ANDI",   "0x02",              ""},
+            {"",                "BEQ",    "divide_quotient",   ""},
+            {"",                "LDI",    "0x00",              ""},
+            {"",                "SUBW",   "_mathRem",          ""},
+            {"",                "STW",    "_mathRem",          ""},
+            {"divide_quotient", "LD",     "_mathSign",         ""},
+            {"",                "ANDI",   "0x01",              ""},
+            {"",                "BEQ",    "divide_positive",   ""},
+            {"",                "LDI",    "0x00",              ""},
+            {"",                "SUBW",   "_mathX",            ""},
+            {"",                "RET",    "",                  ""},
+            {"divide_positive", "LDW",    "_mathX",            ""},
+            {"",                "RET",    "",                  ""}}});
+
+        GBexpr::initialise();
+    }
+
+
+    bool error(const std::string& message, const std::string& text)
+    {
+        fprintf(stderr, "GBasic::compile() : %s : '%s' : in '%s' on line %d\n", message.c_str(), text.c_str(), _filename.c_str(), _lineNumber);
+        return false;
+    }
+
+    std::string trim(const std::string& text)
+    {
+        size_t start = text.find_first_not_of(" \t\r\n");
+        if(start == std::string::npos) return "";
+        size_t end = text.find_last_not_of(" \t\r\n");
+        return text.substr(start, end - start + 1);
+    }
+
+    std::string newLabel(const std::string& prefix)
+    {
+        return prefix + std::to_string(_labelIndex++);
+    }
+
+    std::string hex(uint16_t value, int digits)
+    {
+        char str[16];
+        snprintf(str, sizeof(str), "0x%0*X", digits, value);
+        return std::string(str);
+    }
+
+    bool isIdentifier(const std::string& name)
+    {
+        if(name.empty()  ||  !isalpha((unsigned char)name[0])) return false;
+        for(int i=1; i<int(name.size()); i++)
+        {
+            if(!isalnum((unsigned char)name[i])  &&  name[i] != '_') return false;
+        }
+
+        return !GBexpr::isKeyword(name);
+    }
+
+    // Upper case everything outside of string literals
+    std::string toUpperCode(const std::string& text)
+    {
+        std::string result = text;
+        bool quoted = false;
+        for(int i=0; i<int(result.size()); i++)
+        {
+            if(result[i] == '"') quoted = !quoted;
+            if(!quoted) result[i] = toupper(result[i]);
+        }
+
+        return result;
+    }
+
+    // Finds a character outside of string literals and brackets
+    size_t findTopLevel(const std::string& text, const std::string& chars, size_t start=0)
+    {
+        int depth = 0;
+        bool quoted = false;
+        for(size_t i=start; i<text.size(); i++)
+        {
+            if(text[i] == '"') quoted = !quoted;
+            if(quoted) continue;
+
+            if(text[i] == '(') depth++;
+            else if(text[i] == ')') depth--;
+            else if(depth == 0  &&  chars.find(text[i]) != std::string::npos) return i;
+        }
+
+        return std::string::npos;
+    }
+
+    // Finds a keyword that isn't part of a name, outside of string literals
+    size_t findKeyword(const std::string& text, const std::string& keyword)
+    {
+        bool quoted = false;
+        for(size_t i=0; i<text.size(); i++)
+        {
+            if(text[i] == '"') quoted = !quoted;
+            if(quoted  ||  text.compare(i, keyword.size(), keyword) != 0) continue;
+
+            bool before = i > 0  &&  (isalnum((unsigned char)text[i-1])  ||  text[i-1] == '_');
+            bool after = i + keyword.size() < text.size()  &&  (isalnum((unsigned char)text[i + keyword.size()])  ||  text[i + keyword.size()] == '_');
+            if(!before  &&  !after) return i;
+        }
+
+        return std::string::npos;
+    }
+
+    bool isNumber(const std::string& text)
+    {
+        return !text.empty()  &&  std::all_of(text.begin(), text.end(), [](char c) {return isdigit((unsigned char)c) != 0;});
+    }
+
+
+    void emit(const std::string& opcode, const std::string& operand="", const std::string& comment="")
+    {
+        Instruction instruction;
+        instruction._opcode = opcode;
+        instruction._operand = operand;
+        instruction._comment = comment;
+        _block->_code.push_back(instruction);
+    }
+
+    void emitLabel(const std::string& label)
+    {
+        Instruction instruction;
+        instruction._label = label;
+        _block->_code.push_back(instruction);
+    }
+
+    void useRoutine(const std::string& name)
+    {
+        if(_usedRoutines.find(name) != _usedRoutines.end()) return;
+        _usedRoutines.insert(name);
+
+        for(auto& routine : _routines)
+        {
+            if(routine._name != name) continue;
+            for(auto& call : routine._calls) useRoutine(call);
+        }
+    }
+
+    void callRoutine(const std::string& name)
+    {
+        useRoutine(name);
+        emit("CALL", "_" + name);
+    }
+
+    // Variables that are used inside of loops are more likely to stay in zero page
+    void weighVariable(const std::string& name)
+    {
+        if(std::find(_vars.begin(), _vars.end(), name) == _vars.end()) _vars.push_back(name);
+        _varWeights[name] += 1 << (3 * std::min(int(_forLoops.size()), 4));
+    }
+
+    std::string variable(const std::string& name)
+    {
+        weighVariable("var_" + name);
+        return "var_" + name;
+    }
+
+    std::string temporary(void)
+    {
+        return "_tmp" + std::to_string(_temps++);
+    }
+
+
+    void generate(const GBexpr::Node& node);
+
+    bool isSimple(const GBexpr::Node& node)
+    {
+        return (node._type == GBexpr::Number  &&  node._value < 256)  ||  node._type == GBexpr::Variable;
+    }
+
+    // Instructions with an 8bit immediate or a zero page variable as their operand
+    void emitSimple(const GBexpr::Node& node, const std::string& byteOpcode, const std::string& wordOpcode)
+    {
+        if(node._type == GBexpr::Number)
+        {
+            emit(byteOpcode, std::to_string(node._value));
+        }
+        else
+        {
+            emit(wordOpcode, variable(node._name));
+        }
+    }
+
+    void generateLoad(const GBexpr::Node& node)
+    {
+        if(node._type == GBexpr::Number)
+        {
+            (node._value < 256) ? emit("LDI", std::to_string(node._value)) : emit("LDWI", hex(node._value, 4));
+        }
+        else
+        {
+            emit("LDW", variable(node._name));
+        }
+    }
+
+    // vAC = left - right, which is what relational operators and conditions branch on
+    void generateDifference(const GBexpr::Node& left, const GBexpr::Node& right)
+    {
+        if(right._type == GBexpr::Number  &&  right._value == 0)
+        {
+            generate(left);
+        }
+        else if(isSimple(right))
+        {
+            generate(left);
+            emitSimple(right, "SUBI", "SUBW");
+        }
+        else
+        {
+            generate(right);
+            std::string temp = temporary();
+            emit("STW", temp);
+            generate(left);
+            emit("SUBW", temp);
+        }
+    }
+
+    // mathX = left, mathY = right
+    void generateMathArgs(const GBexpr::Node& left, const GBexpr::Node& right)
+    {
+        if(right._type == GBexpr::Number  ||  right._type == GBexpr::Variable)
+        {
+            generate(left);
+            emit("STW", "_mathX");
+            generateLoad(right);
+            emit("STW", "_mathY");
+        }
+        else
+        {
+            generate(right);
+            std::string temp = temporary();
+            emit("STW", temp);
+            generate(left);
+            emit("STW", "_mathX");
+            emit("LDW", temp);
+            emit("STW", "_mathY");
+        }
+    }
+
+    std::string condition(const std::string& op)
+    {
+        if(op == "=")  return "EQ";
+        if(op == "<>") return "NE";
+        if(op == "<")  return "LT";
+        if(op == ">")  return "GT";
+        if(op == "<=") return "LE";
+        return "GE";
+    }
+
+    std::string inverse(const std::string& cc)
+    {
+        if(cc == "EQ") return "NE";
+        if(cc == "NE") return "EQ";
+        if(cc == "LT") return "GE";
+        if(cc == "GE") return "LT";
+        if(cc == "GT") return "LE";
+        return "GT";
+    }
+
+    int powerOfTwo(const GBexpr::Node& node)
+    {
+        if(node._type != GBexpr::Number) return -1;
+        for(int i=1; i<8; i++)
+        {
+            if(node._value == (1 << i)) return i;
+        }
+
+        return -1;
+    }
+
+    // Expressions are evaluated into vAC, the right operand of a binary operator is evaluated first so that the left one can
+    // be combined with it directly, every temporary is a new name that the zero page allocator assigns a slot to
+    void generate(const GBexpr::Node& node)
+    {
+        switch(node._type)
+        {
+            case GBexpr::Number:
+            case GBexpr::Variable: generateLoad(node); break;
+
+            case GBexpr::Function:
+            {
+                const GBexpr::Node& operand = node._operands[0];
+                if(operand._type == GBexpr::Number  &&  operand._value < 256)
+                {
+                    emit((node._name == "PEEK") ? "LD" : "LDW", hex(operand._value, 2));
+                }
+                else
+                {
+                    generate(operand);
+                    emit(node._name);
+                }
+            }
+            break;
+
+            case GBexpr::Unary:
+            {
+                const GBexpr::Node& operand = node._operands[0];
+                if(operand._type == GBexpr::Variable)
+                {
+                    emit("LDI", "0");
+                    emit("SUBW", variable(operand._name));
+                }
+                else
+                {
+                    generate(operand);
+                    std::string temp = temporary();
+                    emit("STW", temp);
+                    emit("LDI", "0");
+                    emit("SUBW", temp);
+                }
+            }
+            break;
+
+            case GBexpr::Operator:
+            {
+                const std::string& op = node._name;
+                const GBexpr::Node* left = &node._operands[0];
+                const GBexpr::Node* right = &node._operands[1];
+
+                if(GBexpr::isRelational(node))
+                {
+                    std::string trueLabel = newLabel("_true");
+                    std::string doneLabel = newLabel("_done");
+                    generateDifference(*left, *right);
+                    emit("B" + condition(op), trueLabel);
+                    emit("LDI", "0");
+                    emit("BRA", doneLabel);
+                    emitLabel(trueLabel);
+                    emit("LDI", "1");
+                    emitLabel(doneLabel);
+                    break;
+                }
+
+                // Commutative operators keep a simple operand on the right
+                bool commutative = op == "+"  ||  op == "*"  ||  op == "AND"  ||  op == "OR"  ||  op == "XOR";
+                if(commutative  &&  ((isSimple(*left)  &&  !isSimple(*right))  ||  powerOfTwo(*left) > 0)) std::swap(left, right);
+
+                if(op == "*")
+                {
+                    int shift = powerOfTwo(*right);
+                    if(shift > 0)
+                    {
+                        generate(*left);
+                        for(int i=0; i<shift; i++) emit("LSLW");
+                        break;
+                    }
+
+                    generateMathArgs(*left, *right);
+                    callRoutine("multiply");
+                    break;
+                }
+
+                if(op == "/"  ||  op == "MOD")
+                {
+                    generateMathArgs(*left, *right);
+                    callRoutine("divide");
+                    if(op == "MOD") emit("LDW", "_mathRem");
+                    break;
+                }
+
+                std::string byteOpcode, wordOpcode;
+                if(op == "+")        {byteOpcode = "ADDI"; wordOpcode = "ADDW";}
+                else if(op == "-")   {byteOpcode = "SUBI"; wordOpcode = "SUBW";}
+                else if(op == "AND") {byteOpcode = "ANDI"; wordOpcode = "ANDW";}
+                else if(op == "OR")  {byteOpcode = "ORI";  wordOpcode = "ORW"; }
+                else                 {byteOpcode = "XORI"; wordOpcode = "XORW";}
+
+                if(isSimple(*right))
+                {
+                    generate(*left);
+                    emitSimple(*right, byteOpcode, wordOpcode);
+                }
+                else
+                {
+                    generate(*right);
+                    std::string temp = temporary();
+                    emit("STW", temp);
+                    generate(*left);
+                    emit(wordOpcode, temp);
+                }
+            }
+            break;
+        }
+    }
+
+    bool parseExpression(const std::string& text, GBexpr::Node& node)
+    {
+        if(!GBexpr::parse(trim(text), node)) return error("Bad expression", trim(text));
+        return true;
+    }
+
+    // Jumps to target when the condition is true, or when it is false
+    void generateCondition(const GBexpr::Node& node, const std::string& target, bool jumpIfTrue)
+    {
+        if(GBexpr::isRelational(node))
+        {
+            generateDifference(node._operands[0], node._operands[1]);
+            std::string cc = condition(node._name);
+            emit("J" + (jumpIfTrue ? cc : inverse(cc)), target);
+        }
+        else
+        {
+            generate(node);
+            emit(jumpIfTrue ? "JNE" : "JEQ", target);
+        }
+    }
+
+
+    bool compileStatements(const std::string& text);
+
+    std::string lineLabel(int line)
+    {
+        return "_line" + std::to_string(line);
+    }
+
+    bool compileJump(const std::string& text, const std::string& keyword)
+    {
+        if(!isNumber(text)) return error(keyword + " needs a line number", text);
+
+        int line = std::stoi(text);
+        _targets.push_back({line, _lineNumber});
+        if(keyword == "GOTO")
+        {
+            emit("JMP", lineLabel(line));
+        }
+        else
+        {
+            emit("LDWI", lineLabel(line));
+            callRoutine("gosub");
+        }
+
+        return true;
+    }
+
+    bool compileString(const std::string& text)
+    {
+        std::string str = text.substr(1, text.size() - 2);
+        if(str.size() > GBASIC_MAX_STRING) return error("String is too long", text);
+        if(str.empty()) return true;
+
+        if(_strings.find(str) == _strings.end()) _strings[str] = "_string" + std::to_string(_strings.size());
+        emit("LDWI", _strings[str]);
+        callRoutine("printText");
+        return true;
+    }
+
+    bool compilePrint(const std::string& text)
+    {
+        size_t start = 0;
+        bool newLine = true;
+        while(start < text.size())
+        {
+            size_t end = findTopLevel(text, ";,", start);
+            std::string item = trim(text.substr(start, (end == std::string::npos) ? std::string::npos : end - start));
+            newLine = (end == std::string::npos);
+
+            if(item.size() >= 2  &&  item.front() == '"'  &&  item.back() == '"'  &&  item.find('"', 1) == item.size() - 1)
+            {
+                if(!compileString(item)) return false;
+            }
+            else if(!item.empty())
+            {
+                GBexpr::Node node;
+                if(!parseExpression(item, node)) return false;
+                generate(node);
+                callRoutine("printInt");
+            }
+
+            if(end == std::string::npos) break;
+            if(text[end] == ',')
+            {
+                emit("LDI", "32", "','");
+                callRoutine("printChar");
+            }
+            start = end + 1;
+        }
+
+        if(newLine) callRoutine("newLine");
+        return true;
+    }
+
+    bool compileAssignment(const std::string& text)
+    {
+        size_t equals = findTopLevel(text, "=");
+        std::string name = trim(text.substr(0, equals));
+        if(equals == std::string::npos  ||  !isIdentifier(name)) return error("Syntax error", text);
+
+        GBexpr::Node node;
+        if(!parseExpression(text.substr(equals + 1), node)) return false;
+        generate(node);
+        emit("STW", variable(name));
+        return true;
+    }
+
+    // POKE and DOKE, a constant zero page address is stored to directly
+    bool compilePoke(const std::string& text, const std::string& keyword)
+    {
+        size_t comma = findTopLevel(text, ",");
+        if(comma == std::string::npos) return error(keyword + " needs an address and a value", text);
+
+        GBexpr::Node address, value;
+        if(!parseExpression(text.substr(0, comma), address)  ||  !parseExpression(text.substr(comma + 1), value)) return false;
+
+        if(address._type == GBexpr::Number  &&  address._value < 256)
+        {
+            generate(value);
+            emit((keyword == "POKE") ? "ST" : "STW", hex(address._value, 2));
+        }
+        else if(address._type == GBexpr::Variable)
+        {
+            generate(value);
+            emit(keyword, variable(address._name));
+        }
+        else
+        {
+            generate(address);
+            std::string temp = temporary();
+            emit("STW", temp);
+            generate(value);
+            emit(keyword, temp);
+        }
+
+        return true;
+    }
+
+    // FOR var = start TO end STEP constant, the body always runs at least once
+    bool compileFor(const std::string& text)
+    {
+        size_t equals = findTopLevel(text, "=");
+        size_t to = findKeyword(text, "TO");
+        if(equals == std::string::npos  ||  to == std::string::npos  ||  to < equals) return error("Syntax error", text);
+
+        std::string name = trim(text.substr(0, equals));
+        if(!isIdentifier(name)) return error("Bad loop variable", name);
+
+        size_t step = findKeyword(text, "STEP");
+        std::string endText = (step == std::string::npos) ? text.substr(to + 2) : text.substr(to + 2, step - to - 2);
+
+        GBexpr::Node start, end, stepNode;
+        stepNode._value = 1;
+        if(!parseExpression(text.substr(equals + 1, to - equals - 1), start)  ||  !parseExpression(endText, end)) return false;
+        if(step != std::string::npos  &&  !parseExpression(text.substr(step + 4), stepNode)) return false;
+        if(stepNode._type != GBexpr::Number  ||  stepNode._value == 0) return error("STEP must be a non zero constant", text);
+
+        ForLoop forLoop = {name, newLabel("_for"), "", int16_t(stepNode._value)};
+
+        generate(start);
+        emit("STW", variable(name));
+        if(end._type != GBexpr::Number  ||  end._value >= 256)
+        {
+            forLoop._end = "_forEnd" + std::to_string(_forLoops.size());
+            weighVariable(forLoop._end);
+            generate(end);
+            emit("STW", forLoop._end);
+        }
+        else
+        {
+            forLoop._end = std::to_string(end._value);
+        }
+
+        emitLabel(forLoop._label);
+        _forLoops.push_back(forLoop);
+        return true;
+    }
+
+    bool compileNext(const std::string& text)
+    {
+        if(_forLoops.empty()) return error("NEXT without FOR", text);
+
+        ForLoop forLoop = _forLoops.back();
+        if(!text.empty()  &&  text != forLoop._var) return error("NEXT doesn't match FOR " + forLoop._var, text);
+
+        std::string var = variable(forLoop._var);
+        if(forLoop._step > 0  &&  forLoop._step < 256)
+        {
+            emit("LDW", var);
+            emit("ADDI", std::to_string(forLoop._step));
+        }
+        else if(forLoop._step < 0  &&  forLoop._step > -256)
+        {
+            emit("LDW", var);
+            emit("SUBI", std::to_string(-forLoop._step));
+        }
+        else
+        {
+            emit("LDWI", hex(uint16_t(forLoop._step), 4));
+            emit("ADDW", var);
+        }
+        emit("STW", var);
+
+        if(isNumber(forLoop._end))
+        {
+            if(forLoop._end != "0") emit("SUBI", forLoop._end);
+        }
+        else
+        {
+            weighVariable(forLoop._end);
+            emit("SUBW", forLoop._end);
+        }
+        emit((forLoop._step > 0) ? "JLE" : "JGE", forLoop._label);
+        _forLoops.pop_back();
+
+        return true;
+    }
+
+    // IF condition THEN line or statements, the statements run to the end of the source line
+    bool compileIf(const std::string& text)
+    {
+        size_t then = findKeyword(text, "THEN");
+        if(then == std::string::npos) return error("IF without THEN", text);
+
+        GBexpr::Node node;
+        if(!parseExpression(text.substr(0, then), node)) return false;
+
+        std::string statements = trim(text.substr(then + 4));
+        if(isNumber(statements))
+        {
+            int line = std::stoi(statements);
+            _targets.push_back({line, _lineNumber});
+            generateCondition(node, lineLabel(line), true);
+            return true;
+        }
+
+        std::string endLabel = newLabel("_endif");
+        generateCondition(node, endLabel, false);
+        if(!compileStatements(statements)) return false;
+        emitLabel(endLabel);
+
+        return true;
+    }
+
+    bool compileStatement(const std::string& statement)
+    {
+        size_t i = 0;
+        while(i < statement.size()  &&  (isalnum((unsigned char)statement[i])  ||  statement[i] == '_')) i++;
+        std::string keyword = statement.substr(0, i);
+        std::string text = trim(statement.substr(i));
+
+        if(keyword == "LET")                        return compileAssignment(text);
+        if(keyword == "PRINT")                      return compilePrint(text);
+        if(keyword == "GOTO"  ||  keyword == "GOSUB") return compileJump(text, keyword);
+        if(keyword == "POKE"  ||  keyword == "DOKE")  return compilePoke(text, keyword);
+        if(keyword == "FOR")                        return compileFor(text);
+        if(keyword == "NEXT")                       return compileNext(text);
+        if(keyword == "RETURN")                     {emit("POP"); emit("RET"); return true;}
+        if(keyword == "END"  ||  keyword == "STOP")   {emit("JMP", "_end"); return true;}
+        if(keyword == "CLS")                        {callRoutine("cls"); return true;}
+        if(statement[0] == '?')                     return compilePrint(trim(statement.substr(1)));
+
+        return compileAssignment(statement);
+    }
+
+    bool compileStatements(const std::string& text)
+    {
+        size_t start = 0;
+        while(start < text.size())
+        {
+            std::string rest = trim(text.substr(start));
+            if(rest.empty()) break;
+            if(findKeyword(rest, "REM") == 0  ||  rest[0] == '\'') break;
+            if(findKeyword(rest, "IF") == 0) return compileIf(rest.substr(2));
+
+            size_t colon = findTopLevel(text, ":", start);
+            std::string statement = trim(text.substr(start, (colon == std::string::npos) ? std::string::npos : colon - start));
+            if(!statement.empty()  &&  !compileStatement(statement)) return false;
+
+            if(colon == std::string::npos) break;
+            start = colon + 1;
+        }
+
+        return true;
+    }
+
+    bool compileLine(const std::string& input)
+    {
+        std::string text = trim(toUpperCode(input));
+        if(text.empty()) return true;
+
+        size_t i = 0;
+        while(i < text.size()  &&  isdigit((unsigned char)text[i])) i++;
+
+        Block block;
+        block._isMain = true;
+        block._name = "_text" + std::to_string(_lineNumber);
+        if(i)
+        {
+            int line = std::stoi(text.substr(0, i));
+            if(_lines.find(line) != _lines.end()) return error("Duplicate line number", text.substr(0, i));
+            _lines.insert(line);
+            block._name = lineLabel(line);
+        }
+
+        _blocks.push_back(block);
+        _block = &_blocks.back();
+        emitLabel(block._name);
+
+        return compileStatements(text.substr(i));
+    }
+
+
+    const Routine* findRoutine(const std::string& name)
+    {
+        for(auto& routine : _routines)
+        {
+            if(routine._name == name) return &routine;
+        }
+
+        return nullptr;
+    }
+
+    // Scratch of a routine and of every routine that it calls
+    void getClobbers(const Routine& routine, std::set<std::string>& clobbers)
+    {
+        for(auto& var : routine._vars) clobbers.insert(var.first);
+        for(auto& call : routine._calls) getClobbers(*findRoutine(call), clobbers);
+    }
+
+    // A CALL reads the routine's inputs and writes all of its scratch
+    void getUsesAndDefs(const Instruction& instruction, std::set<std::string>& uses, std::set<std::string>& defs)
+    {
+        if(instruction._opcode == "CALL")
+        {
+            const Routine* routine = (instruction._operand[0] == '_') ? findRoutine(instruction._operand.substr(1)) : nullptr;
+            if(routine == nullptr) return;
+
+            for(auto& input : routine->_inputs) uses.insert(input);
+            getClobbers(*routine, defs);
+            return;
+        }
+
+        if(_scratch.find(instruction._operand) == _scratch.end()) return;
+        if(instruction._opcode == "STW"  ||  instruction._opcode == "ST")
+        {
+            defs.insert(instruction._operand);
+        }
+        else
+        {
+            uses.insert(instruction._operand);
+        }
+    }
+
+    void addInterference(const std::string& a, const std::string& b)
+    {
+        if(a == b) return;
+        _interference[a].insert(b);
+        _interference[b].insert(a);
+    }
+
+    // Backwards liveness over the instructions of a block, temporaries and routine inputs never live across statements so
+    // jumps out of the block are exits, whatever is written interferes with everything that is live after it
+    void addBlockInterference(const Block& block)
+    {
+        int n = int(block._code.size());
+        std::map<std::string, int> labels;
+        for(int i=0; i<n; i++)
+        {
+            if(block._code[i]._label.size()) labels[block._code[i]._label] = i;
+        }
+
+        std::vector<std::vector<int>> successors(n);
+        std::vector<std::set<std::string>> uses(n), defs(n), liveIn(n), liveOut(n);
+        for(int i=0; i<n; i++)
+        {
+            const std::string& opcode = block._code[i]._opcode;
+            if(opcode != "BRA"  &&  opcode != "JMP"  &&  opcode != "RET"  &&  i + 1 < n) successors[i].push_back(i + 1);
+            if(opcode[0] == 'B'  ||  opcode[0] == 'J')
+            {
+                auto it = labels.find(block._code[i]._operand);
+                if(it != labels.end()) successors[i].push_back(it->second);
+            }
+
+            getUsesAndDefs(block._code[i], uses[i], defs[i]);
+        }
+
+        bool changed = true;
+        while(changed)
+        {
+            changed = false;
+            for(int i=n-1; i>=0; i--)
+            {
+                std::set<std::string> out, in = uses[i];
+                for(int successor : successors[i]) out.insert(liveIn[successor].begin(), liveIn[successor].end());
+                for(auto& name : out)
+                {
+                    if(defs[i].find(name) == defs[i].end()) in.insert(name);
+                }
+
+                if(in != liveIn[i]  ||  out != liveOut[i])
+                {
+                    liveIn[i] = in;
+                    liveOut[i] = out;
+                    changed = true;
+                }
+            }
+        }
+
+        for(int i=0; i<n; i++)
+        {
+            for(auto& def : defs[i])
+            {
+                for(auto& live : liveOut[i]) addInterference(def, live);
+            }
+        }
+    }
+
+    bool placeZeroPage(const std::string& name, int size, bool exclusive, std::vector<std::vector<std::string>>& owners)
+    {
+        for(int address=VARS_BASE_ADDRESS; address+size<=GBASIC_VARS_END; address++)
+        {
+            if(address <= 0x80  &&  address + size > 0x80) continue;
+
+            bool free = true;
+            for(int i=0; i<size  &&  free; i++)
+            {
+                for(auto& owner : owners[address + i])
+                {
+                    if(exclusive  ||  _scratch.find(owner) == _scratch.end()  ||  _interference[name].count(owner)) {free = false; break;}
+                }
+            }
+            if(!free) continue;
+
+            for(int i=0; i<size; i++) owners[address + i].push_back(name);
+            _zeroPage.push_back({name, size});
+            _zeroPageAddresses[name] = uint16_t(address);
+            return true;
+        }
+
+        return false;
+    }
+
+    // Routine address slots and routine state have zero page to themselves, temporaries and routine scratch share slots with
+    // everything they don't interfere with, variables get what is left, heaviest first, the rest is spilled to RAM
+    bool allocateZeroPage(void)
+    {
+        std::vector<std::string> dedicated;
+        for(auto& routine : _routines)
+        {
+            if(_usedRoutines.find(routine._name) == _usedRoutines.end()) continue;
+
+            std::set<std::string> clobbers;
+            getClobbers(routine, clobbers);
+            for(auto& var : routine._vars) _scratch[var.first] = var.second;
+            for(auto& a : clobbers)
+            {
+                for(auto& b : clobbers) addInterference(a, b);
+            }
+            for(auto& state : routine._state)
+            {
+                if(std::find(dedicated.begin(), dedicated.end(), state) == dedicated.end()) dedicated.push_back(state);
+            }
+            dedicated.push_back("_" + routine._name);
+        }
+        for(int i=0; i<_temps; i++) _scratch["_tmp" + std::to_string(i)] = 2;
+        for(auto& block : _blocks) addBlockInterference(block);
+
+        std::vector<std::vector<std::string>> owners(256);
+        for(auto& name : dedicated)
+        {
+            if(!placeZeroPage(name, 2, true, owners)) return error("Out of zero page", name);
+        }
+
+        std::vector<std::pair<std::string, int>> scratch(_scratch.begin(), _scratch.end());
+        std::stable_sort(scratch.begin(), scratch.end(), [](const std::pair<std::string, int>& a, const std::pair<std::string, int>& b)
+        {
+            if(a.second != b.second) return a.second > b.second;
+            return _interference[a.first].size() > _interference[b.first].size();
+        });
+        for(auto& var : scratch)
+        {
+            if(!placeZeroPage(var.first, var.second, false, owners)) return error("Out of zero page", var.first);
+        }
+
+        std::vector<std::string> vars = _vars;
+        std::stable_sort(vars.begin(), vars.end(), [](const std::string& a, const std::string& b) {return _varWeights[a] > _varWeights[b];});
+
+        // Spilled variables are accessed through two scratch words
+        std::vector<std::vector<std::string>> varOwners = owners;
+        std::vector<std::pair<std::string, int>> zeroPage = _zeroPage;
+        for(auto& var : vars)
+        {
+            if(placeZeroPage(var, 2, true, varOwners)) continue;
+
+            _zeroPage = zeroPage;
+            if(!placeZeroPage("_spillValue", 2, true, owners)  ||  !placeZeroPage("_spillOperand", 2, true, owners)) return error("Out of zero page", var);
+            for(auto& name : vars)
+            {
+                if(placeZeroPage(name, 2, true, owners)) continue;
+
+                _spills.push_back(name);
+                fprintf(stderr, "GBasic::compile() : Warning, out of zero page, '%s' is in RAM : in '%s'\n", name.c_str(), _filename.c_str());
+            }
+            break;
+        }
+
+        return true;
+    }
+
+    // Spilled variables are loaded with DEEK and stored with DOKE, instructions that combine vAC with a variable get it in
+    // a scratch word
+    void rewriteSpills(void)
+    {
+        if(_spills.empty()) return;
+
+        for(auto& block : _blocks)
+        {
+            std::vector<Instruction> code;
+            for(auto& instruction : block._code)
+            {
+                if(std::find(_spills.begin(), _spills.end(), instruction._operand) == _spills.end())
+                {
+                    code.push_back(instruction);
+                    continue;
+                }
+
+                std::string ram = "ram" + instruction._operand;
+                if(instruction._opcode == "LDW")
+                {
+                    code.push_back({instruction._label, "LDWI", ram, instruction._comment});
+                    code.push_back({"", "DEEK", "", ""});
+                }
+                else if(instruction._opcode == "STW")
+                {
+                    code.push_back({instruction._label, "STW", "_spillValue", instruction._comment});
+                    code.push_back({"", "LDWI", ram, ""});
+                    code.push_back({"", "STW", "_spillOperand", ""});
+                    code.push_back({"", "LDW", "_spillValue", ""});
+                    code.push_back({"", "DOKE", "_spillOperand", ""});
+                }
+                else
+                {
+                    code.push_back({instruction._label, "STW", "_spillValue", instruction._comment});
+                    code.push_back({"", "LDWI", ram, ""});
+                    code.push_back({"", "DEEK", "", ""});
+                    code.push_back({"", "STW", "_spillOperand", ""});
+                    code.push_back({"", "LDW", "_spillValue", ""});
+                    code.push_back({"", instruction._opcode, "_spillOperand", ""});
+                }
+            }
+            block._code = code;
+        }
+    }
+
+    // Sets up the stack and the routine address slots
+    void compileInit(void)
+    {
+        Block block;
+        block._isMain = true;
+        block._name = "_init";
+        _blocks.insert(_blocks.begin(), block);
+        _block = &_blocks[0];
+
+        emitLabel("_init");
+        emit("LDI", "0x00");
+        emit("ST", "vSP", "stack grows down from the top of page 0");
+        for(auto& routine : _routines)
+        {
+            if(_usedRoutines.find(routine._name) == _usedRoutines.end()) continue;
+            emit("LDWI", routine._name);
+            emit("STW", "_" + routine._name);
+        }
+        if(_usedRoutines.find("printChar") != _usedRoutines.end()) emit("CALL", "_cls");
+
+        // Variables start at zero every run, they are cleared a few per block as spilled variables are later rewritten into
+        // DOKE sequences that would overflow a single region
+        for(int i=0; i<int(_vars.size()); i+=GBASIC_ZERO_VARS)
+        {
+            Block zero;
+            zero._isMain = true;
+            zero._name = "_zero";
+            int index = 1 + i/GBASIC_ZERO_VARS;
+            _blocks.insert(_blocks.begin() + index, zero);
+            _block = &_blocks[index];
+
+            emitLabel(newLabel("_zero"));
+            emit("LDI", "0x00");
+            for(int j=i; j<std::min(i + GBASIC_ZERO_VARS, int(_vars.size())); j++) emit("STW", _vars[j]);
+        }
+    }
+
+    void compileEnd(void)
+    {
+        Block block;
+        block._isMain = true;
+        block._name = "_end";
+        _blocks.push_back(block);
+        _block = &_blocks.back();
+
+        Instruction instruction;
+        instruction._label = "_end";
+        instruction._opcode = "BRA";
+        instruction._operand = "_end";
+        _block->_code.push_back(instruction);
+    }
+
+
+    // Label only instructions are attached to the next instruction, or aliased to its label, which may be in the next block
+    std::string resolve(const std::string& label)
+    {
+        auto it = _aliases.find(label);
+        return (it == _aliases.end()) ? label : resolve(it->second);
+    }
+
+    void resolveLabels(void)
+    {
+        std::string next;
+        for(int i=int(_blocks.size())-1; i>=0; i--)
+        {
+            std::vector<Instruction> code;
+            std::vector<std::string> pending;
+            for(auto& instruction : _blocks[i]._code)
+            {
+                if(instruction._opcode.empty())
+                {
+                    pending.push_back(instruction._label);
+                    continue;
+                }
+
+                if(pending.size())
+                {
+                    if(instruction._label.empty()) instruction._label = pending[0];
+                    for(auto& label : pending)
+                    {
+                        if(label != instruction._label) _aliases[label] = instruction._label;
+                    }
+                    pending.clear();
+                }
+                code.push_back(instruction);
+            }
+
+            for(auto& label : pending) _aliases[label] = next;
+            _blocks[i]._code = code;
+            if(code.size()) next = code[0]._label;
+        }
+
+        for(auto& block : _blocks)
+        {
+            for(auto& instruction : block._code) instruction._operand = resolve(instruction._operand);
+        }
+    }
+
+    int instructionSize(const Instruction& instruction)
+    {
+        const std::string& opcode = instruction._opcode;
+        if(opcode == "JMP") return (instruction._isLong) ? 5 : 2;
+        if(opcode[0] == 'J') return (instruction._isLong) ? 8 : 3;
+        if(opcode == "DB") return int(std::count(instruction._operand.begin(), instruction._operand.end(), ' ')) + 1;
+
+        return _opcodeSizes[opcode];
+    }
+
+    int blockSize(const Block& block)
+    {
+        int size = 0;
+        for(auto& instruction : block._code) size += instructionSize(instruction);
+        return size;
+    }
+
+    // Every region is within a page, so branches within a block always reach
+    void initialiseRegions(void)
+    {
+        _regions.clear();
+        for(uint16_t page=0x02; page<=0x04; page++) _regions.push_back({uint16_t(page <<8), uint16_t((page <<8) | 0xFA)});
+        for(uint16_t page=0x05; page<=0x07; page++) _regions.push_back({uint16_t(page <<8), uint16_t((page + 1) <<8)});
+        for(uint16_t page=0x08; page<=0x7F; page++)
+        {
+            if(page >= 0x59  &&  page <= 0x5B) continue; // loader
+            _regions.push_back({uint16_t((page <<8) | 0xA0), uint16_t((page + 1) <<8)});
+        }
+    }
+
+    // Main code flows through the regions in order, a region that can't fit the next block is continued with a long jump
+    bool layoutMain(void)
+    {
+        for(auto& region : _regions) region._used = 0;
+
+        int r = 0, previous = -1;
+        for(int i=0; i<int(_blocks.size()); i++)
+        {
+            Block& block = _blocks[i];
+            block._isContinued = false;
+
+            int size = blockSize(block);
+            int need = size + ((i == int(_blocks.size()) - 1) ? 0 : GBASIC_CONTINUATION);
+            while(size  &&  _regions[r]._used + need > _regions[r]._end - _regions[r]._start)
+            {
+                if(_regions[r]._used == 0  &&  need > _regions[r]._end - _regions[r]._start)
+                {
+                    fprintf(stderr, "GBasic::compile() : Line too long, %d bytes : '%s' : in '%s'\n", size, block._name.c_str(), _filename.c_str());
+                    return false;
+                }
+                if(r + 1 >= int(_regions.size()))
+                {
+                    fprintf(stderr, "GBasic::compile() : Out of RAM : '%s' : in '%s'\n", block._name.c_str(), _filename.c_str());
+                    return false;
+                }
+                if(_regions[r]._used  &&  previous >= 0)
+                {
+                    _blocks[previous]._isContinued = true;
+                    _regions[r]._used += GBASIC_CONTINUATION;
+                }
+                r++;
+            }
+
+            block._region = r;
+            block._address = _regions[r]._start + _regions[r]._used;
+            _regions[r]._used += size;
+            if(size) previous = i;
+        }
+
+        return true;
+    }
+
+    std::string nextBlockLabel(int index)
+    {
+        for(int i=index+1; i<int(_blocks.size()); i++)
+        {
+            if(_blocks[i]._code.size()) return _blocks[i]._code[0]._label;
+        }
+
+        return "_end";
+    }
+
+    // Jumps start short and become long when their target is in another page, until nothing changes, a long conditional jump
+    // branches over itself so it needs a label on the instruction after it
+    bool relax(void)
+    {
+        for(;;)
+        {
+            if(!layoutMain()) return false;
+
+            std::map<std::string, uint16_t> addresses;
+            for(auto& block : _blocks)
+            {
+                uint16_t address = block._address;
+                for(auto& instruction : block._code)
+                {
+                    if(instruction._label.size()) addresses[instruction._label] = address;
+                    address += uint16_t(instructionSize(instruction));
+                }
+            }
+
+            bool changed = false;
+            for(int b=0; b<int(_blocks.size()); b++)
+            {
+                Block& block = _blocks[b];
+                uint16_t address = block._address;
+                for(int i=0; i<int(block._code.size()); i++)
+                {
+                    Instruction& instruction = block._code[i];
+                    if(instruction._opcode[0] == 'J'  &&  !instruction._isLong)
+                    {
+                        auto it = addresses.find(instruction._operand);
+                        if(it == addresses.end())
+                        {
+                            fprintf(stderr, "GBasic::compile() : Missing label : '%s' : in '%s'\n", instruction._operand.c_str(), _filename.c_str());
+                            return false;
+                        }
+
+                        if((it->second >>8) != (address >>8))
+                        {
+                            instruction._isLong = true;
+                            changed = true;
+
+                            if(instruction._opcode != "JMP")
+                            {
+                                if(i == int(block._code.size()) - 1)
+                                {
+                                    Instruction jump;
+                                    jump._opcode = "JMP";
+                                    jump._operand = nextBlockLabel(b);
+                                    block._code.push_back(jump);
+                                }
+                                if(block._code[i+1]._label.empty()) block._code[i+1]._label = newLabel("_skip");
+                            }
+                            break;
+                        }
+                    }
+                    address += uint16_t(instructionSize(instruction));
+                }
+
+                if(changed) break;
+            }
+
+            if(!changed) return true;
+        }
+    }
+
+    void compileData(void)
+    {
+        _data.clear();
+        for(auto& routine : _routines)
+        {
+            if(_usedRoutines.find(routine._name) == _usedRoutines.end()) continue;
+
+            Block block;
+            block._name = routine._name;
+            block._code = routine._code;
+            _data.push_back(block);
+        }
+
+        for(auto& str : _strings)
+        {
+            Block block;
+            block._name = str.second;
+            std::string bytes = hex(uint16_t(str.first.size()), 2);
+            for(int i=0; i<int(str.first.size()); i++)
+            {
+                if(i % 16 == 15)
+                {
+                    block._code.push_back({block._code.empty() ? block._name : "", "DB", bytes, ""});
+                    bytes.clear();
+                }
+                bytes += (bytes.empty() ? "" : " ") + hex(uint8_t(str.first[i]), 2);
+            }
+            block._code.push_back({block._code.empty() ? block._name : "", "DB", bytes, "'" + str.first + "'"});
+            _data.push_back(block);
+        }
+
+        for(auto& spill : _spills)
+        {
+            Block block;
+            block._name = "ram" + spill;
+            block._code.push_back({block._name, "DB", "0x00 0x00", "spilled variable"});
+            _data.push_back(block);
+        }
+    }
+
+    // Routines and strings go into the smallest gaps that fit them, largest first
+    bool placeData(void)
+    {
+        std::vector<int> order;
+        for(int i=0; i<int(_data.size()); i++) order.push_back(i);
+        std::stable_sort(order.begin(), order.end(), [](int a, int b) {return blockSize(_data[a]) > blockSize(_data[b]);});
+
+        for(int i : order)
+        {
+            int size = blockSize(_data[i]);
+            int best = -1;
+            for(int r=0; r<int(_regions.size()); r++)
+            {
+                int free = _regions[r]._end - _regions[r]._start - _regions[r]._used;
+                if(free >= size  &&  (best < 0  ||  free < _regions[best]._end - _regions[best]._start - _regions[best]._used)) best = r;
+            }
+            if(best < 0)
+            {
+                fprintf(stderr, "GBasic::compile() : Out of RAM : '%s' : in '%s'\n", _data[i]._name.c_str(), _filename.c_str());
+                return false;
+            }
+
+            _data[i]._region = best;
+            _data[i]._address = _regions[best]._start + _regions[best]._used;
+            _regions[best]._used += uint16_t(size);
+        }
+
+        return true;
+    }
+
+
+    void pad(std::string& line, size_t column)
+    {
+        line += std::string((line.size() < column) ? column - line.size() : 1, ' ');
+    }
+
+    void writeLine(std::ofstream& outfile, const std::string& label, const std::string& opcode, const std::string& operand, const std::string& comment)
+    {
+        std::string line = label;
+        pad(line, 16);
+        line += opcode;
+        if(operand.size()  ||  comment.size()) {pad(line, 24); line += operand;}
+        if(comment.size()) {pad(line, 44); line += "; " + comment;}
+        outfile << line << "\n";
+    }
+
+    void writeInstruction(std::ofstream& outfile, const Instruction& instruction, const std::string& label, const std::string& next)
+    {
+        const std::string& opcode = instruction._opcode;
+        if(opcode == "JMP"  ||  opcode[0] != 'J')
+        {
+            if(opcode == "JMP"  &&  instruction._isLong)
+            {
+                writeLine(outfile, label, "LDWI", instruction._operand, instruction._comment);
+                writeLine(outfile, "", "CALL", "vAC", "");
+                return;
+            }
+
+            writeLine(outfile, label, (opcode == "JMP") ? "BRA" : opcode, instruction._operand, instruction._comment);
+            return;
+        }
+
+        std::string cc = opcode.substr(1);
+        if(instruction._isLong)
+        {
+            writeLine(outfile, label, "B" + inverse(cc), next, instruction._comment);
+            writeLine(outfile, "", "LDWI", instruction._operand, "");
+            writeLine(outfile, "", "CALL", "vAC", "");
+            return;
+        }
+
+        writeLine(outfile, label, "B" + cc, instruction._operand, instruction._comment);
+    }
+
+    // Everything is written in address order, each discontinuity starts a new section with an equate of its first label
+    bool writeVasm(const std::string& outputFilename)
+    {
+        std::ofstream outfile(outputFilename);
+        if(!outfile.is_open())
+        {
+            fprintf(stderr, "GBasic::compile() : Failed to open file : '%s'\n", outputFilename.c_str());
+            return false;
+        }
+
+        outfile << "; generated by gtbasic from '" << _filename << "'\n\n";
+
+        const std::pair<const char*, uint16_t> equates[] =
+        {
+            {"vPC", 0x16}, {"vAC", 0x18}, {"vLR", 0x1A}, {"vSP", 0x1C}, {"giga_sysFn", 0x22}, {"giga_sysArg0", 0x24}, {"giga_sysArg2", 0x26},
+            {"giga_sysArg4", 0x28}, {"giga_sysArg5", 0x29}, {"giga_vram", 0x0800}, {"giga_text32", 0x0700}, {"giga_xres", 160}, {"SYS_VDrawBits_134", 0x04e1}
+        };
+        for(auto& equate : equates) writeLine(outfile, equate.first, "EQU", hex(equate.second, (equate.second < 256) ? 2 : 4), "");
+        outfile << "\n";
+        std::stable_sort(_zeroPage.begin(), _zeroPage.end(), [](const std::pair<std::string, int>& a, const std::pair<std::string, int>& b)
+        {
+            return _zeroPageAddresses[a.first] < _zeroPageAddresses[b.first];
+        });
+        for(auto& zp : _zeroPage) writeLine(outfile, zp.first, "EQU", hex(_zeroPageAddresses[zp.first], 2), "");
+        outfile << "\n";
+
+        std::vector<const Block*> blocks;
+        for(auto& block : _blocks)
+        {
+            if(block._code.size()) blocks.push_back(&block);
+        }
+        for(auto& block : _data) blocks.push_back(&block);
+        std::stable_sort(blocks.begin(), blocks.end(), [](const Block* a, const Block* b) {return a->_address < b->_address;});
+
+        uint16_t address = 0x0000;
+        for(auto block : blocks)
+        {
+            if(block->_address != address)
+            {
+                outfile << "\n";
+                writeLine(outfile, block->_code[0]._label, "EQU", hex(block->_address, 4), "");
+            }
+            else
+            {
+                outfile << "\n";
+            }
+
+            for(int i=0; i<int(block->_code.size()); i++)
+            {
+                const Instruction& instruction = block->_code[i];
+                std::string next = (i + 1 < int(block->_code.size())) ? block->_code[i+1]._label : "";
+                writeInstruction(outfile, instruction, instruction._label, next);
+            }
+
+            address = block->_address + uint16_t(blockSize(*block));
+            if(block->_isContinued)
+            {
+                int index = int(block - &_blocks[0]);
+                writeLine(outfile, "", "LDWI", nextBlockLabel(index), "continued in the next region");
+                writeLine(outfile, "", "CALL", "vAC", "");
+                address += GBASIC_CONTINUATION;
+            }
+        }
+
+        return true;
+    }
+
+
+    void clearCompiler(void)
+    {
+        _lineNumber = 0;
+        _labelIndex = 0;
+        _temps = 0;
+        _block = nullptr;
+
+        _blocks.clear();
+        _data.clear();
+        _forLoops.clear();
+        _vars.clear();
+        _zeroPage.clear();
+        _zeroPageAddresses.clear();
+        _usedRoutines.clear();
+        _strings.clear();
+        _lines.clear();
+        _targets.clear();
+        _aliases.clear();
+        _varWeights.clear();
+        _scratch.clear();
+        _interference.clear();
+        _spills.clear();
+    }
+
+    bool compile(const std::string& inputFilename, const std::string& outputFilename)
+    {
+        clearCompiler();
+        _filename = inputFilename;
+
+        std::ifstream infile(inputFilename);
+        if(!infile.is_open())
+        {
+            fprintf(stderr, "GBasic::compile() : Failed to open file : '%s'\n", inputFilename.c_str());
+            return false;
+        }
+
+        std::string line;
+        while(std::getline(infile, line))
+        {
+            _lineNumber++;
+            if(!compileLine(line)) return false;
+        }
+
+        if(_forLoops.size()) return error("FOR without NEXT", _forLoops.back()._var);
+        for(auto& target : _targets)
+        {
+            if(_lines.find(target.first) == _lines.end())
+            {
+                _lineNumber = target.second;
+                return error("Missing line number", std::to_string(target.first));
+            }
+        }
+
+        compileEnd();
+        if(_usedRoutines.find("printChar") != _usedRoutines.end()) useRoutine("cls");
+        compileInit();
+
+        resolveLabels();
+        if(!allocateZeroPage()) return false;
+        rewriteSpills();
+
+        initialiseRegions();
+        if(!relax()) return false;
+
+        compileData();
+        if(!placeData()) return false;
+
+        return writeVasm(outputFilename);
+    }
+}
@@ -0,0 +1,53 @@
+#ifndef GBASIC_H
+#define GBASIC_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+
+#define GBASIC_VARS_END       0xD0 // variables start at VARS_BASE_ADDRESS, the vCPU stack grows down from 0x00 into the top of page 0
+#define GBASIC_CONTINUATION   5    // LDWI next, CALL vAC at the end of a full region
+#define GBASIC_ZERO_VARS      6    // variables cleared per block, 11 bytes each when spilled
+#define GBASIC_MAX_STRING     80
+#define GBASIC_PRINT_COLUMNS  26   // 6 pixels per char
+
+
+namespace GBasic
+{
+    // JMP and Jcc (JEQ, JNE, JLT, JGT, JLE, JGE) are relaxed into BRA/Bcc or LDWI, CALL vAC sequences once code is laid out,
+    // an instruction without an opcode is a label for the next instruction
+    struct Instruction
+    {
+        std::string _label;
+        std::string _opcode;
+        std::string _operand;
+        std::string _comment;
+        bool _isLong = false;
+    };
+
+    // Code or data that must be contiguous and within a page, main code blocks are source lines
+    struct Block
+    {
+        std::string _name;
+        std::vector<Instruction> _code;
+        bool _isMain = false;
+        bool _isContinued = false;
+        int _region = -1;
+        uint16_t _address = 0x0000;
+    };
+
+    struct Region
+    {
+        uint16_t _start;
+        uint16_t _end;
+        uint16_t _used = 0;
+    };
+
+
+    void initialise(void);
+
+    bool compile(const std::string& inputFilename, const std::string& outputFilename);
+}
+
+#endif
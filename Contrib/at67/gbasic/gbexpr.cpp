@@ -1,23 +1,29 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <ctype.h>
+#include <string.h>
 #include <string>
 #include <algorithm>
 
-#include "expression.h"
+#include "gbexpr.h"
 
 
 namespace GBexpr
 {
-    char* _input;
-    std::string& _output;
+    const char* _input;
+    const char* _start;
+    bool _error = false;
 
     bool _binaryChars[256] = {false};
     bool _octalChars[256] = {false};
     bool _decimalChars[256] = {false};
     bool _hexaDecimalChars[256] = {false};
 
+    const char* _keywords[] = {"LET", "IF", "THEN", "FOR", "TO", "STEP", "NEXT", "GOTO", "GOSUB", "RETURN", "PRINT", "POKE", "DOKE", "PEEK", "DEEK",
+                               "CLS", "REM", "END", "STOP", "AND", "OR", "XOR", "MOD"};
 
-    uint16_t expression(void);
+
+    bool expression(Node& node);
 
 
     void initialise(void)
@@ -126,93 +132,285 @@ namespace GBexpr
         return true;
     }
 
+    bool isKeyword(const std::string& name)
+    {
+        for(int i=0; i<int(sizeof(_keywords)/sizeof(_keywords[0])); i++)
+        {
+            if(name == _keywords[i]) return true;
+        }
+
+        return false;
+    }
+
+    bool isRelational(const Node& node)
+    {
+        if(node._type != Operator) return false;
+        return node._name == "="  ||  node._name == "<>"  ||  node._name == "<"  ||  node._name == ">"  ||  node._name == "<="  ||  node._name == ">=";
+    }
+
+    bool error(const char* function, const char* message)
+    {
+        if(!_error) fprintf(stderr, "GBexpr::%s() : %s : at '%s' in '%s'\n", function, message, _input, _start);
+        _error = true;
+        return false;
+    }
+
     char peek(void)
     {
+        while(*_input == ' '  ||  *_input == '\t') _input++;
         return *_input;
     }
 
     char get(void)
     {
+        peek();
         return *_input++;
     }
 
-    bool number(uint16_t& value)
+    // Matches a symbol or a keyword, keywords can't be followed by the characters of a name
+    bool match(const std::string& token)
     {
-        char uchr;
+        peek();
+        if(strncmp(_input, token.c_str(), token.size()) != 0) return false;
+        if(isalpha((unsigned char)token[0])  &&  (isalnum((unsigned char)_input[token.size()])  ||  _input[token.size()] == '_')) return false;
+
+        _input += token.size();
+        return true;
+    }
 
+    std::string name(void)
+    {
+        std::string result;
+        peek();
+        while(isalnum((unsigned char)*_input)  ||  *_input == '_') result.push_back(*_input++);
+        return result;
+    }
+
+    bool number(uint16_t& value)
+    {
         std::string valueStr;
-        uchr = toupper(peek());
-        valueStr.push_back(uchr); get();
-        uchr = toupper(peek());
-        if((uchr >= '0'  &&  uchr <= '9')  ||  uchr == 'X'  ||  uchr == 'B'  ||  uchr == 'O'  ||  uchr == 'Q')
+        peek();
+        if(*_input == '$') valueStr.push_back(*_input++);
+        while(isalnum((unsigned char)*_input)) valueStr.push_back(toupper(*_input++));
+
+        return stringToU16(valueStr, value);
+    }
+
+    // Comparisons and division are signed
+    bool evaluate(const std::string& op, uint16_t a, uint16_t b, uint16_t& result)
+    {
+        int16_t sa = int16_t(a), sb = int16_t(b);
+        if(op == "+")        result = a + b;
+        else if(op == "-")   result = a - b;
+        else if(op == "*")   result = a * b;
+        else if(op == "AND") result = a & b;
+        else if(op == "OR")  result = a | b;
+        else if(op == "XOR") result = a ^ b;
+        else if(op == "=")   result = (a == b);
+        else if(op == "<>")  result = (a != b);
+        else if(op == "<")   result = (sa < sb);
+        else if(op == ">")   result = (sa > sb);
+        else if(op == "<=")  result = (sa <= sb);
+        else if(op == ">=")  result = (sa >= sb);
+        else
         {
-            valueStr.push_back(uchr); get();
-            while((peek() >= '0'  &&  peek() <= '9')  ||  (peek() >= 'A'  &&  peek() <= 'F'))
-            {
-                valueStr.push_back(get());
-            }
+            if(b == 0) return error("evaluate", "Division by zero");
+            result = (op == "/") ? uint16_t(sa / sb) : uint16_t(sa % sb);
         }
 
-        return stringToU16(valueStr, value);
+        return true;
+    }
+
+    // Folds constants and removes operations that leave their other operand unchanged
+    bool fold(const std::string& op, Node& left, Node& right, Node& node)
+    {
+        bool leftNumber = left._type == Number, rightNumber = right._type == Number;
+        if(leftNumber  &&  rightNumber)
+        {
+            node = Node();
+            return evaluate(op, left._value, right._value, node._value);
+        }
+
+        if(rightNumber  &&  ((right._value == 0  &&  (op == "+"  ||  op == "-"  ||  op == "OR"  ||  op == "XOR"))  ||  (right._value == 1  &&  (op == "*"  ||  op == "/"))))
+        {
+            node = left;
+            return true;
+        }
+        if(leftNumber  &&  ((left._value == 0  &&  (op == "+"  ||  op == "OR"  ||  op == "XOR"))  ||  (left._value == 1  &&  op == "*")))
+        {
+            node = right;
+            return true;
+        }
+
+        node = Node();
+        node._type = Operator;
+        node._name = op;
+        node._operands.push_back(left);
+        node._operands.push_back(right);
+        return true;
     }
 
-    uint16_t factor(void)
+    bool factor(Node& node)
     {
-        uint16_t value = 0;
-        if((peek() >= '0'  &&  peek() <= '9')  ||  peek() == '$')
+        node = Node();
+
+        char chr = peek();
+        if(isdigit((unsigned char)chr)  ||  chr == '$')
+        {
+            if(!number(node._value)) return error("factor", "Bad numeric data");
+            return true;
+        }
+
+        if(chr == '(')
+        {
+            get();
+            if(!expression(node)) return false;
+            if(get() != ')') return error("factor", "Expecting ')'");
+            return true;
+        }
+
+        if(chr == '-')
         {
-            if(!number(value))
+            get();
+            Node operand;
+            if(!factor(operand)) return false;
+            if(operand._type == Number)
             {
-                fprintf(stderr, "Expression::factor() : Bad numeric data in '%s'.\n", _input);
-                value = 0;
+                node._value = -operand._value;
+                return true;
             }
-            return value;
+
+            node._type = Unary;
+            node._name = "-";
+            node._operands.push_back(operand);
+            return true;
         }
-        else if(peek() == '(')
+
+        if(isalpha((unsigned char)chr))
         {
-            get(); // '('
-            uint16_t result = expression();
-            if(peek() != ')')
+            std::string id = name();
+            if(id == "PEEK"  ||  id == "DEEK")
             {
-                fprintf(stderr, "Expression::factor() : Expecting ')' : found '%c' in '%s'.\n", peek(), _input);
-                result = 0;
+                Node operand;
+                if(get() != '(') return error("factor", "Expecting '('");
+                if(!expression(operand)) return false;
+                if(get() != ')') return error("factor", "Expecting ')'");
+
+                node._type = Function;
+                node._name = id;
+                node._operands.push_back(operand);
+                return true;
             }
-            get(); // ')'
-            return result;
+
+            if(isKeyword(id)) return error("factor", "Unexpected keyword");
+
+            node._type = Variable;
+            node._name = id;
+            return true;
         }
-        else if(peek() == '-')
+
+        return error("factor", "Expecting a number, variable or '('");
+    }
+
+    bool term(Node& node)
+    {
+        if(!factor(node)) return false;
+
+        for(;;)
         {
-            get();
-            return -factor();
+            std::string op;
+            if(match("*")) op = "*";
+            else if(match("/")) op = "/";
+            else if(match("MOD")) op = "MOD";
+            else return true;
+
+            Node right;
+            if(!factor(right)) return false;
+            Node left = node;
+            if(!fold(op, left, right, node)) return false;
         }
-        return 0; // error
     }
 
-    uint16_t term(void)
+    bool sum(Node& node)
     {
-        uint16_t result = factor();
-        while(peek() == '*'  ||  peek() == '/')
+        if(!term(node)) return false;
+
+        for(;;)
         {
-            (get() == '*') ? result *= factor() : result /= factor();
+            std::string op;
+            if(match("+")) op = "+";
+            else if(match("-")) op = "-";
+            else return true;
+
+            Node right;
+            if(!term(right)) return false;
+            Node left = node;
+            if(!fold(op, left, right, node)) return false;
         }
+    }
 
-        return result;
+    bool relation(Node& node)
+    {
+        if(!sum(node)) return false;
+
+        // Two character operators first
+        const char* ops[] = {"<>", "<=", ">=", "=", "<", ">"};
+        for(int i=0; i<int(sizeof(ops)/sizeof(ops[0])); i++)
+        {
+            if(!match(ops[i])) continue;
+
+            Node right;
+            if(!sum(right)) return false;
+            Node left = node;
+            return fold(ops[i], left, right, node);
+        }
+
+        return true;
     }
 
-    uint16_t expression(void)
+    bool conjunction(Node& node)
     {
-        uint16_t result = term();
-        while(peek() == '+' || peek() == '-')
+        if(!relation(node)) return false;
+
+        while(match("AND"))
         {
-            (get() == '+') ? result += term() : result -= term();
+            Node right;
+            if(!relation(right)) return false;
+            Node left = node;
+            if(!fold("AND", left, right, node)) return false;
         }
 
-        return result;
+        return true;
     }
 
-    bool parse(const std::string& input, std::string& output)
+    bool expression(Node& node)
     {
-        _input = input.c_str();
-        _output = output;
+        if(!conjunction(node)) return false;
+
+        for(;;)
+        {
+            std::string op;
+            if(match("OR")) op = "OR";
+            else if(match("XOR")) op = "XOR";
+            else return true;
+
+            Node right;
+            if(!conjunction(right)) return false;
+            Node left = node;
+            if(!fold(op, left, right, node)) return false;
+        }
+    }
+
+    // Input is upper case, the whole of it must be one expression
+    bool parse(const std::string& input, Node& node)
+    {
+        _start = input.c_str();
+        _input = _start;
+        _error = false;
+
+        if(!expression(node)) return false;
+        if(peek() != 0) return error("parse", "Unexpected characters");
+
+        return true;
     }
-}
\ No newline at end of file
+}
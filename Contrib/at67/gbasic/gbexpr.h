@@ -1,10 +1,25 @@
 #ifndef GBEXPR_H
 #define GBEXPR_H
 
+#include <stdint.h>
+#include <string>
+#include <vector>
+
 
 namespace GBexpr
+{
     enum ExpressionType {Invalid=-1, None, Valid};
     enum NumericType {BadBase=-1, Decimal, HexaDecimal, Octal, Binary};
+    enum NodeType {Number=0, Variable, Function, Unary, Operator};
+
+    // Operators are + - * / MOD AND OR XOR = <> < > <= >=, unary is -, functions are PEEK and DEEK, comparisons are 1 when true
+    struct Node
+    {
+        NodeType _type = Number;
+        uint16_t _value = 0;
+        std::string _name;
+        std::vector<Node> _operands;
+    };
 
 
     void initialise(void);
@@ -17,7 +32,10 @@ namespace GBexpr
     bool stringToU8(const std::string& token, uint8_t& result);
     bool stringToU16(const std::string& token, uint16_t& result);
 
-    bool parse(const std::string& input, std::string& output);
+    bool isKeyword(const std::string& name);
+    bool isRelational(const Node& node);
+
+    bool parse(const std::string& input, Node& node);
 }
 
 #endif
@@ -2,6 +2,7 @@
 #include <iomanip>
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 
 #include "graphics.h"
 #include "timing.h"
@@ -28,6 +29,14 @@ namespace Graphics
     bool _displayHelpScreen = false;
     uint8_t _displayHelpScreenAlpha = 0;
 
+    // Frameskip only skips video work, emulation always runs every frame
+    int _frameSkip = 0;
+    int _frameSkipAuto = 0;
+    int _frameSkipCount = 0;
+    bool _skipFrame = false;
+    double _renderTime = 0.0;
+    double _emulationTime = 0.0;
+
     uint32_t _pixels[SCREEN_WIDTH * SCREEN_HEIGHT];
     uint32_t _colours[COLOUR_PALETTE];
     uint32_t _hlineTiming[GIGA_HEIGHT];
@@ -224,6 +233,7 @@ namespace Graphics
         _resizable = false;
         _borderless = true;
         _vSync = false;
+        _frameSkip = 0;
 
         // Parse graphics config file
         INIReader iniReader(GRAPHICS_CONFIG_INI);
@@ -264,6 +274,9 @@ namespace Graphics
                          _width = (result == "DESKTOP") ? _width : _width = strtol(result.c_str(), nullptr, 10);
                         getKeyAsString(sectionString, "Height", "DESKTOP", result);
                         _height = (result == "DESKTOP") ? _height : _height = strtol(result.c_str(), nullptr, 10);
+
+                        getKeyAsString(sectionString, "FrameSkip", "0", result);
+                        _frameSkip = (result == "AUTO") ? FRAME_SKIP_AUTO : std::min(std::max(int(strtol(result.c_str(), nullptr, 10)), 0), MAX_FRAME_SKIP);
                     }
                     break;
                 }
@@ -358,7 +371,7 @@ namespace Graphics
     {
         _hlineTiming[pixelY % GIGA_HEIGHT] = colour;
 
-        if(debugging) return;
+        if(debugging  ||  _skipFrame) return;
 
         uint32_t screen = (vgaX % SCREEN_WIDTH)*3 + (pixelY % GIGA_HEIGHT)*4*SCREEN_WIDTH;
         _pixels[screen + 0 + 0*SCREEN_WIDTH] = colour; _pixels[screen + 1 + 0*SCREEN_WIDTH] = colour; _pixels[screen + 2 + 0*SCREEN_WIDTH] = colour;
@@ -369,7 +382,7 @@ namespace Graphics
 
     void refreshPixel(const Cpu::State& S, int vgaX, int vgaY, bool debugging)
     {
-        if(debugging) return;
+        if(debugging  ||  _skipFrame) return;
 
         uint32_t colour = _colours[S._OUT & (COLOUR_PALETTE-1)];
         uint32_t address = (vgaX % SCREEN_WIDTH)*3 + (vgaY % SCREEN_HEIGHT)*SCREEN_WIDTH;
@@ -569,6 +582,8 @@ namespace Graphics
 
     void renderText(void)
     {
+        if(_skipFrame) return;
+
         // Update 60 times per second no matter what the FPS is
         if(Timing::getFrameTime()  &&  Timing::getFrameUpdate())
         {
@@ -587,6 +602,8 @@ namespace Graphics
             }
 
             //drawText(std::string("LEDS:"), _pixels, 0, 0, 0xFFFFFFFF, false, 0);
+            (_frameSkip == FRAME_SKIP_AUTO) ? sprintf(str, "Skip:A%d", _frameSkipAuto) : sprintf(str, "Skip: %d", _frameSkip);
+            drawText(std::string(str), _pixels, 0, 0, 0xFFFFFFFF, false, 0);
             sprintf(str, "FPS %5.1f  XOUT %02X IN %02X", 1.0f / Timing::getFrameTime(), Cpu::getXOUT(), Cpu::getIN());
             drawText(std::string(str), _pixels, 0, FONT_CELL_Y, 0xFFFFFFFF, false, 0);
             drawText("Mode:      Free:", _pixels, 0, 472 - FONT_CELL_Y, 0xFFFFFFFF, false, 0);
@@ -599,12 +616,19 @@ namespace Graphics
             drawText(std::string(str), _pixels, 30, 472 - FONT_CELL_Y, 0xFF00FF00, false, 0);
             sprintf(str, "%d", Cpu::getFreeRAM());
             drawText(std::string(str), _pixels, 96, 472 - FONT_CELL_Y, 0xFFFFFFFF, false, 0);
-            drawText(std::string(VERSION_STR), _pixels, 30, 472, 0xFFFFFFFF, false, 0);
+
+            // Upload status, (e.g. compile errors), replaces the version string until the next upload
+            bool uploadStatus = Loader::getUploadStatus().size() > 0;
+            std::string status = (uploadStatus) ? Loader::getUploadStatus().substr(0, HIGHLIGHT_SIZE) : std::string("     ") + VERSION_STR;
+            status.append(HIGHLIGHT_SIZE - status.size(), ' ');
+            drawText(status, _pixels, 0, 472, (uploadStatus) ? 0xFFFF4040 : 0xFFFFFFFF, false, 0);
         }
     }
 
     void renderTextWindow(void)
     {
+        if(_skipFrame) return;
+
         // Update 60 times per second no matter what the FPS is
         if(Timing::getFrameTime()  &&  Timing::getFrameUpdate())
         {
@@ -734,17 +758,66 @@ namespace Graphics
         }
     }
 
+    // Auto mode skips just enough frames to amortise the measured render cost over the headroom left by emulation
+    void updateFrameSkip(void)
+    {
+        int frameSkip = _frameSkip;
+        if(_frameSkip == FRAME_SKIP_AUTO)
+        {
+            double headroom = Timing::getTimingHack() - _emulationTime;
+            if(_emulationTime + _renderTime <= Timing::getTimingHack())
+            {
+                _frameSkipAuto = 0;
+            }
+            else
+            {
+                _frameSkipAuto = (headroom <= 0.0) ? MAX_FRAME_SKIP : std::min(int(ceil(_renderTime / headroom)) - 1, MAX_FRAME_SKIP);
+            }
+
+            frameSkip = _frameSkipAuto;
+        }
+
+        _skipFrame = (frameSkip > 0)  &&  (_frameSkipCount++ < frameSkip);
+        if(!_skipFrame) _frameSkipCount = 0;
+    }
+
     void render(bool synchronise)
     {
-        drawLeds();
-        renderText();
-        renderTextWindow();
+        static uint64_t prevRenderCounter = SDL_GetPerformanceCounter();
 
-        SDL_UpdateTexture(_screenTexture, NULL, _pixels, SCREEN_WIDTH * sizeof(uint32_t));
-        SDL_RenderCopy(_renderer, _screenTexture, NULL, NULL);
-        renderHelpScreen();
-        SDL_RenderPresent(_renderer);
-        if(synchronise) Timing::synchronise();
+        // Debugger refreshes are never skipped
+        if(synchronise)
+        {
+            uint64_t renderCounter = SDL_GetPerformanceCounter();
+            _emulationTime = _emulationTime*0.9 + 0.1*double(renderCounter - prevRenderCounter) / double(SDL_GetPerformanceFrequency());
+        }
+        else
+        {
+            _skipFrame = false;
+        }
+
+        if(!_skipFrame)
+        {
+            uint64_t renderCounter = SDL_GetPerformanceCounter();
+
+            drawLeds();
+            renderText();
+            renderTextWindow();
+
+            SDL_UpdateTexture(_screenTexture, NULL, _pixels, SCREEN_WIDTH * sizeof(uint32_t));
+            SDL_RenderCopy(_renderer, _screenTexture, NULL, NULL);
+            renderHelpScreen();
+            SDL_RenderPresent(_renderer);
+
+            _renderTime = _renderTime*0.9 + 0.1*double(SDL_GetPerformanceCounter() - renderCounter) / double(SDL_GetPerformanceFrequency());
+        }
+
+        if(synchronise)
+        {
+            Timing::synchronise();
+            updateFrameSkip();
+            prevRenderCounter = SDL_GetPerformanceCounter();
+        }
     }
 
 
@@ -1327,6 +1400,7 @@ namespace Graphics
 
                     case SDLK_ESCAPE:
                     {
+                        Loader::shutdown();
                         SDL_Quit();
                         exit(0);
                     }
@@ -36,6 +36,8 @@
 #define CPUA_START       78
 #define CPUB_START       120
 #define HIGHLIGHT_SIZE   23
+#define MAX_FRAME_SKIP   8
+#define FRAME_SKIP_AUTO  -1
 
 #define GRAPHICS_CONFIG_INI  "graphics_config.ini"
 
@@ -0,0 +1,859 @@
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <unordered_map>
+
+#include "mapping.h"
+#include "linker.h"
+
+
+namespace Linker
+{
+    struct Region
+    {
+        uint32_t _start;
+        uint32_t _end;
+    };
+
+
+    // Free RAM of a 32K Gigatron, pages 2 to 4 lose their audio channel bytes and video memory pages only have their
+    // right hand 96 bytes free, a 64K Gigatron adds the whole of the upper 32K
+    void getFreeRam(bool ram64k, std::vector<Region>& regions)
+    {
+        regions.clear();
+        regions.push_back({0x0200, 0x02FA});
+        regions.push_back({0x0300, 0x03FA});
+        regions.push_back({0x0400, 0x04FA});
+        regions.push_back({0x0500, 0x0800});
+        for(uint32_t page=0x08; page<0x80; page++) regions.push_back({(page <<8) + 0xA0, (page + 1) <<8});
+        if(ram64k) regions.push_back({0x8000, 0x10000});
+    }
+
+
+    // Removes [start, end) from the free regions
+    void reserveRam(std::vector<Region>& regions, uint32_t start, uint32_t end)
+    {
+        for(int i=0; i<int(regions.size()); i++)
+        {
+            if(start >= regions[i]._end  ||  end <= regions[i]._start) continue;
+
+            Region after = {end, regions[i]._end};
+            regions[i]._end = std::max(start, regions[i]._start);
+            if(after._end > after._start)
+            {
+                regions.insert(regions.begin() + i + 1, after);
+                i++;
+            }
+        }
+
+        regions.erase(std::remove_if(regions.begin(), regions.end(), [](const Region& region) {return region._end <= region._start;}), regions.end());
+    }
+
+
+    void writeU8(std::vector<uint8_t>& buffer, uint8_t data)
+    {
+        buffer.push_back(data);
+    }
+
+    void writeU16(std::vector<uint8_t>& buffer, uint16_t data)
+    {
+        buffer.push_back(uint8_t(data & 0x00FF));
+        buffer.push_back(uint8_t((data & 0xFF00) >>8));
+    }
+
+    void writeString(std::vector<uint8_t>& buffer, const std::string& data)
+    {
+        size_t length = std::min(data.size(), size_t(255));
+        buffer.push_back(uint8_t(length));
+        buffer.insert(buffer.end(), data.begin(), data.begin() + length);
+    }
+
+    bool saveObject(const std::string& filename, const Object& object)
+    {
+        std::vector<uint8_t> buffer(OBJECT_MAGIC, OBJECT_MAGIC + strlen(OBJECT_MAGIC));
+        writeU16(buffer, object._entrySection);
+        writeU16(buffer, object._entryOffset);
+
+        writeU16(buffer, uint16_t(object._sections.size()));
+        for(int i=0; i<int(object._sections.size()); i++)
+        {
+            const Section& section = object._sections[i];
+            writeU8(buffer, uint8_t(section._isCode) | (uint8_t(section._isAbsolute) <<1));
+            writeU16(buffer, section._address);
+            writeU16(buffer, uint16_t(section._data.size()));
+            buffer.insert(buffer.end(), section._data.begin(), section._data.end());
+
+            writeU16(buffer, uint16_t(section._cuts.size()));
+            for(int j=0; j<int(section._cuts.size()); j++)
+            {
+                writeU16(buffer, section._cuts[j]._offset);
+                writeU8(buffer, section._cuts[j]._fallThrough);
+            }
+        }
+
+        writeU16(buffer, uint16_t(object._exports.size()));
+        for(int i=0; i<int(object._exports.size()); i++)
+        {
+            writeU16(buffer, object._exports[i]._section);
+            writeU16(buffer, object._exports[i]._offset);
+            writeString(buffer, object._exports[i]._name);
+        }
+
+        writeU16(buffer, uint16_t(object._imports.size()));
+        for(int i=0; i<int(object._imports.size()); i++) writeString(buffer, object._imports[i]);
+
+        writeU16(buffer, uint16_t(object._relocations.size()));
+        for(int i=0; i<int(object._relocations.size()); i++)
+        {
+            writeU8(buffer, uint8_t(object._relocations[i]._type));
+            writeU16(buffer, object._relocations[i]._section);
+            writeU16(buffer, object._relocations[i]._offset);
+            writeU16(buffer, object._relocations[i]._target);
+        }
+
+        writeU16(buffer, uint16_t(object._reserves.size()));
+        for(int i=0; i<int(object._reserves.size()); i++)
+        {
+            writeU16(buffer, object._reserves[i]._address);
+            writeU16(buffer, object._reserves[i]._size);
+        }
+
+        FILE* file = fopen(filename.c_str(), "wb");
+        if(file == nullptr)
+        {
+            fprintf(stderr, "Linker::saveObject() : failed to open '%s'\n", filename.c_str());
+            return false;
+        }
+
+        bool success = (fwrite(&buffer[0], 1, buffer.size(), file) == buffer.size());
+        fclose(file);
+        if(!success) fprintf(stderr, "Linker::saveObject() : failed to write '%s'\n", filename.c_str());
+
+        return success;
+    }
+
+
+    // Every read is bounds checked, a short read marks the whole object as bad
+    struct Reader
+    {
+        const uint8_t* _data;
+        size_t _size;
+        size_t _offset = 0;
+        bool _good = true;
+
+        bool has(size_t size)
+        {
+            if(_offset + size > _size) _good = false;
+            return _good;
+        }
+
+        uint8_t readU8(void)
+        {
+            if(!has(1)) return 0;
+            return _data[_offset++];
+        }
+
+        uint16_t readU16(void)
+        {
+            if(!has(2)) return 0;
+            uint16_t data = _data[_offset] | (_data[_offset + 1] <<8);
+            _offset += 2;
+            return data;
+        }
+
+        std::string readString(void)
+        {
+            uint8_t length = readU8();
+            if(!has(length)) return "";
+            std::string data((const char*)&_data[_offset], length);
+            _offset += length;
+            return data;
+        }
+    };
+
+    bool loadObject(const std::string& filename, Object& object)
+    {
+        Mapping::File file;
+        if(!Mapping::mapFile(filename, file)) return false;
+
+        Reader reader = {file._data, file._size};
+        size_t magicSize = strlen(OBJECT_MAGIC);
+        if(!reader.has(magicSize)  ||  memcmp(file._data, OBJECT_MAGIC, magicSize) != 0)
+        {
+            fprintf(stderr, "Linker::loadObject() : '%s' is not an object file\n", filename.c_str());
+            Mapping::unmapFile(file);
+            return false;
+        }
+        reader._offset = magicSize;
+
+        object = Object();
+        object._name = filename;
+        object._entrySection = reader.readU16();
+        object._entryOffset = reader.readU16();
+
+        int numSections = reader.readU16();
+        for(int i=0; i<numSections  &&  reader._good; i++)
+        {
+            Section section;
+            uint8_t flags = reader.readU8();
+            section._isCode = (flags & 0x01) != 0;
+            section._isAbsolute = (flags & 0x02) != 0;
+            section._address = reader.readU16();
+            uint16_t size = reader.readU16();
+            if(reader.has(size)) section._data.assign(&file._data[reader._offset], &file._data[reader._offset] + size);
+            reader._offset += size;
+
+            int numCuts = reader.readU16();
+            for(int j=0; j<numCuts  &&  reader._good; j++)
+            {
+                Cut cut;
+                cut._offset = reader.readU16();
+                cut._fallThrough = (reader.readU8() != 0);
+                section._cuts.push_back(cut);
+            }
+
+            object._sections.push_back(section);
+        }
+
+        int numExports = reader.readU16();
+        for(int i=0; i<numExports  &&  reader._good; i++)
+        {
+            Symbol symbol;
+            symbol._section = reader.readU16();
+            symbol._offset = reader.readU16();
+            symbol._name = reader.readString();
+            object._exports.push_back(symbol);
+        }
+
+        int numImports = reader.readU16();
+        for(int i=0; i<numImports  &&  reader._good; i++) object._imports.push_back(reader.readString());
+
+        int numRelocations = reader.readU16();
+        for(int i=0; i<numRelocations  &&  reader._good; i++)
+        {
+            Relocation relocation;
+            relocation._type = RelocationType(reader.readU8());
+            relocation._section = reader.readU16();
+            relocation._offset = reader.readU16();
+            relocation._target = reader.readU16();
+            object._relocations.push_back(relocation);
+        }
+
+        int numReserves = reader.readU16();
+        for(int i=0; i<numReserves  &&  reader._good; i++)
+        {
+            Reserve reserve;
+            reserve._address = reader.readU16();
+            reserve._size = reader.readU16();
+            object._reserves.push_back(reserve);
+        }
+
+        Mapping::unmapFile(file);
+
+        if(!reader._good)
+        {
+            fprintf(stderr, "Linker::loadObject() : '%s' is truncated\n", filename.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+
+    bool validateObject(const Object& object)
+    {
+        int numSections = int(object._sections.size());
+        int numTargets = numSections + int(object._imports.size());
+        if(numSections  &&  object._entrySection >= numSections)
+        {
+            fprintf(stderr, "Linker::validateObject() : '%s' has a bad entry section %d\n", object._name.c_str(), object._entrySection);
+            return false;
+        }
+
+        for(int i=0; i<numSections; i++)
+        {
+            const Section& section = object._sections[i];
+            for(int j=0; j<int(section._cuts.size()); j++)
+            {
+                if(!section._isCode  ||  section._isAbsolute  ||  section._cuts[j]._offset == 0  ||  section._cuts[j]._offset >= section._data.size()  ||  (j  &&  section._cuts[j]._offset <= section._cuts[j - 1]._offset))
+                {
+                    fprintf(stderr, "Linker::validateObject() : '%s' has a bad cut %d in section %d\n", object._name.c_str(), j, i);
+                    return false;
+                }
+            }
+        }
+
+        for(int i=0; i<int(object._exports.size()); i++)
+        {
+            if(object._exports[i]._section >= numSections)
+            {
+                fprintf(stderr, "Linker::validateObject() : '%s' exports '%s' from bad section %d\n", object._name.c_str(), object._exports[i]._name.c_str(), object._exports[i]._section);
+                return false;
+            }
+        }
+
+        for(int i=0; i<int(object._relocations.size()); i++)
+        {
+            const Relocation& relocation = object._relocations[i];
+            int width = (relocation._type == Word) ? 2 : 1;
+            int limit = (relocation._type == HiByte) ? numSections : numTargets;
+            if(relocation._section >= numSections  ||  relocation._target >= limit  ||  relocation._offset + width > int(object._sections[relocation._section]._data.size()))
+            {
+                fprintf(stderr, "Linker::validateObject() : '%s' has a bad relocation %d\n", object._name.c_str(), i);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool isVideoRam(const Region& region)
+    {
+        return region._start >= 0x0800  &&  region._start < 0x8000;
+    }
+
+    // Code can't cross a page, it moves up to the next page if it would
+    uint32_t getRegionStart(const Region& region, uint32_t size, bool isCode)
+    {
+        uint32_t start = region._start;
+        if(isCode  &&  (start >>8) != ((start + size - 1) >>8)) start = ((start >>8) + 1) <<8;
+        return start;
+    }
+
+    void allocateRegion(std::vector<Region>& regions, int index, uint32_t start, uint32_t size)
+    {
+        Region after = {start + size, regions[index]._end};
+        regions[index]._end = start;
+        if(after._end > after._start) regions.insert(regions.begin() + index + 1, after);
+        if(regions[index]._end == regions[index]._start) regions.erase(regions.begin() + index);
+    }
+
+    // Smallest region that holds size bytes, optionally only the gaps to the right of video memory
+    int getBestFit(const std::vector<Region>& regions, uint32_t size, bool isCode, bool videoOnly, uint32_t& start)
+    {
+        int best = -1;
+        uint32_t bestWaste = 0;
+        for(int i=0; i<int(regions.size()); i++)
+        {
+            if(videoOnly  &&  !isVideoRam(regions[i])) continue;
+
+            uint32_t regionStart = getRegionStart(regions[i], size, isCode);
+            if(regionStart + size > regions[i]._end) continue;
+
+            uint32_t waste = regions[i]._end - regionStart - size;
+            if(best == -1  ||  waste < bestWaste)
+            {
+                best = i;
+                bestWaste = waste;
+                start = regionStart;
+            }
+        }
+
+        return best;
+    }
+
+    // First region that holds size bytes at the same offset within a page as address, so that high bytes only move by whole pages
+    int getAlignedFit(const std::vector<Region>& regions, uint32_t size, uint16_t address, bool videoOnly, uint32_t& start)
+    {
+        for(int i=0; i<int(regions.size()); i++)
+        {
+            if(videoOnly  &&  !isVideoRam(regions[i])) continue;
+
+            uint32_t aligned = (regions[i]._start & 0xFFFFFF00) | (address & 0x00FF);
+            if(aligned < regions[i]._start) aligned += 0x0100;
+            if(aligned + size <= regions[i]._end)
+            {
+                start = aligned;
+                return i;
+            }
+        }
+
+        return -1;
+    }
+
+    // Largest block of a code section, starting at offset and ending at one of its cuts, that fits into a region
+    int getSplitFit(const std::vector<Region>& regions, const Section& section, uint16_t offset, bool videoOnly, uint32_t& start, Cut& cut)
+    {
+        int best = -1;
+        uint32_t bestSize = 0;
+        for(int i=0; i<int(regions.size()); i++)
+        {
+            if(videoOnly  &&  !isVideoRam(regions[i])) continue;
+
+            // Either the start of the region or the start of its next page
+            uint32_t starts[2] = {regions[i]._start, ((regions[i]._start >>8) + 1) <<8};
+            for(int j=0; j<2; j++)
+            {
+                if(starts[j] >= regions[i]._end) continue;
+
+                uint32_t available = std::min(regions[i]._end, ((starts[j] >>8) + 1) <<8) - starts[j];
+                for(int k=int(section._cuts.size())-1; k>=0; k--)
+                {
+                    const Cut& candidate = section._cuts[k];
+                    if(candidate._offset <= offset) break;
+
+                    uint32_t size = candidate._offset - offset;
+                    if(size + ((candidate._fallThrough) ? PACK_TRAMPOLINE_SIZE : 0) > available) continue;
+
+                    if(size > bestSize)
+                    {
+                        best = i;
+                        bestSize = size;
+                        start = starts[j];
+                        cut = candidate;
+                    }
+                    break;
+                }
+            }
+        }
+
+        return best;
+    }
+
+    // Absolute sections collide with each other below 0x0200, anything from 0x0200 up must be in free RAM and is taken out of it
+    bool placeAbsolute(const std::vector<Object>& objects, const std::vector<Placement>& placements, std::vector<Region>& regions, const Placement& placement, bool verbose)
+    {
+        const Section& section = objects[placement._object]._sections[placement._section];
+        for(int i=0; i<int(placements.size()); i++)
+        {
+            const Section& other = objects[placements[i]._object]._sections[placements[i]._section];
+            if(other._isAbsolute  &&  section._address < other._address + other._data.size()  &&  other._address < section._address + section._data.size())
+            {
+                if(verbose) fprintf(stderr, "Linker::placeSections() : absolute section 0x%04X of '%s' overlaps 0x%04X of '%s'\n", section._address, objects[placement._object]._name.c_str(),
+                                                                                                                                 other._address, objects[placements[i]._object]._name.c_str());
+                return false;
+            }
+        }
+
+        uint32_t start = std::max(uint32_t(section._address), uint32_t(0x0200)), end = section._address + uint32_t(section._data.size());
+        if(end > start)
+        {
+            uint32_t free = 0;
+            for(int i=0; i<int(regions.size()); i++)
+            {
+                if(start < regions[i]._end  &&  regions[i]._start < end) free += std::min(end, regions[i]._end) - std::max(start, regions[i]._start);
+            }
+            if(free != end - start)
+            {
+                if(verbose) fprintf(stderr, "Linker::placeSections() : absolute section 0x%04X of '%s' runs into RAM that isn't free, 0x%04X <-> 0x%04X\n", section._address,
+                                                                                                                                      objects[placement._object]._name.c_str(), start, end - 1);
+                return false;
+            }
+
+            reserveRam(regions, start, end);
+        }
+
+        return true;
+    }
+
+    // Largest sections first, code sections must stay within a page, data sections only need contiguous RAM. Without packing sections are placed
+    // whole into the first free RAM that fits, packing prefers the gaps to the right of video memory, best fit, and splits code sections at their
+    // cuts to fill them, leaving the rest of RAM free
+    bool placeSections(const std::vector<Object>& objects, bool ram64k, bool pack, std::vector<Placement>& placements, bool verbose)
+    {
+        std::vector<Region> regions;
+        getFreeRam(ram64k, regions);
+        for(int i=0; i<int(objects.size()); i++)
+        {
+            for(int j=0; j<int(objects[i]._reserves.size()); j++) reserveRam(regions, objects[i]._reserves[j]._address, objects[i]._reserves[j]._address + objects[i]._reserves[j]._size);
+        }
+
+        std::vector<Placement> sections;
+        for(int i=0; i<int(objects.size()); i++)
+        {
+            for(int j=0; j<int(objects[i]._sections.size()); j++)
+            {
+                Placement placement = {i, j, 0, uint16_t(objects[i]._sections[j]._data.size()), 0x0000};
+                sections.push_back(placement);
+            }
+        }
+
+        std::stable_sort(sections.begin(), sections.end(), [](const Placement& a, const Placement& b) {return a._size > b._size;});
+
+        // Sections whose high bytes are relocated keep their offset within a page and are never split
+        std::vector<std::vector<bool>> aligned(objects.size());
+        for(int i=0; i<int(objects.size()); i++)
+        {
+            aligned[i].resize(objects[i]._sections.size(), false);
+            for(int j=0; j<int(objects[i]._relocations.size()); j++)
+            {
+                if(objects[i]._relocations[j]._type == HiByte) aligned[i][objects[i]._relocations[j]._target] = true;
+            }
+        }
+
+        // Absolute sections first, so that the RAM they reach into isn't given to anything else
+        placements.clear();
+        for(int i=0; i<int(sections.size()); i++)
+        {
+            const Section& section = objects[sections[i]._object]._sections[sections[i]._section];
+            if(!section._isAbsolute  ||  sections[i]._size == 0) continue;
+
+            if(!placeAbsolute(objects, placements, regions, sections[i], verbose)) return false;
+            sections[i]._address = section._address;
+            placements.push_back(sections[i]);
+        }
+
+        for(int i=0; i<int(sections.size()); i++)
+        {
+            const Section& section = objects[sections[i]._object]._sections[sections[i]._section];
+            uint32_t size = sections[i]._size;
+            if(size == 0)
+            {
+                placements.push_back(sections[i]);
+                continue;
+            }
+            if(section._isAbsolute) continue;
+
+            uint16_t offset = 0;
+            while(offset < size)
+            {
+                Placement block = sections[i];
+                block._offset = offset;
+                block._size = uint16_t(size - offset);
+
+                uint32_t start = 0;
+                Cut cut = {0, false};
+                int region = -1;
+                if(aligned[sections[i]._object][sections[i]._section])
+                {
+                    if(pack) region = getAlignedFit(regions, block._size, section._address, true, start);
+                    if(region == -1) region = getAlignedFit(regions, block._size, section._address, false, start);
+                }
+                else if(!pack)
+                {
+                    for(int j=0; j<int(regions.size())  &&  region == -1; j++)
+                    {
+                        start = getRegionStart(regions[j], block._size, section._isCode);
+                        if(start + block._size <= regions[j]._end) region = j;
+                    }
+                }
+                else
+                {
+                    region = getBestFit(regions, block._size, section._isCode, true, start);
+                    if(region == -1  &&  section._isCode)
+                    {
+                        region = getSplitFit(regions, section, offset, true, start, cut);
+                        if(region >= 0  &&  cut._offset - offset < PACK_MIN_BLOCK) region = -1;
+                    }
+                    if(region == -1) region = getBestFit(regions, block._size, section._isCode, false, start);
+                    if(region == -1  &&  section._isCode) region = getSplitFit(regions, section, offset, false, start, cut);
+
+                    if(cut._offset)
+                    {
+                        block._size = cut._offset - offset;
+                        block._trampoline = cut._fallThrough;
+                    }
+                }
+
+                if(region == -1)
+                {
+                    if(verbose) fprintf(stderr, "Linker::placeSections() : no room for section %d of '%s', %d bytes\n", sections[i]._section, objects[sections[i]._object]._name.c_str(), int(size - offset));
+                    return false;
+                }
+
+                block._address = uint16_t(start);
+                allocateRegion(regions, region, start, block._size + ((block._trampoline) ? PACK_TRAMPOLINE_SIZE : 0));
+                placements.push_back(block);
+                offset += block._size;
+            }
+        }
+
+        // Back into object, section and block order
+        std::sort(placements.begin(), placements.end(), [](const Placement& a, const Placement& b)
+        {
+            if(a._object != b._object) return a._object < b._object;
+            return (a._section != b._section) ? a._section < b._section : a._offset < b._offset;
+        });
+
+        return true;
+    }
+
+
+    // Placements of the blocks of each section of each object
+    typedef std::vector<std::vector<std::vector<int>>> Blocks;
+
+    void getBlocks(const std::vector<Object>& objects, const std::vector<Placement>& placements, Blocks& blocks)
+    {
+        blocks.clear();
+        blocks.resize(objects.size());
+        for(int i=0; i<int(objects.size()); i++) blocks[i].resize(objects[i]._sections.size());
+        for(int i=0; i<int(placements.size()); i++) blocks[placements[i]._object][placements[i]._section].push_back(i);
+    }
+
+    const Placement& findBlock(const std::vector<Placement>& placements, const std::vector<int>& blocks, int offset)
+    {
+        for(int i=int(blocks.size())-1; i>0; i--)
+        {
+            if(offset >= placements[blocks[i]]._offset) return placements[blocks[i]];
+        }
+
+        return placements[blocks[0]];
+    }
+
+    uint16_t getLinkedAddress(const std::vector<Placement>& placements, const std::vector<int>& blocks, int offset)
+    {
+        const Placement& block = findBlock(placements, blocks, offset);
+        return uint16_t(block._address + offset - block._offset);
+    }
+
+    bool resolveImports(const std::vector<Object>& objects, const std::vector<Placement>& placements, const Blocks& blocks, std::vector<std::vector<uint16_t>>& importAddresses)
+    {
+        // Exports that are in more than one object are only an error if they are imported
+        std::unordered_map<std::string, std::vector<int>> exports;
+        for(int i=0; i<int(objects.size()); i++)
+        {
+            for(int j=0; j<int(objects[i]._exports.size()); j++) exports[objects[i]._exports[j]._name].push_back(i);
+        }
+
+        importAddresses.resize(objects.size());
+        for(int i=0; i<int(objects.size()); i++)
+        {
+            for(int j=0; j<int(objects[i]._imports.size()); j++)
+            {
+                const std::string& name = objects[i]._imports[j];
+                auto it = exports.find(name);
+                if(it == exports.end())
+                {
+                    fprintf(stderr, "Linker::resolveImports() : '%s' imports '%s', no object exports it\n", objects[i]._name.c_str(), name.c_str());
+                    return false;
+                }
+
+                std::vector<int> owners = it->second;
+                owners.erase(std::unique(owners.begin(), owners.end()), owners.end());
+                if(owners.size() > 1)
+                {
+                    fprintf(stderr, "Linker::resolveImports() : '%s' imports '%s', it is exported by '%s' and '%s'\n", objects[i]._name.c_str(), name.c_str(), objects[owners[0]]._name.c_str(),
+                                                                                                                         objects[owners[1]]._name.c_str());
+                    return false;
+                }
+
+                const Object& owner = objects[owners[0]];
+                for(int k=0; k<int(owner._exports.size()); k++)
+                {
+                    if(owner._exports[k]._name != name) continue;
+
+                    importAddresses[i].push_back(getLinkedAddress(placements, blocks[owners[0]][owner._exports[k]._section], owner._exports[k]._offset));
+                    break;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    // Relocations hold their original values, sections move by the difference between their linked and assembled addresses
+    // and imports by their resolved addresses, (imports are assembled as 0x0000). Split sections are code within a page, the
+    // low byte of the original value finds the block that the relocation moves with
+    bool relocate(const Object& object, const std::vector<Placement>& placements, const std::vector<std::vector<int>>& blocks, const std::vector<uint16_t>& importAddresses,
+                  std::vector<std::vector<uint8_t>>& sections)
+    {
+        sections.clear();
+        for(int i=0; i<int(object._sections.size()); i++) sections.push_back(object._sections[i]._data);
+
+        int numSections = int(object._sections.size());
+        for(int i=0; i<int(object._relocations.size()); i++)
+        {
+            const Relocation& relocation = object._relocations[i];
+            uint8_t* data = &sections[relocation._section][relocation._offset];
+            uint16_t value = (relocation._type == Word) ? uint16_t(data[0] | (data[1] <<8)) : data[0];
+
+            uint16_t target, delta;
+            if(relocation._type == HiByte)
+            {
+                // Only the high byte of the label is known, the section isn't split and moves by whole pages
+                const Section& section = object._sections[relocation._target];
+                delta = uint16_t(placements[blocks[relocation._target][0]]._address - section._address);
+                data[0] = uint8_t(data[0] + (delta >>8));
+                continue;
+            }
+            else if(relocation._target < numSections)
+            {
+                const Section& section = object._sections[relocation._target];
+                int offset = (relocation._type == Word) ? int16_t(value - section._address) : uint8_t(value + ((relocation._type == Branch) ? 2 : 0) - section._address);
+                const Placement& block = findBlock(placements, blocks[relocation._target], offset);
+                delta = uint16_t(block._address - (section._address + block._offset));
+                target = uint16_t(section._address + offset + delta);
+            }
+            else
+            {
+                target = importAddresses[relocation._target - numSections];
+                delta = target;
+            }
+
+            if(relocation._type == Word)
+            {
+                uint16_t word = value + delta;
+                data[0] = uint8_t(word & 0x00FF);
+                data[1] = uint8_t((word & 0xFF00) >>8);
+                continue;
+            }
+
+            data[0] = uint8_t(data[0] + (delta & 0x00FF));
+
+            // Branches can only reach their own page
+            uint16_t site = getLinkedAddress(placements, blocks[relocation._section], relocation._offset);
+            if(relocation._type == Branch  &&  (site >>8) != (target >>8))
+            {
+                fprintf(stderr, "Linker::relocate() : branch at 0x%04X in '%s' can't reach 0x%04X after linking\n", site, object._name.c_str(), target);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void addGt1Data(Loader::Gt1File& gt1File, uint16_t address, const std::vector<uint8_t>& data)
+    {
+        // Segments can't cross pages
+        for(size_t i=0; i<data.size();)
+        {
+            uint16_t start = uint16_t(address + i);
+            size_t size = std::min(data.size() - i, size_t(0x0100 - (start & 0x00FF)));
+
+            Loader::Gt1Segment segment;
+            segment._hiAddress = uint8_t((start & 0xFF00) >>8);
+            segment._loAddress = uint8_t(start & 0x00FF);
+            segment._segmentSize = uint8_t(size);
+            segment._dataBytes.assign(data.begin() + i, data.begin() + i + size);
+            gt1File._segments.push_back(segment);
+            i += size;
+        }
+    }
+
+    bool link(const std::vector<Object>& objects, bool ram64k, bool pack, Loader::Gt1File& gt1File, std::vector<Placement>& placements)
+    {
+        if(objects.size() == 0)
+        {
+            fprintf(stderr, "Linker::link() : nothing to link\n");
+            return false;
+        }
+
+        for(int i=0; i<int(objects.size()); i++)
+        {
+            if(!validateObject(objects[i])) return false;
+        }
+
+        if(!placeSections(objects, ram64k, pack, placements, true)) return false;
+
+        Blocks blocks;
+        getBlocks(objects, placements, blocks);
+
+        std::vector<std::vector<uint16_t>> importAddresses;
+        if(!resolveImports(objects, placements, blocks, importAddresses)) return false;
+
+        // Relocated blocks in address order, adjacent blocks are merged into the same segments
+        std::vector<std::pair<uint16_t, std::vector<uint8_t>>> data;
+        for(int i=0; i<int(objects.size()); i++)
+        {
+            std::vector<std::vector<uint8_t>> sections;
+            if(!relocate(objects[i], placements, blocks[i], importAddresses[i], sections)) return false;
+
+            for(int j=0; j<int(sections.size()); j++)
+            {
+                for(int k=0; k<int(blocks[i][j].size()); k++)
+                {
+                    const Placement& block = placements[blocks[i][j][k]];
+                    if(block._size == 0) continue;
+
+                    std::vector<uint8_t> bytes(sections[j].begin() + block._offset, sections[j].begin() + block._offset + block._size);
+
+                    // LDWI target-2, STW vPC, (vCPU only advances the low byte of vPC)
+                    if(block._trampoline)
+                    {
+                        uint16_t target = getLinkedAddress(placements, blocks[i][j], block._offset + block._size);
+                        uint8_t trampoline[PACK_TRAMPOLINE_SIZE] = {0x11, uint8_t((target - 2) & 0x00FF), uint8_t((target & 0xFF00) >>8), 0x2B, 0x16};
+                        bytes.insert(bytes.end(), trampoline, trampoline + PACK_TRAMPOLINE_SIZE);
+                    }
+
+                    data.push_back(std::make_pair(block._address, bytes));
+                }
+            }
+        }
+        std::sort(data.begin(), data.end(), [](const std::pair<uint16_t, std::vector<uint8_t>>& a, const std::pair<uint16_t, std::vector<uint8_t>>& b) {return a.first < b.first;});
+
+        gt1File = Loader::Gt1File();
+        for(int i=0; i<int(data.size()); i++)
+        {
+            uint16_t address = data[i].first;
+            std::vector<uint8_t> bytes = data[i].second;
+            while(i + 1 < int(data.size())  &&  data[i + 1].first == address + bytes.size())
+            {
+                bytes.insert(bytes.end(), data[i + 1].second.begin(), data[i + 1].second.end());
+                i++;
+            }
+
+            addGt1Data(gt1File, address, bytes);
+        }
+
+        // The first object is the program, its entry point is the start address
+        const Object& program = objects[0];
+        uint16_t start = (program._sections.size()) ? getLinkedAddress(placements, blocks[0][program._entrySection], program._entryOffset) : 0x0000;
+        gt1File._hiStart = uint8_t((start & 0xFF00) >>8);
+        gt1File._loStart = uint8_t(start & 0x00FF);
+
+        return true;
+    }
+
+    void printPlacements(const std::vector<Object>& objects, const std::vector<Placement>& placements)
+    {
+        fprintf(stderr, "\n************************************************************\n");
+        fprintf(stderr, "* Object  : Section :  Type  : Assembled :  Linked  :  Size\n");
+        fprintf(stderr, "************************************************************\n");
+        for(int i=0; i<int(placements.size()); i++)
+        {
+            const Section& section = objects[placements[i]._object]._sections[placements[i]._section];
+            fprintf(stderr, "*  %4d   :  %4d   :  %s  :   0x%04x  :  0x%04x  : %5d bytes%s\n", placements[i]._object, placements[i]._section, (section._isAbsolute) ? "Abs " : (section._isCode) ? "Code" : "Data",
+                                                                                            section._address + placements[i]._offset, placements[i]._address, int(placements[i]._size),
+                                                                                            (placements[i]._trampoline) ? " + trampoline" : "");
+        }
+        fprintf(stderr, "************************************************************\n");
+        for(int i=0; i<int(objects.size()); i++) fprintf(stderr, "* %4d : %s\n", i, objects[i]._name.c_str());
+        fprintf(stderr, "************************************************************\n");
+    }
+
+    void getRamUsage(const std::vector<Object>& objects, const std::vector<Placement>& placements, int& mainRam, int& videoRam, int& trampolines)
+    {
+        mainRam = videoRam = trampolines = 0;
+        for(int i=0; i<int(placements.size()); i++)
+        {
+            const Placement& block = placements[i];
+            if(objects[block._object]._sections[block._section]._isAbsolute) continue;
+
+            int size = block._size + ((block._trampoline) ? PACK_TRAMPOLINE_SIZE : 0);
+            Region region = {block._address, uint32_t(block._address + size)};
+            if(isVideoRam(region)) videoRam += size; else mainRam += size;
+            if(block._trampoline) trampolines++;
+        }
+    }
+
+    // Main RAM is everything outside of the gaps to the right of video memory, it is what packing saves compared to placing sections whole
+    void printPacking(const std::vector<Object>& objects, const std::vector<Placement>& placements, bool ram64k)
+    {
+        int mainRam, videoRam, trampolines;
+        getRamUsage(objects, placements, mainRam, videoRam, trampolines);
+
+        std::vector<Placement> unpacked;
+        bool fits = placeSections(objects, ram64k, false, unpacked, false);
+        int unpackedMainRam = 0, unpackedVideoRam = 0, unpackedTrampolines = 0;
+        if(fits) getRamUsage(objects, unpacked, unpackedMainRam, unpackedVideoRam, unpackedTrampolines);
+
+        fprintf(stderr, "\n************************************************************\n");
+        fprintf(stderr, "*  Packing       :  Unpacked   :   Packed\n");
+        fprintf(stderr, "************************************************************\n");
+        if(fits)
+        {
+            fprintf(stderr, "* Main RAM       : %5d bytes : %5d bytes\n", unpackedMainRam, mainRam);
+            fprintf(stderr, "* Video RAM gaps : %5d bytes : %5d bytes\n", unpackedVideoRam, videoRam);
+        }
+        else
+        {
+            fprintf(stderr, "* Main RAM       :  no room    : %5d bytes\n", mainRam);
+            fprintf(stderr, "* Video RAM gaps :  no room    : %5d bytes\n", videoRam);
+        }
+        fprintf(stderr, "* Trampolines    : %5d       : %5d       : %d bytes\n", 0, trampolines, trampolines*PACK_TRAMPOLINE_SIZE);
+        fprintf(stderr, "************************************************************\n");
+        if(fits) fprintf(stderr, "* Main RAM saved : %d bytes\n", unpackedMainRam - mainRam);
+        else     fprintf(stderr, "* Only fits when packed\n");
+        fprintf(stderr, "************************************************************\n");
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef LINKER_H
+#define LINKER_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "loader.h"
+
+
+#define OBJECT_MAGIC       "GTO3"
+#define OBJECT_MAX_TARGETS 250 // sections plus imports, object relocations are found by biasing labels by (target+1)*0x0101
+
+#define PACK_TRAMPOLINE_SIZE 5  // LDWI target-2, STW vPC
+#define PACK_MIN_BLOCK       16 // smallest block worth splitting off into a video memory gap
+
+
+namespace Linker
+{
+    enum RelocationType {Word=0, Byte, Branch, HiByte};
+
+    // Offset of an instruction that a code section can be split in front of, fall through cuts need a trampoline
+    struct Cut
+    {
+        uint16_t _offset;
+        bool _fallThrough;
+    };
+
+    // Contiguous block of assembled code or data, _address is where it was assembled, relocations are relative to it,
+    // absolute sections are linked at _address
+    struct Section
+    {
+        bool _isCode = false;
+        bool _isAbsolute = false;
+        uint16_t _address = 0x0000;
+        std::vector<uint8_t> _data;
+        std::vector<Cut> _cuts;
+    };
+
+    // Targets below the number of sections are sections of the same object, the rest are imports, HiByte targets are always sections
+    // and those sections are linked at the same offset within a page as where they were assembled
+    struct Relocation
+    {
+        RelocationType _type;
+        uint16_t _section;
+        uint16_t _offset;
+        uint16_t _target;
+    };
+
+    // RAM used by an object outside of its sections, e.g. buffers addressed through equates
+    struct Reserve
+    {
+        uint16_t _address;
+        uint16_t _size;
+    };
+
+    struct Symbol
+    {
+        uint16_t _section;
+        uint16_t _offset;
+        std::string _name;
+    };
+
+    struct Object
+    {
+        uint16_t _entrySection = 0;
+        uint16_t _entryOffset = 0;
+        std::string _name;
+        std::vector<Section> _sections;
+        std::vector<Symbol> _exports;
+        std::vector<std::string> _imports;
+        std::vector<Relocation> _relocations;
+        std::vector<Reserve> _reserves;
+    };
+
+    // A section or, when packing, a block of a split code section, trampolines jump to the section's next block
+    struct Placement
+    {
+        int _object;
+        int _section;
+        uint16_t _offset;
+        uint16_t _size;
+        uint16_t _address;
+        bool _trampoline = false;
+    };
+
+
+    bool saveObject(const std::string& filename, const Object& object);
+    bool loadObject(const std::string& filename, Object& object);
+
+    bool link(const std::vector<Object>& objects, bool ram64k, bool pack, Loader::Gt1File& gt1File, std::vector<Placement>& placements);
+    void printPlacements(const std::vector<Object>& objects, const std::vector<Placement>& placements);
+    void printPacking(const std::vector<Object>& objects, const std::vector<Placement>& placements, bool ram64k);
+}
+
+#endif
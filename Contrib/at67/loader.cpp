@@ -6,6 +6,8 @@
 #include <algorithm>
 
 #ifndef STAND_ALONE
+#include <atomic>
+#include <thread>
 #include "editor.h"
 #include "timing.h"
 #include "graphics.h"
@@ -15,7 +17,8 @@
 #if defined(_WIN32)
 #include <direct.h>
 #include "dirent/dirent.h"
-#define chdir _chdir
+#define popen _popen
+#define pclose _pclose
 #else
 #include <dirent.h>
 #endif
@@ -24,8 +27,10 @@
 
 #include "cpu.h"
 #include "loader.h"
+#include "mapping.h"
 #include "assembler.h"
 #include "expression.h"
+#include "../kervinck/gcl/gcl.h"
 
 
 #define DEFAULT_COM_BAUD_RATE 115200
@@ -33,12 +38,38 @@
 #define DEFAULT_GIGA_TIMEOUT  5.0
 #define MAX_GT1_SIZE          (1 <<16)
 
+#define GT1_GAP_START       0xA0 // first byte to the right of the visible pixels of a scanline
+#define GT1_GAP_PAGE_LO     0x08
+#define GT1_GAP_PAGE_HI     0x7F
+#define GT1_LOADER_PAGE_LO  0x59 // the Loader's activity indicator, code and buffer
+#define GT1_LOADER_PAGE_HI  0x5B
+#define GT1_STUB_ZP_LO      0x30
+#define GT1_STUB_ZP_HI      0x80
+#define GT1_STUB_VARS       13
+#define GT1_ROUTINES_SIZE   0x1C
+#define GT1_ROM_ENTRY       0x0200 // the ROM menu starts every program it loads with SYS_Exec_88 here
+#define GT1_SYS_ARGS0       0x24
+#define GT1_MIN_MATCH       3
+#define GT1_MAX_MATCH       (0x7F + GT1_MIN_MATCH)
+#define GT1_MAX_LITERALS    0x7F
+
 
 namespace Loader
 {
 #ifndef STAND_ALONE
     enum LoaderState {FirstByte=0, MsgLength, LowAddress, HighAddress, Message, LastByte, ResetIN, NumLoaderStates};
     enum FrameState {Resync=0, Frame, Execute, NumFrameStates};
+    enum UploadMode {Direct=0, Frames};
+    enum CompileState {Idle=0, Compiling, Compiled, Failed};
+    enum GclCompiler {Internal=0, Python};
+
+    struct LoaderFrame
+    {
+        FrameState _frameState;
+        uint16_t _address;
+        uint8_t _length;
+        uint8_t _payload[PAYLOAD_SIZE];
+    };
 
 
     UploadTarget _uploadTarget = None;
@@ -53,6 +84,23 @@ namespace Loader
     double _configTimeout = DEFAULT_GIGA_TIMEOUT;
     std::string _configGclBuild = ".";
     bool _configGclBuildFound = false;
+    UploadMode _configUploadMode = Direct;
+    GclCompiler _configGclCompiler = Internal;
+
+    bool _frameUploading = false;
+    int _frameUploadIndex = 0;
+    int _frameUploadBytes = 0;
+    uint64_t _frameUploadStart = 0;
+    std::vector<LoaderFrame> _loaderFrames;
+
+    std::thread _compileThread;
+    std::atomic<int> _compileState(Idle);
+    std::string _compileOutput;
+    std::string _compileFilename;
+    std::string _compileFilepath;
+    UploadTarget _compileTarget = None;
+    bool _compileGt1Deleted = false;
+    std::string _uploadStatus = "";
 
     std::string _currentGame = "";
 
@@ -62,6 +110,7 @@ namespace Loader
 
 
     UploadTarget getUploadTarget(void) {return _uploadTarget;}
+    const std::string& getUploadStatus(void) {return _uploadStatus;}
     void setUploadTarget(UploadTarget target) {_uploadTarget = target;}
 
 
@@ -117,6 +166,12 @@ namespace Loader
 
                         _configGclBuildFound = getKeyAsString(_loaderConfigIniReader, sectionString, "GclBuild", ".", result, false);   
                         _configGclBuild = result;
+
+                        getKeyAsString(_loaderConfigIniReader, sectionString, "GclCompiler", "INTERNAL", result);
+                        _configGclCompiler = (result == "PYTHON") ? Python : Internal;
+
+                        getKeyAsString(_loaderConfigIniReader, sectionString, "UploadMode", "DIRECT", result);
+                        _configUploadMode = (result == "FRAMES") ? Frames : Direct;
                     }
                     break;
                 }
@@ -167,6 +222,12 @@ namespace Loader
         }
     }
 
+    // Quitting during a compile waits for the compiler, exiting with the worker still joinable would call std::terminate
+    void shutdown(void)
+    {
+        if(_compileThread.joinable()) _compileThread.join();
+    }
+
     int matchFileSystemName(const std::string& path, const std::string& match, std::vector<std::string>& names)
     {
         DIR *dir;
@@ -343,78 +404,418 @@ namespace Loader
 
     bool loadGt1File(const std::string& filename, Gt1File& gt1File)
     {
-        std::ifstream infile(filename, std::ios::binary | std::ios::in);
+        Mapping::Gt1Map gt1Map;
+        if(!Mapping::mapGt1File(filename, gt1Map))
+        {
+            fprintf(stderr, "Loader::loadGt1File() : failed to load '%s'\n", filename.c_str());
+            return false;
+        }
+
+        // Segments are copied out of the mapping for callers that edit or re-encode them, uploads and
+        // stats read the mapping directly, sizes are already validated
+        gt1File._segments.resize(gt1Map._spans.size());
+        for(int i=0; i<int(gt1Map._spans.size()); i++)
+        {
+            const Mapping::Gt1Span& span = gt1Map._spans[i];
+            Gt1Segment& segment = gt1File._segments[i];
+            segment._hiAddress = uint8_t(span._address >>8);
+            segment._loAddress = uint8_t(span._address & 0x00FF);
+            segment._segmentSize = uint8_t(span._size);
+            segment._dataBytes.assign(span._data, span._data + span._size);
+        }
+        gt1File._hiStart = gt1Map._hiStart;
+        gt1File._loStart = gt1Map._loStart;
+
+        Mapping::unmapGt1File(gt1Map);
+
+        return true;
+    }
+
+    // Compiles a gcl file in process and writes the resulting gt1 file, an empty interface filename uses the last loaded bindings
+    bool compileGclFile(const std::string& gclFilename, const std::string& gt1Filename, const std::string& interfaceFilename, std::string& error)
+    {
+        if(interfaceFilename.size()  &&  compileBindings(interfaceFilename.c_str()) != 0)
+        {
+            fprintf(stderr, "Loader::compileGclFile() : failed to load interface '%s' : using built in bindings\n", interfaceFilename.c_str());
+        }
+
+        std::ifstream infile(gclFilename, std::ios::binary | std::ios::in);
         if(!infile.is_open())
         {
-            fprintf(stderr, "Loader::loadGt1File() : failed to open '%s'\n", filename.c_str());
+            error = "failed to open '" + gclFilename + "'";
+            fprintf(stderr, "Loader::compileGclFile() : %s\n", error.c_str());
             return false;
         }
 
-        int segmentCount = 1;
-        for(;;)
+        compileBegin();
+
+        std::string line;
+        while(std::getline(infile, line))
+        {
+            line += "\n";
+            if(compileLine(&line[0]) != 0) break;
+        }
+        if(compileError == nullptr) compileEnd();
+
+        if(compileError)
+        {
+            error = std::string(compileError);
+            fprintf(stderr, "Loader::compileGclFile() : '%s' : %s\n", gclFilename.c_str(), compileError);
+            return false;
+        }
+
+        int size = 0;
+        unsigned char* object = compileObject(&size);
+        std::ofstream outfile(gt1Filename, std::ios::binary | std::ios::out);
+        if(!outfile.is_open())
+        {
+            error = "failed to create '" + gt1Filename + "'";
+            fprintf(stderr, "Loader::compileGclFile() : %s\n", error.c_str());
+            return false;
+        }
+        outfile.write((char *)object, size);
+
+        return true;
+    }
+
+    // Segments are written into a RAM image in file order, so later segments win where they overlap, then every contiguous run of
+    // bytes within a page becomes one segment, ROM segments are kept as they are
+    void optimiseGt1File(Gt1File& gt1File)
+    {
+        std::vector<uint8_t> image(0x10000, 0x00);
+        std::vector<bool> used(0x10000, false);
+        std::vector<Gt1Segment> segments;
+        for(int i=0; i<int(gt1File._segments.size()); i++)
         {
-            // Read segment header
+            const Gt1Segment& segment = gt1File._segments[i];
+            if(segment._isRomAddress)
+            {
+                segments.push_back(segment);
+                continue;
+            }
+
+            uint16_t address = segment._loAddress + (segment._hiAddress <<8);
+            for(int j=0; j<int(segment._dataBytes.size()); j++)
+            {
+                image[uint16_t(address + j)] = segment._dataBytes[j];
+                used[uint16_t(address + j)] = true;
+            }
+        }
+
+        for(int address=0x0000; address<0x10000;)
+        {
+            if(!used[address])
+            {
+                address++;
+                continue;
+            }
+
+            int end = address + 1;
+            while(end < 0x10000  &&  used[end]  &&  (end & 0x00FF)) end++;
+
             Gt1Segment segment;
-            infile.read((char *)&segment._hiAddress, SEGMENT_HEADER_SIZE);
-            if(infile.eof() || infile.bad() || infile.fail())
+            segment._hiAddress = uint8_t(address >>8);
+            segment._loAddress = uint8_t(address & 0x00FF);
+            segment._segmentSize = uint8_t(end - address);
+            segment._dataBytes.assign(image.begin() + address, image.begin() + end);
+            segments.push_back(segment);
+            address = end;
+        }
+
+        std::stable_sort(segments.begin(), segments.end(), [](const Gt1Segment& segmentA, const Gt1Segment& segmentB)
+        {
+            return segmentA._loAddress + (segmentA._hiAddress <<8) < segmentB._loAddress + (segmentB._hiAddress <<8);
+        });
+
+        gt1File._segments = segments;
+    }
+
+    int getGt1FileSize(const Gt1File& gt1File)
+    {
+        int size = GT1FILE_TRAILER_SIZE;
+        for(int i=0; i<int(gt1File._segments.size()); i++) size += SEGMENT_HEADER_SIZE + int(gt1File._segments[i]._dataBytes.size());
+        return size;
+    }
+
+    // Each segment becomes its destination address, then tokens until a zero, a destination page of zero ends the stream. Tokens below
+    // 0x80 are followed by that many literal bytes, the rest copy (token - 0x80 + GT1_MIN_MATCH) bytes starting (next byte + 1) bytes back
+    // from the destination, segments are within a page so matches are too
+    void compressGt1Segment(const Gt1Segment& segment, std::vector<uint8_t>& stream)
+    {
+        const std::vector<uint8_t>& data = segment._dataBytes;
+        stream.push_back(segment._loAddress);
+        stream.push_back(segment._hiAddress);
+
+        int literals = 0;
+        for(int i=0; i<=int(data.size());)
+        {
+            int bestLength = 0, bestOffset = 0;
+            for(int j=0; j<i; j++)
             {
-                fprintf(stderr, "Loader::loadGt1File() : bad header in segment %d of '%s'\n", segmentCount, filename.c_str());
-                return false;
+                int length = 0;
+                while(i + length < int(data.size())  &&  length < GT1_MAX_MATCH  &&  data[j + length] == data[i + length]) length++;
+                if(length > bestLength)
+                {
+                    bestLength = length;
+                    bestOffset = i - j - 1;
+                }
             }
 
-            // Finished
-            if(segment._hiAddress == 0x00  &&  infile.peek() == EOF)
+            // Pending literals are flushed in front of a match, at the end of the segment and when there are as many as a token can hold
+            if(literals  &&  (bestLength >= GT1_MIN_MATCH  ||  i == int(data.size())  ||  literals == GT1_MAX_LITERALS))
             {
-                // Segment header aligns with Gt1File terminator, hiStart and loStart
-                gt1File._hiStart = segment._loAddress;
-                gt1File._loStart = segment._segmentSize;
-                break;
+                stream.push_back(uint8_t(literals));
+                stream.insert(stream.end(), data.begin() + i - literals, data.begin() + i);
+                literals = 0;
             }
+            if(i == int(data.size())) break;
 
-            // Read segment
-            int segmentSize = (segment._segmentSize == 0) ? 256 : segment._segmentSize;
-            segment._dataBytes.resize(segmentSize);
-            infile.read((char *)&segment._dataBytes[0], segmentSize);
-            if(infile.eof() || infile.bad() || infile.fail())
+            if(bestLength >= GT1_MIN_MATCH)
             {
-                fprintf(stderr, "Loader::loadGt1File() : bad segment %d in '%s'\n", segmentCount, filename.c_str());
-                return false;
+                stream.push_back(uint8_t(0x80 + bestLength - GT1_MIN_MATCH));
+                stream.push_back(uint8_t(bestOffset));
+                i += bestLength;
+                continue;
             }
 
-            gt1File._segments.push_back(segment);
-            segmentCount++;
+            literals++;
+            i++;
+        }
+
+        stream.push_back(0x00);
+    }
+
+    // Video memory to the right of the visible scanlines that no segment writes to, pages that the Loader itself uses while the gt1 is
+    // loading are never free
+    bool isGt1GapFree(const Gt1File& gt1File, uint8_t page)
+    {
+        if(page < GT1_GAP_PAGE_LO  ||  page > GT1_GAP_PAGE_HI  ||  (page >= GT1_LOADER_PAGE_LO  &&  page <= GT1_LOADER_PAGE_HI)) return false;
+
+        for(int i=0; i<int(gt1File._segments.size()); i++)
+        {
+            const Gt1Segment& segment = gt1File._segments[i];
+            if(segment._hiAddress == page  &&  segment._loAddress + int(segment._dataBytes.size()) > GT1_GAP_START) return false;
         }
 
         return true;
     }
 
-    bool saveGt1File(const std::string& filepath, Gt1File& gt1File, std::string& filename)
+    // The decompressor's main loop, (82 bytes), lives in the gap of one page, its read routines and the stream fill the gaps of the
+    // pages above it, the stream skips from the end of each page to the start of the next page's gap. It runs after the Loader has
+    // finished and starts the program at the gt1's original start address. The ROM version, (77 bytes), reads the stream straight out
+    // of ROM with LUP from where SYS_Exec_88 stopped, sysArgs0 and sysArgs1 are its source pointer
+    void getGt1Decompressor(uint8_t page, uint8_t zp, uint16_t entry, bool fromRom, std::vector<uint8_t>& mainLoop, std::vector<uint8_t>& routines)
     {
-        if(gt1File._segments.size() == 0)
+        const uint8_t src = (fromRom) ? GT1_SYS_ARGS0 : zp, dst = zp + 2, ref = zp + 4, get = zp + 6, fetch = zp + 8, tmp = zp + 10, cnt = zp + 12;
+        const uint16_t getbyte = ((page + 1) <<8) | GT1_GAP_START;
+        const uint16_t getref = getbyte + ((fromRom) ? 0x12 : 0x16);
+        const uint16_t stream = getbyte + GT1_ROUTINES_SIZE;
+        const uint8_t run = GT1_GAP_START + ((fromRom) ? 0x05 : 0x0A), token = run + 0x10, match = run + 0x22, copy = run + 0x37;
+
+        mainLoop =
         {
-            fprintf(stderr, "Loader::saveGt1File() : zero segments, not saving.\n");
+            0x11, uint8_t(getbyte & 0x00FF), uint8_t(getbyte >>8),  //         LDWI    getbyte
+            0x2B, get,                                              //         STW     get
+        };
+        if(!fromRom)
+        {
+            mainLoop.insert(mainLoop.end(),
+            {
+                0x11, uint8_t(stream & 0x00FF), uint8_t(stream >>8),    //         LDWI    stream
+                0x2B, src,                                              //         STW     src
+            });
+        }
+        mainLoop.insert(mainLoop.end(),
+        {
+            0xCF, get,                                              // run     CALL    get
+            0x5E, dst,                                              //         ST      dst
+            0xCF, get,                                              //         CALL    get
+            0x5E, uint8_t(dst + 1),                                 //         ST      dst+1
+            0x35, 0x72, uint8_t(token - 2),                         //         BNE     token
+            0x11, uint8_t(entry & 0x00FF), uint8_t(entry >>8),      //         LDWI    entry
+            0xCF, 0x18,                                             //         CALL    vAC
+            0xCF, get,                                              // token   CALL    get
+            0x35, 0x3F, uint8_t(run - 2),                           //         BEQ     run
+            0x5E, cnt,                                              //         ST      cnt
+            0xE6, 0x80,                                             //         SUBI    0x80
+            0x35, 0x53, uint8_t(match - 2),                         //         BGE     match
+            0x21, get,                                              //         LDW     get
+            0x2B, fetch,                                            //         STW     fetch
+            0x90, uint8_t(copy - 2),                                //         BRA     copy
+            0xE3, GT1_MIN_MATCH,                                    // match   ADDI    GT1_MIN_MATCH
+            0x5E, cnt,                                              //         ST      cnt
+            0xCF, get,                                              //         CALL    get
+            0x2B, tmp,                                              //         STW     tmp
+            0x21, dst,                                              //         LDW     dst
+            0xB8, tmp,                                              //         SUBW    tmp
+            0xE6, 0x01,                                             //         SUBI    1
+            0x2B, ref,                                              //         STW     ref
+            0x11, uint8_t(getref & 0x00FF), uint8_t(getref >>8),    //         LDWI    getref
+            0x2B, fetch,                                            //         STW     fetch
+            0xCF, fetch,                                            // copy    CALL    fetch
+            0xF0, dst,                                              //         POKE    dst
+            0x93, dst,                                              //         INC     dst
+            0x1A, cnt,                                              //         LD      cnt
+            0xE6, 0x01,                                             //         SUBI    1
+            0x5E, cnt,                                              //         ST      cnt
+            0x35, 0x72, uint8_t(copy - 2),                          //         BNE     copy
+            0x90, uint8_t(token - 2),                               //         BRA     token
+        });
+
+        if(fromRom)
+        {
+            routines =
+            {
+                0x1A, src,                                              // getbyte LD      src
+                0x8C, 0xFB,                                             //         XORI    251
+                0x35, 0x72, GT1_GAP_START + 0x0B - 2,                   //         BNE     getbyte+0x0B
+                0x5E, src,                                              //         ST      src
+                0x93, uint8_t(src + 1),                                 //         INC     src+1
+                0x21, src,                                              //         LDW     src
+                0x7F, 0x00,                                             //         LUP     0
+                0x93, src,                                              //         INC     src
+                0xFF,                                                   //         RET
+            };
+        }
+        else
+        {
+            routines =
+            {
+                0x21, src,                                              // getbyte LDW     src
+                0xAD,                                                   //         PEEK
+                0x5E, tmp,                                              //         ST      tmp
+                0x93, src,                                              //         INC     src
+                0x1A, src,                                              //         LD      src
+                0x35, 0x72, GT1_GAP_START + 0x13 - 2,                   //         BNE     getbyte+0x13
+                0x11, 0xA0, 0x01,                                       //         LDWI    0x01A0
+                0x99, src,                                              //         ADDW    src
+                0x2B, src,                                              //         STW     src
+                0x1A, tmp,                                              //         LD      tmp
+                0xFF,                                                   //         RET
+            };
+        }
+        routines.insert(routines.end(),
+        {
+            0x21, ref,                                              // getref  LDW     ref
+            0xAD,                                                   //         PEEK
+            0x93, ref,                                              //         INC     ref
+            0xFF,                                                   //         RET
+        });
+    }
+
+    // Page zero is loaded as it is, everything else is compressed into a stream, the stub needs GT1_STUB_VARS bytes of zero page that
+    // the gt1 doesn't load
+    bool compressGt1Segments(const Gt1File& gt1File, Gt1File& optimised, Gt1File& compressed, std::vector<uint8_t>& stream, int& zp)
+    {
+        optimised = gt1File;
+        optimiseGt1File(optimised);
+
+        uint16_t entry = optimised._loStart + (optimised._hiStart <<8);
+        if(entry < 0x0100)
+        {
+            fprintf(stderr, "Loader::compressGt1File() : no start address\n");
             return false;
         }
 
-        size_t i = filepath.rfind('.');
-        filename = (i != std::string::npos) ? filepath.substr(0, i) + ".gt1" : filepath + ".gt1";
+        compressed = Gt1File();
+        std::vector<bool> zeroPage(0x0100, false);
+        for(int i=0; i<int(optimised._segments.size()); i++)
+        {
+            const Gt1Segment& segment = optimised._segments[i];
+            if(segment._isRomAddress  ||  segment._hiAddress == 0x00)
+            {
+                compressed._segments.push_back(segment);
+                if(segment._hiAddress) continue;
+                for(int j=0; j<int(segment._dataBytes.size()); j++) zeroPage[segment._loAddress + j] = true;
+                continue;
+            }
 
-        std::ofstream outfile(filename, std::ios::binary | std::ios::out);
-        if(!outfile.is_open())
+            compressGt1Segment(segment, stream);
+        }
+        stream.push_back(0x00);
+        stream.push_back(0x00);
+
+        // Stub variables in user zero page
+        zp = GT1_STUB_ZP_LO;
+        for(; zp+GT1_STUB_VARS<=GT1_STUB_ZP_HI; zp++)
         {
-            fprintf(stderr, "Loader::saveGt1File() : failed to open '%s'\n", filename.c_str());
+            if(std::find(zeroPage.begin() + zp, zeroPage.begin() + zp + GT1_STUB_VARS, true) == zeroPage.begin() + zp + GT1_STUB_VARS) break;
+        }
+        if(zp + GT1_STUB_VARS > GT1_STUB_ZP_HI)
+        {
+            fprintf(stderr, "Loader::compressGt1File() : no room in zero page for the decompressor's %d bytes of variables\n", GT1_STUB_VARS);
             return false;
         }
 
-        // Sort segments from lowest address to highest address
-        std::sort(gt1File._segments.begin(), gt1File._segments.end(), [](const Gt1Segment& segmentA, const Gt1Segment& segmentB)
+        return true;
+    }
+
+    // Highest run of free gaps
+    int getGt1GapPages(const Gt1File& optimised, int pages)
+    {
+        int page = GT1_GAP_PAGE_HI - pages + 1;
+        for(; page>=GT1_GAP_PAGE_LO; page--)
         {
-            uint16_t addressA = segmentA._loAddress + (segmentA._hiAddress <<8);
-            uint16_t addressB = segmentB._loAddress + (segmentB._hiAddress <<8);
-            return (addressA < addressB);
-        });
+            int free = 0;
+            while(free < pages  &&  isGt1GapFree(optimised, uint8_t(page + free))) free++;
+            if(free == pages) break;
+        }
+        if(page < GT1_GAP_PAGE_LO)
+        {
+            fprintf(stderr, "Loader::compressGt1File() : no room in video memory for %d pages of decompressor and stream\n", pages);
+            return -1;
+        }
+
+        return page;
+    }
+
+    void addGt1Decompressor(uint8_t page, const std::vector<uint8_t>& mainLoop, const std::vector<uint8_t>& routines, Gt1File& compressed)
+    {
+        const int gapSize = 0x0100 - GT1_GAP_START;
+
+        Gt1Segment segment;
+        segment._hiAddress = page;
+        segment._loAddress = GT1_GAP_START;
+        segment._segmentSize = uint8_t(mainLoop.size());
+        segment._dataBytes = mainLoop;
+        compressed._segments.push_back(segment);
+        for(int i=0; i<int(routines.size()); i+=gapSize)
+        {
+            segment._hiAddress = uint8_t(page + 1 + i/gapSize);
+            segment._dataBytes.assign(routines.begin() + i, routines.begin() + std::min(i + gapSize, int(routines.size())));
+            segment._segmentSize = uint8_t(segment._dataBytes.size());
+            compressed._segments.push_back(segment);
+        }
+    }
+
+    // Page zero is loaded as it is, everything else is compressed into a stream in video memory gaps that a vCPU stub expands at start up,
+    // the stub needs GT1_STUB_VARS bytes of zero page that the gt1 doesn't load and enough consecutive free gaps
+    bool compressGt1File(const Gt1File& gt1File, Gt1File& compressed)
+    {
+        int zp;
+        Gt1File optimised;
+        std::vector<uint8_t> stream;
+        if(!compressGt1Segments(gt1File, optimised, compressed, stream, zp)) return false;
+
+        // One gap for the main loop and enough for the routines and the stream
+        const int gapSize = 0x0100 - GT1_GAP_START;
+        int page = getGt1GapPages(optimised, 1 + (GT1_ROUTINES_SIZE + int(stream.size()) + gapSize - 1) / gapSize);
+        if(page < 0) return false;
+
+        std::vector<uint8_t> mainLoop, routines;
+        getGt1Decompressor(uint8_t(page), uint8_t(zp), optimised._loStart + (optimised._hiStart <<8), false, mainLoop, routines);
+        routines.insert(routines.end(), stream.begin(), stream.end());
+        addGt1Decompressor(uint8_t(page), mainLoop, routines, compressed);
+
+        compressed._hiStart = uint8_t(page);
+        compressed._loStart = GT1_GAP_START;
 
-        // Special case: There can only be one segment in page 0 - merge all the occurences with padding if necessary.
+        return true;
+    }
+
+    // Special case: There can only be one segment in page 0 - merge all the occurences with padding if necessary.
+    void mergeZeroPageSegments(Gt1File& gt1File)
+    {
         while (gt1File._segments.size() >= 2 && gt1File._segments[0]._hiAddress == 0 && gt1File._segments[1]._hiAddress == 0)
         {
             Gt1Segment& A = gt1File._segments[0];
@@ -430,6 +831,132 @@ namespace Loader
 
             gt1File._segments.erase(gt1File._segments.begin() + 1);
         }
+    }
+
+    // A ROM stream for SYS_Exec_88 of the gt1's page zero, the ROM decompressor and a jump to it at GT1_ROM_ENTRY, then its terminator,
+    // followed by the compressed stream that the decompressor reads on from, everything else in RAM is written by the decompressor
+    bool compressGt1FileForRom(const Gt1File& gt1File, std::vector<uint8_t>& romStream)
+    {
+        int zp;
+        Gt1File optimised, compressed;
+        std::vector<uint8_t> stream;
+        if(!compressGt1Segments(gt1File, optimised, compressed, stream, zp)) return false;
+
+        for(int i=0; i<int(compressed._segments.size()); i++)
+        {
+            if(compressed._segments[i]._isRomAddress)
+            {
+                fprintf(stderr, "Loader::compressGt1FileForRom() : ROM segments can't be loaded from ROM\n");
+                return false;
+            }
+        }
+
+        // The main loop and the routines each fit in one gap
+        int page = getGt1GapPages(optimised, 2);
+        if(page < 0) return false;
+
+        std::vector<uint8_t> mainLoop, routines;
+        getGt1Decompressor(uint8_t(page), uint8_t(zp), optimised._loStart + (optimised._hiStart <<8), true, mainLoop, routines);
+        addGt1Decompressor(uint8_t(page), mainLoop, routines, compressed);
+
+        uint16_t start = (page <<8) | GT1_GAP_START;
+        Gt1Segment entry;
+        entry._hiAddress = GT1_ROM_ENTRY >>8;
+        entry._loAddress = GT1_ROM_ENTRY & 0x00FF;
+        entry._dataBytes = {0x11, uint8_t(start & 0x00FF), uint8_t(start >>8), 0xCF, 0x18}; // LDWI start, CALL vAC
+        entry._segmentSize = uint8_t(entry._dataBytes.size());
+        compressed._segments.push_back(entry);
+        mergeZeroPageSegments(compressed);
+
+        romStream.clear();
+        for(int i=0; i<int(compressed._segments.size()); i++)
+        {
+            const Gt1Segment& segment = compressed._segments[i];
+            romStream.push_back(segment._hiAddress);
+            romStream.push_back(segment._loAddress);
+            romStream.push_back(segment._segmentSize);
+            romStream.insert(romStream.end(), segment._dataBytes.begin(), segment._dataBytes.end());
+        }
+        romStream.push_back(0x00);
+        romStream.insert(romStream.end(), stream.begin(), stream.end());
+
+        return true;
+    }
+
+    // vCPU cycles to load a ROM stream, counted along the paths that SYS_Exec_88's loader and the ROM decompressor take for it, ROM page
+    // wraps are not counted
+    uint32_t getGt1RomLoadCycles(const std::vector<uint8_t>& romStream, bool isCompressed)
+    {
+        const uint32_t read = 26 + 138;                         // CALL, LD XORI BCC LDW LUP INC RET
+        const uint32_t getref = 26 + 78;                        // CALL, LDW PEEK INC RET
+        const uint32_t copy = 28 + 16 + 18 + 28 + 16 + 28;      // POKE INC LD SUBI ST BCC, the loader has the same instructions
+
+        // SYS_Exec_88, PUSH BRA, segments, (the first can be in page zero), then the terminator, POP RET
+        uint32_t cycles = 88 + 26 + 14;
+        int i = 0;
+        for(bool first=true; i<int(romStream.size())  &&  (first  ||  romStream[i]); first=false)
+        {
+            int size = (i + 2 < int(romStream.size())  &&  romStream[i + 2]) ? romStream[i + 2] : 256;
+            cycles += read + 28 + 16 + read + 16 + read + size*(read + copy);
+            i += SEGMENT_HEADER_SIZE + size;
+        }
+        cycles += read + 28 + 26 + 16;
+        if(!isCompressed) return cycles;
+
+        // GT1_ROM_ENTRY's LDWI CALL, the decompressor's LDWI STW, then its stream
+        cycles += 20 + 26 + 20 + 20;
+        for(i++; i<int(romStream.size());)
+        {
+            // Destination, the last one is zero and starts the program with LDWI CALL
+            cycles += read + 16 + read + 16 + 28;
+            if(i + 1 >= int(romStream.size())  ||  romStream[i + 1] == 0x00) return cycles + 20 + 26;
+            i += 2;
+
+            // Tokens, CALL BEQ then ST SUBI BGE, literals LDW STW BRA, matches ADDI ST CALL STW LDW SUBW SUBI STW LDWI STW, then BRA
+            for(;;)
+            {
+                uint8_t token = romStream[i++];
+                cycles += read + 28;
+                if(token == 0x00) break;
+
+                cycles += 16 + 28 + 28 + 14;
+                if(token < 0x80)
+                {
+                    cycles += 20 + 20 + 14 + token*(read + copy);
+                    i += token;
+                    continue;
+                }
+
+                cycles += 28 + 16 + read + 20 + 20 + 28 + 28 + 20 + 20 + 20 + (token - 0x80 + GT1_MIN_MATCH)*(getref + copy);
+                i++;
+            }
+        }
+
+        return cycles;
+    }
+
+    bool saveGt1File(const std::string& filepath, Gt1File& gt1File, std::string& filename)
+    {
+        if(gt1File._segments.size() == 0)
+        {
+            fprintf(stderr, "Loader::saveGt1File() : zero segments, not saving.\n");
+            return false;
+        }
+
+        size_t i = filepath.rfind('.');
+        filename = (i != std::string::npos) ? filepath.substr(0, i) + ".gt1" : filepath + ".gt1";
+
+        std::ofstream outfile(filename, std::ios::binary | std::ios::out);
+        if(!outfile.is_open())
+        {
+            fprintf(stderr, "Loader::saveGt1File() : failed to open '%s'\n", filename.c_str());
+            return false;
+        }
+
+        // Coalesced, split at pages and sorted from lowest address to highest address
+        optimiseGt1File(gt1File);
+
+        mergeZeroPageSegments(gt1File);
 
         for(int i=0; i<gt1File._segments.size(); i++)
         {
@@ -462,17 +989,17 @@ namespace Loader
         return true;
     }
 
-    uint16_t printGt1Stats(const std::string& filename, const Gt1File& gt1File)
+    // Segments are read through spans, so mapped gt1 files and Gt1File's share the same report
+    uint16_t printGt1Stats(const std::string& filename, uint16_t startAddress, const std::vector<Mapping::Gt1Span>& spans, const std::vector<bool>& isRomAddress)
     {
         // Header
         uint16_t totalSize = 0;
-        for(int i=0; i<gt1File._segments.size(); i++)
+        for(int i=0; i<spans.size(); i++)
         {
-            totalSize += int(gt1File._segments[i]._dataBytes.size());
+            totalSize += spans[i]._size;
         }
-        uint16_t startAddress = gt1File._loStart + (gt1File._hiStart <<8);
         fprintf(stderr, "\n************************************************************\n");
-        fprintf(stderr, "* %s : 0x%04x : %5d bytes : %3d segments\n", filename.c_str(), startAddress, totalSize, int(gt1File._segments.size()));
+        fprintf(stderr, "* %s : 0x%04x : %5d bytes : %3d segments\n", filename.c_str(), startAddress, totalSize, int(spans.size()));
         fprintf(stderr, "************************************************************\n");
         fprintf(stderr, "* Segment :  Type  : Address : Memory Used                  \n");
         fprintf(stderr, "************************************************************\n");
@@ -481,15 +1008,15 @@ namespace Loader
         int contiguousSegments = 0;
         int startContiguousSegment = 0;
         uint16_t startContiguousAddress = 0x0000;
-        for(int i=0; i<gt1File._segments.size(); i++)
+        for(int i=0; i<spans.size(); i++)
         {
-            uint16_t address = gt1File._segments[i]._loAddress + (gt1File._segments[i]._hiAddress <<8);
-            int segmentSize = (gt1File._segments[i]._segmentSize == 0) ? 256 : gt1File._segments[i]._segmentSize;
+            uint16_t address = spans[i]._address;
+            int segmentSize = spans[i]._size;
             std::string memory = "RAM";
-            if(gt1File._segments[i]._isRomAddress)
+            if(isRomAddress[i])
             {
                 memory = "ROM";
-                if(gt1File._segments.size() == 1)
+                if(spans.size() == 1)
                 {
                     fprintf(stderr, "*  %4d   :  %s   : 0x%04x  : %5d bytes\n", i, memory.c_str(), address, totalSize);
                     fprintf(stderr, "************************************************************\n");
@@ -497,11 +1024,6 @@ namespace Loader
                 }
                 totalSize -= segmentSize;
             }
-            else if(segmentSize != int(gt1File._segments[i]._dataBytes.size()))
-            {
-                fprintf(stderr, "Segment %4d : %s 0x%04x : segmentSize %3d != dataBytes.size() %3d\n", i, memory.c_str(), address, segmentSize, int(gt1File._segments[i]._dataBytes.size()));
-                return 0;
-            }
 
             // New contiguous segment
             if(segmentSize == 256)
@@ -536,6 +1058,35 @@ namespace Loader
         return totalSize;
     }
 
+    uint16_t printGt1Stats(const std::string& filename, const Gt1File& gt1File)
+    {
+        std::vector<Mapping::Gt1Span> spans;
+        std::vector<bool> isRomAddress;
+        for(int i=0; i<gt1File._segments.size(); i++)
+        {
+            const Gt1Segment& segment = gt1File._segments[i];
+            uint16_t address = segment._loAddress + (segment._hiAddress <<8);
+            int segmentSize = (segment._segmentSize == 0) ? 256 : segment._segmentSize;
+            if(!segment._isRomAddress  &&  segmentSize != int(segment._dataBytes.size()))
+            {
+                fprintf(stderr, "Segment %4d : RAM 0x%04x : segmentSize %3d != dataBytes.size() %3d\n", i, address, segmentSize, int(segment._dataBytes.size()));
+                return 0;
+            }
+
+            // ROM segments aren't split into pages, so their size is the size of their data
+            if(segment._isRomAddress) segmentSize = int(segment._dataBytes.size());
+            spans.push_back({address, uint16_t(segmentSize), segment._dataBytes.data()});
+            isRomAddress.push_back(segment._isRomAddress);
+        }
+
+        return printGt1Stats(filename, gt1File._loStart + (gt1File._hiStart <<8), spans, isRomAddress);
+    }
+
+    uint16_t printGt1Stats(const std::string& filename, const Mapping::Gt1Map& gt1Map)
+    {
+        return printGt1Stats(filename, gt1Map._loStart + (gt1Map._hiStart <<8), gt1Map._spans, std::vector<bool>(gt1Map._spans.size(), false));
+    }
+
 #ifndef STAND_ALONE
     void disableUploads(bool disable)
     {
@@ -794,29 +1345,128 @@ namespace Loader
         }
     }
 
-    void uploadDirect(UploadTarget uploadTarget)
+    void addLoaderFrames(uint16_t executeAddress, uint16_t address, const uint8_t* data, int size)
     {
-        bool isGt1File = false;
-        bool hasRomCode = false;
-        bool hasRamCode = false;
+        _loaderFrames.push_back({Resync, executeAddress, 0, {}});
 
-        uint16_t executeAddress = Editor::getLoadBaseAddress();
+        for(int i=0; i<size;)
+        {
+            int length = std::min(size - i, PAYLOAD_SIZE);
+            length = std::min(length, 0x0100 - (address & 0x00FF));
+
+            LoaderFrame frame = {Frame, address, uint8_t(length), {}};
+            std::copy(data + i, data + i + length, frame._payload);
+            _loaderFrames.push_back(frame);
+
+            address += uint16_t(length);
+            i += length;
+        }
+    }
+
+    void startLoaderFrames(uint16_t executeAddress)
+    {
+        _loaderFrames.push_back({Resync, executeAddress, 0, {}});
+        _loaderFrames.push_back({Execute, executeAddress, 0, {}});
+
+        _frameUploadIndex = 0;
+        _frameUploadBytes = 0;
+        _frameUploadStart = Timing::getFrameCount();
+        _frameUploading = true;
+    }
+
+    // Splits a gt1 file into Loader frames of at most PAYLOAD_SIZE bytes, frames never cross a page and
+    // every segment is preceded by a resync frame so that both ends restart their checksums
+    void buildLoaderFrames(const Gt1File& gt1File, uint16_t executeAddress)
+    {
+        _loaderFrames.clear();
+
+        for(int j=0; j<gt1File._segments.size(); j++)
+        {
+            const Gt1Segment& segment = gt1File._segments[j];
+            if(segment._isRomAddress) continue;
+
+            addLoaderFrames(executeAddress, segment._loAddress + (segment._hiAddress <<8), segment._dataBytes.data(), int(segment._dataBytes.size()));
+        }
+
+        startLoaderFrames(executeAddress);
+    }
+
+    // Payloads are copied straight out of the mapping
+    void buildLoaderFrames(const Mapping::Gt1Map& gt1Map, uint16_t executeAddress)
+    {
+        _loaderFrames.clear();
+
+        for(int j=0; j<gt1Map._spans.size(); j++)
+        {
+            addLoaderFrames(executeAddress, gt1Map._spans[j]._address, gt1Map._spans[j]._data, gt1Map._spans[j]._size);
+        }
+
+        startLoaderFrames(executeAddress);
+    }
+
+    // Runs on a worker thread, the compiler's output is captured so that errors can be reported in the status area
+    void compileGcl(const std::string command, const std::string gt1Filepath)
+    {
+        std::string output;
+        FILE* pipe = popen(command.c_str(), "r");
+        if(pipe)
+        {
+            char buffer[256];
+            while(fgets(buffer, sizeof(buffer), pipe)) output += buffer;
+            pclose(pipe);
+        }
+
+        std::ifstream infile(gt1Filepath, std::ios::binary | std::ios::in);
+        _compileOutput = output;
+        _compileState = infile.is_open() ? Compiled : Failed;
+    }
+
+    void uploadFile(UploadTarget uploadTarget, std::string filename, std::string filepath, bool gt1FileBuilt);
+
+    void uploadDirect(UploadTarget uploadTarget)
+    {
         std::string filename = *Editor::getFileEntryName(Editor::getCursorY() + Editor::getFileEntriesIndex());
         std::string filepath = std::string(Editor::getBrowserPath() + filename);
+        if(_compileState == Idle) _uploadStatus = "";
 
-        // Reset video table and reset single step watch address to video line counter
-        Graphics::resetVTable();
-        Editor::setSingleStepWatchAddress(VIDEO_Y_ADDRESS);
+        // Compile gcl to gt1 in process
+        if(_configGclCompiler == Internal  &&  filename.find(".gcl") != filename.npos)
+        {
+            std::string gclFilepath = filepath;
+            size_t dot = filename.find_last_of(".");
+            filename = filename.substr(0, dot) + ".gt1";
+            dot = filepath.find_last_of(".");
+            filepath = filepath.substr(0, dot) + ".gt1";
 
-        // Compile gcl to gt1
-        Gt1File gt1File;
-        bool gt1FileBuilt = false;
+            std::string error;
+            std::string interfaceFilepath = (_configGclBuildFound) ? _configGclBuild + "/interface.json" : "";
+            if(!compileGclFile(gclFilepath, filepath, interfaceFilepath, error))
+            {
+                _uploadStatus = "Error: " + error;
+                return;
+            }
+
+            uploadFile(uploadTarget, filename, filepath, true);
+            return;
+        }
+
+        // Compile gcl to gt1 in the background, the upload happens in the first vBlank after the compile completes
         if(_configGclBuildFound  &&  filename.find(".gcl") != filename.npos)
         {
-            // Create compile gcl string
-            chdir(Editor::getBrowserPath().c_str());
-            std::string command = "py -B \"" + _configGclBuild + "/Core/compilegcl.py\" \"" + filepath + "\" \"" + Editor::getBrowserPath() + "\" -s \"" + _configGclBuild + "/interface.json\"";
-            fprintf(stderr, command.c_str());
+            if(_compileState != Idle)
+            {
+                fprintf(stderr, "Loader::uploadDirect() : already compiling '%s'\n", _compileFilename.c_str());
+                return;
+            }
+
+            // Create compile gcl string, the compiler runs in the browser directory without changing ours
+#if defined(_WIN32)
+            std::string command = "cd /d \"" + Editor::getBrowserPath() + "\" && ";
+#else
+            std::string command = "cd \"" + Editor::getBrowserPath() + "\" && ";
+#endif
+            command += "py -B \"" + _configGclBuild + "/Core/compilegcl.py\" \"" + filepath + "\" \"" + Editor::getBrowserPath() + "\" -s \"" + _configGclBuild + "/interface.json\" 2>&1";
+            fprintf(stderr, "%s\n", command.c_str());
 
             // Create gt1 name and path
             size_t dot = filename.find_last_of(".");
@@ -828,41 +1478,82 @@ namespace Loader
             }
 
             // Build gcl
-            int gt1FileDeleted = remove(filepath.c_str());
-            fprintf(stderr, "\n");
-            system(command.c_str());
+            _compileGt1Deleted = (remove(filepath.c_str()) == 0);
+            _compileFilename = filename;
+            _compileFilepath = filepath;
+            _compileTarget = uploadTarget;
+            _compileState = Compiling;
+            _uploadStatus = "Compiling...";
+            _compileThread = std::thread(compileGcl, command, filepath);
+            return;
+        }
 
-            // Check for gt1
-            std::ifstream infile(filepath, std::ios::binary | std::ios::in);
-            if(!infile.is_open())
-            {
-                fprintf(stderr, "\nLoader::uploadDirect() : failed to compile '%s'\n", filename.c_str());
-                filename = "";
-                if(gt1FileDeleted == 0) Editor::browseDirectory();
-            }
-            else
-            {
-                gt1FileBuilt = true;
-            }
+        uploadFile(uploadTarget, filename, filepath, false);
+    }
+
+    // Called in vBlank once the worker has finished
+    void uploadCompiled(void)
+    {
+        _compileThread.join();
+        fprintf(stderr, "%s", _compileOutput.c_str());
+
+        if(_compileState == Failed)
+        {
+            // Last line of the compiler's output is the most descriptive
+            std::string error = _compileOutput;
+            while(error.size()  &&  (error.back() == '\n'  ||  error.back() == '\r')) error.pop_back();
+            size_t eol = error.find_last_of("\n");
+            if(eol != std::string::npos) error = error.substr(eol + 1);
+            _uploadStatus = "Error: " + error;
+
+            fprintf(stderr, "\nLoader::uploadCompiled() : failed to compile '%s'\n", _compileFilename.c_str());
+            if(_compileGt1Deleted) Editor::browseDirectory();
         }
-        
-        // Upload gt1
+        else
+        {
+            _uploadStatus = "";
+            uploadFile(_compileTarget, _compileFilename, _compileFilepath, true);
+        }
+
+        _compileState = Idle;
+    }
+
+    void uploadFile(UploadTarget uploadTarget, std::string filename, std::string filepath, bool gt1FileBuilt)
+    {
+        bool isGt1File = false;
+        bool hasRomCode = false;
+        bool hasRamCode = false;
+
+        uint16_t executeAddress = Editor::getLoadBaseAddress();
+
+        // Reset video table and reset single step watch address to video line counter
+        Graphics::resetVTable();
+        Editor::setSingleStepWatchAddress(VIDEO_Y_ADDRESS);
+
+        Gt1File gt1File;
+        Mapping::Gt1Map gt1Map;
+
+        // Upload gt1, segments are read straight out of the mapping
         if(filename.find(".gt1") != filename.npos)
         {
             Assembler::clearAssembler();
 
-            if(!loadGt1File(filepath, gt1File)) return;
-            executeAddress = gt1File._loStart + (gt1File._hiStart <<8);
+            if(!Mapping::mapGt1File(filepath, gt1Map))
+            {
+                fprintf(stderr, "Loader::upload() : failed to load '%s'\n", filepath.c_str());
+                return;
+            }
+            executeAddress = gt1Map._loStart + (gt1Map._hiStart <<8);
             Editor::setLoadBaseAddress(executeAddress);
 
-            if(uploadTarget == Emulator)
+            if(uploadTarget == Emulator  &&  _configUploadMode == Direct)
             {
-                for(int j=0; j<gt1File._segments.size(); j++)
+                for(int j=0; j<gt1Map._spans.size(); j++)
                 {
-                    uint16_t address = gt1File._segments[j]._loAddress + (gt1File._segments[j]._hiAddress <<8);
-                    for(int i=0; i<gt1File._segments[j]._dataBytes.size(); i++)
+                    const Mapping::Gt1Span& span = gt1Map._spans[j];
+                    for(int i=0; i<span._size; i++)
                     {
-                        Cpu::setRAM(address+i, gt1File._segments[j]._dataBytes[i]);
+                        Cpu::setRAM(span._address+i, span._data[i]);
                     }
                 }
             }
@@ -911,7 +1602,7 @@ namespace Loader
                     gt1Segment._hiAddress = (address & 0xFF00) >>8;
                 }
 
-                if(uploadTarget == Emulator  &&  !_disableUploads)
+                if(uploadTarget == Emulator  &&  !_disableUploads  &&  (_configUploadMode == Direct  ||  byteCode._isRomAddress))
                 {
                     (byteCode._isRomAddress) ? Cpu::setROM(customAddress, address++, byteCode._data) : Cpu::setRAM(address++, byteCode._data);
                 }
@@ -938,7 +1629,7 @@ namespace Loader
             return;
         }
 
-        uint16_t totalSize = printGt1Stats(filename, gt1File);
+        uint16_t totalSize = (isGt1File) ? printGt1Stats(filename, gt1Map) : printGt1Stats(filename, gt1File);
         Cpu::setFreeRAM(Cpu::getBaseFreeRAM() - totalSize); 
 
         if(uploadTarget == Emulator)
@@ -947,8 +1638,13 @@ namespace Loader
             _currentGame = (i != std::string::npos) ? filename.substr(0, i) : filename;
             loadHighScore();
 
+            // Stream code through the emulated Loader, one frame per vSync
+            if(!_disableUploads  &&  hasRamCode  &&  _configUploadMode == Frames)
+            {
+                (isGt1File) ? buildLoaderFrames(gt1Map, executeAddress) : buildLoaderFrames(gt1File, executeAddress);
+            }
             // Execute code
-            if(!_disableUploads  &&  hasRamCode)
+            else if(!_disableUploads  &&  hasRamCode)
             {
                 Cpu::setRAM(0x0016, executeAddress-2 & 0x00FF);
                 Cpu::setRAM(0x0017, (executeAddress & 0xFF00) >>8);
@@ -970,6 +1666,8 @@ namespace Loader
             }
         }
 
+        Mapping::unmapGt1File(gt1Map);
+
         // Updates browser in case a new gt1 file was created from a gcl file or a vasm file
         if(gt1FileBuilt) Editor::browseDirectory();
 
@@ -1075,62 +1773,58 @@ namespace Loader
         return sending;
     }
 
-    // TODO: fix the Gigatron version of upload so that it can send more than 60 total bytes, (i.e. break up the payload into multiple packets of 60, 1 packet per frame)
     void upload(int vgaY)
     {
-        static bool frameUploading = false;
-        static FILE* fileToUpload = NULL;
-        static FILE* fileToSave = NULL;
-        static uint8_t payload[RAM_SIZE];
-        static uint8_t payloadSize = 0;
+        static uint8_t checksum = 0;
+
+        if(vgaY == VSYNC_START  &&  _compileState >= Compiled) uploadCompiled();
 
-        if(_uploadTarget != None  ||  frameUploading)
+        if(_uploadTarget != None)
         {
-            uint16_t executeAddress = Editor::getLoadBaseAddress();
-            if(_uploadTarget != None)
-            {
-                uploadDirect(_uploadTarget);
-                _uploadTarget = None;
-                //frameUploading = true;
+            uploadDirect(_uploadTarget);
+            _uploadTarget = None;
+            return;
+        }
 
-                return;
-            }
-            
-            static uint8_t checksum = 0;
-            static FrameState frameState = FrameState::Resync;
+        if(!_frameUploading) return;
 
-            switch(frameState)
+        LoaderFrame& frame = _loaderFrames[_frameUploadIndex];
+        switch(frame._frameState)
+        {
+            case FrameState::Resync:
             {
-                case FrameState::Resync:
+                if(!sendFrame(vgaY, -1, frame._payload, frame._length, frame._address, checksum))
                 {
-                    if(!sendFrame(vgaY, -1, payload, payloadSize, executeAddress, checksum))
-                    {
-                        checksum = 'g'; // loader resets checksum
-                        frameState = FrameState::Frame;
-                    }
+                    checksum = 'g'; // loader resets checksum
+                    _frameUploadIndex++;
                 }
-                break;
+            }
+            break;
 
-                case FrameState::Frame:
+            case FrameState::Frame:
+            {
+                if(!sendFrame(vgaY, 'L', frame._payload, frame._length, frame._address, checksum))
                 {
-                    if(!sendFrame(vgaY,'L', payload, payloadSize, executeAddress, checksum))
-                    {
-                        frameState = FrameState::Execute;
-                    }
+                    _frameUploadBytes += frame._length;
+                    _frameUploadIndex++;
                 }
-                break;
+            }
+            break;
 
-                case FrameState::Execute:
+            case FrameState::Execute:
+            {
+                if(!sendFrame(vgaY, 'L', frame._payload, 0, frame._address, checksum))
                 {
-                    if(!sendFrame(vgaY, 'L', payload, 0, executeAddress, checksum))
-                    {
-                        checksum = 0;
-                        frameState = FrameState::Resync;
-                        frameUploading = false;
-                    }
+                    checksum = 0;
+                    _frameUploading = false;
+                    _loaderFrames.clear();
+
+                    // Throughput is measured in emulated time, i.e. 60 frames per second
+                    uint64_t frames = std::max(Timing::getFrameCount() - _frameUploadStart, uint64_t(1));
+                    fprintf(stderr, "Loader::upload() : sent %d bytes in %d frames : %.1f bytes/s\n", _frameUploadBytes, int(frames), double(_frameUploadBytes) * VSYNC_RATE / double(frames));
                 }
-                break;
             }
+            break;
         }
     }
 #endif
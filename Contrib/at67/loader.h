@@ -2,9 +2,11 @@
 #define LOADER_H
 
 
+#include <string>
 #include <vector>
 
 #include "timing.h"
+#include "mapping.h"
 
 
 #define PAYLOAD_SIZE              60
@@ -39,8 +41,15 @@ namespace Loader
 
 
     bool loadGt1File(const std::string& filename, Gt1File& gt1File);
+    bool compileGclFile(const std::string& gclFilename, const std::string& gt1Filename, const std::string& interfaceFilename, std::string& error);
+    void optimiseGt1File(Gt1File& gt1File);
+    int getGt1FileSize(const Gt1File& gt1File);
+    bool compressGt1File(const Gt1File& gt1File, Gt1File& compressed);
+    bool compressGt1FileForRom(const Gt1File& gt1File, std::vector<uint8_t>& romStream);
+    uint32_t getGt1RomLoadCycles(const std::vector<uint8_t>& romStream, bool isCompressed);
     bool saveGt1File(const std::string& filepath, Gt1File& gt1File, std::string& filename);
     uint16_t printGt1Stats(const std::string& filename, const Gt1File& gt1File);
+    uint16_t printGt1Stats(const std::string& filename, const Mapping::Gt1Map& gt1Map);
 
 
 #ifndef STAND_ALONE
@@ -61,8 +70,10 @@ namespace Loader
 
 
     void initialise(void);
+    void shutdown(void);
 
     UploadTarget getUploadTarget(void);
+    const std::string& getUploadStatus(void);
     void setUploadTarget(UploadTarget target);
     void disableUploads(bool disable);
     void sendCommandToGiga(char cmd, bool wait);
@@ -0,0 +1,196 @@
+#include <stdio.h>
+
+#include "mapping.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+namespace Mapping
+{
+#ifdef _WIN32
+    bool mapFile(const std::string& filename, File& file)
+    {
+        file = File();
+
+        HANDLE fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(fileHandle == INVALID_HANDLE_VALUE)
+        {
+            fprintf(stderr, "Mapping::mapFile() : failed to open '%s'\n", filename.c_str());
+            return false;
+        }
+
+        LARGE_INTEGER fileSize;
+        if(!GetFileSizeEx(fileHandle, &fileSize))
+        {
+            fprintf(stderr, "Mapping::mapFile() : failed to get size of '%s'\n", filename.c_str());
+            CloseHandle(fileHandle);
+            return false;
+        }
+
+        // Zero length files can't be mapped, they are returned as an empty view
+        file._fileHandle = fileHandle;
+        file._size = size_t(fileSize.QuadPart);
+        if(file._size == 0) return true;
+
+        HANDLE mapHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if(mapHandle == NULL)
+        {
+            fprintf(stderr, "Mapping::mapFile() : failed to map '%s'\n", filename.c_str());
+            unmapFile(file);
+            return false;
+        }
+        file._mapHandle = mapHandle;
+
+        file._data = (const uint8_t*)MapViewOfFile(mapHandle, FILE_MAP_READ, 0, 0, 0);
+        if(file._data == nullptr)
+        {
+            fprintf(stderr, "Mapping::mapFile() : failed to view '%s'\n", filename.c_str());
+            unmapFile(file);
+            return false;
+        }
+
+        return true;
+    }
+
+    void unmapFile(File& file)
+    {
+        if(file._data) UnmapViewOfFile(file._data);
+        if(file._mapHandle) CloseHandle(HANDLE(file._mapHandle));
+        if(file._fileHandle) CloseHandle(HANDLE(file._fileHandle));
+        file = File();
+    }
+#else
+    bool mapFile(const std::string& filename, File& file)
+    {
+        file = File();
+
+        int fd = open(filename.c_str(), O_RDONLY);
+        if(fd == -1)
+        {
+            fprintf(stderr, "Mapping::mapFile() : failed to open '%s'\n", filename.c_str());
+            return false;
+        }
+
+        struct stat fileStat;
+        if(fstat(fd, &fileStat) == -1)
+        {
+            fprintf(stderr, "Mapping::mapFile() : failed to get size of '%s'\n", filename.c_str());
+            close(fd);
+            return false;
+        }
+
+        // Zero length files can't be mapped, they are returned as an empty view
+        file._fd = fd;
+        file._size = size_t(fileStat.st_size);
+        if(file._size == 0) return true;
+
+        void* data = mmap(nullptr, file._size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data == MAP_FAILED)
+        {
+            fprintf(stderr, "Mapping::mapFile() : failed to map '%s'\n", filename.c_str());
+            unmapFile(file);
+            return false;
+        }
+        file._data = (const uint8_t*)data;
+
+        return true;
+    }
+
+    void unmapFile(File& file)
+    {
+        if(file._data) munmap((void*)file._data, file._size);
+        if(file._fd != -1) close(file._fd);
+        file = File();
+    }
+#endif
+
+    // Walks the segment headers without copying, every span is checked against the end of the data
+    bool validateGt1(const uint8_t* data, size_t size, Gt1Map& gt1Map, const std::string& filename)
+    {
+        gt1Map._spans.clear();
+        gt1Map._pageCrossings = 0;
+
+        if(data == nullptr  ||  size < GT1_MIN_SIZE)
+        {
+            fprintf(stderr, "Mapping::validateGt1() : '%s' is too small to be a gt1 file, %d bytes\n", filename.c_str(), int(size));
+            return false;
+        }
+
+        size_t offset = 0;
+        for(;;)
+        {
+            // Terminator, hiStart and loStart must be the last three bytes
+            if(data[offset] == 0x00  &&  offset + GT1_MIN_SIZE == size)
+            {
+                gt1Map._hiStart = data[offset + 1];
+                gt1Map._loStart = data[offset + 2];
+                break;
+            }
+
+            int segment = int(gt1Map._spans.size()) + 1;
+            if(offset + GT1_MIN_SIZE > size)
+            {
+                fprintf(stderr, "Mapping::validateGt1() : truncated header in segment %d of '%s' at offset %d\n", segment, filename.c_str(), int(offset));
+                return false;
+            }
+
+            Gt1Span span;
+            span._address = (data[offset] <<8) | data[offset + 1];
+            span._size = (data[offset + 2] == 0) ? 256 : data[offset + 2];
+            span._data = &data[offset + GT1_MIN_SIZE];
+            offset += GT1_MIN_SIZE;
+
+            if(offset + span._size > size)
+            {
+                fprintf(stderr, "Mapping::validateGt1() : truncated data in segment %d of '%s', 0x%04X needs %d bytes, %d left\n", segment, filename.c_str(), span._address, span._size,
+                                                                                                                                  int(size - offset));
+                return false;
+            }
+            offset += span._size;
+
+            // The Loader wraps segments within their page, so a crossing is legal but almost certainly a mistake
+            if((span._address & 0x00FF) + span._size > 256) gt1Map._pageCrossings++;
+
+            gt1Map._spans.push_back(span);
+
+            if(offset == size)
+            {
+                fprintf(stderr, "Mapping::validateGt1() : missing terminator in '%s'\n", filename.c_str());
+                return false;
+            }
+        }
+
+        if(gt1Map._pageCrossings)
+        {
+            fprintf(stderr, "Mapping::validateGt1() : warning, %d segments of '%s' cross a page boundary\n", gt1Map._pageCrossings, filename.c_str());
+        }
+
+        return true;
+    }
+
+    bool mapGt1File(const std::string& filename, Gt1Map& gt1Map)
+    {
+        if(!mapFile(filename, gt1Map._file)) return false;
+
+        if(!validateGt1(gt1Map._file._data, gt1Map._file._size, gt1Map, filename))
+        {
+            unmapGt1File(gt1Map);
+            return false;
+        }
+
+        return true;
+    }
+
+    void unmapGt1File(Gt1Map& gt1Map)
+    {
+        unmapFile(gt1Map._file);
+        gt1Map._spans.clear();
+    }
+}
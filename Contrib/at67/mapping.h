@@ -0,0 +1,53 @@
+#ifndef MAPPING_H
+#define MAPPING_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+
+#define GT1_MIN_SIZE  3
+
+
+namespace Mapping
+{
+    // Read only view of a whole file, backed by mmap/MapViewOfFile
+    struct File
+    {
+        const uint8_t* _data = nullptr;
+        size_t _size = 0;
+#ifdef _WIN32
+        void* _fileHandle = nullptr;
+        void* _mapHandle = nullptr;
+#else
+        int _fd = -1;
+#endif
+    };
+
+    // A gt1 segment as a span into the mapping, no bytes are copied
+    struct Gt1Span
+    {
+        uint16_t _address;
+        uint16_t _size;
+        const uint8_t* _data;
+    };
+
+    struct Gt1Map
+    {
+        File _file;
+        std::vector<Gt1Span> _spans;
+        uint8_t _hiStart = 0x00;
+        uint8_t _loStart = 0x00;
+        int _pageCrossings = 0;
+    };
+
+
+    bool mapFile(const std::string& filename, File& file);
+    void unmapFile(File& file);
+
+    bool validateGt1(const uint8_t* data, size_t size, Gt1Map& gt1Map, const std::string& filename);
+    bool mapGt1File(const std::string& filename, Gt1Map& gt1Map);
+    void unmapGt1File(Gt1Map& gt1Map);
+}
+
+#endif
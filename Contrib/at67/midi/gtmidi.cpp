@@ -6,26 +6,85 @@
 #include <iomanip>
 #include <fstream>
 #include <string>
+#include <vector>
+#include <map>
 #include <algorithm>
 
 
-// 64K is maximum size, (good luck getting it into a Gigatron)
-#define MAX_MIDI_BUFFER_SIZE  0x10000
 #define MAX_SOUND_CHANNELS    4
 #define MASK_SOUND_CHANNELS   0x03
 #define MIN_GIGA_NOTE         12
 #define MAX_GIGA_NOTE         106
 #define PERCUSSION_NOTES      128
-
-#define GTMIDI_MAJOR_VERSION "0.3"
-#define GTMIDI_MINOR_VERSION "4"
+#define PERCUSSION_CHANNEL    9
+#define FRAME_TIME_MS         16.6666666667
+#define MAX_RAW_DELAY         0x7F
+
+// Compact score commands, see README.md
+#define COMPACT_NOTE_OFF      0x80  // 0x8m, stops every channel in mask m
+#define COMPACT_CHANNEL       0x90  // 0x9t, sets the running channel, notes 0x00-0x7F play on the running channel which then advances
+#define COMPACT_DELAY         0xA0  // 0xA0-0xCF, waits 1 to 48 frames
+#define COMPACT_SEGMENT       0xD0  // 0xD0 lo hi, continues at a new segment
+#define COMPACT_PATTERN       0xD1  // 0xD1 lo hi len, plays len bytes at lo hi then returns
+#define COMPACT_DELAY_LONG    0xE0  // 0xE0 varint, waits varint frames
+#define MAX_COMPACT_DELAY     48
+#define COMPACT_NOTE_NONE     -1
+#define COMPACT_NOTE_STOP     -2
+#define MAX_PATTERN_SIZE      0xFF
+#define MAX_PATTERN_SEARCH    1024  // most recent candidates searched for each pattern
+#define SEGMENT_COMMAND_SIZE  3
+#define PATTERN_COMMAND_SIZE  4
+
+#define GTMIDI_MAJOR_VERSION "0.4"
+#define GTMIDI_MINOR_VERSION "0"
 #define GTMIDI_VERSION_STR "gtmidi v" GTMIDI_MAJOR_VERSION "." GTMIDI_MINOR_VERSION
 
 
 enum Format {vCPU=0, GCL, CPP, PY, NumFormats};
+enum Encoding {Raw=0, Compact, NumEncodings};
+enum EventType {NoteOn=0, NoteOff, Delay};
+
+
+// Delays are in ms, notes have already been assigned to a sound channel
+struct Event
+{
+    EventType _type;
+    uint8_t _channel = 0;
+    uint8_t _note = 0;
+    double _delay = 0.0;
+};
+
+// A complete command, tokens are never split across segments or patterns
+struct Token
+{
+    std::vector<uint8_t> _bytes;
+    uint8_t _channel = 0; // compact running channel before this token
+};
+
+struct Segment
+{
+    uint16_t _address;
+    int _size = 0;
+    std::vector<std::vector<uint8_t>> _commands;
+};
 
+// SMF tracks are read an event at a time from their own position in the file
+struct Track
+{
+    std::streamoff _position = 0;
+    uint32_t _remaining = 0;
+    uint64_t _tick = 0;
+    uint8_t _status = 0;
+    bool _done = false;
+};
 
-uint8_t midiBuffer[MAX_MIDI_BUFFER_SIZE];
+struct Generator
+{
+    bool _playing = false;
+    uint8_t _channel = 0;
+    uint8_t _note = 0;
+    uint64_t _started = 0;
+};
 
 
 void padString(std::string &str, size_t num, char pad=' ')
@@ -47,16 +106,11 @@ void outputvCPUheader(std::ofstream& outfile, const std::string& name, uint16_t
         ss << segmentName << std::setfill('0') << std::setw(2) << std::to_string(segmentIndex);
         segmentName = ss.str();
     }
-    addString(segmentName, 16 - segmentName.size());
+    addString(segmentName, (segmentName.size() < 16) ? 16 - segmentName.size() : 2);
     outfile << segmentName.c_str() << "EQU     0x" << std::hex << std::setw(4) << std::setfill('0') << address << std::endl;
     outfile << segmentName.c_str() << "DB     ";
     charCount = 26;
 };
-void outputvCPUstartNote(std::ofstream& outfile, uint8_t command, uint8_t note, int& charCount)
-{
-    outfile << " 0x" << std::hex << std::setw(2) << std::setfill('0') << uint16_t(command) << " 0x" << std::hex << std::setw(2) << std::setfill('0') << uint16_t(note);
-    charCount += 10;
-}
 void outputvCPUcommand(std::ofstream& outfile, uint8_t command, int& charCount)
 {
     outfile << " 0x" << std::hex << std::setw(2) << std::setfill('0') << uint16_t(command);
@@ -77,11 +131,6 @@ void outputGCLheader(std::ofstream& outfile, uint16_t address, int& charCount)
     outfile << "[def" << std::endl << " ";
     charCount = 1;
 };
-void outputGCLstartNote(std::ofstream& outfile, uint8_t command, uint8_t note, int& charCount)
-{
-    outfile << " $" << std::hex << std::setw(2) << std::setfill('0') << uint16_t(command) << "#" << " $" << std::hex << std::setw(2) << std::setfill('0') << uint16_t(note) << "#";
-    charCount += 10;
-}
 void outputGCLcommand(std::ofstream& outfile, uint8_t command, int& charCount)
 {
     outfile << " $" << std::hex << std::setw(2) << std::setfill('0') << uint16_t(command) << "#";
@@ -92,31 +141,27 @@ void outputGCLnewLine(std::ofstream& outfile, int& charCount)
     outfile << std::endl << " ";
     charCount = 1;
 }
-void outputGCLfooter(std::ofstream& outfile, const std::string& name)
+void outputGCLfooter(std::ofstream& outfile)
 {
     outfile << std::endl << "]" << std::endl;
 }
 
 // CPP output
-void outputCPPheader(std::ofstream& outfile, const std::string& name, uint16_t segmentSize, uint16_t segmentIndex, std::string& segmentName, int& charCount)
+void outputCPPheader(std::ofstream& outfile, const std::string& name, uint16_t address, uint16_t segmentSize, uint16_t segmentIndex, std::string& segmentName, int& charCount)
 {
     segmentName = name;
     if(segmentSize)
     {
         std::stringstream ss;
         ss << segmentName << std::setfill('0') << std::setw(2) << std::to_string(segmentIndex);
-        segmentName = ss.str() + "[] = ";
+        segmentName = ss.str();
     }
-    outfile << "uint8_t " << segmentName.c_str() << std::endl;
+    outfile << "#define " << segmentName.c_str() << "Address 0x" << std::hex << std::setw(4) << std::setfill('0') << address << std::endl;
+    outfile << "uint8_t " << segmentName.c_str() << "[] = " << std::endl;
     outfile << "{" << std::endl;
     outfile << "    ";
     charCount = 4;
 };
-void outputCPPstartNote(std::ofstream& outfile, uint8_t command, uint8_t note, int& charCount)
-{
-    outfile << "0x" << std::hex << std::setw(2) << std::setfill('0') << uint16_t(command) << ",0x" << std::hex << std::setw(2) << std::setfill('0') << uint16_t(note) << ",";
-    charCount += 10;
-}
 void outputCPPcommand(std::ofstream& outfile, uint8_t command, int& charCount)
 {
     outfile << "0x" << std::hex << std::setw(2) << std::setfill('0') << uint16_t(command) << ",";
@@ -140,17 +185,12 @@ void outputPYheader(std::ofstream& outfile, const std::string& name, uint16_t se
     {
         std::stringstream ss;
         ss << segmentName << std::setfill('0') << std::setw(2) << std::to_string(segmentIndex);
-        segmentName = ss.str() + " = bytearray([";
+        segmentName = ss.str();
     }
-    outfile << segmentName.c_str() << std::endl;
+    outfile << segmentName.c_str() << " = bytearray([" << std::endl;
     outfile << "    ";
     charCount = 4;
 };
-void outputPYstartNote(std::ofstream& outfile, uint8_t command, uint8_t note, int& charCount)
-{
-    outfile << "0x" << std::hex << std::setw(2) << std::setfill('0') << uint16_t(command) << ",0x" << std::hex << std::setw(2) << std::setfill('0') << uint16_t(note) << ",";
-    charCount += 10;
-}
 void outputPYcommand(std::ofstream& outfile, uint8_t command, int& charCount)
 {
     outfile << "0x" << std::hex << std::setw(2) << std::setfill('0') << uint16_t(command) << ",";
@@ -166,255 +206,784 @@ void outputPYfooter(std::ofstream& outfile)
     outfile << std::endl << "])" << std::endl;
 }
 
-void outputDelay(std::ofstream& outfile, Format format, uint8_t delay8, double timingAdjust, double totalTime16, double& totalTime8, int& charCount)
+
+uint8_t gigaNote(uint8_t note)
 {
-    // Adjust delay8 to try and keep overall timing as accurate as possible
-    if(timingAdjust)
-    {
-        if(totalTime16 > totalTime8 + double(delay8)*16.6666666667 + 16.6666666667*timingAdjust  &&  delay8 < 0x7F)  delay8++;
-        if(totalTime16 < totalTime8 + double(delay8)*16.6666666667 - 16.6666666667*timingAdjust  &&  delay8 > 0x01)  delay8--;
-    }
+    if(note >= PERCUSSION_NOTES) note -= PERCUSSION_NOTES;
+    if(note < MIN_GIGA_NOTE) note = MIN_GIGA_NOTE;
+    if(note > MAX_GIGA_NOTE) note = MAX_GIGA_NOTE;
+    return note;
+}
 
-    totalTime8 += double(delay8) * 16.6666666667;
+// Sequences of delays are coalesced together
+void addDelay(std::vector<Event>& events, double delay)
+{
+    if(delay <= 0.0) return;
 
-    switch(format)
+    if(events.size()  &&  events.back()._type == Delay)
     {
-        case Format::vCPU: outputvCPUcommand(outfile, delay8, charCount); break;
-        case Format::GCL:  outputGCLcommand(outfile, delay8, charCount);  break;
-        case Format::CPP:  outputCPPcommand(outfile, delay8, charCount);  break;
-        case Format::PY:   outputPYcommand(outfile, delay8, charCount);   break;
+        events.back()._delay += delay;
+        return;
     }
+
+    Event event = {Delay};
+    event._delay = delay;
+    events.push_back(event);
 }
 
-int main(int argc, char* argv[])
+void addNote(std::vector<Event>& events, EventType type, uint8_t channel, uint8_t note=0)
 {
-    if(argc != 10)
+    Event event = {type};
+    event._channel = channel & MASK_SOUND_CHANNELS;
+    event._note = note;
+    events.push_back(event);
+}
+
+
+// Miditones binary, delays are 16bit big endian ms
+bool parseMiditones(std::ifstream& infile, const std::string& inFilename, std::vector<Event>& events, size_t& inputSize)
+{
+    int command;
+    while((command = infile.get()) != EOF)
     {
-        fprintf(stderr, "%s\n", GTMIDI_VERSION_STR);
-        fprintf(stderr, "Usage:   gtmidi <input filename> <output filename> <midiname> <int format 0, 1, 2 or 3> <uint16_t start_address in hex>\n         <uint16_t segment_offset in hex> <int segment_size> <int line_length> <float timing_adjust>\n");
-        fprintf(stderr, "Example: gtmidi game_over.bin game_over.i gameOver 0 0x8000 0 0 100 0.5\n");
-        fprintf(stderr, "Input:   miditones binary file produced with miditones, e.g. miditones -t4 -b -s1 -pi <filename>.bin\n");
-        fprintf(stderr, "Format:  0 = vCPU ASM, 1 = GCL, 2 = C/C++, 3 = Python\n");
-        return 1;
+        inputSize++;
+        if(command & 0x80)
+        {
+            // Start note
+            if((command & 0xF0) == 0x90)
+            {
+                int note = infile.get();
+                if(note == EOF) break;
+                inputSize++;
+                addNote(events, NoteOn, uint8_t(command), gigaNote(uint8_t(note)));
+            }
+            // Stop note
+            else if((command & 0xF0) == 0x80)
+            {
+                addNote(events, NoteOff, uint8_t(command));
+            }
+            // Stop and restart midi events are ignored
+        }
+        // Delay n milliseconds where n = 16bit value
+        else
+        {
+            int delay = infile.get();
+            if(delay == EOF) break;
+            inputSize++;
+            addDelay(events, double((command <<8) | delay));
+        }
     }
 
-    std::string inFilename = std::string(argv[1]);
-    std::string outFilename = std::string(argv[2]);
-    std::string midiName = std::string(argv[3]);
+    if(infile.bad())
+    {
+        fprintf(stderr, "parseMiditones() : failed to read input file '%s'\n", inFilename.c_str());
+        return false;
+    }
 
-    Format format = (Format)strtol(argv[4], nullptr, 10);
-    if(format < Format::vCPU  ||  format >= Format::NumFormats)
+    return true;
+}
+
+
+bool readByte(std::ifstream& infile, Track& track, uint8_t& byte)
+{
+    if(track._remaining == 0) return false;
+
+    int data = infile.get();
+    if(data == EOF) return false;
+
+    track._remaining--;
+    byte = uint8_t(data);
+    return true;
+}
+bool readVarint(std::ifstream& infile, Track& track, uint32_t& value)
+{
+    value = 0;
+    for(int i=0; i<4; i++)
     {
-        fprintf(stderr, "Format must be 0, 1, 2 or 3\n");
-        return 1;
+        uint8_t byte;
+        if(!readByte(infile, track, byte)) return false;
+        value = (value <<7) | (byte & 0x7F);
+        if((byte & 0x80) == 0) return true;
     }
 
-    // Handles hex numbers
-    uint16_t startAddress, segmentOffset;
-    std::stringstream ss0, ss1;
-    ss0 << std::hex << argv[5];
-    ss0 >> startAddress;
-    ss1 << std::hex << argv[6];
-    ss1 >> segmentOffset;
+    return false;
+}
+bool skipBytes(std::ifstream& infile, Track& track, uint32_t count)
+{
+    uint8_t byte;
+    for(uint32_t i=0; i<count; i++)
+    {
+        if(!readByte(infile, track, byte)) return false;
+    }
 
-    uint16_t segmentSize = uint16_t(strtol(argv[7], nullptr, 10));
-    int lineLength = strtol(argv[8], nullptr, 10);
-    double timingAdjust = strtod(argv[9], nullptr);
+    return true;
+}
+uint32_t readBigEndian(const uint8_t* bytes, int count)
+{
+    uint32_t value = 0;
+    for(int i=0; i<count; i++) value = (value <<8) | bytes[i];
+    return value;
+}
 
-    std::ifstream infile(inFilename, std::ios::binary | std::ios::in);
-    if(!infile.is_open())
+// MIDI channels are mapped onto the Gigatron's sound channels, when they run out the oldest note is stolen
+void startNote(std::vector<Event>& events, Generator* generators, uint8_t channel, uint8_t note, uint64_t tick)
+{
+    int index = -1;
+    for(int i=0; i<MAX_SOUND_CHANNELS; i++)
     {
-        fprintf(stderr, "Failed to open input file '%s'\n", inFilename.c_str());
-        return 1;
+        if(generators[i]._playing  &&  generators[i]._channel == channel  &&  generators[i]._note == note) {index = i; break;}
+    }
+    for(int i=0; i<MAX_SOUND_CHANNELS  &&  index == -1; i++)
+    {
+        if(!generators[i]._playing) index = i;
+    }
+    if(index == -1)
+    {
+        index = 0;
+        for(int i=1; i<MAX_SOUND_CHANNELS; i++)
+        {
+            if(generators[i]._started < generators[index]._started) index = i;
+        }
     }
 
-    std::ofstream outfile(outFilename, std::ios::binary | std::ios::out);
-    if(!outfile.is_open())
+    generators[index]._playing = true;
+    generators[index]._channel = channel;
+    generators[index]._note = note;
+    generators[index]._started = tick;
+    addNote(events, NoteOn, uint8_t(index), gigaNote(note));
+}
+void stopNote(std::vector<Event>& events, Generator* generators, uint8_t channel, uint8_t note)
+{
+    for(int i=0; i<MAX_SOUND_CHANNELS; i++)
     {
-        fprintf(stderr, "Failed to open output file '%s'\n", outFilename.c_str());
-        return 1;
+        if(generators[i]._playing  &&  generators[i]._channel == channel  &&  generators[i]._note == note)
+        {
+            generators[i]._playing = false;
+            addNote(events, NoteOff, uint8_t(i));
+            return;
+        }
     }
+}
 
-    infile.read((char *)&midiBuffer, MAX_MIDI_BUFFER_SIZE);
-    if(infile.bad())
+// Standard MIDI file, tracks are merged in tick order while being read, nothing is buffered except the resulting events
+bool parseSMF(std::ifstream& infile, const std::string& inFilename, std::vector<Event>& events, size_t& inputSize)
+{
+    uint8_t header[14];
+    infile.read((char *)header, sizeof(header));
+    if(infile.gcount() != sizeof(header)  ||  readBigEndian(&header[4], 4) < 6)
     {
-        fprintf(stderr, "Failed to read input file '%s'\n", inFilename.c_str());
-        return 1;
+        fprintf(stderr, "parseSMF() : bad header in '%s'\n", inFilename.c_str());
+        return false;
     }
 
-    size_t midiSize = infile.gcount();
-    uint8_t* midiPtr = midiBuffer;
-    uint16_t gigaSize = 0;
+    uint32_t headerSize = readBigEndian(&header[4], 4);
+    uint16_t numTracks = uint16_t(readBigEndian(&header[10], 2));
+    uint16_t division = uint16_t(readBigEndian(&header[12], 2));
+    infile.seekg(headerSize - 6, std::ios::cur);
 
-    double totalTime16 = 0;
-    double totalTime8 = 0;
+    // Tempo only applies to ticks per quarter note, SMPTE divisions are absolute
+    double msPerTick = 0.0;
+    uint32_t tempo = 500000;
+    bool smpte = (division & 0x8000) != 0;
+    if(smpte)
+    {
+        int framesPerSecond = -int8_t(division >>8);
+        int ticksPerFrame = division & 0x00FF;
+        if(framesPerSecond <= 0  ||  ticksPerFrame == 0)
+        {
+            fprintf(stderr, "parseSMF() : bad SMPTE division 0x%04x in '%s'\n", division, inFilename.c_str());
+            return false;
+        }
+        msPerTick = 1000.0 / double(framesPerSecond * ticksPerFrame);
+    }
+    else
+    {
+        if(division == 0)
+        {
+            fprintf(stderr, "parseSMF() : bad division in '%s'\n", inFilename.c_str());
+            return false;
+        }
+        msPerTick = double(tempo) / 1000.0 / double(division);
+    }
+
+    // Find track chunks, unknown chunks are skipped
+    std::vector<Track> tracks;
+    while(int(tracks.size()) < numTracks)
+    {
+        uint8_t chunk[8];
+        infile.read((char *)chunk, sizeof(chunk));
+        if(infile.gcount() != sizeof(chunk)) break;
+
+        Track track;
+        track._remaining = readBigEndian(&chunk[4], 4);
+        track._position = infile.tellg();
+        infile.seekg(track._remaining, std::ios::cur);
+        if(std::string((char *)chunk, 4) == "MTrk") tracks.push_back(track);
+    }
+    if(int(tracks.size()) != numTracks)
+    {
+        fprintf(stderr, "parseSMF() : expected %d tracks, found %d in '%s'\n", numTracks, int(tracks.size()), inFilename.c_str());
+    }
 
-    int charCount = 0;
-    uint16_t segmentIndex = 0;
-    std::string segmentName;
+    infile.clear();
+    infile.seekg(0, std::ios::end);
+    inputSize = size_t(infile.tellg());
 
-    // Header
-    switch(format)
+    // Delta time of each track's first event
+    for(int i=0; i<int(tracks.size()); i++)
     {
-        case Format::vCPU: outputvCPUheader(outfile, midiName, startAddress, segmentSize, segmentIndex, segmentName, charCount); break;
-        case Format::GCL:  outputGCLheader(outfile, startAddress, charCount);                                                    break;
-        case Format::CPP:  outputCPPheader(outfile, midiName, segmentSize, segmentIndex, segmentName, charCount);                break;
-        case Format::PY:   outputPYheader(outfile, midiName, segmentSize, segmentIndex, segmentName, charCount);                 break;
+        uint32_t delta;
+        infile.seekg(tracks[i]._position);
+        tracks[i]._done = !readVarint(infile, tracks[i], delta);
+        tracks[i]._tick = delta;
+        tracks[i]._position = infile.tellg();
     }
-    
-    // Commands
-    while(midiSize)
+
+    Generator generators[MAX_SOUND_CHANNELS];
+    uint64_t tick = 0;
+    double time = 0.0, eventTime = 0.0;
+
+    for(;;)
     {
-        uint8_t command = *midiPtr++; midiSize--;
-        if(command & 0x80)
+        // Next event in tick order, (ties go to the lowest track)
+        int index = -1;
+        for(int i=0; i<int(tracks.size()); i++)
         {
-            // Start note
-            if((command & 0xF0) == 0x90)
+            if(tracks[i]._done) continue;
+            if(index == -1  ||  tracks[i]._tick < tracks[index]._tick) index = i;
+        }
+        if(index == -1) break;
+
+        Track& track = tracks[index];
+        time += double(track._tick - tick) * msPerTick;
+        tick = track._tick;
+        infile.seekg(track._position);
+
+        // Running status, the first data byte has already been read
+        uint8_t status, data = 0;
+        bool runningStatus = false;
+        if(!readByte(infile, track, status)) {track._done = true; continue;}
+        if(status & 0x80)
+        {
+            if(status < 0xF0) track._status = status;
+        }
+        else
+        {
+            data = status;
+            status = track._status;
+            runningStatus = true;
+            if(status == 0)
             {
-                uint8_t note = *midiPtr++; midiSize--;
-                if(note >= PERCUSSION_NOTES) note -= PERCUSSION_NOTES;
-                if(note < MIN_GIGA_NOTE) note = MIN_GIGA_NOTE;
-                if(note > MAX_GIGA_NOTE) note = MAX_GIGA_NOTE;
-                gigaSize += 2;
-                switch(format)
+                fprintf(stderr, "parseSMF() : data byte without status in track %d of '%s'\n", index, inFilename.c_str());
+                return false;
+            }
+        }
+
+        bool valid = true;
+        switch(status & 0xF0)
+        {
+            case 0x80:
+            case 0x90:
+            {
+                uint8_t note = data, velocity;
+                if(!runningStatus) valid = readByte(infile, track, note);
+                valid = valid  &&  readByte(infile, track, velocity);
+                uint8_t channel = status & 0x0F;
+                if(!valid  ||  channel == PERCUSSION_CHANNEL) break;
+
+                addDelay(events, time - eventTime);
+                eventTime = time;
+                if((status & 0xF0) == 0x90  &&  velocity) startNote(events, generators, channel, note, tick);
+                else stopNote(events, generators, channel, note);
+            }
+            break;
+
+            // Aftertouch, controllers and pitch bend are ignored
+            case 0xA0:
+            case 0xB0:
+            case 0xE0: valid = skipBytes(infile, track, runningStatus ? 1 : 2); break;
+
+            // Program change and channel pressure are ignored
+            case 0xC0:
+            case 0xD0: valid = runningStatus  ||  skipBytes(infile, track, 1); break;
+
+            case 0xF0:
+            {
+                uint32_t length;
+                if(status == 0xF0  ||  status == 0xF7)
+                {
+                    valid = readVarint(infile, track, length)  &&  skipBytes(infile, track, length);
+                }
+                else if(status == 0xFF)
                 {
-                    case Format::vCPU: outputvCPUstartNote(outfile, command, note, charCount);  break;
-                    case Format::GCL:  outputGCLstartNote(outfile, command, note, charCount);   break;
-                    case Format::CPP:  outputCPPstartNote(outfile, command, note, charCount);   break;
-                    case Format::PY:   outputPYstartNote(outfile, command, note, charCount);    break;
+                    uint8_t type;
+                    valid = readByte(infile, track, type)  &&  readVarint(infile, track, length);
+                    if(!valid) break;
+
+                    // Tempo
+                    if(type == 0x51  &&  length == 3  &&  !smpte)
+                    {
+                        uint8_t bytes[3];
+                        valid = readByte(infile, track, bytes[0])  &&  readByte(infile, track, bytes[1])  &&  readByte(infile, track, bytes[2]);
+                        tempo = readBigEndian(bytes, 3);
+                        msPerTick = double(tempo) / 1000.0 / double(division);
+                    }
+                    // End of track
+                    else if(type == 0x2F)
+                    {
+                        track._done = true;
+                    }
+                    else
+                    {
+                        valid = skipBytes(infile, track, length);
+                    }
                 }
             }
-            // Stop note
-            else if((command & 0xF0) == 0x80)
+            break;
+
+            default: break;
+        }
+
+        if(!valid)
+        {
+            fprintf(stderr, "parseSMF() : track %d of '%s' is truncated\n", index, inFilename.c_str());
+            track._done = true;
+        }
+
+        uint32_t delta;
+        if(!track._done  &&  !readVarint(infile, track, delta)) track._done = true;
+        if(!track._done) track._tick += delta;
+        track._position = infile.tellg();
+    }
+
+    // Stop anything still playing and keep the tail of the score so that looping keeps time
+    addDelay(events, time - eventTime);
+    for(int i=0; i<MAX_SOUND_CHANNELS; i++)
+    {
+        if(generators[i]._playing) addNote(events, NoteOff, uint8_t(i));
+    }
+
+    return true;
+}
+
+
+// Adjust delay to try and keep overall timing as accurate as possible
+uint32_t adjustDelay(uint32_t delay, uint32_t maxDelay, double timingAdjust, double totalTime16, double& totalTime8)
+{
+    if(timingAdjust)
+    {
+        if(totalTime16 > totalTime8 + double(delay)*FRAME_TIME_MS + FRAME_TIME_MS*timingAdjust  &&  delay < maxDelay)  delay++;
+        if(totalTime16 < totalTime8 + double(delay)*FRAME_TIME_MS - FRAME_TIME_MS*timingAdjust  &&  delay > 0x01)  delay--;
+    }
+
+    totalTime8 += double(delay) * FRAME_TIME_MS;
+    return delay;
+}
+
+// One command per event, delays are a variable length stream of 1 byte delays
+void encodeRaw(const std::vector<Event>& events, double timingAdjust, std::vector<Token>& tokens, double& totalTime16, double& totalTime8)
+{
+    for(int i=0; i<int(events.size()); i++)
+    {
+        const Event& event = events[i];
+        Token token;
+        switch(event._type)
+        {
+            case NoteOn:  token._bytes = {uint8_t(0x90 | event._channel), event._note}; tokens.push_back(token); break;
+            case NoteOff: token._bytes = {uint8_t(0x80 | event._channel)};              tokens.push_back(token); break;
+
+            case Delay:
             {
-                gigaSize += 1;
-                switch(format)
+                totalTime16 += event._delay;
+
+                // Ignore zero delays
+                uint32_t delay = uint32_t(event._delay/FRAME_TIME_MS + 0.5);
+                if(delay == 0) break;
+
+                uint32_t div = delay / MAX_RAW_DELAY;
+                uint32_t rem = delay % MAX_RAW_DELAY;
+                for(uint32_t j=0; j<div; j++)
+                {
+                    token._bytes = {uint8_t(adjustDelay(MAX_RAW_DELAY, MAX_RAW_DELAY, timingAdjust, totalTime16, totalTime8))};
+                    tokens.push_back(token);
+                }
+                if(rem)
                 {
-                    case Format::vCPU: outputvCPUcommand(outfile, command, charCount); break;
-                    case Format::GCL:  outputGCLcommand(outfile, command, charCount);  break;
-                    case Format::CPP:  outputCPPcommand(outfile, command, charCount);  break;
-                    case Format::PY:   outputPYcommand(outfile, command, charCount);   break;
+                    token._bytes = {uint8_t(adjustDelay(rem, MAX_RAW_DELAY, timingAdjust, totalTime16, totalTime8))};
+                    tokens.push_back(token);
                 }
             }
-            // Stop midi events are ignored
-            else if((command & 0xF0) == 0xF0)
+            break;
+        }
+    }
+}
+
+// Delays are 1 byte up to 48 frames and then varints, note offs between delays share a channel mask, notes use running channels
+void encodeCompact(const std::vector<Event>& events, double timingAdjust, std::vector<Token>& tokens, double& totalTime16, double& totalTime8)
+{
+    // The score loops, so the first note can't rely on the running channel
+    uint8_t channel = MAX_SOUND_CHANNELS;
+
+    int i = 0;
+    while(i < int(events.size()))
+    {
+        if(events[i]._type == Delay)
+        {
+            totalTime16 += events[i]._delay;
+
+            // Ignore zero delays
+            uint32_t delay = uint32_t(events[i++]._delay/FRAME_TIME_MS + 0.5);
+            if(delay == 0) continue;
+
+            delay = adjustDelay(delay, 0xFFFFFFFF, timingAdjust, totalTime16, totalTime8);
+
+            Token token;
+            token._channel = channel;
+            if(delay <= MAX_COMPACT_DELAY)
             {
+                token._bytes = {uint8_t(COMPACT_DELAY + delay - 1)};
             }
-            // Restart midi events are ignored
-            else if((command & 0xF0) == 0xE0)
+            else
             {
+                // Big endian 7 bits per byte, bit 7 set on every byte but the last, (same as SMF)
+                uint8_t groups[5];
+                int count = 0;
+                do {groups[count++] = delay & 0x7F; delay >>= 7;} while(delay);
+                token._bytes = {COMPACT_DELAY_LONG};
+                while(count--) token._bytes.push_back(groups[count] | (count ? 0x80 : 0x00));
             }
+            tokens.push_back(token);
+            continue;
         }
-        // Delay n milliseconds where n = 16bit value, converted to 8bit, (0x00 <-> 0x7F)
-        else
+
+        // No time passes between delays, so only the last note event of each channel matters
+        int notes[MAX_SOUND_CHANNELS] = {COMPACT_NOTE_NONE, COMPACT_NOTE_NONE, COMPACT_NOTE_NONE, COMPACT_NOTE_NONE};
+        for(; i<int(events.size())  &&  events[i]._type != Delay; i++)
         {
-            // Coalesce sequence of delays together
-            int i = 0;
-            int coalescedDelay = ((command<<8) | *midiPtr++); midiSize--;
-            while(midiSize)
-            {
-                if(midiPtr[i] & 0x80) break;
-                coalescedDelay += (midiPtr[i]<<8) + midiPtr[i+1];
-                i += 2;
-                midiSize -= 2;
-            }
-            midiPtr += i;
+            notes[events[i]._channel] = (events[i]._type == NoteOn) ? events[i]._note : COMPACT_NOTE_STOP;
+        }
 
-            // Break up coalesced delay into bytes
-            if(coalescedDelay)
-            {
-                totalTime16 += double(coalescedDelay);
-                coalescedDelay = int(double(coalescedDelay)/16.6666666667 + 0.5);
+        uint8_t mask = 0x00;
+        for(int j=0; j<MAX_SOUND_CHANNELS; j++)
+        {
+            if(notes[j] == COMPACT_NOTE_STOP) mask |= uint8_t(1 <<j);
+        }
+        if(mask)
+        {
+            Token token;
+            token._channel = channel;
+            token._bytes = {uint8_t(COMPACT_NOTE_OFF | mask)};
+            tokens.push_back(token);
+        }
 
-                // Ignore zero delays
-                if(coalescedDelay)
+        for(int j=0; j<MAX_SOUND_CHANNELS; j++)
+        {
+            if(notes[j] == COMPACT_NOTE_NONE  ||  notes[j] == COMPACT_NOTE_STOP) continue;
+
+            Token token;
+            token._channel = channel;
+            if(channel != j) token._bytes.push_back(uint8_t(COMPACT_CHANNEL | j));
+            token._bytes.push_back(uint8_t(notes[j]));
+            tokens.push_back(token);
+            channel = (j + 1) & MASK_SOUND_CHANNELS;
+        }
+    }
+}
+
+
+std::string patternKey(const std::vector<Token>& tokens, int index)
+{
+    std::string key(1, char(tokens[index]._channel));
+    key.append(tokens[index]._bytes.begin(), tokens[index]._bytes.end());
+    if(index + 1 < int(tokens.size())) key.append(tokens[index + 1]._bytes.begin(), tokens[index + 1]._bytes.end());
+    return key;
+}
+
+// Lays commands out into segments, each segment is linked to the next by 0xD0, the last links back to the start so the score loops.
+// Compact scores replace repeats of already placed commands with 0xD1 pattern references, a pattern never spans segments or contains
+// another pattern, so players only need to remember one return address
+void layoutScore(const std::vector<Token>& tokens, Encoding encoding, uint16_t startAddress, uint16_t segmentOffset, uint16_t segmentSize,
+                 std::vector<Segment>& segments, int& numPatterns, int& patternSaving)
+{
+    bool segmented = segmentSize  &&  segmentOffset;
+    int capacity = segmented ? segmentSize - SEGMENT_COMMAND_SIZE : 0x10000;
+
+    // Placed literal commands, -1 when covered by a pattern
+    std::vector<int> addresses(tokens.size(), -1);
+    std::vector<int> segmentIndices(tokens.size(), -1);
+    std::map<std::string, std::vector<int>> candidates;
+
+    Segment segment;
+    segment._address = startAddress;
+    segments.push_back(segment);
+
+    numPatterns = 0;
+    patternSaving = 0;
+
+    int i = 0;
+    while(i < int(tokens.size()))
+    {
+        int patternStart = -1, patternLength = 0, patternBytes = 0;
+        std::string key = patternKey(tokens, i);
+
+        if(encoding == Compact)
+        {
+            auto it = candidates.find(key);
+            if(it != candidates.end())
+            {
+                const std::vector<int>& positions = it->second;
+                int count = 0;
+                for(int k=int(positions.size())-1; k>=0  &&  count<MAX_PATTERN_SEARCH; k--, count++)
                 {
-                    int div = coalescedDelay / 0x7F;
-                    int rem = coalescedDelay % 0x7F;
-                    gigaSize += div + 1;
+                    int j = positions[k];
+                    if(tokens[j]._channel != tokens[i]._channel) continue;
 
-                    for(int i=0; i<div; i++)
+                    int length = 0, bytes = 0;
+                    while(j + length < i  &&  i + length < int(tokens.size()))
                     {
-                        outputDelay(outfile, format, 0x7f, timingAdjust, totalTime16, totalTime8, charCount);
+                        int size = int(tokens[i + length]._bytes.size());
+                        if(addresses[j + length] == -1  ||  segmentIndices[j + length] != segmentIndices[j]) break;
+                        if(bytes + size > MAX_PATTERN_SIZE  ||  tokens[j + length]._bytes != tokens[i + length]._bytes) break;
+                        bytes += size;
+                        length++;
                     }
-                    outputDelay(outfile, format, rem, timingAdjust, totalTime16, totalTime8, charCount);
+                    if(bytes > patternBytes) {patternStart = j; patternLength = length; patternBytes = bytes;}
                 }
             }
         }
-        
-        // Segmented stream
-        if(midiSize  &&  segmentSize  &&  segmentOffset)
+
+        // Patterns must save something
+        bool pattern = patternBytes > PATTERN_COMMAND_SIZE;
+        int size = pattern ? PATTERN_COMMAND_SIZE : int(tokens[i]._bytes.size());
+        if(segments.back()._size + size > capacity)
         {
-            // If segment size is approaching count, (leave room for segment command 0xD0 and 1 extra byte for Note On command)
-            if(gigaSize / (segmentSize-4) > segmentIndex)
-            {
-                gigaSize += 3; 
-                segmentIndex++;
+            uint16_t address = segments.back()._address + segmentOffset;
+            segments.back()._commands.push_back({COMPACT_SEGMENT, uint8_t(address & 0x00FF), uint8_t((address & 0xFF00) >>8)});
+            segments.back()._size += SEGMENT_COMMAND_SIZE;
 
-                static uint16_t segment = startAddress;
-                segment += segmentOffset;
+            Segment next;
+            next._address = address;
+            segments.push_back(next);
+        }
 
-                // Commands
-                switch(format)
-                {
-                    case Format::vCPU: outputvCPUcommand(outfile, 0xD0, charCount); outputvCPUcommand(outfile, segment & 0x00FF, charCount); outputvCPUcommand(outfile, (segment & 0xFF00) >>8, charCount); break;
-                    case Format::GCL:  outputGCLcommand(outfile, 0xD0, charCount);  outputGCLcommand(outfile, segment & 0x00FF, charCount);  outputGCLcommand(outfile, (segment & 0xFF00) >>8, charCount);  break;
-                    case Format::CPP:  outputCPPcommand(outfile, 0xD0, charCount);  outputCPPcommand(outfile, segment & 0x00FF, charCount);  outputCPPcommand(outfile, (segment & 0xFF00) >>8, charCount);  break;
-                    case Format::PY:   outputPYcommand(outfile, 0xD0, charCount);   outputPYcommand(outfile, segment & 0x00FF, charCount);   outputPYcommand(outfile, (segment & 0xFF00) >>8, charCount);   break;                
-                }
-                // Old segment footer
+        Segment& current = segments.back();
+        if(pattern)
+        {
+            uint16_t address = uint16_t(addresses[patternStart]);
+            current._commands.push_back({COMPACT_PATTERN, uint8_t(address & 0x00FF), uint8_t((address & 0xFF00) >>8), uint8_t(patternBytes)});
+            current._size += PATTERN_COMMAND_SIZE;
+            numPatterns++;
+            patternSaving += patternBytes - PATTERN_COMMAND_SIZE;
+            i += patternLength;
+            continue;
+        }
+
+        addresses[i] = current._address + current._size;
+        segmentIndices[i] = int(segments.size()) - 1;
+        current._commands.push_back(tokens[i]._bytes);
+        current._size += size;
+        if(encoding == Compact) candidates[key].push_back(i);
+        i++;
+    }
+
+    // Last segment points back to start address, (can be user edited in output source file to point to a different MIDI stream)
+    segments.back()._commands.push_back({COMPACT_SEGMENT, uint8_t(startAddress & 0x00FF), uint8_t((startAddress & 0xFF00) >>8)});
+    segments.back()._size += SEGMENT_COMMAND_SIZE;
+}
+
+void outputScore(std::ofstream& outfile, const std::vector<Segment>& segments, Format format, Encoding encoding, const std::string& midiName, uint16_t segmentSize, int lineLength)
+{
+    // Lets C/C++ players pick the decoder at compile time, (and detect headers from before encodings existed)
+    if(format == Format::CPP) outfile << "#define " << midiName.c_str() << "Encoding " << int(encoding) << std::endl;
+
+    for(int i=0; i<int(segments.size()); i++)
+    {
+        int charCount = 0;
+        uint16_t segmentIndex = uint16_t(i);
+        std::string segmentName;
+
+        if(i) outfile << std::endl << std::endl;
+
+        // Header
+        switch(format)
+        {
+            case Format::vCPU: outputvCPUheader(outfile, midiName, segments[i]._address, segmentSize, segmentIndex, segmentName, charCount); break;
+            case Format::GCL:  outputGCLheader(outfile, segments[i]._address, charCount);                                                    break;
+            case Format::CPP:  outputCPPheader(outfile, midiName, segments[i]._address, segmentSize, segmentIndex, segmentName, charCount);   break;
+            case Format::PY:   outputPYheader(outfile, midiName, segmentSize, segmentIndex, segmentName, charCount);                         break;
+
+            default: break;
+        }
+
+        // Commands, (never split across lines)
+        int headerCount = charCount;
+        for(int j=0; j<int(segments[i]._commands.size()); j++)
+        {
+            const std::vector<uint8_t>& command = segments[i]._commands[j];
+            if(charCount > headerCount  &&  charCount + int(command.size())*5 > lineLength)
+            {
                 switch(format)
                 {
-                    case Format::GCL: outputGCLfooter(outfile, midiName); break;
-                    case Format::CPP: outputCPPfooter(outfile);           break;
-                    case Format::PY:  outputPYfooter(outfile);            break;
+                    case Format::vCPU: outputvCPUnewLine(outfile, segmentName, charCount); break;
+                    case Format::GCL:  outputGCLnewLine(outfile, charCount);               break;
+                    case Format::CPP:  outputCPPnewLine(outfile, charCount);               break;
+                    case Format::PY:   outputPYnewLine(outfile, charCount);                break;
+
+                    default: break;
                 }
-                outfile << std::endl << std::endl;
-                // New segment header
+            }
+
+            for(int k=0; k<int(command.size()); k++)
+            {
                 switch(format)
                 {
-                    case Format::vCPU: outputvCPUheader(outfile, midiName, segment, segmentSize, segmentIndex, segmentName, charCount); break;
-                    case Format::GCL:  outputGCLheader(outfile, segment, charCount);                                                    break;
-                    case Format::CPP:  outputCPPheader(outfile, midiName, segmentSize, segmentIndex, segmentName, charCount);           break;
-                    case Format::PY:   outputPYheader(outfile, midiName, segmentSize, segmentIndex, segmentName, charCount);            break;
+                    case Format::vCPU: outputvCPUcommand(outfile, command[k], charCount); break;
+                    case Format::GCL:  outputGCLcommand(outfile, command[k], charCount);  break;
+                    case Format::CPP:  outputCPPcommand(outfile, command[k], charCount);  break;
+                    case Format::PY:   outputPYcommand(outfile, command[k], charCount);   break;
+
+                    default: break;
                 }
             }
         }
 
-        // Last segment points back to address, (can be user edited in output source file to point to a different MIDI stream)                
-        if(midiSize == 0)
+        // Footer
+        switch(format)
         {
-            switch(format)
-            {
-                case Format::vCPU: outputvCPUcommand(outfile, 0xD0, charCount); outputvCPUcommand(outfile, startAddress & 0x00FF, charCount); outputvCPUcommand(outfile, (startAddress & 0xFF00) >>8, charCount); break;
-                case Format::GCL:  outputGCLcommand(outfile, 0xD0, charCount);  outputGCLcommand(outfile, startAddress & 0x00FF, charCount);  outputGCLcommand(outfile, (startAddress & 0xFF00) >>8, charCount);  break;
-                case Format::CPP:  outputCPPcommand(outfile, 0xD0, charCount);  outputCPPcommand(outfile, startAddress & 0x00FF, charCount);  outputCPPcommand(outfile, (startAddress & 0xFF00) >>8, charCount);  break;
-                case Format::PY:   outputPYcommand(outfile, 0xD0, charCount);   outputPYcommand(outfile, startAddress & 0x00FF, charCount);   outputPYcommand(outfile, (startAddress & 0xFF00) >>8, charCount);   break;                
-            }
-        }
+            case Format::GCL: outputGCLfooter(outfile); break;
+            case Format::CPP: outputCPPfooter(outfile); break;
+            case Format::PY:  outputPYfooter(outfile);  break;
 
-        // Newline
-        if(charCount >= lineLength - 10  &&  midiSize)
-        {
-            switch(format)
-            {
-                case Format::vCPU: outputvCPUnewLine(outfile, segmentName, charCount); break;
-                case Format::GCL:  outputGCLnewLine(outfile, charCount);               break;
-                case Format::CPP:  outputCPPnewLine(outfile, charCount);               break;
-                case Format::PY:   outputPYnewLine(outfile, charCount);                break;
-            }
+            default: break;
         }
     }
+}
+
+int tokensSize(const std::vector<Token>& tokens)
+{
+    int size = 0;
+    for(int i=0; i<int(tokens.size()); i++) size += int(tokens[i]._bytes.size());
+    return size;
+}
+
+int main(int argc, char* argv[])
+{
+    if(argc != 10  &&  argc != 11)
+    {
+        fprintf(stderr, "%s\n", GTMIDI_VERSION_STR);
+        fprintf(stderr, "Usage:   gtmidi <input filename> <output filename> <midiname> <int format 0, 1, 2 or 3> <uint16_t start_address in hex>\n         <uint16_t segment_offset in hex> <int segment_size> <int line_length> <float timing_adjust> <optional int encoding 0 or 1>\n");
+        fprintf(stderr, "Example: gtmidi game_over.bin game_over.i gameOver 0 0x8000 0 0 100 0.5\n");
+        fprintf(stderr, "Input:   miditones binary file produced with miditones, e.g. miditones -t4 -b -s1 -pi <filename>.bin\n");
+        fprintf(stderr, "         or a standard MIDI file, (.mid)\n");
+        fprintf(stderr, "Format:  0 = vCPU ASM, 1 = GCL, 2 = C/C++, 3 = Python\n");
+        fprintf(stderr, "Encoding: 0 = raw, (default), 1 = compact\n");
+        return 1;
+    }
+
+    std::string inFilename = std::string(argv[1]);
+    std::string outFilename = std::string(argv[2]);
+    std::string midiName = std::string(argv[3]);
+
+    Format format = (Format)strtol(argv[4], nullptr, 10);
+    if(format < Format::vCPU  ||  format >= Format::NumFormats)
+    {
+        fprintf(stderr, "Format must be 0, 1, 2 or 3\n");
+        return 1;
+    }
+
+    // Handles hex numbers
+    uint16_t startAddress, segmentOffset;
+    std::stringstream ss0, ss1;
+    ss0 << std::hex << argv[5];
+    ss0 >> startAddress;
+    ss1 << std::hex << argv[6];
+    ss1 >> segmentOffset;
+
+    uint16_t segmentSize = uint16_t(strtol(argv[7], nullptr, 10));
+    int lineLength = strtol(argv[8], nullptr, 10);
+    double timingAdjust = strtod(argv[9], nullptr);
+
+    Encoding encoding = (argc == 11) ? (Encoding)strtol(argv[10], nullptr, 10) : Encoding::Raw;
+    if(encoding < Encoding::Raw  ||  encoding >= Encoding::NumEncodings)
+    {
+        fprintf(stderr, "Encoding must be 0 or 1\n");
+        return 1;
+    }
+
+    // Smallest segment that can hold a pattern, (the largest command), and its link
+    if(segmentSize  &&  segmentOffset  &&  segmentSize < PATTERN_COMMAND_SIZE + SEGMENT_COMMAND_SIZE)
+    {
+        fprintf(stderr, "Segment size must be at least %d\n", PATTERN_COMMAND_SIZE + SEGMENT_COMMAND_SIZE);
+        return 1;
+    }
+
+    std::ifstream infile(inFilename, std::ios::binary | std::ios::in);
+    if(!infile.is_open())
+    {
+        fprintf(stderr, "Failed to open input file '%s'\n", inFilename.c_str());
+        return 1;
+    }
+
+    // Input is streamed, so there is no limit on its size
+    char id[4] = {0};
+    infile.read(id, sizeof(id));
+    bool smf = infile.gcount() == sizeof(id)  &&  std::string(id, sizeof(id)) == "MThd";
+    infile.clear();
+    infile.seekg(0);
+
+    size_t inputSize = 0;
+    std::vector<Event> events;
+    if(smf)
+    {
+        if(!parseSMF(infile, inFilename, events, inputSize)) return 1;
+    }
+    else
+    {
+        if(!parseMiditones(infile, inFilename, events, inputSize)) return 1;
+    }
 
-    // Footer
-    switch(format)
+    // Raw is always encoded for the size report
+    double totalTime16 = 0.0, totalTime8 = 0.0;
+    std::vector<Token> rawTokens, compactTokens;
+    encodeRaw(events, timingAdjust, rawTokens, totalTime16, totalTime8);
+    if(encoding == Encoding::Compact)
     {
-        case Format::GCL: outputGCLfooter(outfile, midiName); break;
-        case Format::CPP: outputCPPfooter(outfile);           break;
-        case Format::PY:  outputPYfooter(outfile);            break;
+        totalTime16 = 0.0, totalTime8 = 0.0;
+        encodeCompact(events, timingAdjust, compactTokens, totalTime16, totalTime8);
     }
 
+    int numPatterns, patternSaving;
+    std::vector<Segment> segments;
+    layoutScore((encoding == Encoding::Compact) ? compactTokens : rawTokens, encoding, startAddress, segmentOffset, segmentSize, segments, numPatterns, patternSaving);
+
+    std::ofstream outfile(outFilename, std::ios::binary | std::ios::out);
+    if(!outfile.is_open())
+    {
+        fprintf(stderr, "Failed to open output file '%s'\n", outFilename.c_str());
+        return 1;
+    }
+
+    outputScore(outfile, segments, format, encoding, midiName, segmentSize, lineLength);
+
+    int gigaSize = 0;
+    for(int i=0; i<int(segments.size()); i++) gigaSize += segments[i]._size;
+    int endAddress = segments.back()._address + segments.back()._size;
+
     fprintf(stderr, "Original size:%d  New size:%d  Original time:%.1lfms  New time:%.1lfms  Error:%.1lfms  Start Address:0x%04x  End Address:0x%04x\n",
-                    int(infile.gcount()), gigaSize, totalTime16, totalTime8, totalTime8 - totalTime16, startAddress, startAddress+gigaSize);
+                    int(inputSize), gigaSize, totalTime16, totalTime8, totalTime8 - totalTime16, startAddress, endAddress);
+    fprintf(stderr, "Input:%s  Events:%d  Segments:%d  Raw size:%d", smf ? "SMF" : "miditones", int(events.size()), int(segments.size()), tokensSize(rawTokens));
+    if(encoding == Encoding::Compact)
+    {
+        int compactSize = tokensSize(compactTokens);
+        fprintf(stderr, "  Compact size:%d  Patterns:%d  Pattern saving:%d  Ratio:%.1lf%%", compactSize - patternSaving, numPatterns, patternSaving,
+                        100.0 * double(compactSize - patternSaving) / double(std::max(tokensSize(rawTokens), 1)));
+    }
+    fprintf(stderr, "\n");
+
+    if(endAddress > 0x10000)
+    {
+        fprintf(stderr, "Warning: score overflows the 64K address space by %d bytes\n", endAddress - 0x10000);
+    }
+
     return 0;
 }
@@ -3,9 +3,11 @@
 #include <fstream>
 #include <sstream>
 
+#include "../../mapping.h"
+
 
 #define GT1TOROM_MAJOR_VERSION "0.2"
-#define GT1TOROM_MINOR_VERSION "0"
+#define GT1TOROM_MINOR_VERSION "1"
 #define GT1TOROM_VERSION_STR "gt1torom v" GT1TOROM_MAJOR_VERSION "." GT1TOROM_MINOR_VERSION
 
 #define GT1_MAX_SIZE (1<<16)
@@ -13,7 +15,7 @@
 #define TRAMPOLINE_START 0x00FB
 
 
-uint8_t _gt1[GT1_MAX_SIZE];
+const uint8_t* _gt1 = nullptr;
 
 
 bool writeRomDataWithTrampoline(const std::string& outputFilename0, const std::string& outputFilename1, std::ofstream& outfile0, std::ofstream& outfile1, uint16_t& startAddress, uint16_t size, bool _default)
@@ -94,22 +96,20 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    // Check for gt1 file
-    std::ifstream gt1file(inputFilename, std::ios::binary | std::ios::in);
-    if(!gt1file.is_open())
+    // Map and validate gt1 file, the ROM loader gets the raw bytes
+    Mapping::Gt1Map gt1Map;
+    if(!Mapping::mapGt1File(inputFilename, gt1Map))
     {
-        fprintf(stderr, "gt1torom : couldn't open %s GT1 file.\n", inputFilename.c_str());
+        fprintf(stderr, "gt1torom : failed to load %s GT1 file.\n", inputFilename.c_str());
         return 1;
     }
-
-    // Load gt1 file
-    gt1file.read((char *)_gt1, GT1_MAX_SIZE);
-    if(gt1file.bad())
+    if(gt1Map._file._size > GT1_MAX_SIZE)
     {
-        fprintf(stderr, "gt1torom : failed to read %s GT1 file.\n", inputFilename.c_str());
+        fprintf(stderr, "gt1torom : %s GT1 file is larger than %d bytes.\n", inputFilename.c_str(), GT1_MAX_SIZE);
         return 1;
     }
-    int gt1Size = int(gt1file.gcount());
+    _gt1 = gt1Map._file._data;
+    int gt1Size = int(gt1Map._file._size);
 
     std::string outputFilename0 = std::string(argv[2]) + "_ti";
     std::ofstream outfile0(outputFilename0, std::ios::binary | std::ios::out);
@@ -136,6 +136,8 @@ int main(int argc, char* argv[])
     if(!writeRomDataWithTrampoline(outputFilename0, outputFilename1, outfile0, outfile1, startAddress, gt1Size, false)) return 1;
     if(!writeRomDataWithTrampoline(outputFilename0, outputFilename1, outfile0, outfile1, startAddress, TRAMPOLINE_START + 1 - (startAddress & 0x00FF), true)) return 1;
 
+    Mapping::unmapGt1File(gt1Map);
+
     fprintf(stderr, "%s success : next available address : 0x%04X\n", GT1TOROM_VERSION_STR, startAddress - 1);
 
     return 0;
@@ -1,6 +1,12 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <sstream>
+#include <algorithm>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
 
 #include "../../loader.h"
 #include "../../assembler.h"
@@ -8,44 +14,64 @@
 
 
 #define GTASM_MAJOR_VERSION "0.1"
-#define GTASM_MINOR_VERSION "3"
+#define GTASM_MINOR_VERSION "9"
 #define GTASM_VERSION_STR "gtasm v" GTASM_MAJOR_VERSION "." GTASM_MINOR_VERSION
 
 
-int main(int argc, char* argv[])
+struct Options
 {
-    if(argc != 3)
-    {
-        fprintf(stderr, "%s\n", GTASM_VERSION_STR);
-        fprintf(stderr, "Usage:   gtasm <input filename> <uint16_t start address in hex>\n");
-        return 1;
-    }
+    bool _optimise = false;
+    bool _listing = false;
+    bool _compress = false;
+    Assembler::RomVersion _romVersion = Assembler::ROMv3;
+};
 
-    std::string filename = std::string(argv[1]);
-    if(filename.find(".vasm") == filename.npos  &&  filename.find(".gasm") == filename.npos   &&  filename.find(".asm") == filename.npos  &&  filename.find(".s") == filename.npos)
-    {
-        fprintf(stderr, "Wrong file extension in %s : must be one of : '.vasm' or '.gasm' or '.asm' or '.s'\n", filename.c_str());
-        return 1;
-    }
+// Serialises the reports of files assembled on different threads
+std::mutex _printMutex;
 
-    // Handles hex numbers
-    uint16_t address = DEFAULT_START_ADDRESS;
-    std::stringstream ss;
-    ss << std::hex << argv[2];
-    ss >> address;
-    if(address < DEFAULT_START_ADDRESS) address = DEFAULT_START_ADDRESS;
 
-    Assembler::initialise();
-    Expression::initialise();
+bool isAsmFile(const std::string& filename)
+{
+    return filename.find(".vasm") != filename.npos  ||  filename.find(".gasm") != filename.npos  ||  filename.find(".asm") != filename.npos  ||  filename.find(".s") != filename.npos;
+}
+
+void usage(void)
+{
+    fprintf(stderr, "%s\n", GTASM_VERSION_STR);
+    fprintf(stderr, "Usage:   gtasm <input filenames> <uint16_t start address in hex> <optional benchmark count> <optional -O> <optional -l> <optional -z> <optional -ROMv1/2/3> <optional -j<threads>>\n");
+    fprintf(stderr, "         gtasm <input filename .gcl> <optional interface.json>\n");
+}
+
+void setupAssembler(const std::string& filename, const Options& options)
+{
+    Assembler::setOptimise(options._optimise);
 
     size_t last_dir_sep = filename.find_last_of("/\\");
-    if (last_dir_sep != std::string::npos)
-        Assembler::setIncludePath(filename.substr(0, last_dir_sep+1));
+    Assembler::setIncludePath((last_dir_sep != std::string::npos) ? filename.substr(0, last_dir_sep+1) : "");
+}
 
-    if(!Assembler::assemble(filename, address)) return 1;
+// Assembles into the calling thread's assembler context, so any number of threads can assemble at once
+bool buildGt1File(const std::string& filename, uint16_t address, const Options& options, Loader::Gt1File& gt1File, std::string& gt1FileName)
+{
+    setupAssembler(filename, options);
+    if(!Assembler::assemble(filename, address)) return false;
+
+    if(options._optimise)
+    {
+        const Assembler::AssembleTimes& times = Assembler::getAssembleTimes();
+        Expression::print("gtasm : optimiser : '%s' : %d rewrites : %d bytes saved\n", filename.c_str(), times._optimisations, times._optimisedBytes);
+    }
+
+    // Listing and symbol map
+    if(options._listing)
+    {
+        std::string name = filename.substr(0, filename.find_last_of("."));
+        if(!Assembler::saveListing(name + ".lst", options._romVersion)  ||  !Assembler::saveSymbolMap(name + ".map")) return false;
+
+        Expression::print("gtasm : listing : '%s.lst' : symbol map : '%s.map'\n", name.c_str(), name.c_str());
+    }
 
     // Create gt1 format
-    Loader::Gt1File gt1File;
     gt1File._loStart = address & 0x00FF;
     gt1File._hiStart = (address & 0xFF00) >>8;
     Loader::Gt1Segment gt1Segment;
@@ -85,11 +111,176 @@ int main(int argc, char* argv[])
         gt1File._segments.push_back(gt1Segment);
     }
 
+    // Compressed gt1, only used when it fits and is smaller than the optimised original
+    if(options._compress  &&  !hasRomCode)
+    {
+        Loader::Gt1File compressed;
+        bool fits = Loader::compressGt1File(gt1File, compressed);
+
+        Loader::optimiseGt1File(gt1File);
+        int size = Loader::getGt1FileSize(gt1File);
+        int compressedSize = (fits) ? Loader::getGt1FileSize(compressed) : size;
+        if(compressedSize < size) gt1File = compressed;
+
+        Expression::print("gtasm : compressed : '%s' : %d bytes -> %d bytes%s\n", filename.c_str(), size, compressedSize, (compressedSize < size) ? "" : " : keeping original");
+    }
+
     // Don't save gt1 file for any asm files that contain native rom code
+    return hasRomCode  ||  saveGt1File(filename, gt1File, gt1FileName);
+}
+
+// Everything a file prints while it is assembled is collected and printed in one piece, so reports of files assembled on
+// different threads aren't interleaved
+bool assembleFile(const std::string& filename, uint16_t address, const Options& options)
+{
+    std::string output;
     std::string gt1FileName;
-    if(!hasRomCode  &&  !saveGt1File(filename, gt1File, gt1FileName)) return 1;
+    Loader::Gt1File gt1File;
+    Expression::setOutput(&output);
+    bool success = buildGt1File(filename, address, options, gt1File, gt1FileName);
+    Expression::setOutput(nullptr);
+
+    std::lock_guard<std::mutex> lock(_printMutex);
+    fputs(output.c_str(), stderr);
+    if(success) Loader::printGt1Stats(gt1FileName, gt1File);
+
+    return success;
+}
+
+
+int main(int argc, char* argv[])
+{
+    // Optional peephole optimiser, listing, compression, ROM version of its cycles and batch threads, can be anywhere after the input filename
+    int jobs = 0;
+    Options options;
+    for(int i=2; i<argc;)
+    {
+        std::string option = std::string(argv[i]);
+        if(option == "-O") options._optimise = true;
+        else if(option == "-l") options._listing = true;
+        else if(option == "-z") options._compress = true;
+        else if(option.size() > 2  &&  option.substr(0, 2) == "-j") jobs = std::max(1, atoi(option.c_str() + 2));
+        else if(option.size() < 2  ||  option[0] != '-'  ||  !Assembler::getRomVersion(option.substr(1), options._romVersion))
+        {
+            i++;
+            continue;
+        }
 
-    Loader::printGt1Stats(gt1FileName, gt1File);
+        for(int j=i; j<argc-1; j++) argv[j] = argv[j + 1];
+        argc--;
+    }
+
+    if(argc < 2)
+    {
+        usage();
+        return 1;
+    }
+
+    std::string filename = std::string(argv[1]);
+
+    // GCL is compiled in process, the start address comes from the interface bindings
+    if(filename.find(".gcl") != filename.npos)
+    {
+        if(argc > 3)
+        {
+            usage();
+            return 1;
+        }
+
+        std::string gt1FileName = filename.substr(0, filename.find_last_of(".")) + ".gt1";
+        std::string interfaceName = (argc == 3) ? std::string(argv[2]) : "";
+
+        std::string error;
+        Mapping::Gt1Map gt1Map;
+        if(!Loader::compileGclFile(filename, gt1FileName, interfaceName, error)) return 1;
+        if(!Mapping::mapGt1File(gt1FileName, gt1Map)) return 1;
+
+        Loader::printGt1Stats(gt1FileName, gt1Map);
+        Mapping::unmapGt1File(gt1Map);
+
+        return 0;
+    }
+
+    if(!isAsmFile(filename))
+    {
+        fprintf(stderr, "Wrong file extension in %s : must be one of : '.vasm' or '.gasm' or '.asm' or '.s' or '.gcl'\n", filename.c_str());
+        return 1;
+    }
+
+    // Input filenames, then the start address and an optional benchmark count
+    std::vector<std::string> filenames;
+    int arg = 1;
+    while(arg < argc  &&  isAsmFile(argv[arg])) filenames.push_back(std::string(argv[arg++]));
+    if(argc - arg < 1  ||  argc - arg > 2  ||  (filenames.size() > 1  &&  argc - arg == 2))
+    {
+        usage();
+        return 1;
+    }
+
+    // Handles hex numbers
+    uint16_t address = DEFAULT_START_ADDRESS;
+    std::stringstream ss;
+    ss << std::hex << argv[arg];
+    ss >> address;
+    if(address < DEFAULT_START_ADDRESS) address = DEFAULT_START_ADDRESS;
+
+    Assembler::initialise();
+    Expression::initialise();
+
+    // Batch, files are handed out to a pool of threads that each assemble into their own context, their .gt1 files are written next to their sources
+    if(filenames.size() > 1)
+    {
+        int numThreads = (jobs) ? jobs : std::max(1, int(std::thread::hardware_concurrency()));
+        numThreads = std::min(numThreads, int(filenames.size()));
+
+        std::atomic<int> next(0);
+        std::atomic<int> failed(0);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for(int i=0; i<numThreads; i++)
+        {
+            threads.push_back(std::thread([&]()
+            {
+                for(int j=next++; j<int(filenames.size()); j=next++)
+                {
+                    if(!assembleFile(filenames[j], address, options)) failed++;
+                }
+            }));
+        }
+        for(int i=0; i<numThreads; i++) threads[i].join();
+
+        double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        fprintf(stderr, "gtasm : batch : %d files : %d failed : %d threads : %.3f ms\n", int(filenames.size()), int(failed), numThreads, elapsed);
+
+        return (failed) ? 1 : 0;
+    }
+
+    // Benchmark reassembles the same source and reports the average time spent in each phase
+    int benchmarkCount = (argc - arg == 2) ? std::max(1, atoi(argv[arg + 1])) : 0;
+    if(benchmarkCount)
+    {
+        setupAssembler(filename, options);
+
+        Assembler::AssembleTimes total;
+        for(int i=0; i<benchmarkCount; i++)
+        {
+            if(!Assembler::assemble(filename, address)) return 1;
+
+            const Assembler::AssembleTimes& times = Assembler::getAssembleTimes();
+            total._preProcess += times._preProcess;
+            total._parse += times._parse;
+            total._mnemonicPass += times._mnemonicPass;
+            total._codePass += times._codePass;
+            total._expandMacros += times._expandMacros;
+            total._macroExpansions = times._macroExpansions;
+        }
+
+        double count = double(benchmarkCount);
+        fprintf(stderr, "gtasm : benchmark : '%s' : %d runs : pre-process %.3f ms : parse %.3f ms : mnemonic pass %.3f ms : code pass %.3f ms\n", filename.c_str(), benchmarkCount,
+                                                                                                                                                    total._preProcess / count, total._parse / count,
+                                                                                                                                                    total._mnemonicPass / count, total._codePass / count);
+        fprintf(stderr, "gtasm : benchmark : '%s' : %d macro expansions in %.3f ms of pre-process\n", filename.c_str(), total._macroExpansions, total._expandMacros / count);
+    }
 
-    return 0;
+    return (assembleFile(filename, address, options)) ? 0 : 1;
 }
@@ -0,0 +1,52 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "../../gbasic/gbasic.h"
+
+
+#define GTBASIC_MAJOR_VERSION "0.1"
+#define GTBASIC_MINOR_VERSION "0"
+#define GTBASIC_VERSION_STR "gtbasic v" GTBASIC_MAJOR_VERSION "." GTBASIC_MINOR_VERSION
+
+
+void usage(void)
+{
+    fprintf(stderr, "%s\n", GTBASIC_VERSION_STR);
+    fprintf(stderr, "Usage:   gtbasic <input filename .gbas> <optional output filename .vasm>\n");
+}
+
+
+int main(int argc, char* argv[])
+{
+    if(argc != 2  &&  argc != 3)
+    {
+        usage();
+        return 1;
+    }
+
+    std::string inputFilename = argv[1];
+    if(inputFilename.find(".gbas") == inputFilename.npos  &&  inputFilename.find(".bas") == inputFilename.npos)
+    {
+        fprintf(stderr, "Wrong file extension in %s : must be one of : '.gbas' or '.bas'\n", inputFilename.c_str());
+        return 1;
+    }
+
+    std::string outputFilename;
+    if(argc == 3)
+    {
+        outputFilename = argv[2];
+    }
+    else
+    {
+        size_t i = inputFilename.rfind('.');
+        outputFilename = inputFilename.substr(0, i) + ".vasm";
+    }
+
+    GBasic::initialise();
+    if(!GBasic::compile(inputFilename, outputFilename)) return 1;
+
+    fprintf(stderr, "gtbasic : '%s' : compiled to '%s'\n", inputFilename.c_str(), outputFilename.c_str());
+
+    return 0;
+}
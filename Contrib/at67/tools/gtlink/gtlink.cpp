@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "../../loader.h"
+#include "../../assembler.h"
+#include "../../expression.h"
+#include "../../linker.h"
+
+
+#define GTLINK_MAJOR_VERSION "0.1"
+#define GTLINK_MINOR_VERSION "2"
+#define GTLINK_VERSION_STR "gtlink v" GTLINK_MAJOR_VERSION "." GTLINK_MINOR_VERSION
+
+
+void usage(void)
+{
+    fprintf(stderr, "%s\n", GTLINK_VERSION_STR);
+    fprintf(stderr, "Usage:   gtlink -c <input filenames .vasm> <optional -O>\n");
+    fprintf(stderr, "         gtlink <output filename .gt1> <input filenames .vasm or .gto> <optional -64k> <optional -pack> <optional -O>\n");
+}
+
+bool isSource(const std::string& filename)
+{
+    return filename.find(".vasm") != filename.npos  ||  filename.find(".gasm") != filename.npos  ||  filename.find(".asm") != filename.npos  ||  filename.find(".s") != filename.npos;
+}
+
+std::string getObjectFilename(const std::string& filename)
+{
+    size_t i = filename.rfind('.');
+    return (i != std::string::npos) ? filename.substr(0, i) + ".gto" : filename + ".gto";
+}
+
+bool getObject(const std::string& filename, Linker::Object& object)
+{
+    if(filename.find(".gto") != filename.npos) return Linker::loadObject(filename, object);
+
+    if(!isSource(filename))
+    {
+        fprintf(stderr, "Wrong file extension in %s : must be one of : '.vasm' or '.gasm' or '.asm' or '.s' or '.gto'\n", filename.c_str());
+        return false;
+    }
+
+    size_t last_dir_sep = filename.find_last_of("/\\");
+    Assembler::setIncludePath((last_dir_sep != std::string::npos) ? filename.substr(0, last_dir_sep+1) : "");
+
+    return Assembler::assembleObject(filename, object);
+}
+
+
+int main(int argc, char* argv[])
+{
+    if(argc < 3)
+    {
+        usage();
+        return 1;
+    }
+
+    Assembler::initialise();
+    Expression::initialise();
+
+    // Options apply to every input, wherever they are
+    for(int i=2; i<argc; i++)
+    {
+        if(std::string(argv[i]) == "-O") Assembler::setOptimise(true);
+    }
+
+    // Compile only, each source is assembled into an object next to it
+    if(std::string(argv[1]) == "-c")
+    {
+        for(int i=2; i<argc; i++)
+        {
+            if(std::string(argv[i]) == "-O") continue;
+
+            Linker::Object object;
+            if(!getObject(argv[i], object)) return 1;
+            if(!Linker::saveObject(getObjectFilename(argv[i]), object)) return 1;
+
+            fprintf(stderr, "gtlink : '%s' : %d sections : %d exports : %d imports : %d relocations\n", getObjectFilename(argv[i]).c_str(), int(object._sections.size()), int(object._exports.size()),
+                                                                                                       int(object._imports.size()), int(object._relocations.size()));
+        }
+
+        return 0;
+    }
+
+    std::string outputFilename = std::string(argv[1]);
+    if(outputFilename.find(".gt1") == outputFilename.npos)
+    {
+        fprintf(stderr, "Wrong file extension in %s : must be '.gt1'\n", outputFilename.c_str());
+        return 1;
+    }
+
+    bool ram64k = false, pack = false;
+    std::vector<Linker::Object> objects;
+    for(int i=2; i<argc; i++)
+    {
+        if(std::string(argv[i]) == "-64k")
+        {
+            ram64k = true;
+            continue;
+        }
+        if(std::string(argv[i]) == "-pack")
+        {
+            pack = true;
+            continue;
+        }
+        if(std::string(argv[i]) == "-O") continue;
+
+        Linker::Object object;
+        if(!getObject(argv[i], object)) return 1;
+        objects.push_back(object);
+    }
+
+    Loader::Gt1File gt1File;
+    std::vector<Linker::Placement> placements;
+    if(!Linker::link(objects, ram64k, pack, gt1File, placements)) return 1;
+
+    std::string gt1FileName;
+    if(!Loader::saveGt1File(outputFilename, gt1File, gt1FileName)) return 1;
+
+    Linker::printPlacements(objects, placements);
+    if(pack) Linker::printPacking(objects, placements, ram64k);
+    Loader::printGt1Stats(gt1FileName, gt1File);
+
+    return 0;
+}
@@ -0,0 +1,632 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+
+#include "../../cpu.h"
+#include "../../loader.h"
+#include "../../mapping.h"
+
+
+#define GTPACKROM_MAJOR_VERSION "0.2"
+#define GTPACKROM_MINOR_VERSION "0"
+#define GTPACKROM_VERSION_STR "gtpackrom v" GTPACKROM_MAJOR_VERSION "." GTPACKROM_MINOR_VERSION
+
+#define TRAMPOLINE_START 0x00FB // also the number of data bytes per ROM page
+#define TRAMPOLINE_SIZE  5
+
+#define VERIFY_BOOT_CYCLES 30000000  // ROMv1 has shown its menu by then
+#define VERIFY_MAX_CYCLES  200000000
+#define VERIFY_CLOCK_KHZ   6250.0
+#define ROM_VCPU_ENTER     0x02FF    // where ROMv1's video loop hands over to vCPU
+#define SYS_EXEC_88        0x00AD
+#define GT1_ROM_ENTRY      0x0200    // the menu sets vLR here before its SYS_Exec_88 call
+
+
+// A GT1 stored in ROM as one "ld $xx" per byte, the ROM loader reads each page with LUP and needs a trampoline at the end of it
+struct Gt1Entry
+{
+    std::string _filename;
+    std::string _menuName;
+    Cpu::InternalGt1Id _gt1Id;
+    std::vector<uint8_t> _stream;
+    bool _isCompressed = false;
+    int _gt1Size = 0;
+    int _size = 0;
+    uint32_t _loadCycles = 0;
+    uint32_t _rawLoadCycles = 0;
+    int _bin = -1;
+    uint16_t _address = 0x0000;
+};
+
+// Writable ROM, end is exclusive
+struct Region
+{
+    uint32_t _start;
+    uint32_t _end;
+};
+
+// A run of data bytes that a ROM stream can read without leaving writable ROM or a page without a trampoline
+struct Bin
+{
+    uint16_t _start;
+    int _capacity = 0;
+    int _used = 0;
+};
+
+
+uint8_t* _ROM = nullptr;
+int _romSize = 0;
+
+std::vector<Gt1Entry> _entries;
+std::vector<Region> _regions;
+std::vector<Bin> _bins;
+
+std::vector<int> _order;
+std::vector<int> _assignment;
+std::vector<int> _bestAssignment;
+int _bestPages = 0;
+int _bestBins = 0;
+
+static uint8_t _trampolineOpcode[TRAMPOLINE_SIZE]  = {0xFE, 0xFC, 0x14, 0xE0, 0xC2};
+static uint8_t _trampolineOperand[TRAMPOLINE_SIZE] = {0x00, 0xFD, 0x04, 0x65, 0x18};
+
+
+uint32_t getDataAddress(uint16_t start, int index)
+{
+    int offset = (start & 0x00FF) + index;
+    return (start & 0xFF00) + (offset / TRAMPOLINE_START)*0x0100 + offset % TRAMPOLINE_START;
+}
+
+int getPages(uint16_t start, int size)
+{
+    return (size) ? ((start & 0x00FF) + size - 1) / TRAMPOLINE_START + 1 : 0;
+}
+
+bool isWritable(uint32_t address)
+{
+    for(int i=0; i<int(_regions.size()); i++)
+    {
+        if(address >= _regions[i]._start  &&  address < _regions[i]._end) return true;
+    }
+
+    return false;
+}
+
+bool hasTrampoline(uint16_t page)
+{
+    bool writable = true, present = true;
+    for(int i=0; i<TRAMPOLINE_SIZE; i++)
+    {
+        uint16_t address = (page <<8) + TRAMPOLINE_START + i;
+        if(!isWritable(address)) writable = false;
+        if(_ROM[address*2 + ROM_INST] != _trampolineOpcode[i]  ||  _ROM[address*2 + ROM_DATA] != _trampolineOperand[i]) present = false;
+    }
+
+    return writable  ||  present;
+}
+
+bool parseRegions(const std::string& text)
+{
+    if(text == "none") return true;
+
+    std::stringstream ss(text);
+    std::string token;
+    while(std::getline(ss, token, ','))
+    {
+        size_t dash = token.find('-');
+        if(dash == std::string::npos)
+        {
+            fprintf(stderr, "gtpackrom : bad region '%s', must be <start>-<end> in hex\n", token.c_str());
+            return false;
+        }
+
+        uint16_t start = 0x0000, end = 0x0000;
+        std::stringstream ss0, ss1;
+        ss0 << std::hex << token.substr(0, dash);
+        ss0 >> start;
+        ss1 << std::hex << token.substr(dash + 1);
+        ss1 >> end;
+        if(ss0.fail()  ||  ss1.fail()  ||  end < start)
+        {
+            fprintf(stderr, "gtpackrom : bad region '%s', must be <start>-<end> in hex\n", token.c_str());
+            return false;
+        }
+
+        _regions.push_back({start, uint32_t(end) + 1});
+    }
+
+    return true;
+}
+
+void mergeRegions(void)
+{
+    std::sort(_regions.begin(), _regions.end(), [](const Region& a, const Region& b) {return a._start < b._start;});
+
+    std::vector<Region> regions;
+    for(int i=0; i<int(_regions.size()); i++)
+    {
+        if(regions.size()  &&  _regions[i]._start <= regions.back()._end)
+        {
+            regions.back()._end = std::max(regions.back()._end, _regions[i]._end);
+            continue;
+        }
+        regions.push_back(_regions[i]);
+    }
+
+    _regions = regions;
+}
+
+// ROM stream format is [<addrH> <addrL> <n&255> n*<byte>]* 0, returns the exclusive end of the stream or 0 if it isn't a valid stream
+uint32_t getStreamEnd(uint16_t start)
+{
+    uint32_t address = start;
+    int index = 0;
+    auto readByte = [&](uint8_t& data)
+    {
+        address = getDataAddress(start, index++);
+        if(address >= ROM_SIZE  ||  _ROM[address*2 + ROM_INST] != 0x00) return false;
+        data = _ROM[address*2 + ROM_DATA];
+        return true;
+    };
+
+    for(;;)
+    {
+        uint8_t hi, lo, n;
+        if(!readByte(hi)) return 0;
+        if(hi == 0x00) return address + 1;
+        if(!readByte(lo)  ||  !readByte(n)) return 0;
+        for(int i=0; i<((n) ? n : 256); i++)
+        {
+            uint8_t data;
+            if(!readByte(data)) return 0;
+        }
+    }
+}
+
+// Streams replaced in the menu are dead, so their ROM is reused
+void reclaimInternalGt1s(void)
+{
+    for(int i=0; i<int(_entries.size()); i++)
+    {
+        uint16_t patch = Cpu::getInternalGt1(_entries[i]._gt1Id)._patch;
+        uint16_t start = _ROM[patch*2 + ROM_DATA] | (_ROM[(patch + 1)*2 + ROM_DATA] <<8);
+        uint32_t end = getStreamEnd(start);
+        if(end == 0)
+        {
+            fprintf(stderr, "gtpackrom : menu %d does not point to a valid ROM stream at 0x%04X, it won't be reclaimed\n", _entries[i]._gt1Id, start);
+            continue;
+        }
+
+        fprintf(stderr, "gtpackrom : reclaiming menu %d stream at 0x%04X-0x%04X\n", _entries[i]._gt1Id, start, end - 1);
+        _regions.push_back({start, end});
+    }
+}
+
+void buildBins(void)
+{
+    uint32_t next = 0;
+    bool open = false;
+    for(int i=0; i<int(_regions.size()); i++)
+    {
+        for(uint32_t address=_regions[i]._start; address<_regions[i]._end; address++)
+        {
+            if((address & 0x00FF) >= TRAMPOLINE_START) continue;
+
+            if(!hasTrampoline(uint16_t(address >>8)))
+            {
+                open = false;
+                continue;
+            }
+
+            if(!open  ||  address != next)
+            {
+                Bin bin;
+                bin._start = uint16_t(address);
+                _bins.push_back(bin);
+                open = true;
+            }
+
+            _bins.back()._capacity++;
+            next = ((address & 0x00FF) == TRAMPOLINE_START - 1) ? (address & 0xFF00) + 0x0100 : address + 1;
+        }
+    }
+}
+
+// Exhaustive search with at most one GT1 per menu entry, minimises the pages that need a trampoline, then the number of bins used
+void searchLayout(int index, int pages)
+{
+    if(pages > _bestPages) return;
+
+    if(index == int(_order.size()))
+    {
+        int bins = 0;
+        for(int i=0; i<int(_bins.size()); i++) bins += (_bins[i]._used) ? 1 : 0;
+        if(pages < _bestPages  ||  bins < _bestBins)
+        {
+            _bestPages = pages;
+            _bestBins = bins;
+            _bestAssignment = _assignment;
+        }
+        return;
+    }
+
+    int size = _entries[_order[index]]._size;
+    for(int i=0; i<int(_bins.size()); i++)
+    {
+        Bin& bin = _bins[i];
+        if(bin._used + size > bin._capacity) continue;
+
+        int delta = getPages(bin._start, bin._used + size) - getPages(bin._start, bin._used);
+        bin._used += size;
+        _assignment[_order[index]] = i;
+        searchLayout(index + 1, pages + delta);
+        bin._used -= size;
+    }
+}
+
+void writeStream(const Gt1Entry& entry)
+{
+    const uint8_t* data = &entry._stream[0];
+    for(int i=0; i<entry._size; i++)
+    {
+        uint16_t address = uint16_t(getDataAddress(entry._address, i));
+        _ROM[address*2 + ROM_INST] = 0x00;
+        _ROM[address*2 + ROM_DATA] = data[i];
+
+        if(i == 0  ||  (address & 0x00FF) == 0x00)
+        {
+            for(int j=0; j<TRAMPOLINE_SIZE; j++)
+            {
+                uint16_t trampoline = (address & 0xFF00) + TRAMPOLINE_START + j;
+                _ROM[trampoline*2 + ROM_INST] = _trampolineOpcode[j];
+                _ROM[trampoline*2 + ROM_DATA] = _trampolineOperand[j];
+            }
+        }
+    }
+}
+
+// Load is in millions of vCPU cycles, (see Loader::getGt1RomLoadCycles()), the raw load is for the uncompressed GT1
+void printReport(void)
+{
+    int gt1Bytes = 0, streamBytes = 0, pages = 0, slack = 0, capacity = 0;
+
+    fprintf(stderr, "\nMenu  Name        Size   Stream  Start   End     Pages  Raw Load  Load   File\n");
+    for(int i=0; i<int(_entries.size()); i++)
+    {
+        const Gt1Entry& entry = _entries[i];
+        uint16_t end = uint16_t(getDataAddress(entry._address, entry._size - 1));
+        fprintf(stderr, "%-4d  %-10s  %-5d  %-6d  0x%04X  0x%04X  %-5d  %-8.2f  %-5.2f  %s%s\n", entry._gt1Id, entry._menuName.c_str(), entry._gt1Size, entry._size,
+                        entry._address, end, getPages(entry._address, entry._size), entry._rawLoadCycles/1.0e6, entry._loadCycles/1.0e6, entry._filename.c_str(),
+                        (entry._isCompressed) ? " : compressed" : "");
+        gt1Bytes += entry._gt1Size;
+        streamBytes += entry._size;
+    }
+
+    fprintf(stderr, "\nBin  Start   End     Capacity  Used   Free   Pages\n");
+    for(int i=0; i<int(_bins.size()); i++)
+    {
+        const Bin& bin = _bins[i];
+        int binPages = getPages(bin._start, bin._used);
+        uint16_t end = uint16_t(getDataAddress(bin._start, bin._capacity - 1));
+        fprintf(stderr, "%-3d  0x%04X  0x%04X  %-8d  %-5d  %-5d  %d\n", i, bin._start, end, bin._capacity, bin._used, bin._capacity - bin._used, binPages);
+
+        pages += binPages;
+        capacity += bin._capacity;
+        if(binPages) slack += std::min(bin._capacity, binPages*TRAMPOLINE_START - (bin._start & 0x00FF)) - bin._used;
+    }
+
+    int romBytes = streamBytes + pages*TRAMPOLINE_SIZE;
+    fprintf(stderr, "\nGT1 bytes:%d  Stream bytes:%d  ROM bytes:%d  Density:%.2f GT1 bytes per ROM address  Trampoline bytes:%d (%.1f%%)\n",
+                    gt1Bytes, streamBytes, romBytes, double(gt1Bytes)/romBytes, pages*TRAMPOLINE_SIZE, 100.0*pages*TRAMPOLINE_SIZE/romBytes);
+    fprintf(stderr, "Slack in used pages:%d  Free bytes:%d  Utilisation:%.1f%%\n\n", slack, capacity - streamBytes, 100.0*streamBytes/capacity);
+}
+
+// Boots the output ROM on Cpu, then loads every entry the way the menu does, from its SYS_Exec_88 call to the .gt1's start address,
+// and compares RAM against the .gt1, skipping the system variables and the stack that the loader itself uses
+bool verifyStreams(void)
+{
+    Cpu::State boot = {0x0000, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+    for(uint32_t cycles=0; cycles<VERIFY_BOOT_CYCLES  ||  boot._PC != ROM_VCPU_ENTER; cycles++) boot = Cpu::cycle(boot);
+
+    std::vector<uint8_t> bootRAM(RAM_SIZE);
+    for(int i=0; i<RAM_SIZE; i++) bootRAM[i] = Cpu::getRAM(uint16_t(i));
+
+    bool success = true;
+    fprintf(stderr, "Menu  Name        Cycles     Load Time (ms)  Bytes  Mismatches\n");
+    for(int i=0; i<int(_entries.size()); i++)
+    {
+        const Gt1Entry& entry = _entries[i];
+        Loader::Gt1File gt1File;
+        if(!Loader::loadGt1File(entry._filename, gt1File))
+        {
+            fprintf(stderr, "gtpackrom : failed to load %s GT1 file.\n", entry._filename.c_str());
+            return false;
+        }
+
+        std::vector<int> expected(RAM_SIZE, -1);
+        for(int j=0; j<int(gt1File._segments.size()); j++)
+        {
+            const Loader::Gt1Segment& segment = gt1File._segments[j];
+            uint16_t address = (segment._hiAddress <<8) | segment._loAddress;
+            for(int k=0; k<int(segment._dataBytes.size()); k++) expected[(address + k) & (RAM_SIZE-1)] = segment._dataBytes[k];
+        }
+        uint16_t start = (gt1File._hiStart <<8) | gt1File._loStart;
+
+        // The SYS call is placed where the .gt1 doesn't load, so it can't be confused with the .gt1's own code
+        uint16_t stub = 0x0000;
+        for(uint32_t address=RAM_SIZE - 0x10; address>=0x0200  &&  stub==0x0000; address-=0x10)
+        {
+            if(expected[address] < 0  &&  expected[address + 1] < 0) stub = uint16_t(address);
+        }
+        if(stub == 0x0000)
+        {
+            fprintf(stderr, "gtpackrom : no free RAM to verify %s from\n", entry._filename.c_str());
+            return false;
+        }
+
+        for(int j=0; j<RAM_SIZE; j++) Cpu::setRAM(uint16_t(j), bootRAM[j]);
+        Cpu::setRAM(stub, 0xB4);
+        Cpu::setRAM(stub + 1, 0xE2); // SYS 88
+        Cpu::setRAM16(0x0016, stub - 2);
+        Cpu::setRAM16(0x001A, GT1_ROM_ENTRY);
+        Cpu::setRAM16(0x0022, SYS_EXEC_88);
+        Cpu::setRAM16(0x0024, entry._address);
+
+        // The compressed loader runs its decompressor from GT1_ROM_ENTRY, so vPC is only at the start once the .gt1's code is there
+        Cpu::State S = boot;
+        uint32_t cycles = 0;
+        for(; cycles<VERIFY_MAX_CYCLES; cycles++)
+        {
+            S = Cpu::cycle(S);
+            uint16_t vPC = Cpu::getRAM16(0x0016);
+            if(vPC != uint16_t(start - 2)  &&  vPC != start) continue;
+
+            bool loaded = true;
+            for(int j=0; j<4; j++)
+            {
+                int data = expected[(start + j) & (RAM_SIZE-1)];
+                if(data >= 0  &&  Cpu::getRAM(start + j) != data) loaded = false;
+            }
+            if(loaded) break;
+        }
+
+        int bytes = 0, mismatches = 0;
+        for(int j=0; j<RAM_SIZE; j++)
+        {
+            if(expected[j] < 0  ||  j < 0x0030  ||  (j >= 0x00C0  &&  j < 0x0100)) continue;
+
+            bytes++;
+            if(Cpu::getRAM(uint16_t(j)) != expected[j]) mismatches++;
+        }
+
+        fprintf(stderr, "%-4d  %-10s  %-9u  %-14.0f  %-5d  %d%s\n", entry._gt1Id, entry._menuName.c_str(), cycles, cycles/VERIFY_CLOCK_KHZ, bytes, mismatches,
+                        (cycles == VERIFY_MAX_CYCLES) ? " : never reached its start address" : "");
+        if(mismatches  ||  cycles == VERIFY_MAX_CYCLES) success = false;
+    }
+    fprintf(stderr, "\n");
+
+    return success;
+}
+
+bool writeRoms(const std::string& outputFilename)
+{
+    // Merged ROM
+    std::ofstream outfile(outputFilename, std::ios::binary | std::ios::out);
+    if(!outfile.is_open())
+    {
+        fprintf(stderr, "gtpackrom : failed to open '%s'\n", outputFilename.c_str());
+        return false;
+    }
+    outfile.write((char *)_ROM, _romSize);
+    if(outfile.bad() || outfile.fail())
+    {
+        fprintf(stderr, "gtpackrom : write error in file '%s'\n", outputFilename.c_str());
+        return false;
+    }
+
+    // Split ROM
+    std::string outputFilename0 = outputFilename + "_i";
+    std::ofstream outfile0(outputFilename0, std::ios::binary | std::ios::out);
+    if(!outfile0.is_open())
+    {
+        fprintf(stderr, "gtpackrom : failed to open '%s'\n", outputFilename0.c_str());
+        return false;
+    }
+    std::string outputFilename1 = outputFilename + "_d";
+    std::ofstream outfile1(outputFilename1, std::ios::binary | std::ios::out);
+    if(!outfile1.is_open())
+    {
+        fprintf(stderr, "gtpackrom : failed to open '%s'\n", outputFilename1.c_str());
+        return false;
+    }
+    for(int i=0; i<_romSize; i+=2)
+    {
+        outfile0.write((char *)&_ROM[i + 0], 1);
+        if(outfile0.bad() || outfile0.fail())
+        {
+            fprintf(stderr, "gtpackrom : write error at address %04x in file '%s'\n", i, outputFilename0.c_str());
+            return false;
+        }
+
+        outfile1.write((char *)&_ROM[i + 1], 1);
+        if(outfile1.bad() || outfile1.fail())
+        {
+            fprintf(stderr, "gtpackrom : write error at address %04x in file '%s'\n", i, outputFilename1.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+int main(int argc, char* argv[])
+{
+    // Optional compression and verification can be anywhere after the title
+    bool compress = false, verify = false;
+    std::vector<std::string> args;
+    for(int i=0; i<argc; i++)
+    {
+        std::string arg = std::string(argv[i]);
+        if(i > 3  &&  (arg == "-c"  ||  arg == "-C"))
+        {
+            compress = true;
+            continue;
+        }
+        if(i > 3  &&  (arg == "-v"  ||  arg == "-V"))
+        {
+            verify = true;
+            continue;
+        }
+        args.push_back(arg);
+    }
+
+    if(args.size() < 8  ||  (args.size() - 5) % 3)
+    {
+        fprintf(stderr, "%s\n", GTPACKROM_VERSION_STR);
+        fprintf(stderr, "Usage:   gtpackrom <input ROM filename> <output ROM filename> <title> <free regions>\n");
+        fprintf(stderr, "                   <input GT1 filename> <menu_name> <int menu 0 to 5> [<input GT1 filename> <menu_name> <int menu 0 to 5> ...] <optional -c> <optional -v>\n");
+        fprintf(stderr, "         <free regions> comma separated <start>-<end> hex address ranges of ROM that may be overwritten, or none.\n");
+        fprintf(stderr, "         <menu> Snake = 0, Racer = 1, Mandelbrot = 2, Pictures = 3, Credits = 4, Loader = 5\n");
+        fprintf(stderr, "         -c stores each GT1 compressed, with a decompressor that reads it from ROM, when that is smaller.\n");
+        fprintf(stderr, "         -v loads every GT1 from the output ROM on an emulated Gigatron and checks RAM against it, the ROM is only written if all match.\n");
+        fprintf(stderr, "Example: gtpackrom ROMv1.rom test.rom \"TTL microcomputer ROM at67\" 0x0B00-0x5FFF tetris.gt1 Tetris 4 life.gt1 Life 5\n");
+        return 1;
+    }
+
+    std::string inputFilename = args[1];
+    if(inputFilename.find(".rom") == inputFilename.npos  &&  inputFilename.find(".hex") == inputFilename.npos  &&  inputFilename.find(".bin") == inputFilename.npos  &&
+       inputFilename.find(".ROM") == inputFilename.npos  &&  inputFilename.find(".HEX") == inputFilename.npos  &&  inputFilename.find(".BIN") == inputFilename.npos)
+    {
+        fprintf(stderr, "Wrong file extension in %s : must be one of : '.rom' or '.hex' or '.bin'\n", inputFilename.c_str());
+        return 1;
+    }
+
+    // Load ROM file
+    std::ifstream romfile(inputFilename, std::ios::binary | std::ios::in);
+    if(!romfile.is_open())
+    {
+        fprintf(stderr, "gtpackrom : couldn't open %s ROM file.\n", inputFilename.c_str());
+        return 1;
+    }
+    _ROM = Cpu::getPtrToROM(_romSize);
+    romfile.read((char *)_ROM, _romSize);
+    if(romfile.bad() || romfile.fail()  ||  romfile.gcount() < _romSize)
+    {
+        fprintf(stderr, "gtpackrom : failed to read %s ROM file : required size is %d\n", inputFilename.c_str(), _romSize);
+        return 1;
+    }
+
+    Cpu::initialiseInternalGt1s();
+
+    std::string outputFilename = args[2];
+    std::string title = args[3];
+    if(!parseRegions(args[4])) return 1;
+
+    // Map and validate GT1 files
+    for(int i=5; i<int(args.size()); i+=3)
+    {
+        Gt1Entry entry;
+        entry._filename = args[i];
+        entry._menuName = args[i + 1];
+        entry._gt1Id = (Cpu::InternalGt1Id)strtol(args[i + 2].c_str(), nullptr, 10);
+        if(entry._gt1Id < Cpu::SnakeGt1  ||  entry._gt1Id >= Cpu::NumInternalGt1s)
+        {
+            fprintf(stderr, "gtpackrom : menu %s for %s must be 0 to 5\n", args[i + 2].c_str(), entry._filename.c_str());
+            return 1;
+        }
+        for(int j=0; j<int(_entries.size()); j++)
+        {
+            if(_entries[j]._gt1Id == entry._gt1Id)
+            {
+                fprintf(stderr, "gtpackrom : menu %d is used by %s and %s\n", entry._gt1Id, _entries[j]._filename.c_str(), entry._filename.c_str());
+                return 1;
+            }
+        }
+
+        // The ROM loader gets the raw bytes, unless the compressed stream is smaller
+        Mapping::Gt1Map gt1Map;
+        if(!Mapping::mapGt1File(entry._filename, gt1Map))
+        {
+            fprintf(stderr, "gtpackrom : failed to load %s GT1 file.\n", entry._filename.c_str());
+            return 1;
+        }
+        entry._stream.assign(gt1Map._file._data, gt1Map._file._data + gt1Map._file._size);
+        Mapping::unmapGt1File(gt1Map);
+        entry._gt1Size = int(entry._stream.size());
+        entry._rawLoadCycles = Loader::getGt1RomLoadCycles(entry._stream, false);
+        entry._loadCycles = entry._rawLoadCycles;
+
+        Loader::Gt1File gt1File;
+        std::vector<uint8_t> stream;
+        if(compress  &&  Loader::loadGt1File(entry._filename, gt1File)  &&  Loader::compressGt1FileForRom(gt1File, stream)  &&  stream.size() < entry._stream.size())
+        {
+            entry._stream = stream;
+            entry._isCompressed = true;
+            entry._loadCycles = Loader::getGt1RomLoadCycles(entry._stream, true);
+        }
+        entry._size = int(entry._stream.size());
+        _entries.push_back(entry);
+    }
+
+    // Find every run of ROM that can hold a stream, before anything is patched
+    reclaimInternalGt1s();
+    mergeRegions();
+    buildBins();
+
+    // Largest first finds tight layouts early, which prunes the most
+    for(int i=0; i<int(_entries.size()); i++) _order.push_back(i);
+    std::stable_sort(_order.begin(), _order.end(), [](int a, int b) {return _entries[a]._size > _entries[b]._size;});
+    _assignment.resize(_entries.size(), -1);
+    _bestPages = ROM_SIZE;
+    _bestBins = int(_bins.size()) + 1;
+    searchLayout(0, 0);
+    if(_bestAssignment.empty())
+    {
+        int streamBytes = 0, capacity = 0;
+        for(int i=0; i<int(_entries.size()); i++) streamBytes += _entries[i]._size;
+        for(int i=0; i<int(_bins.size()); i++) capacity += _bins[i]._capacity;
+        fprintf(stderr, "gtpackrom : failed to fit %d stream bytes into %d free ROM data bytes in %d runs\n", streamBytes, capacity, int(_bins.size()));
+        return 1;
+    }
+
+    // Streams within a bin are back to back, so consecutive streams share pages and their trampolines
+    for(int i=0; i<int(_order.size()); i++)
+    {
+        Gt1Entry& entry = _entries[_order[i]];
+        Bin& bin = _bins[_bestAssignment[_order[i]]];
+        entry._bin = _bestAssignment[_order[i]];
+        entry._address = uint16_t(getDataAddress(bin._start, bin._used));
+        bin._used += entry._size;
+    }
+
+    // Patches SYS_Exec_88 loader to accept page0 segments as the first segment and works with 64KB SRAM hardware
+    Cpu::patchSYS_Exec_88();
+
+    // Modifies ROM to disable scanline VideoB
+    Cpu::patchScanlineModeVideoB();
+
+    Cpu::patchTitleIntoRom(title);
+    for(int i=0; i<int(_entries.size()); i++)
+    {
+        writeStream(_entries[i]);
+        Cpu::patchMenuIntoRom(_entries[i]._menuName, _entries[i]._address, _entries[i]._gt1Id);
+    }
+
+    printReport();
+
+    if(verify  &&  !verifyStreams())
+    {
+        fprintf(stderr, "gtpackrom : verification failed, '%s' was not written\n", outputFilename.c_str());
+        return 1;
+    }
+
+    if(!writeRoms(outputFilename)) return 1;
+
+    fprintf(stderr, "%s success.\n", GTPACKROM_VERSION_STR);
+
+    return 0;
+}
@@ -2,7 +2,8 @@ resetAudio      LDWI    0x0000
                 STW     midiCommand
                 STW     midiDelay
                 STW     midiNote
-                LDWI    giga_soundChan1 + 2 ; keyL, keyH
+                STW     midiPatternEnd
+                LDWI    giga_soundChan1 + 2 ; keyL, keyH, (low byte of running channel)
                 STW     midiChannel
                 STW     scratch
                 LDWI    title_screenMidi00  ; midi score
@@ -38,63 +39,62 @@ playMidiAsync   LD      giga_frameCount
 playMV_exit     RET
 
 
+; compact midi stream player, see Contrib/at67/midi/README.md, segments and patterns must not cross a page
 playMidi        LDI     0x01                ; keep pumping soundTimer, so that global sound stays alive
                 ST      giga_soundTimer
                 LDW     midiDelay
-                BEQ     playM_process
+                BEQ     playM_start
                 SUBI    0x01
                 STW     midiDelay
-                BEQ     playM_process    
+                BEQ     playM_start
                 RET
 
-playM_process   LDW     midiStreamPtr
-                PEEK                        ; get midi stream byte
-                STW     midiCommand
-                LDW     midiStreamPtr
-                ADDI    0x01
+playM_start     PUSH
+playM_process   LDW     midiStreamPtr       ; end of pattern returns to the stream
+                SUBW    midiPatternEnd
+                BNE     playM_fetch
+                LDW     midiReturn
                 STW     midiStreamPtr
-                LDW     midiCommand
-                ANDI    0xF0
-                STW     scratch
-                XORI    0x90                ; check for start note
-                BNE     playM_endnote
+                LDI     0x00
+                STW     midiPatternEnd
 
-                PUSH                    
-                CALL    midiStartNote       ; start note
-                POP
+playM_fetch     LDW     midiStreamPtr
+                PEEK                        ; get midi stream byte
+                ST      midiCommand
+                INC     midiStreamPtr
+                SUBI    0xA0                ; notes, note offs and channels
+                BGE     playM_delay
+                CALL    midiNotes
                 BRA     playM_process
-                
-playM_endnote   LDW     scratch 
-                XORI    0x80                ; check for end note
-                BNE     playM_segment
 
-                PUSH
-                CALL    midiEndNote         ; end note
+playM_delay     SUBI    0x30                ; 0xA0 to 0xCF waits 1 to 48 frames
+                BGE     playM_command
+                ADDI    0x31
+                STW     midiDelay
                 POP
-                BRA     playM_process
-
-
-playM_segment   LDW     scratch
-                XORI    0xD0                ; check for new segment
-                BNE     playM_delay
+                RET
 
-                PUSH
-                CALL    midiSegment         ; new midi segment
+playM_command   CALL    midiCommands        ; segment, pattern or long delay
+                LDW     midiDelay
+                BEQ     playM_process
                 POP
-                BRA     playM_process
-
-playM_delay     LDW     midiCommand         ; all that is left is delay
-                STW     midiDelay
                 RET
 
 
-midiStartNote   LDWI    giga_notesTable     ; note table in ROM
-                STW     scratch
-                LDW     midiStreamPtr       ; midi score
-                PEEK
-                SUBI    10
+midiNotes       LD      midiCommand
+                SUBI    0x80                ; 0x00 to 0x7F note on the running channel
+                BLT     midiN_note
+                SUBI    0x10                ; 0x8m note off channel mask
+                BLT     midiN_off
+                ANDI    0x03                ; 0x9t running channel
+                ADDI    0x01
+                ST      midiChannel + 1
+                RET
+
+midiN_note      LD      midiCommand
                 LSLW
-                SUBI    2
+                STW     scratch
+                LDWI    giga_notesTable - 22 ; (note - 10)*2 - 2
                 ADDW    scratch
                 STW     scratch
                 LUP     0x00                ; get ROM midi note low byte
@@ -102,36 +102,70 @@ midiStartNote   LDWI    giga_notesTable     ; note table in ROM
                 LDW     scratch
                 LUP     0x01                ; get ROM midi note high byte
                 ST      midiNote + 1
-                LDW     midiCommand
-                ANDI    0x03                ; get channel
-                ST      scratch + 1
-                LDI     0x00
-                ST      scratch
-                LDW     scratch
-                ADDW    midiChannel         ; channel address
-                STW     scratch
                 LDW     midiNote
-                DOKE    scratch             ; set note
-                LDW     midiStreamPtr
-                ADDI    0x01                ; midiStreamPtr++
-                STW     midiStreamPtr
+                DOKE    midiChannel         ; set note
+                LD      midiChannel + 1     ; next running channel
+                ANDI    0x03
+                ADDI    0x01
+                ST      midiChannel + 1
                 RET
 
-
-midiEndNote     LDW     midiCommand
-                ANDI    0x03                ; get channel
-                ST      scratch + 1
-                LDI     0x00
-                ST      scratch
-                LDW     scratch
-                ADDW    midiChannel         ; channel address
+midiN_off       LDWI    giga_soundChan1 + 2 ; keyL, keyH
                 STW     scratch
-                LDWI    0x0000
+                LDI     0x01
+                ST      midiNote            ; channel bit
+midiN_offLoop   LD      midiCommand
+                ANDW    midiNote
+                BEQ     midiN_offNext
+                LDI     0x00
                 DOKE    scratch             ; end note
+midiN_offNext   INC     scratch + 1
+                LD      midiNote
+                LSLW
+                ST      midiNote
+                XORI    0x10
+                BNE     midiN_offLoop
+                RET
+
+
+midiCommands    BEQ     midiC_segment       ; vAC = command - 0xD0
+                SUBI    0x01
+                BEQ     midiC_pattern
+midiC_delay     LDW     midiDelay           ; 0xE0 varint long delay, 7 bits per byte, most significant first
+                LSLW
+                LSLW
+                LSLW
+                LSLW
+                LSLW
+                LSLW
+                LSLW
+                STW     midiDelay
+                LDW     midiStreamPtr
+                PEEK
+                ST      midiCommand
+                INC     midiStreamPtr
+                ANDI    0x7F
+                ORW     midiDelay
+                STW     midiDelay
+                LD      midiCommand
+                ANDI    0x80
+                BNE     midiC_delay
                 RET
 
+midiC_segment   LDW     midiStreamPtr       ; 0xD0 new midi segment address
+                DEEK
+                STW     midiStreamPtr
+                RET
 
-midiSegment     LDW     midiStreamPtr       ; midi score
+midiC_pattern   LDW     midiStreamPtr       ; 0xD1 pattern address and length
+                ADDI    0x03
+                STW     midiReturn
+                SUBI    0x01
+                PEEK
+                STW     midiPatternEnd
+                LDW     midiStreamPtr
                 DEEK
-                STW     midiStreamPtr       ; 0xD0 new midi segment address
+                STW     midiStreamPtr
+                ADDW    midiPatternEnd
+                STW     midiPatternEnd
                 RET
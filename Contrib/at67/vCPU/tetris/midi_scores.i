@@ -1,649 +1,367 @@
-game_overMidi00     EQU     0x34a1
-game_overMidi00     DB      0x90 0x53 0x91 0x47 0x07 0x90 0x52 0x91 0x46 0x07 0x90 0x53
-                    DB      0x91 0x47 0x07 0x90 0x52 0x91 0x46 0x07 0x90 0x53 0x91 0x47
-                    DB      0x07 0x90 0x54 0x91 0x48 0x07 0x90 0x53 0x91 0x47 0x07 0x90 0x52
-                    DB      0x91 0x46 0x07 0x90 0x53 0x91 0x47 0x1e 0x80 0x81 0xd0 0xa1 0x35
+game_overMidi00 EQU     0x34a1
+game_overMidi00 DB      0x90 0x53 0x47 0xa6 0x90 0x52 0x46 0xa6 0x90 0x53 0xd1 0xa3 0x34 0x08
+                DB      0x47 0xa6 0x90 0x54 0x48 0xa6 0x90 0x53 0xd1 0xa3 0x34 0x08 0x47 0xbd
+                DB      0x83 0xd0 0xa1 0x35
 
 
 title_screenMidi00  EQU     0x35a1
-title_screenMidi00  DB      0x20 0x90 0x4a 0x91 0x3b 0x92 0x4d 0x0d 0x90 0x3a 0x91 0x4b
-                    DB      0x92 0x4e 0x0d 0x90 0x3b 0x91 0x4a 0x92 0x4d 0x0d 0x90 0x3a
-                    DB      0x91 0x4b 0x92 0x4e 0x0d 0x90 0x36 0x91 0x46 0x92 0x4b 0x0d
-                    DB      0x90 0x27 0x91 0x4e 0x92 0x57 0x0d 0x93 0x2a 0x80 0x81 0x82
-                    DB      0x0d 0x93 0x25 0x0d 0x90 0x4a 0x91 0x3b 0x92 0x4d 0x83 0x0d
-                    DB      0x90 0x3a 0x91 0x4b 0x92 0x4e 0x0d 0x90 0x3b 0x91 0x4a 0x92 0x4d
-                    DB      0x0d 0x90 0x3a 0x91 0x4b 0x92 0x4e 0x0d 0x90 0x36 0x91 0x46
-                    DB      0x92 0x4b 0x0d 0x90 0x27 0xd0 0xa1 0x36
+title_screenMidi00  DB      0xbf 0x90 0x4a 0x3b 0x4d 0xac 0x90 0x3a 0x4b 0x4e 0xac 0x90 0x3b 0x4a
+                    DB      0xd1 0xa5 0x35 0x07 0x90 0x36 0x46 0x4b 0xac 0x90 0x27 0x4e 0x57 0xac
+                    DB      0x87 0x2a 0xac 0x93 0x25 0xac 0x88 0x4a 0xd1 0xa4 0x35 0x0b
+                    DB      0xd1 0xa5 0x35 0x07 0xd1 0xb3 0x35 0x11 0x2e 0xac 0x90 0x53 0x4a 0x35
+                    DB      0xac 0x86 0x90 0x2e 0xac 0x90 0x52 0x4a 0x29 0xac 0x86 0x90 0x29 0xac
+                    DB      0x90 0x50 0x48 0xd1 0xdf 0x35 0x09 0x35 0xac 0x90 0x48 0x2c 0x50 0xa5
+                    DB      0x90 0x4a 0x92 0x52 0xa5 0x90 0x36 0x48 0xd0 0xa1 0x36
 
 title_screenMidi01  EQU     0x36a1
-title_screenMidi01  DB      0x91 0x4e 0x92 0x57 0x0d 0x93 0x2a 0x80 0x81 0x82 0x0d 0x93 0x25
-                    DB      0x0d 0x90 0x2e 0x83 0x0d 0x91 0x4a 0x90 0x53 0x92 0x35 0x0d
-                    DB      0x90 0x2e 0x81 0x82 0x0d 0x91 0x4a 0x90 0x52 0x92 0x29 0x0d
-                    DB      0x90 0x29 0x81 0x82 0x0d 0x91 0x48 0x90 0x50 0x92 0x29 0x0d
-                    DB      0x90 0x29 0x81 0x82 0x0d 0x91 0x48 0x90 0x50 0x92 0x35 0x0d
-                    DB      0x90 0x48 0x91 0x2c 0x92 0x50 0x06 0x90 0x4a 0x92 0x52 0x06
-                    DB      0x90 0x36 0x91 0x48 0x92 0x50 0x0d 0x90 0x2c 0x91 0x48 0x92 0x50
-                    DB      0x0d 0xd0 0xa1 0x37
+title_screenMidi01  DB      0x50 0xac 0x90 0x2c 0x48 0x50 0xac 0x90 0x36 0x47 0x4b 0xac 0x90 0x2e
+                    DB      0x4a 0x4d 0xac 0x87 0xc5 0x90 0x3b 0x4b 0x4e 0xac 0x90 0x3a 0x4d 0x50
+                    DB      0xac 0xd1 0xb4 0x36 0x0a 0xd1 0xad 0x36 0x05 0x90 0x2e 0x56 0x59
+                    DB      0xd1 0xbc 0x35 0x08 0x4b 0x3b 0xd1 0xb7 0x36 0x07 0xd1 0xb4 0x36 0x0a
+                    DB      0xd1 0xad 0x36 0x05 0x90 0x2e 0x56 0x59 0xd1 0xbc 0x35 0x08 0x2c 0xac
+                    DB      0x90 0x5a 0x57 0x35 0xac 0x86 0x90 0x2c 0xac 0x90 0x59 0x56
+                    DB      0xd1 0xd6 0x35 0x06 0x90 0x57 0x52 0x36 0xd0 0xa1 0x37
 
 title_screenMidi02  EQU     0x37a1
-title_screenMidi02  DB      0x90 0x36 0x91 0x47 0x92 0x4b 0x0d 0x90 0x2e 0x91 0x4a 0x92 0x4d
-                    DB      0x0d 0x80 0x81 0x82 0x26 0x90 0x3b 0x91 0x4b 0x92 0x4e 0x0d
-                    DB      0x90 0x3a 0x91 0x4d 0x92 0x50 0x0d 0x90 0x3b 0x91 0x4b 0x92 0x4e
-                    DB      0x0d 0x90 0x3a 0x91 0x4d 0x92 0x50 0x0d 0x90 0x2e 0x91 0x4a
-                    DB      0x92 0x4d 0x0d 0x90 0x2e 0x91 0x56 0x92 0x59 0x0d 0x93 0x2a
-                    DB      0x80 0x81 0x82 0x0d 0x93 0x25 0x0d 0x90 0x4b 0x91 0x3b 0x92 0x4e
-                    DB      0x83 0x0d 0x90 0x3a 0x91 0x4d 0x92 0x50 0x0d 0x90 0x3b 0x91 0x4b 0xd0 0xa1 0x38
+title_screenMidi02  DB      0xd1 0xd7 0x35 0x05 0x90 0x57 0x52 0x36 0xac 0x86 0x90 0x2f 0xac
+                    DB      0x90 0x57 0x53 0x38 0xa5 0x90 0x56 0x59 0xa5 0x90 0x2f 0x53 0x57 0xa5
+                    DB      0x86 0xa5 0x90 0x52 0x38 0x56 0xa5 0x85 0xa5 0x90 0x4f 0x33 0x57 0xa5
+                    DB      0x85 0xa5 0x82 0xc5 0x90 0x43 0x33 0x46 0xa5 0x90 0x44 0x92 0x48 0xa5
+                    DB      0x90 0x33 0x43 0x46 0x25 0xac 0x89 0xac 0x86 0x33 0x93 0x2c 0xac 0x33
+                    DB      0x93 0x2c 0xac 0x33 0x93 0x25 0xac 0x88 0x4b 0x43 0xac 0x33 0x2c 0xac
+                    DB      0x44 0x33 0x48 0x2c 0xac 0x91 0x33 0xd0 0xa1 0x38
 
 title_screenMidi03  EQU     0x38a1
-title_screenMidi03  DB      0x92 0x4e 0x0d 0x90 0x3a 0x91 0x4d 0x92 0x50 0x0d 0x90 0x2e
-                    DB      0x91 0x4a 0x92 0x4d 0x0d 0x90 0x2e 0x91 0x56 0x92 0x59 0x0d
-                    DB      0x93 0x2a 0x80 0x81 0x82 0x0d 0x93 0x25 0x0d 0x90 0x2c 0x83
-                    DB      0x0d 0x91 0x57 0x90 0x5a 0x92 0x35 0x0d 0x90 0x2c 0x81 0x82
-                    DB      0x0d 0x91 0x56 0x90 0x59 0x92 0x35 0x0d 0x90 0x2e 0x81 0x82
-                    DB      0x0d 0x91 0x52 0x90 0x57 0x92 0x36 0x0d 0x90 0x2e 0x81 0x82
-                    DB      0x0d 0x91 0x52 0x90 0x57 0x92 0x36 0x0d 0x90 0x2f 0x81 0x82
-                    DB      0x0d 0x91 0x53 0xd0 0xa1 0x39
+title_screenMidi03  DB      0x93 0x25 0xac 0x8f 0xd1 0xe4 0x37 0x06 0xd1 0xe6 0x37 0x07 0x89
+                    DB      0xd1 0xe4 0x37 0x05 0x44 0x41 0x2e 0x2c 0xa5 0x43 0x46 0xa5 0x90 0x2e
+                    DB      0x41 0x44 0xd1 0xdc 0x37 0x05 0x2e 0x93 0x2c 0xac 0x2e 0x93 0x2c 0xac
+                    DB      0x2e 0x93 0x25 0xac 0x88 0x4a 0x41 0xac 0x2e 0x2c 0xac 0x43 0x33 0x4a
+                    DB      0x2c 0xa5 0x92 0x4b 0xa5 0x91 0x33 0x46 0x25 0xac 0x8b 0xac 0x84
+                    DB      0xd1 0xe1 0x37 0x0c 0x89 0xd1 0xe4 0x37 0x05 0x43 0x3f 0x33 0x2c 0xa5
+                    DB      0x3c 0x46 0xa5 0x90 0x33 0x3a 0x43 0xd0 0xa1 0x39
 
 title_screenMidi04  EQU     0x39a1
-title_screenMidi04  DB      0x90 0x57 0x92 0x38 0x06 0x90 0x56 0x91 0x59 0x06 0x90 0x2f
-                    DB      0x91 0x53 0x92 0x57 0x06 0x81 0x82 0x06 0x90 0x52 0x91 0x38
-                    DB      0x92 0x56 0x06 0x80 0x82 0x06 0x90 0x4f 0x91 0x33 0x92 0x57
-                    DB      0x06 0x80 0x82 0x06 0x81 0x26 0x90 0x43 0x91 0x33 0x92 0x46
-                    DB      0x06 0x90 0x44 0x92 0x48 0x06 0x93 0x25 0x90 0x33 0x91 0x43
-                    DB      0x92 0x46 0x0d 0x80 0x83 0x0d 0x90 0x33 0x93 0x2c 0x81 0x82
-                    DB      0x0d 0x90 0x33 0x93 0x2c 0x0d 0x90 0x33 0x93 0x25 0x0d 0x91 0x43
-                    DB      0x90 0x4b 0xd0 0xa1 0x3a
+title_screenMidi04  DB      0xd1 0xdc 0x37 0x12 0x46 0xd1 0xef 0x37 0x05 0x3e 0x2c 0x46 0x2c 0xa5
+                    DB      0x3f 0x92 0x48 0xa5 0x90 0x2c 0x3c 0x44 0xd1 0xdc 0x37 0x05 0x2c
+                    DB      0x93 0x2c 0xac 0x2c 0x93 0x2c 0xac 0x2c 0x93 0x25 0xac 0x89
+                    DB      0xd1 0xbe 0x39 0x05 0x3e 0x3a 0x2e 0x2c 0xa5 0x3c 0x3f 0xa5 0x90 0x2e
+                    DB      0x3a 0x3e 0xd1 0xdc 0x37 0x05 0xd1 0xc2 0x38 0x0d 0x41 0x38 0xac 0x2e
+                    DB      0x2c 0xac 0x3b 0x33 0x44 0x2c 0xac 0x91 0x33 0x93 0x25 0xac 0x8f 0xac
+                    DB      0x3a 0x33 0x43 0x2c 0xac 0x91 0x33 0x93 0x2c 0xd0 0xa1 0x3a
 
 title_screenMidi05  EQU     0x3aa1
-title_screenMidi05  DB      0x83 0x0d 0x92 0x33 0x93 0x2c 0x0d 0x90 0x44 0x91 0x33 0x93 0x2c
-                    DB      0x92 0x48 0x0d 0x91 0x33 0x93 0x25 0x0d 0x80 0x81 0x82 0x83
-                    DB      0x0d 0x90 0x33 0x93 0x2c 0x0d 0x90 0x33 0x93 0x2c 0x0d 0x90 0x33
-                    DB      0x93 0x25 0x0d 0x80 0x83 0x0d 0x90 0x33 0x93 0x2c 0x0d 0x91 0x41
-                    DB      0x90 0x44 0x92 0x2e 0x93 0x2c 0x06 0x90 0x43 0x91 0x46 0x06
-                    DB      0x90 0x2e 0x93 0x25 0x91 0x41 0x92 0x44 0x0d 0x80 0x83 0x0d
-                    DB      0x90 0x2e 0x93 0x2c 0x81 0x82 0x0d 0x90 0x2e 0x93 0x2c 0xd0 0xa1 0x3b
+title_screenMidi05  DB      0xac 0x86 0x33 0x93 0x25 0xac 0x89 0xd1 0xe4 0x37 0x05 0x46 0x4f 0x33
+                    DB      0x2c 0xa5 0x48 0xa5 0x90 0x33 0x92 0x46 0x25 0xac 0x89 0xac 0x84 0x33
+                    DB      0x50 0x93 0x2c 0xd1 0xe4 0x37 0x0a 0x4f 0x4b 0xac 0x33 0x2c 0xac 0x52
+                    DB      0x2c 0x48 0x2c 0xac 0x91 0x2c 0x93 0x25 0xac 0x8e 0xac 0x2c 0x50
+                    DB      0x93 0x2c 0xd1 0xbe 0x39 0x05 0x82 0xd1 0xc3 0x39 0x05
+                    DB      0xd1 0xbe 0x39 0x05 0x44 0x4b 0x2e 0x2c 0xa5 0x46 0xa5 0x90 0x2e
+                    DB      0x92 0x44 0xd1 0xb7 0x3a 0x05 0x2e 0x4d 0x93 0x2c 0xd0 0xa1 0x3b
 
 title_screenMidi06  EQU     0x3ba1
-title_screenMidi06  DB      0x0d 0x90 0x2e 0x93 0x25 0x0d 0x91 0x41 0x90 0x4a 0x83 0x0d
-                    DB      0x92 0x2e 0x93 0x2c 0x0d 0x90 0x43 0x91 0x33 0x93 0x2c 0x92 0x4a
-                    DB      0x06 0x92 0x4b 0x06 0x91 0x33 0x93 0x25 0x92 0x46 0x0d 0x80
-                    DB      0x81 0x83 0x0d 0x90 0x33 0x93 0x2c 0x82 0x0d 0x90 0x33 0x93 0x2c
-                    DB      0x0d 0x90 0x33 0x93 0x25 0x0d 0x80 0x83 0x0d 0x90 0x33 0x93 0x2c
-                    DB      0x0d 0x91 0x3f 0x90 0x43 0x92 0x33 0x93 0x2c 0x06 0x90 0x3c
-                    DB      0x91 0x46 0x06 0x90 0x33 0x93 0x25 0x91 0x3a 0x92 0x43 0x0d 0xd0 0xa1 0x3c
+title_screenMidi06  DB      0xd1 0xc5 0x38 0x0a 0x4f 0x4a 0xac 0x2e 0x2c 0xac 0x50
+                    DB      0xd1 0xd6 0x38 0x0c 0x8a 0xac 0x84 0x33 0x4f 0x93 0x2c 0xac 0x32
+                    DB      0x93 0x2c 0xac 0x82 0x32 0x93 0x25 0xac 0x89 0xd1 0xb7 0x3b 0x05 0x43
+                    DB      0x4b 0x30 0x2c 0xa5 0x46 0xa5 0x90 0x30 0x92 0x43 0xd1 0xb7 0x3a 0x05
+                    DB      0x30 0x4a 0x93 0x2c 0xd1 0xc5 0x38 0x05 0x4a 0x2e 0x93 0x25 0xac 0x8a
+                    DB      0x92 0x46 0xac 0x91 0x2e 0x93 0x2c 0xac 0x4f 0x2c 0x46 0x2c 0xa5
+                    DB      0x92 0x48 0xa5 0x91 0x2c 0x44 0x25 0xac 0x8a 0xac 0x84 0xd0 0xa1 0x3c
 
 title_screenMidi07  EQU     0x3ca1
-title_screenMidi07  DB      0x80 0x83 0x0d 0x90 0x33 0x93 0x2c 0x81 0x82 0x0d 0x90 0x33
-                    DB      0x93 0x2c 0x0d 0x90 0x33 0x93 0x25 0x0d 0x91 0x43 0x90 0x46
-                    DB      0x83 0x0d 0x92 0x33 0x93 0x2c 0x0d 0x90 0x3e 0x91 0x2c 0x93 0x2c
-                    DB      0x92 0x46 0x06 0x90 0x3f 0x92 0x48 0x06 0x90 0x2c 0x93 0x25
-                    DB      0x91 0x3c 0x92 0x44 0x0d 0x80 0x83 0x0d 0x90 0x2c 0x93 0x2c
-                    DB      0x81 0x82 0x0d 0x90 0x2c 0x93 0x2c 0x0d 0x90 0x2c 0x93 0x25
-                    DB      0x0d 0x80 0x83 0x0d 0x90 0x2c 0x93 0x2c 0x0d 0x91 0x3a 0x90 0x3e
-                    DB      0x92 0x2e 0xd0 0xa1 0x3d
-
-title_screenMidi08  EQU     0x3da1
-title_screenMidi08  DB      0x93 0x2c 0x06 0x90 0x3c 0x91 0x3f 0x06 0x90 0x2e 0x93 0x25
-                    DB      0x91 0x3a 0x92 0x3e 0x0d 0x80 0x83 0x0d 0x90 0x2e 0x93 0x2c
-                    DB      0x81 0x82 0x0d 0x90 0x2e 0x93 0x2c 0x0d 0x90 0x2e 0x93 0x25
-                    DB      0x0d 0x91 0x38 0x90 0x41 0x83 0x0d 0x92 0x2e 0x93 0x2c 0x0d
-                    DB      0x90 0x3b 0x91 0x33 0x93 0x2c 0x92 0x44 0x0d 0x91 0x33 0x93 0x25
-                    DB      0x0d 0x80 0x81 0x82 0x83 0x0d 0x90 0x3a 0x91 0x33 0x93 0x2c
-                    DB      0x92 0x43 0x0d 0x91 0x33 0x93 0x2c 0x0d 0x90 0x33 0x93 0x25
-                    DB      0x81 0xd0 0xa1 0x3e
-
-title_screenMidi09  EQU     0x3ea1
-title_screenMidi09  DB      0x82 0x0d 0x80 0x83 0x0d 0x90 0x33 0x93 0x2c 0x0d 0x91 0x4f
-                    DB      0x90 0x46 0x92 0x33 0x93 0x2c 0x06 0x90 0x48 0x06 0x90 0x33
-                    DB      0x93 0x25 0x92 0x46 0x0d 0x80 0x83 0x0d 0x90 0x33 0x93 0x2c
-                    DB      0x91 0x50 0x82 0x0d 0x90 0x33 0x93 0x2c 0x0d 0x90 0x33 0x93 0x25
-                    DB      0x0d 0x90 0x4f 0x91 0x4b 0x83 0x0d 0x92 0x33 0x93 0x2c 0x0d
-                    DB      0x90 0x52 0x91 0x2c 0x93 0x2c 0x92 0x48 0x0d 0x91 0x2c 0x93 0x25
-                    DB      0x0d 0x81 0x82 0x83 0x0d 0x90 0x2c 0x93 0x2c 0x91 0x50 0x0d
-                    DB      0x90 0x2c 0xd0 0xa1 0x3f
-
-title_screenMidi10  EQU     0x3fa1
-title_screenMidi10  DB      0x93 0x2c 0x0d 0x90 0x2c 0x93 0x25 0x81 0x0d 0x80 0x83 0x0d
-                    DB      0x90 0x2c 0x93 0x2c 0x0d 0x91 0x4b 0x90 0x44 0x92 0x2e 0x93 0x2c
-                    DB      0x06 0x90 0x46 0x06 0x90 0x2e 0x93 0x25 0x92 0x44 0x0d 0x80
-                    DB      0x83 0x0d 0x90 0x2e 0x93 0x2c 0x91 0x4d 0x82 0x0d 0x90 0x2e
-                    DB      0x93 0x2c 0x0d 0x90 0x2e 0x93 0x25 0x0d 0x90 0x4f 0x91 0x4a
-                    DB      0x83 0x0d 0x92 0x2e 0x93 0x2c 0x0d 0x90 0x50 0x91 0x33 0x93 0x2c
-                    DB      0x92 0x4a 0x06 0x92 0x4b 0x06 0x91 0x33 0x93 0x25 0x92 0x46 0xd0 0xa1 0x40
-
-title_screenMidi11  EQU     0x40a1
-title_screenMidi11  DB      0x0d 0x81 0x83 0x0d 0x90 0x33 0x93 0x2c 0x91 0x4f 0x82 0x0d
-                    DB      0x90 0x32 0x93 0x2c 0x0d 0x90 0x32 0x93 0x25 0x81 0x0d 0x80
-                    DB      0x83 0x0d 0x90 0x32 0x93 0x2c 0x0d 0x91 0x4b 0x90 0x43 0x92 0x30
-                    DB      0x93 0x2c 0x06 0x90 0x46 0x06 0x90 0x30 0x93 0x25 0x92 0x43
-                    DB      0x0d 0x80 0x83 0x0d 0x90 0x30 0x93 0x2c 0x91 0x4a 0x82 0x0d
-                    DB      0x90 0x2e 0x93 0x2c 0x0d 0x90 0x4a 0x91 0x2e 0x93 0x25 0x0d
-                    DB      0x92 0x46 0x81 0x83 0x0d 0x91 0x2e 0x93 0x2c 0x0d 0x90 0x4f
-                    DB      0x91 0x2c 0xd0 0xa1 0x41
-
-title_screenMidi12  EQU     0x41a1
-title_screenMidi12  DB      0x93 0x2c 0x92 0x46 0x06 0x92 0x48 0x06 0x91 0x2c 0x93 0x25
-                    DB      0x92 0x44 0x0d 0x81 0x83 0x0d 0x90 0x2c 0x93 0x2c 0x91 0x4d
-                    DB      0x82 0x0d 0x90 0x2c 0x93 0x2c 0x0d 0x90 0x2c 0x93 0x25 0x81
-                    DB      0x0d 0x91 0x48 0x80 0x83 0x0d 0x90 0x2c 0x93 0x2c 0x0d 0x90 0x50
-                    DB      0x91 0x2e 0x93 0x2c 0x92 0x3e 0x06 0x92 0x3f 0x06 0x91 0x2e
-                    DB      0x93 0x25 0x92 0x3e 0x0d 0x81 0x83 0x0d 0x90 0x2e 0x93 0x2c
-                    DB      0x91 0x52 0x82 0x0d 0x90 0x2e 0x93 0x2c 0x0d 0x90 0x2e 0x93 0x25
-                    DB      0x0d 0xd0 0xa1 0x42
-
-title_screenMidi13  EQU     0x42a1
-title_screenMidi13  DB      0x90 0x50 0x91 0x41 0x83 0x0d 0x92 0x2e 0x93 0x2c 0x0d 0x91 0x4d
-                    DB      0x92 0x33 0x93 0x2c 0x0d 0x90 0x33 0x93 0x25 0x82 0x0d 0x80
-                    DB      0x83 0x0d 0x90 0x33 0x93 0x2c 0x91 0x4b 0x92 0x43 0x0d 0x90 0x33
-                    DB      0x93 0x2c 0x0d 0x90 0x33 0x93 0x25 0x81 0x82 0x0d 0x80 0x83
-                    DB      0x0d 0x90 0x33 0x93 0x25 0x0d 0x80 0x83 0xd0 0xa1 0x43
-
-
-
-music_a_2_Midi00    EQU     0x43a1
-music_a_2_Midi00    DB      0x90 0x47 0x91 0x28 0x92 0x4c 0x0c 0x93 0x20 0x91 0x34 0x0c
-                    DB      0x90 0x44 0x91 0x28 0x92 0x47 0x83 0x0c 0x93 0x20 0x91 0x34
-                    DB      0x90 0x45 0x92 0x48 0x0c 0x91 0x28 0x90 0x47 0x92 0x4a 0x83
-                    DB      0x0c 0x93 0x20 0x91 0x34 0x06 0x93 0x20 0x06 0x90 0x45 0x91 0x28
-                    DB      0x92 0x48 0x83 0x0c 0x93 0x20 0x91 0x34 0x90 0x44 0x92 0x47
-                    DB      0x06 0x83 0x06 0x90 0x40 0x91 0x2d 0x92 0x45 0x0c 0x93 0x20
-                    DB      0x91 0x39 0x0c 0x90 0x40 0x91 0x2d 0x92 0x45 0x83 0x0c 0x93 0x20
-                    DB      0x91 0x39 0x90 0x45 0xd0 0xa1 0x44
-
-music_a_2_Midi01    EQU     0x44a1
-music_a_2_Midi01    DB      0x92 0x48 0x0c 0x91 0x2d 0x90 0x48 0x92 0x4c 0x83 0x0c 0x93 0x20
-                    DB      0x91 0x39 0x0c 0x90 0x20 0x92 0x47 0x91 0x2d 0x93 0x4a 0x06
-                    DB      0x80 0x06 0x90 0x20 0x92 0x45 0x91 0x39 0x93 0x48 0x0c 0x91 0x2c
-                    DB      0x90 0x44 0x92 0x47 0x83 0x0c 0x93 0x20 0x91 0x38 0x0c 0x91 0x2c
-                    DB      0x83 0x0c 0x93 0x20 0x90 0x45 0x91 0x38 0x92 0x48 0x0c 0x91 0x28
-                    DB      0x90 0x47 0x92 0x4a 0x83 0x0c 0x93 0x20 0x91 0x34 0x06 0x93 0x20
-                    DB      0x06 0x90 0x47 0x91 0x28 0x92 0x4c 0x83 0x0c 0x93 0x20 0xd0 0xa1 0x45
-
-music_a_2_Midi02    EQU     0x45a1
-music_a_2_Midi02    DB      0x91 0x34 0x06 0x83 0x06 0x90 0x45 0x91 0x2d 0x92 0x48 0x0c
-                    DB      0x93 0x20 0x91 0x39 0x0c 0x90 0x40 0x91 0x2d 0x92 0x45 0x83
-                    DB      0x0c 0x93 0x20 0x91 0x39 0x0c 0x90 0x40 0x91 0x2d 0x92 0x45
-                    DB      0x83 0x0c 0x93 0x20 0x91 0x39 0x0c 0x90 0x20 0x91 0x2f 0x82
-                    DB      0x83 0x06 0x80 0x06 0x90 0x20 0x91 0x30 0x0c 0x91 0x32 0x80
-                    DB      0x0c 0x90 0x20 0x92 0x41 0x93 0x4a 0x91 0x26 0x0c 0x80 0x81
-                    DB      0x82 0x83 0x0c 0x90 0x20 0x92 0x45 0x91 0x26 0x93 0x4d 0x0c
-                    DB      0x90 0x48 0xd0 0xa1 0x46
-
-music_a_2_Midi03    EQU     0x46a1
-music_a_2_Midi03    DB      0x92 0x51 0x81 0x83 0x0c 0x91 0x26 0x93 0x20 0x90 0x48 0x06
-                    DB      0x91 0x26 0x90 0x20 0x93 0x48 0x06 0x91 0x2d 0x90 0x47 0x92 0x4f
-                    DB      0x83 0x0c 0x93 0x20 0x91 0x29 0x90 0x45 0x92 0x4d 0x06 0x83
-                    DB      0x06 0x90 0x43 0x91 0x24 0x92 0x4c 0x0c 0x93 0x20 0x91 0x30
-                    DB      0x80 0x82 0x0c 0x81 0x83 0x0c 0x90 0x20 0x92 0x40 0x91 0x30
-                    DB      0x93 0x48 0x0c 0x90 0x43 0x92 0x4c 0x81 0x83 0x0c 0x91 0x24
-                    DB      0x93 0x20 0x90 0x45 0x06 0x91 0x25 0x90 0x43 0x06 0x91 0x26
-                    DB      0x90 0x20 0xd0 0xa1 0x47
-
-music_a_2_Midi04    EQU     0x47a1
-music_a_2_Midi04    DB      0x92 0x41 0x93 0x4a 0x06 0x80 0x06 0x90 0x20 0x92 0x40 0x91 0x27
-                    DB      0x93 0x48 0x0c 0x90 0x44 0x92 0x47 0x81 0x83 0x0c 0x91 0x3b
-                    DB      0x93 0x20 0x80 0x0c 0x90 0x44 0x92 0x47 0x81 0x83 0x0c 0x91 0x3b
-                    DB      0x93 0x20 0x90 0x45 0x92 0x48 0x0c 0x90 0x47 0x92 0x4a 0x81
-                    DB      0x83 0x0c 0x91 0x34 0x93 0x20 0x06 0x93 0x20 0x06 0x90 0x47
-                    DB      0x92 0x4c 0x81 0x83 0x0c 0x91 0x38 0x93 0x20 0x06 0x83 0x06
-                    DB      0x90 0x45 0x91 0x2d 0x92 0x48 0x0c 0x93 0x20 0x91 0x34 0x0c
-                    DB      0x90 0x40 0xd0 0xa1 0x48
-
-music_a_2_Midi05    EQU     0x48a1
-music_a_2_Midi05    DB      0x91 0x2d 0x92 0x45 0x83 0x0c 0x93 0x20 0x91 0x34 0x0c 0x90 0x40
-                    DB      0x91 0x2d 0x92 0x45 0x83 0x0c 0x93 0x20 0x81 0x0c 0x90 0x20
-                    DB      0x82 0x83 0x06 0x80 0x06 0x90 0x20 0x0c 0x92 0x47 0x91 0x28
-                    DB      0x90 0x4c 0x0c 0x93 0x20 0x91 0x34 0x0c 0x90 0x44 0x91 0x28
-                    DB      0x92 0x47 0x83 0x0c 0x93 0x20 0x91 0x34 0x90 0x45 0x92 0x48
-                    DB      0x0c 0x91 0x28 0x90 0x47 0x92 0x4a 0x83 0x0c 0x93 0x20 0x91 0x34
-                    DB      0x06 0x93 0x20 0x06 0x90 0x45 0x91 0x28 0x92 0x48 0x83 0x0c 0xd0 0xa1 0x49
-
-music_a_2_Midi06    EQU     0x49a1
-music_a_2_Midi06    DB      0x93 0x20 0x91 0x34 0x90 0x44 0x92 0x47 0x06 0x83 0x06 0x90 0x40
-                    DB      0x91 0x2d 0x92 0x45 0x0c 0x93 0x20 0x91 0x39 0x0c 0x90 0x40
-                    DB      0x91 0x2d 0x92 0x45 0x83 0x0c 0x93 0x20 0x91 0x39 0x90 0x45
-                    DB      0x92 0x48 0x0c 0x91 0x2d 0x90 0x48 0x92 0x4c 0x83 0x0c 0x93 0x20
-                    DB      0x91 0x39 0x0c 0x90 0x20 0x92 0x47 0x91 0x2d 0x93 0x4a 0x06
-                    DB      0x80 0x06 0x90 0x20 0x92 0x45 0x91 0x39 0x93 0x48 0x0c 0x91 0x2c
-                    DB      0x90 0x44 0x92 0x47 0x83 0x0c 0x93 0x20 0x91 0x38 0x0c 0x91 0x2c 0xd0 0xa1 0x4a
-
-music_a_2_Midi07    EQU     0x4aa1
-music_a_2_Midi07    DB      0x83 0x0c 0x93 0x20 0x90 0x45 0x91 0x38 0x92 0x48 0x0c 0x91 0x28
-                    DB      0x90 0x47 0x92 0x4a 0x83 0x0c 0x93 0x20 0x91 0x34 0x06 0x93 0x20
-                    DB      0x06 0x90 0x47 0x91 0x28 0x92 0x4c 0x83 0x0c 0x93 0x20 0x91 0x34
-                    DB      0x06 0x83 0x06 0x90 0x45 0x91 0x2d 0x92 0x48 0x0c 0x93 0x20
-                    DB      0x91 0x39 0x0c 0x90 0x40 0x91 0x2d 0x92 0x45 0x83 0x0c 0x93 0x20
-                    DB      0x91 0x39 0x0c 0x90 0x40 0x91 0x2d 0x92 0x45 0x83 0x0c 0x93 0x20
-                    DB      0x91 0x39 0x0c 0x90 0x20 0x91 0x2f 0x82 0x83 0xd0 0xa1 0x4b
-
-music_a_2_Midi08    EQU     0x4ba1
-music_a_2_Midi08    DB      0x06 0x80 0x06 0x90 0x20 0x91 0x30 0x0c 0x91 0x32 0x80 0x0c
-                    DB      0x90 0x20 0x92 0x41 0x93 0x4a 0x91 0x26 0x0c 0x80 0x81 0x82
-                    DB      0x83 0x0c 0x90 0x20 0x92 0x45 0x91 0x26 0x93 0x4d 0x0c 0x90 0x48
-                    DB      0x92 0x51 0x81 0x83 0x0c 0x91 0x26 0x93 0x20 0x90 0x48 0x06
-                    DB      0x91 0x26 0x90 0x20 0x93 0x48 0x06 0x91 0x2d 0x90 0x47 0x92 0x4f
-                    DB      0x83 0x0c 0x93 0x20 0x91 0x29 0x90 0x45 0x92 0x4d 0x06 0x83
-                    DB      0x06 0x90 0x43 0x91 0x24 0x92 0x4c 0x0c 0x93 0x20 0x91 0x30
-                    DB      0x80 0xd0 0xa1 0x4c
-
-music_a_2_Midi09    EQU     0x4ca1
-music_a_2_Midi09    DB      0x82 0x0c 0x81 0x83 0x0c 0x90 0x20 0x92 0x40 0x91 0x30 0x93 0x48
-                    DB      0x0c 0x90 0x43 0x92 0x4c 0x81 0x83 0x0c 0x91 0x24 0x93 0x20
-                    DB      0x90 0x45 0x06 0x91 0x25 0x90 0x43 0x06 0x91 0x26 0x90 0x20
-                    DB      0x92 0x41 0x93 0x4a 0x06 0x80 0x06 0x90 0x20 0x92 0x40 0x91 0x27
-                    DB      0x93 0x48 0x0c 0x90 0x44 0x92 0x47 0x81 0x83 0x0c 0x91 0x3b
-                    DB      0x93 0x20 0x80 0x0c 0x90 0x44 0x92 0x47 0x81 0x83 0x0c 0x91 0x3b
-                    DB      0x93 0x20 0x90 0x45 0x92 0x48 0x0c 0x90 0x47 0x92 0x4a 0x81 0xd0 0xa1 0x4d
-
-music_a_2_Midi10    EQU     0x4da1
-music_a_2_Midi10    DB      0x83 0x0c 0x91 0x34 0x93 0x20 0x06 0x93 0x20 0x06 0x90 0x47
-                    DB      0x92 0x4c 0x81 0x83 0x0c 0x91 0x38 0x93 0x20 0x06 0x83 0x06
-                    DB      0x90 0x45 0x91 0x2d 0x92 0x48 0x0c 0x93 0x20 0x91 0x34 0x0c
-                    DB      0x90 0x40 0x91 0x2d 0x92 0x45 0x83 0x0c 0x93 0x20 0x91 0x34
-                    DB      0x0c 0x90 0x40 0x91 0x2d 0x92 0x45 0x83 0x0c 0x93 0x20 0x81
-                    DB      0x0c 0x90 0x20 0x82 0x83 0x06 0x80 0x06 0x90 0x20 0x0c 0x91 0x39
-                    DB      0x92 0x45 0x90 0x40 0x0c 0x92 0x20 0x93 0x4c 0x0c 0x92 0x45
-                    DB      0x83 0x0c 0xd0 0xa1 0x4e
-
-music_a_2_Midi11    EQU     0x4ea1
-music_a_2_Midi11    DB      0x93 0x20 0x92 0x4c 0x0c 0x90 0x3c 0x92 0x45 0x83 0x0c 0x93 0x20
-                    DB      0x92 0x4c 0x06 0x93 0x20 0x06 0x92 0x45 0x83 0x0c 0x93 0x20
-                    DB      0x92 0x4c 0x06 0x83 0x06 0x90 0x38 0x92 0x44 0x91 0x3e 0x0c
-                    DB      0x92 0x20 0x93 0x4c 0x0c 0x92 0x44 0x83 0x0c 0x93 0x20 0x92 0x4c
-                    DB      0x0c 0x91 0x3b 0x92 0x44 0x83 0x0c 0x93 0x20 0x92 0x4c 0x0c
-                    DB      0x92 0x20 0x93 0x44 0x06 0x82 0x06 0x92 0x20 0x93 0x4c 0x0c
-                    DB      0x90 0x39 0x92 0x45 0x91 0x3c 0x83 0x0c 0x92 0x20 0x93 0x4c
-                    DB      0x0c 0xd0 0xa1 0x4f
-
-music_a_2_Midi12    EQU     0x4fa1
-music_a_2_Midi12    DB      0x92 0x45 0x83 0x0c 0x93 0x20 0x92 0x4c 0x0c 0x90 0x34 0x92 0x45
-                    DB      0x91 0x39 0x83 0x0c 0x92 0x20 0x93 0x4c 0x06 0x92 0x20 0x06
-                    DB      0x92 0x45 0x83 0x0c 0x93 0x20 0x92 0x4c 0x06 0x83 0x06 0x91 0x38
-                    DB      0x92 0x44 0x0c 0x93 0x20 0x92 0x4c 0x0c 0x92 0x44 0x83 0x0c
-                    DB      0x93 0x20 0x92 0x4c 0x0c 0x90 0x3b 0x92 0x44 0x83 0x0c 0x93 0x20
-                    DB      0x92 0x4c 0x0c 0x92 0x20 0x93 0x44 0x06 0x82 0x06 0x92 0x20
-                    DB      0x93 0x4c 0x0c 0x90 0x39 0x92 0x45 0x91 0x40 0x83 0x0c 0x92 0x20 0xd0 0xa1 0x50
-
-music_a_2_Midi13    EQU     0x50a1
-music_a_2_Midi13    DB      0x93 0x4c 0x0c 0x92 0x45 0x83 0x0c 0x93 0x20 0x92 0x4c 0x0c
-                    DB      0x91 0x3c 0x92 0x45 0x83 0x0c 0x93 0x20 0x92 0x4c 0x06 0x93 0x20
-                    DB      0x06 0x92 0x45 0x83 0x0c 0x93 0x20 0x92 0x4c 0x06 0x83 0x06
-                    DB      0x90 0x38 0x92 0x44 0x91 0x3e 0x0c 0x92 0x20 0x93 0x4c 0x0c
-                    DB      0x92 0x44 0x83 0x0c 0x93 0x20 0x92 0x4c 0x0c 0x91 0x3b 0x92 0x44
-                    DB      0x83 0x0c 0x93 0x20 0x92 0x4c 0x0c 0x92 0x20 0x93 0x44 0x06
-                    DB      0x82 0x06 0x92 0x20 0x93 0x4c 0x0c 0x90 0x39 0x92 0x45 0x91 0x3c 0xd0 0xa1 0x51
-
-music_a_2_Midi14    EQU     0x51a1
-music_a_2_Midi14    DB      0x83 0x0c 0x92 0x20 0x93 0x4c 0x0c 0x91 0x40 0x92 0x45 0x83
-                    DB      0x0c 0x93 0x20 0x92 0x4c 0x0c 0x91 0x45 0x92 0x45 0x83 0x0c
-                    DB      0x93 0x20 0x92 0x4c 0x06 0x93 0x20 0x06 0x91 0x45 0x92 0x45
-                    DB      0x83 0x0c 0x93 0x20 0x92 0x4c 0x06 0x83 0x06 0x90 0x3e 0x92 0x44
-                    DB      0x91 0x44 0x0c 0x92 0x20 0x93 0x4c 0x0c 0x92 0x44 0x83 0x0c
-                    DB      0x93 0x20 0x92 0x4c 0x0c 0x92 0x44 0x83 0x0c 0x93 0x20 0x92 0x4c
-                    DB      0x0c 0x92 0x20 0x93 0x44 0x06 0x82 0x06 0x92 0x20 0x93 0x4c 0xd0 0xa1 0x52
-
-music_a_2_Midi15    EQU     0x52a1
-music_a_2_Midi15    DB      0x0c 0x92 0x47 0x93 0x4c 0x80 0x81 0x0c 0x90 0x20 0x91 0x34
-                    DB      0x0c 0x90 0x47 0x91 0x28 0x92 0x44 0x83 0x0c 0x93 0x20 0x91 0x34
-                    DB      0x90 0x45 0x92 0x48 0x0c 0x91 0x28 0x90 0x47 0x92 0x4a 0x83
-                    DB      0x0c 0x93 0x20 0x91 0x34 0x06 0x93 0x20 0x06 0x90 0x48 0x91 0x28
-                    DB      0x92 0x45 0x83 0x0c 0x93 0x20 0x91 0x34 0x90 0x44 0x92 0x47
-                    DB      0x06 0x83 0x06 0x90 0x40 0x91 0x2d 0x92 0x45 0x0c 0x93 0x20
-                    DB      0x91 0x39 0x0c 0x90 0x40 0x91 0x2d 0x92 0x45 0x83 0x0c 0x93 0x20 0xd0 0xa1 0x53
-
-music_a_2_Midi16    EQU     0x53a1
-music_a_2_Midi16    DB      0x91 0x39 0x90 0x48 0x92 0x45 0x0c 0x91 0x2d 0x90 0x4c 0x92 0x48
-                    DB      0x83 0x0c 0x93 0x20 0x91 0x39 0x0c 0x90 0x20 0x92 0x47 0x91 0x2d
-                    DB      0x93 0x4a 0x06 0x80 0x06 0x90 0x20 0x92 0x45 0x91 0x39 0x93 0x48
-                    DB      0x0c 0x91 0x2c 0x90 0x44 0x92 0x47 0x83 0x0c 0x93 0x20 0x91 0x38
-                    DB      0x0c 0x91 0x2c 0x83 0x0c 0x93 0x20 0x90 0x48 0x91 0x38 0x92 0x45
-                    DB      0x0c 0x91 0x28 0x90 0x47 0x92 0x4a 0x83 0x0c 0x93 0x20 0x91 0x34
-                    DB      0x06 0x93 0x20 0x06 0x90 0x4c 0x91 0x28 0x92 0x47 0xd0 0xa1 0x54
-
-music_a_2_Midi17    EQU     0x54a1
-music_a_2_Midi17    DB      0x83 0x0c 0x93 0x20 0x91 0x34 0x06 0x83 0x06 0x90 0x45 0x91 0x2d
-                    DB      0x92 0x48 0x0c 0x93 0x20 0x91 0x39 0x0c 0x90 0x40 0x91 0x2d
-                    DB      0x92 0x45 0x83 0x0c 0x93 0x20 0x91 0x39 0x0c 0x90 0x40 0x91 0x2d
-                    DB      0x92 0x45 0x83 0x0c 0x93 0x20 0x91 0x39 0x0c 0x90 0x20 0x91 0x2f
-                    DB      0x82 0x83 0x06 0x80 0x06 0x90 0x20 0x91 0x30 0x0c 0x91 0x32
-                    DB      0x80 0x0c 0x90 0x20 0x92 0x4a 0x93 0x41 0x91 0x26 0x0c 0x80
-                    DB      0x81 0x82 0x83 0x0c 0x90 0x20 0x92 0x45 0x91 0x26 0x93 0x4d 0xd0 0xa1 0x55
-
-music_a_2_Midi18    EQU     0x55a1
-music_a_2_Midi18    DB      0x0c 0x90 0x48 0x92 0x51 0x81 0x83 0x0c 0x91 0x26 0x93 0x20
-                    DB      0x90 0x48 0x06 0x91 0x26 0x90 0x20 0x93 0x48 0x06 0x91 0x2d
-                    DB      0x90 0x4f 0x92 0x47 0x83 0x0c 0x93 0x20 0x91 0x29 0x90 0x4d
-                    DB      0x92 0x45 0x06 0x83 0x06 0x90 0x43 0x91 0x24 0x92 0x4c 0x0c
-                    DB      0x93 0x20 0x91 0x30 0x80 0x82 0x0c 0x81 0x83 0x0c 0x90 0x20
-                    DB      0x92 0x40 0x91 0x30 0x93 0x48 0x0c 0x90 0x4c 0x92 0x43 0x81
-                    DB      0x83 0x0c 0x91 0x24 0x93 0x20 0x92 0x45 0x06 0x91 0x25 0x92 0x43
-                    DB      0x06 0xd0 0xa1 0x56
-
-music_a_2_Midi19    EQU     0x56a1
-music_a_2_Midi19    DB      0x91 0x26 0x90 0x20 0x92 0x41 0x93 0x4a 0x06 0x80 0x06 0x90 0x20
-                    DB      0x92 0x48 0x91 0x27 0x93 0x40 0x0c 0x90 0x44 0x92 0x47 0x81
-                    DB      0x83 0x0c 0x91 0x3b 0x93 0x20 0x80 0x0c 0x90 0x44 0x92 0x47
-                    DB      0x81 0x83 0x0c 0x91 0x3b 0x93 0x20 0x90 0x48 0x92 0x45 0x0c
-                    DB      0x90 0x47 0x92 0x4a 0x81 0x83 0x0c 0x91 0x34 0x93 0x20 0x06
-                    DB      0x93 0x20 0x06 0x90 0x47 0x92 0x4c 0x81 0x83 0x0c 0x91 0x38
-                    DB      0x93 0x20 0x06 0x83 0x06 0x90 0x45 0x91 0x2d 0x92 0x48 0x0c
-                    DB      0x93 0x20 0xd0 0xa1 0x57
-
-music_a_2_Midi20    EQU     0x57a1
-music_a_2_Midi20    DB      0x91 0x34 0x0c 0x90 0x45 0x91 0x2d 0x92 0x40 0x83 0x0c 0x93 0x20
-                    DB      0x91 0x34 0x0c 0x90 0x45 0x91 0x2d 0x92 0x40 0x83 0x0c 0x93 0x20
-                    DB      0x81 0x0c 0x90 0x20 0x82 0x83 0x06 0x80 0x06 0x90 0x20 0x0c
-                    DB      0x92 0x47 0x91 0x28 0x90 0x4c 0x0c 0x93 0x20 0x91 0x34 0x0c
-                    DB      0x90 0x44 0x91 0x28 0x92 0x47 0x83 0x0c 0x93 0x20 0x91 0x34
-                    DB      0x90 0x45 0x92 0x48 0x0c 0x91 0x28 0x90 0x4a 0x92 0x47 0x83
-                    DB      0x0c 0x93 0x20 0x91 0x34 0x06 0x93 0x20 0x06 0x90 0x45 0x91 0x28 0xd0 0xa1 0x58
-
-music_a_2_Midi21    EQU     0x58a1
-music_a_2_Midi21    DB      0x92 0x48 0x83 0x0c 0x93 0x20 0x91 0x34 0x90 0x47 0x92 0x44
-                    DB      0x06 0x83 0x06 0x90 0x40 0x91 0x2d 0x92 0x45 0x0c 0x93 0x20
-                    DB      0x91 0x39 0x0c 0x90 0x40 0x91 0x2d 0x92 0x45 0x83 0x0c 0x93 0x20
-                    DB      0x91 0x39 0x90 0x45 0x92 0x48 0x0c 0x91 0x2d 0x90 0x4c 0x92 0x48
-                    DB      0x83 0x0c 0x93 0x20 0x91 0x39 0x0c 0x90 0x20 0x92 0x4a 0x91 0x2d
-                    DB      0x93 0x47 0x06 0x80 0x06 0x90 0x20 0x92 0x45 0x91 0x39 0x93 0x48
-                    DB      0x0c 0x91 0x2c 0x90 0x47 0x92 0x44 0x83 0x0c 0x93 0x20 0xd0 0xa1 0x59
-
-music_a_2_Midi22    EQU     0x59a1
-music_a_2_Midi22    DB      0x91 0x38 0x0c 0x91 0x2c 0x83 0x0c 0x93 0x20 0x90 0x45 0x91 0x38
-                    DB      0x92 0x48 0x0c 0x91 0x28 0x90 0x47 0x92 0x4a 0x83 0x0c 0x93 0x20
-                    DB      0x91 0x34 0x06 0x93 0x20 0x06 0x90 0x47 0x91 0x28 0x92 0x4c
-                    DB      0x83 0x0c 0x93 0x20 0x91 0x34 0x06 0x83 0x06 0x90 0x45 0x91 0x2d
-                    DB      0x92 0x48 0x0c 0x93 0x20 0x91 0x39 0x0c 0x90 0x40 0x91 0x2d
-                    DB      0x92 0x45 0x83 0x0c 0x93 0x20 0x91 0x39 0x0c 0x90 0x45 0x91 0x2d
-                    DB      0x92 0x40 0x83 0x0c 0x93 0x20 0x91 0x39 0x0c 0x90 0x20 0xd0 0xa1 0x5a
-
-music_a_2_Midi23    EQU     0x5aa1
-music_a_2_Midi23    DB      0x91 0x2f 0x82 0x83 0x06 0x80 0x06 0x90 0x20 0x91 0x30 0x0c
-                    DB      0x80 0x81 0xd0 0xa1 0x5b
-
-
-bach_prelude_Midi00 EQU     0x5ba1
-bach_prelude_Midi00 DB      0x90 0x30 0x0b 0x91 0x3c 0x0b 0x91 0x3f 0x0b 0x91 0x43 0x0b
-                    DB      0x91 0x3f 0x80 0x0b 0x90 0x3c 0x81 0x0b 0x90 0x3f 0x0b 0x90 0x3c
-                    DB      0x0b 0x90 0x37 0x0b 0x91 0x3c 0x80 0x0b 0x90 0x33 0x81 0x0b
-                    DB      0x91 0x3c 0x80 0x0b 0x90 0x30 0x81 0x0b 0x91 0x3c 0x0b 0x91 0x3f
-                    DB      0x0b 0x91 0x43 0x0b 0x91 0x3f 0x80 0x0b 0x90 0x3c 0x81 0x0b
-                    DB      0x90 0x3f 0x0b 0x90 0x3c 0x0b 0x90 0x37 0x0b 0x91 0x3c 0x80
-                    DB      0x0b 0x90 0x33 0x81 0x0b 0x91 0x3c 0x80 0x0b 0x90 0x30 0x81
-                    DB      0x0b 0x91 0x3c 0x0b 0xd0 0xa1 0x5c
-
-bach_prelude_Midi01 EQU     0x5ca1
-bach_prelude_Midi01 DB      0x91 0x41 0x0b 0x91 0x44 0x0b 0x91 0x41 0x80 0x0b 0x90 0x3c
-                    DB      0x81 0x0b 0x90 0x41 0x0b 0x90 0x3c 0x0b 0x90 0x38 0x0b 0x91 0x3c
-                    DB      0x80 0x0b 0x90 0x35 0x81 0x0b 0x91 0x3c 0x80 0x0b 0x90 0x30
-                    DB      0x81 0x0b 0x91 0x3c 0x0b 0x91 0x41 0x0b 0x91 0x44 0x0b 0x91 0x41
-                    DB      0x80 0x0b 0x90 0x3c 0x81 0x0b 0x90 0x41 0x0b 0x90 0x3c 0x0b
-                    DB      0x90 0x38 0x0b 0x91 0x3c 0x80 0x0b 0x90 0x35 0x81 0x0b 0x91 0x3c
-                    DB      0x80 0x0b 0x90 0x30 0x81 0x0b 0x91 0x3b 0x0b 0x91 0x3e 0x0b 0xd0 0xa1 0x5d
-
-bach_prelude_Midi02 EQU     0x5da1
-bach_prelude_Midi02 DB      0x91 0x41 0x0b 0x91 0x3e 0x80 0x0b 0x90 0x3b 0x81 0x0b 0x90 0x3e
-                    DB      0x0b 0x90 0x3b 0x0b 0x90 0x38 0x0b 0x91 0x3b 0x80 0x0b 0x90 0x35
-                    DB      0x81 0x0b 0x91 0x3b 0x80 0x0b 0x90 0x30 0x81 0x0b 0x91 0x3b
-                    DB      0x0b 0x91 0x3e 0x0b 0x91 0x41 0x0b 0x91 0x3e 0x80 0x0b 0x90 0x3b
-                    DB      0x81 0x0b 0x90 0x3e 0x0b 0x90 0x3b 0x0b 0x90 0x38 0x0b 0x91 0x3b
-                    DB      0x80 0x0b 0x90 0x35 0x81 0x0b 0x91 0x3b 0x80 0x0b 0x90 0x30
-                    DB      0x81 0x0b 0x91 0x37 0x0b 0x91 0x3c 0x0b 0x91 0x3f 0x0b 0xd0 0xa1 0x5e
-
-bach_prelude_Midi03 EQU     0x5ea1
-bach_prelude_Midi03 DB      0x91 0x3c 0x80 0x0b 0x90 0x37 0x81 0x0b 0x90 0x3c 0x0b 0x90 0x37
-                    DB      0x0b 0x90 0x33 0x0b 0x91 0x37 0x80 0x0b 0x90 0x30 0x81 0x0b
-                    DB      0x91 0x37 0x80 0x0b 0x90 0x2e 0x81 0x0b 0x91 0x37 0x0b 0x91 0x3c
-                    DB      0x0b 0x91 0x3f 0x0b 0x91 0x3c 0x80 0x0b 0x90 0x37 0x81 0x0b
-                    DB      0x90 0x3c 0x0b 0x90 0x37 0x0b 0x90 0x33 0x0b 0x91 0x37 0x80
-                    DB      0x0b 0x90 0x30 0x81 0x0b 0x91 0x37 0x80 0x0b 0x90 0x2c 0x81
-                    DB      0x0b 0x91 0x37 0x0b 0x91 0x3c 0x0b 0x91 0x3f 0x0b 0x91 0x3c
-                    DB      0x80 0xd0 0xa1 0x5f
-
-bach_prelude_Midi04 EQU     0x5fa1
-bach_prelude_Midi04 DB      0x0b 0x90 0x37 0x81 0x0b 0x90 0x3c 0x0b 0x90 0x37 0x0b 0x90 0x33
-                    DB      0x0b 0x91 0x37 0x80 0x0b 0x90 0x30 0x81 0x0b 0x91 0x37 0x80
-                    DB      0x0b 0x90 0x2b 0x81 0x0b 0x91 0x37 0x0b 0x91 0x3c 0x0b 0x91 0x3f
-                    DB      0x0b 0x91 0x3c 0x80 0x0b 0x90 0x37 0x81 0x0b 0x90 0x3c 0x0b
-                    DB      0x90 0x37 0x0b 0x90 0x33 0x0b 0x91 0x37 0x80 0x0b 0x90 0x30
-                    DB      0x81 0x0b 0x91 0x37 0x80 0x0b 0x90 0x2a 0x81 0x0b 0x91 0x39
-                    DB      0x0b 0x91 0x3c 0x0b 0x91 0x3f 0x0b 0x91 0x3c 0x80 0x0b 0x90 0x39 0xd0 0xa1 0x60
-
-bach_prelude_Midi05 EQU     0x60a1
-bach_prelude_Midi05 DB      0x81 0x0b 0x90 0x3c 0x0b 0x90 0x39 0x0b 0x90 0x33 0x0b 0x91 0x39
-                    DB      0x80 0x0b 0x90 0x30 0x81 0x0b 0x91 0x39 0x80 0x0b 0x90 0x2a
-                    DB      0x81 0x0b 0x91 0x39 0x0b 0x91 0x3c 0x0b 0x91 0x3f 0x0b 0x91 0x3c
-                    DB      0x80 0x0b 0x90 0x39 0x81 0x0b 0x90 0x3c 0x0b 0x90 0x39 0x0b
-                    DB      0x90 0x36 0x0b 0x91 0x39 0x80 0x0b 0x90 0x32 0x81 0x0b 0x91 0x39
-                    DB      0x80 0x0b 0x90 0x2b 0x81 0x0b 0x91 0x39 0x0b 0x91 0x3a 0x0b
-                    DB      0x91 0x3e 0x0b 0x91 0x3a 0x80 0x0b 0x90 0x39 0x81 0x0b 0x90 0x3a 0xd0 0xa1 0x61
-
-bach_prelude_Midi06 EQU     0x61a1
-bach_prelude_Midi06 DB      0x0b 0x90 0x39 0x0b 0x90 0x32 0x0b 0x91 0x39 0x80 0x0b 0x90 0x2e
-                    DB      0x81 0x0b 0x91 0x39 0x80 0x0b 0x90 0x2b 0x81 0x0b 0x91 0x37
-                    DB      0x0b 0x91 0x3a 0x0b 0x91 0x3e 0x0b 0x91 0x3a 0x80 0x0b 0x90 0x37
-                    DB      0x81 0x0b 0x90 0x3a 0x0b 0x90 0x37 0x0b 0x90 0x2e 0x0b 0x91 0x37
-                    DB      0x80 0x0b 0x90 0x2b 0x81 0x0b 0x91 0x37 0x80 0x0b 0x90 0x27
-                    DB      0x81 0x0b 0x91 0x3a 0x0b 0x91 0x3e 0x0b 0x91 0x43 0x0b 0x91 0x3e
-                    DB      0x80 0x0b 0x90 0x3a 0x81 0x0b 0x90 0x3e 0x0b 0x90 0x3a 0xd0 0xa1 0x62
-
-bach_prelude_Midi07 EQU     0x62a1
-bach_prelude_Midi07 DB      0x0b 0x90 0x37 0x0b 0x91 0x3a 0x80 0x0b 0x90 0x33 0x81 0x0b
-                    DB      0x91 0x3a 0x80 0x0b 0x90 0x30 0x81 0x0b 0x91 0x39 0x0b 0x91 0x3f
-                    DB      0x0b 0x91 0x43 0x0b 0x91 0x3f 0x80 0x0b 0x90 0x39 0x81 0x0b
-                    DB      0x90 0x3f 0x0b 0x90 0x39 0x0b 0x90 0x30 0x0b 0x91 0x39 0x80
-                    DB      0x0b 0x90 0x2d 0x81 0x0b 0x91 0x39 0x80 0x0b 0x90 0x26 0x81
-                    DB      0x0b 0x91 0x39 0x0b 0x91 0x3c 0x0b 0x91 0x42 0x0b 0x91 0x3c
-                    DB      0x80 0x0b 0x90 0x39 0x81 0x0b 0x90 0x3c 0x0b 0x90 0x39 0x0b
-                    DB      0x90 0x32 0xd0 0xa1 0x63
-
-bach_prelude_Midi08 EQU     0x63a1
-bach_prelude_Midi08 DB      0x0b 0x91 0x39 0x80 0x0b 0x90 0x2d 0x81 0x0b 0x91 0x39 0x80
-                    DB      0x0b 0x90 0x26 0x81 0x0b 0x91 0x39 0x0b 0x91 0x3c 0x0b 0x91 0x42
-                    DB      0x0b 0x91 0x3c 0x80 0x0b 0x90 0x39 0x81 0x0b 0x90 0x3c 0x0b
-                    DB      0x90 0x39 0x0b 0x90 0x32 0x0b 0x91 0x39 0x80 0x0b 0x90 0x2d
-                    DB      0x81 0x0b 0x91 0x39 0x80 0x0b 0x90 0x26 0x81 0x0b 0x91 0x3a
-                    DB      0x0b 0x91 0x3e 0x0b 0x91 0x43 0x0b 0x91 0x3e 0x80 0x0b 0x90 0x3a
-                    DB      0x81 0x0b 0x90 0x3e 0x0b 0x90 0x3a 0x0b 0x90 0x32 0x0b 0x91 0x3a 0xd0 0xa1 0x64
-
-bach_prelude_Midi09 EQU     0x64a1
-bach_prelude_Midi09 DB      0x80 0x0b 0x90 0x2e 0x81 0x0b 0x91 0x3a 0x80 0x0b 0x90 0x26
-                    DB      0x81 0x0b 0x91 0x3c 0x0b 0x91 0x42 0x0b 0x91 0x45 0x0b 0x91 0x42
-                    DB      0x80 0x0b 0x90 0x3c 0x81 0x0b 0x90 0x42 0x0b 0x90 0x3c 0x0b
-                    DB      0x90 0x33 0x0b 0x91 0x3c 0x80 0x0b 0x90 0x30 0x81 0x0b 0x91 0x3c
-                    DB      0x80 0x0b 0x90 0x26 0x81 0x0b 0x91 0x3e 0x0b 0x91 0x43 0x0b
-                    DB      0x91 0x46 0x0b 0x91 0x43 0x80 0x0b 0x90 0x3e 0x81 0x0b 0x90 0x43
-                    DB      0x0b 0x90 0x3e 0x0b 0x90 0x37 0x0b 0x91 0x3e 0x80 0x0b 0xd0 0xa1 0x65
-
-bach_prelude_Midi10 EQU     0x65a1
-bach_prelude_Midi10 DB      0x90 0x32 0x81 0x0b 0x91 0x3e 0x80 0x0b 0x90 0x26 0x81 0x0b
-                    DB      0x91 0x3e 0x0b 0x91 0x42 0x0b 0x91 0x48 0x0b 0x91 0x42 0x80
-                    DB      0x0b 0x90 0x3e 0x81 0x0b 0x90 0x42 0x0b 0x90 0x3e 0x0b 0x90 0x39
-                    DB      0x0b 0x91 0x3e 0x80 0x0b 0x90 0x36 0x81 0x0b 0x91 0x3e 0x80
-                    DB      0x0b 0x90 0x26 0x81 0x0b 0x91 0x3d 0x0b 0x91 0x43 0x0b 0x91 0x46
-                    DB      0x0b 0x91 0x43 0x80 0x0b 0x90 0x3d 0x81 0x0b 0x90 0x43 0x0b
-                    DB      0x90 0x3d 0x0b 0x90 0x37 0x0b 0x91 0x3d 0x80 0x0b 0x90 0x33
-                    DB      0x81 0xd0 0xa1 0x66
-
-bach_prelude_Midi11 EQU     0x66a1
-bach_prelude_Midi11 DB      0x0b 0x91 0x3d 0x80 0x0b 0x90 0x26 0x81 0x0b 0x91 0x3c 0x0b
-                    DB      0x91 0x3f 0x0b 0x91 0x45 0x0b 0x91 0x3f 0x80 0x0b 0x90 0x3c
-                    DB      0x81 0x0b 0x90 0x3f 0x0b 0x90 0x3c 0x0b 0x90 0x36 0x0b 0x91 0x3c
-                    DB      0x80 0x0b 0x90 0x32 0x81 0x0b 0x91 0x3c 0x80 0x0b 0x90 0x26
-                    DB      0x81 0x0b 0x91 0x3a 0x0b 0x91 0x40 0x0b 0x91 0x43 0x0b 0x91 0x40
-                    DB      0x80 0x0b 0x90 0x3a 0x81 0x0b 0x90 0x40 0x0b 0x90 0x3a 0x0b
-                    DB      0x90 0x34 0x0b 0x91 0x3a 0x80 0x0b 0x90 0x31 0x81 0x0b 0x91 0x3a 0xd0 0xa1 0x67
-
-bach_prelude_Midi12 EQU     0x67a1
-bach_prelude_Midi12 DB      0x80 0x0b 0x90 0x26 0x81 0x0b 0x91 0x39 0x0b 0x91 0x3c 0x0b
-                    DB      0x91 0x43 0x0b 0x91 0x3c 0x80 0x0b 0x90 0x39 0x81 0x0b 0x90 0x3c
-                    DB      0x0b 0x90 0x39 0x0b 0x90 0x33 0x0b 0x91 0x39 0x80 0x0b 0x90 0x30
-                    DB      0x81 0x0b 0x91 0x39 0x80 0x0b 0x90 0x26 0x81 0x0b 0x91 0x39
-                    DB      0x0b 0x91 0x3c 0x0b 0x91 0x42 0x0b 0x91 0x3c 0x80 0x0b 0x90 0x39
-                    DB      0x81 0x0b 0x90 0x3c 0x0b 0x90 0x39 0x0b 0x90 0x32 0x0b 0x91 0x39
-                    DB      0x80 0x0b 0x90 0x2d 0x81 0x0b 0x91 0x39 0x80 0x0b 0x90 0x26 0xd0 0xa1 0x68
-
-bach_prelude_Midi13 EQU     0x68a1
-bach_prelude_Midi13 DB      0x81 0x0b 0x91 0x37 0x0b 0x91 0x3a 0x0b 0x91 0x40 0x0b 0x91 0x3a
-                    DB      0x80 0x0b 0x90 0x37 0x81 0x0b 0x90 0x3a 0x0b 0x90 0x37 0x0b
-                    DB      0x90 0x31 0x0b 0x91 0x37 0x80 0x0b 0x90 0x2e 0x81 0x0b 0x91 0x37
-                    DB      0x80 0x0b 0x90 0x26 0x81 0x0b 0x91 0x36 0x0b 0x91 0x39 0x0b
-                    DB      0x91 0x3f 0x0b 0x91 0x39 0x80 0x0b 0x90 0x36 0x81 0x0b 0x90 0x39
-                    DB      0x0b 0x90 0x36 0x0b 0x90 0x30 0x0b 0x91 0x36 0x80 0x0b 0x90 0x2d
-                    DB      0x81 0x0b 0x91 0x36 0x80 0x0b 0x90 0x26 0x81 0x0b 0xd0 0xa1 0x69
-
-bach_prelude_Midi14 EQU     0x69a1
-bach_prelude_Midi14 DB      0x91 0x37 0x0b 0x91 0x3a 0x0b 0x91 0x3e 0x0b 0x91 0x3a 0x80
-                    DB      0x0b 0x90 0x37 0x81 0x0b 0x90 0x3a 0x0b 0x90 0x37 0x0b 0x90 0x2e
-                    DB      0x0b 0x91 0x37 0x80 0x0b 0x90 0x2b 0x81 0x0b 0x91 0x37 0x80
-                    DB      0x0b 0x90 0x26 0x81 0x0b 0x91 0x37 0x0b 0x91 0x39 0x0b 0x91 0x3c
-                    DB      0x0b 0x91 0x39 0x80 0x0b 0x90 0x37 0x81 0x0b 0x90 0x39 0x0b
-                    DB      0x90 0x37 0x0b 0x90 0x33 0x0b 0x91 0x37 0x80 0x0b 0x90 0x30
-                    DB      0x81 0x0b 0x91 0x37 0x80 0x0b 0x90 0x26 0x81 0x0b 0x91 0x36
-                    DB      0x0b 0xd0 0xa1 0x6a
-
-bach_prelude_Midi15 EQU     0x6aa1
-bach_prelude_Midi15 DB      0x91 0x39 0x0b 0x91 0x3c 0x0b 0x91 0x39 0x80 0x0b 0x90 0x36
-                    DB      0x81 0x0b 0x90 0x39 0x0b 0x90 0x36 0x0b 0x90 0x32 0x0b 0x91 0x36
-                    DB      0x80 0x0b 0x90 0x2d 0x81 0x0b 0x91 0x36 0x80 0x0b 0x90 0x2b
-                    DB      0x81 0x0b 0x91 0x36 0x0b 0x91 0x39 0x0b 0x91 0x3c 0x0b 0x91 0x39
-                    DB      0x80 0x0b 0x90 0x36 0x81 0x0b 0x90 0x39 0x0b 0x90 0x36 0x0b
-                    DB      0x90 0x33 0x0b 0x91 0x36 0x80 0x0b 0x90 0x30 0x81 0x0b 0x91 0x36
-                    DB      0x80 0x0b 0x90 0x2b 0x81 0x0b 0x91 0x37 0x0b 0x91 0x39 0x0b 0xd0 0xa1 0x6b
-
-bach_prelude_Midi16 EQU     0x6ba1
-bach_prelude_Midi16 DB      0x91 0x3c 0x0b 0x91 0x3b 0x80 0x0b 0x90 0x37 0x81 0x0b 0x90 0x3b
-                    DB      0x0b 0x90 0x37 0x0b 0x90 0x32 0x0b 0x91 0x37 0x80 0x0b 0x90 0x2f
-                    DB      0x81 0x0b 0x91 0x37 0x80 0x0b 0x90 0x2b 0x81 0x0b 0x91 0x39
-                    DB      0x0b 0x91 0x3c 0x0b 0x91 0x42 0x0b 0x91 0x3c 0x80 0x0b 0x90 0x39
-                    DB      0x81 0x0b 0x90 0x3c 0x0b 0x90 0x39 0x0b 0x90 0x33 0x0b 0x91 0x39
-                    DB      0x80 0x0b 0x90 0x30 0x81 0x0b 0x91 0x39 0x80 0x0b 0x90 0x2b
-                    DB      0x81 0x0b 0x91 0x3c 0x0b 0x91 0x42 0x0b 0x91 0x45 0x0b 0xd0 0xa1 0x6c
-
-bach_prelude_Midi17 EQU     0x6ca1
-bach_prelude_Midi17 DB      0x91 0x42 0x80 0x0b 0x90 0x3c 0x81 0x0b 0x90 0x42 0x0b 0x90 0x3c
-                    DB      0x0b 0x90 0x33 0x0b 0x91 0x3c 0x80 0x0b 0x90 0x30 0x81 0x0b
-                    DB      0x91 0x3c 0x80 0x0b 0x90 0x2b 0x81 0x0b 0x91 0x3b 0x0b 0x91 0x3e
-                    DB      0x0b 0x91 0x43 0x0b 0x91 0x3e 0x80 0x0b 0x90 0x3b 0x81 0x0b
-                    DB      0x90 0x3e 0x0b 0x90 0x3b 0x0b 0x90 0x37 0x0b 0x91 0x3b 0x80
-                    DB      0x0b 0x90 0x32 0x81 0x0b 0x91 0x3b 0x80 0x0b 0x90 0x2b 0x81
-                    DB      0x0b 0x91 0x3b 0x0b 0x91 0x3e 0x0b 0x91 0x41 0x0b 0x91 0x3e
-                    DB      0x80 0xd0 0xa1 0x6d
-
-bach_prelude_Midi18 EQU     0x6da1
-bach_prelude_Midi18 DB      0x0b 0x90 0x3b 0x81 0x0b 0x90 0x3e 0x0b 0x90 0x3b 0x0b 0x90 0x38
-                    DB      0x0b 0x91 0x3b 0x80 0x0b 0x90 0x35 0x81 0x0b 0x91 0x3b 0x80
-                    DB      0x0b 0x90 0x2b 0x81 0x0b 0x91 0x37 0x0b 0x91 0x3c 0x0b 0x91 0x3f
-                    DB      0x0b 0x91 0x3c 0x80 0x0b 0x90 0x37 0x81 0x0b 0x90 0x3c 0x0b
-                    DB      0x90 0x37 0x0b 0x90 0x33 0x0b 0x91 0x37 0x80 0x0b 0x90 0x30
-                    DB      0x81 0x0b 0x91 0x37 0x80 0x0b 0x90 0x2b 0x81 0x0c 0x91 0x36
-                    DB      0x0c 0x91 0x3c 0x0c 0x91 0x3f 0x0c 0x91 0x3c 0x80 0x0c 0x90 0x36 0xd0 0xa1 0x6e
-
-bach_prelude_Midi19 EQU     0x6ea1
-bach_prelude_Midi19 DB      0x81 0x0c 0x90 0x3c 0x0c 0x90 0x36 0x0c 0x90 0x33 0x0c 0x91 0x36
-                    DB      0x80 0x0c 0x90 0x30 0x81 0x0c 0x91 0x36 0x80 0x0c 0x90 0x2b
-                    DB      0x81 0x0c 0x91 0x36 0x0c 0x91 0x3c 0x0c 0x91 0x3f 0x0c 0x91 0x3c
-                    DB      0x80 0x0c 0x90 0x36 0x81 0x0c 0x90 0x3c 0x0c 0x90 0x36 0x0c
-                    DB      0x90 0x33 0x0c 0x91 0x36 0x80 0x0c 0x90 0x30 0x81 0x0c 0x91 0x36
-                    DB      0x80 0x0c 0x90 0x2b 0x81 0x0c 0x91 0x37 0x0c 0x91 0x3b 0x0c
-                    DB      0x91 0x3e 0x0c 0x91 0x3b 0x80 0x0d 0x90 0x37 0x81 0x0d 0x90 0x3b 0xd0 0xa1 0x6f
-
-bach_prelude_Midi20 EQU     0x6fa1
-bach_prelude_Midi20 DB      0x0d 0x90 0x3e 0x0d 0x90 0x3f 0x0f 0x90 0x3c 0x0f 0x90 0x39
-                    DB      0x12 0x90 0x42 0x12 0x90 0x3b 0x91 0x3e 0x92 0x43 0x93 0x2b
-                    DB      0x7f 0x80 0x81 0x82 0x83 0xd0 0xa1 0x70
-
-
-music_cMidi00       EQU     0x70a1
-music_cMidi00       DB      0x90 0x45 0x91 0x36 0x0d 0x90 0x49 0x81 0x0d 0x91 0x42 0x90 0x4e
-                    DB      0x0d 0x90 0x49 0x81 0x0d 0x91 0x41 0x90 0x44 0x0d 0x90 0x49
-                    DB      0x81 0x0d 0x91 0x36 0x90 0x45 0x0d 0x90 0x49 0x81 0x0d 0x91 0x38
-                    DB      0x90 0x42 0x0d 0x90 0x49 0x81 0x0d 0x91 0x3d 0x90 0x41 0x0d
-                    DB      0x90 0x49 0x81 0x0d 0x91 0x42 0x90 0x45 0x0d 0x90 0x49 0x81
-                    DB      0x0d 0x91 0x3e 0x90 0x4e 0x0d 0x90 0x49 0x81 0x0d 0x91 0x3d
-                    DB      0x90 0x44 0x0d 0x90 0x49 0x81 0x0d 0x91 0x42 0x90 0x45 0x0d
-                    DB      0x90 0x49 0x81 0x0d 0xd0 0xa1 0x71
-
-music_cMidi01       EQU     0x71a1
-music_cMidi01       DB      0x91 0x38 0x90 0x42 0x0d 0x90 0x49 0x81 0x0d 0x91 0x3d 0x90 0x41
-                    DB      0x0d 0x90 0x49 0x81 0x0d 0x91 0x36 0x90 0x45 0x0d 0x90 0x49
-                    DB      0x81 0x0d 0x91 0x42 0x90 0x45 0x0d 0x90 0x42 0x81 0x0d 0x91 0x3b
-                    DB      0x90 0x4a 0x0d 0x90 0x47 0x81 0x0d 0x91 0x34 0x90 0x44 0x0d
-                    DB      0x90 0x47 0x81 0x0d 0x91 0x40 0x90 0x44 0x0d 0x90 0x40 0x81
-                    DB      0x0d 0x91 0x39 0x90 0x49 0x0d 0x90 0x45 0x81 0x0d 0x91 0x32
-                    DB      0x90 0x42 0x0d 0x90 0x49 0x81 0x0d 0x91 0x3e 0x90 0x47 0x0d
-                    DB      0x90 0x45 0xd0 0xa1 0x72
-
-music_cMidi02       EQU     0x72a1
-music_cMidi02       DB      0x81 0x0d 0x91 0x3b 0x90 0x44 0x0d 0x90 0x42 0x81 0x0d 0x91 0x3d
-                    DB      0x90 0x41 0x0d 0x90 0x3e 0x91 0x3d 0x0d 0x90 0x3d 0x91 0x41
-                    DB      0x0d 0x90 0x3b 0x91 0x44 0x0d 0x90 0x39 0x91 0x49 0x0d 0x90 0x38
-                    DB      0x91 0x47 0x0d 0x90 0x36 0x91 0x45 0x0d 0x90 0x49 0x81 0x0d
-                    DB      0x91 0x42 0x90 0x4e 0x0d 0x90 0x49 0x81 0x0d 0x91 0x41 0x90 0x44
-                    DB      0x0d 0x90 0x49 0x81 0x0d 0x91 0x36 0x90 0x45 0x0d 0x90 0x49
-                    DB      0x81 0x0d 0x91 0x38 0x90 0x42 0x0d 0x90 0x49 0x81 0x0d 0xd0 0xa1 0x73
-
-music_cMidi03       EQU     0x73a1
-music_cMidi03       DB      0x91 0x3d 0x90 0x41 0x0d 0x90 0x49 0x81 0x0d 0x91 0x42 0x90 0x45
-                    DB      0x0d 0x90 0x49 0x81 0x0d 0x91 0x3e 0x90 0x4e 0x0d 0x90 0x49
-                    DB      0x81 0x0d 0x91 0x3d 0x90 0x44 0x0d 0x90 0x49 0x81 0x0d 0x91 0x42
-                    DB      0x90 0x45 0x0d 0x90 0x49 0x81 0x0d 0x91 0x38 0x90 0x42 0x0d
-                    DB      0x90 0x49 0x81 0x0d 0x91 0x3d 0x90 0x41 0x0d 0x90 0x49 0x81
-                    DB      0x0d 0x91 0x36 0x90 0x45 0x0d 0x90 0x49 0x81 0x0d 0x91 0x42
-                    DB      0x90 0x45 0x0d 0x90 0x42 0x81 0x0d 0x91 0x3b 0x90 0x4a 0x0d
-                    DB      0x90 0x47 0xd0 0xa1 0x74
-
-music_cMidi04       EQU     0x74a1
-music_cMidi04       DB      0x81 0x0d 0x91 0x34 0x90 0x44 0x0d 0x90 0x47 0x81 0x0d 0x91 0x40
-                    DB      0x90 0x44 0x0d 0x90 0x40 0x81 0x0d 0x91 0x38 0x90 0x4c 0x0d
-                    DB      0x90 0x47 0x81 0x0d 0x91 0x39 0x90 0x49 0x0d 0x90 0x4c 0x81
-                    DB      0x0d 0x91 0x3d 0x90 0x49 0x0d 0x90 0x45 0x81 0x0d 0x91 0x3d
-                    DB      0x90 0x40 0x0d 0x90 0x44 0x81 0x0d 0x91 0x39 0x90 0x45 0x0d
-                    DB      0x81 0x0d 0x91 0x34 0x0d 0x81 0x0d 0x91 0x2d 0x0d 0x81 0x0d
-                    DB      0x90 0x3d 0x91 0x4c 0x0d 0x90 0x40 0x91 0x4a 0x0d 0x90 0x45
-                    DB      0x91 0x49 0xd0 0xa1 0x75
-
-music_cMidi05       EQU     0x75a1
-music_cMidi05       DB      0x0d 0x90 0x40 0x91 0x47 0x0d 0x90 0x3b 0x91 0x45 0x0d 0x90 0x40
-                    DB      0x91 0x44 0x0d 0x90 0x3d 0x91 0x45 0x0d 0x90 0x40 0x91 0x47
-                    DB      0x0d 0x90 0x39 0x91 0x49 0x0d 0x90 0x40 0x91 0x45 0x0d 0x90 0x38
-                    DB      0x91 0x47 0x0d 0x90 0x40 0x91 0x4a 0x0d 0x90 0x39 0x91 0x49
-                    DB      0x0d 0x90 0x40 0x91 0x4a 0x0d 0x90 0x45 0x91 0x4c 0x0d 0x90 0x40
-                    DB      0x81 0x0d 0x91 0x44 0x90 0x3b 0x0d 0x90 0x40 0x81 0x0d 0x91 0x45
-                    DB      0x90 0x3d 0x0d 0x90 0x47 0x91 0x40 0x0d 0x90 0x49 0xd0 0xa1 0x76
-
-music_cMidi06       EQU     0x76a1
-music_cMidi06       DB      0x91 0x39 0x0d 0x90 0x40 0x81 0x0d 0x91 0x47 0x90 0x38 0x0d
-                    DB      0x90 0x40 0x81 0x0d 0x91 0x49 0x90 0x3d 0x0d 0x90 0x40 0x81
-                    DB      0x0d 0x91 0x4e 0x90 0x3d 0x0d 0x90 0x39 0x81 0x0d 0x91 0x4b
-                    DB      0x90 0x42 0x0d 0x90 0x3f 0x81 0x0d 0x91 0x4e 0x90 0x3c 0x0d
-                    DB      0x90 0x50 0x91 0x3f 0x0d 0x90 0x51 0x91 0x38 0x0d 0x90 0x3f
-                    DB      0x81 0x0d 0x91 0x50 0x90 0x3c 0x0d 0x90 0x3f 0x81 0x0d 0x91 0x4e
-                    DB      0x90 0x3d 0x0d 0x90 0x4c 0x81 0x0d 0x91 0x44 0x90 0x4b 0x0d
-                    DB      0x90 0x49 0xd0 0xa1 0x77
-
-music_cMidi07       EQU     0x77a1
-music_cMidi07       DB      0x81 0x0d 0x91 0x38 0x90 0x4b 0x0d 0x90 0x48 0x81 0x0d 0x91 0x3d
-                    DB      0x90 0x49 0x0d 0x91 0x40 0x0d 0x91 0x44 0x0d 0x91 0x40 0x0d
-                    DB      0x91 0x3b 0x0d 0x91 0x40 0x0d 0x90 0x4c 0x91 0x3a 0x0d 0x91 0x3d
-                    DB      0x0d 0x91 0x36 0x0d 0x90 0x4e 0x91 0x3d 0x06 0x90 0x4f 0x06
-                    DB      0x90 0x3a 0x91 0x4e 0x0d 0x90 0x3d 0x0d 0x90 0x4c 0x91 0x3b
-                    DB      0x0d 0x90 0x4a 0x81 0x0d 0x90 0x4c 0x0d 0x90 0x49 0x0d 0x90 0x4a
-                    DB      0x0d 0x90 0x47 0x0d 0x91 0x3c 0x90 0x4e 0x0d 0x91 0x3f 0x0d 0xd0 0xa1 0x78
-
-music_cMidi08       EQU     0x78a1
-music_cMidi08       DB      0x91 0x38 0x0d 0x90 0x50 0x91 0x3f 0x06 0x90 0x51 0x06 0x90 0x3c
-                    DB      0x91 0x50 0x0d 0x90 0x3f 0x0d 0x90 0x4e 0x91 0x3d 0x0d 0x90 0x4d
-                    DB      0x81 0x0d 0x90 0x4e 0x0d 0x90 0x4b 0x0d 0x90 0x4d 0x0d 0x90 0x49
-                    DB      0x0d 0x91 0x3d 0x90 0x50 0x0d 0x90 0x4d 0x81 0x0d 0x91 0x38
-                    DB      0x90 0x49 0x0d 0x90 0x4d 0x81 0x0d 0x91 0x35 0x90 0x50 0x0d
-                    DB      0x90 0x53 0x81 0x0d 0x91 0x31 0x90 0x56 0x0d 0x90 0x4d 0x81
-                    DB      0x0d 0x91 0x33 0x90 0x55 0x0d 0x90 0x4d 0x81 0x0d 0x91 0x35 0xd0 0xa1 0x79
-
-music_cMidi09       EQU     0x79a1
-music_cMidi09       DB      0x90 0x53 0x0d 0x90 0x4d 0x81 0x0d 0x91 0x39 0x90 0x51 0x0d
-                    DB      0x80 0x81 0x0d 0x90 0x3b 0x91 0x53 0x0d 0x90 0x51 0x81 0x0d
-                    DB      0x91 0x3d 0x90 0x50 0x0d 0x90 0x51 0x81 0x0d 0x91 0x36 0x90 0x4e
-                    DB      0x03 0x90 0x50 0x03 0x90 0x4e 0x47 0x80 0x81 0xd0 0xa1 0x35
-
-
-
+title_screenMidi07  DB      0x2c 0x4d 0x93 0x2c 0xd1 0xbe 0x39 0x05 0x82 0xd1 0xc3 0x39 0x05
+                    DB      0x91 0x48 0xac 0x90 0x2c 0x93 0x2c 0xac 0x50 0x2e 0x3e 0x2c 0xa5
+                    DB      0x92 0x3f 0xa5 0x91 0x2e 0x3e 0xd1 0xf6 0x3b 0x05 0x2e 0x52 0x93 0x2c
+                    DB      0xd1 0xc5 0x38 0x0a 0x50 0xd1 0xd0 0x38 0x05 0x91 0x4d 0x33 0x2c 0xac
+                    DB      0x84 0xd1 0xa3 0x3a 0x05 0xac 0x33 0x4b 0x43 0x2c 0xd1 0xe4 0x37 0x05
+                    DB      0xd1 0xa2 0x3a 0x06 0xd1 0xe8 0x37 0x05 0x89 0xd0 0xa1 0x3d
+
+
+music_a_2_Midi00  EQU     0x3da1
+music_a_2_Midi00  DB      0x90 0x47 0x28 0x4c 0xab 0x91 0x34 0x93 0x20 0xab 0x88 0x44 0x28 0x47
+                  DB      0xab 0x90 0x45 0x34 0x48 0x20 0xab 0x88 0x47 0x28 0x4a
+                  DB      0xd1 0xa5 0x3d 0x05 0xa5 0x93 0x20 0xa5 0x88 0x45 0x28 0x48 0xab
+                  DB      0x90 0x44 0x34 0x47 0x20 0xa5 0x88 0xa5 0x40 0x2d 0x45 0xab 0x91 0x39
+                  DB      0x93 0x20 0xab 0x88 0x40 0x2d 0x45 0xab 0x90 0x45 0x39 0x48 0x20 0xab
+                  DB      0x88 0x48 0x2d 0x4c 0xd1 0xd2 0x3d 0x06 0x20 0x2d 0x47 0x4a 0xa5 0x81
+                  DB      0xa5 0x20 0x39 0x45 0x48 0xab 0x88 0x44 0x2c 0x47 0xd0 0xa1 0x3e
+
+music_a_2_Midi01  EQU     0x3ea1
+music_a_2_Midi01  DB      0xab 0x91 0x38 0x93 0x20 0xab 0x88 0x91 0x2c 0xab 0x90 0x45 0x38
+                  DB      0xd1 0xb3 0x3d 0x07 0xd1 0xa5 0x3d 0x05 0xd1 0xbe 0x3d 0x05 0x47
+                  DB      0xd1 0xa3 0x3d 0x07 0xa5 0x88 0xa5 0x45 0x2d 0x48 0xd1 0xd2 0x3d 0x0b
+                  DB      0xd1 0xd3 0x3d 0x0a 0xd1 0xd3 0x3d 0x05 0x8c 0x20 0x2f 0xa5 0x81 0xa5
+                  DB      0x90 0x20 0x30 0xab 0x81 0x91 0x32 0xab 0x90 0x20 0x26 0x41 0x4a 0xab
+                  DB      0x8f 0xab 0x20 0x26 0x45 0x4d 0xab 0x8a 0x48 0x92 0x51 0xab 0x90 0x48
+                  DB      0x26 0x93 0x20 0xa5 0x20 0x26 0x93 0x48 0xd0 0xa1 0x3f
+
+music_a_2_Midi02  EQU     0x3fa1
+music_a_2_Midi02  DB      0xa5 0x88 0x47 0x2d 0x4f 0xab 0x90 0x45 0x29 0x4d 0x20 0xa5 0x88 0xa5
+                  DB      0x43 0x24 0x4c 0xab 0x85 0x91 0x30 0x93 0x20 0xab 0x8a 0xab 0x20 0x30
+                  DB      0x40 0x48 0xab 0x8a 0x43 0x92 0x4c 0xab 0x90 0x45 0x24 0x93 0x20 0xa5
+                  DB      0x43 0x25 0xa5 0xd1 0xdf 0x3e 0x05 0xa5 0x81 0xa5 0x20 0x27 0x40 0x48
+                  DB      0xab 0x8a 0x44 0x92 0x47 0xab 0x81 0x91 0x3b 0x93 0x20
+                  DB      0xd1 0xd9 0x3f 0x06 0x90 0x45 0x3b 0x48 0x20 0xab 0x8a 0x47 0x92 0x4a
+                  DB      0xd1 0xa5 0x3d 0x05 0xa5 0x93 0x20 0xa5 0x8a 0xd0 0xa1 0x40
+
+music_a_2_Midi03  EQU     0x40a1
+music_a_2_Midi03  DB      0x47 0x92 0x4c 0xd1 0xa1 0x3e 0x05 0xd1 0xbf 0x3e 0x06
+                  DB      0xd1 0xa5 0x3d 0x07 0x40 0x2d 0x45 0xd1 0xa5 0x3d 0x07 0x40 0x2d 0x45
+                  DB      0xab 0x82 0x20 0xab 0x8c 0x20 0xa5 0x81 0xa5 0x90 0x20 0xab 0x90 0x4c
+                  DB      0x28 0x47 0xd1 0xa5 0x3d 0x15 0xd1 0xa5 0x3d 0x05 0xd1 0xbe 0x3d 0x29
+                  DB      0xd1 0xd2 0x3d 0x06 0xd1 0xeb 0x3d 0x10 0xd1 0xa1 0x3e 0x0d
+                  DB      0xd1 0xb3 0x3d 0x07 0xd1 0xa5 0x3d 0x05 0xd1 0xbe 0x3d 0x05 0x47
+                  DB      0xd1 0xa3 0x3d 0x07 0xd1 0xbf 0x3e 0x06 0xd1 0xd2 0x3d 0x0b
+                  DB      0xd0 0xa1 0x41
+
+music_a_2_Midi04  EQU     0x41a1
+music_a_2_Midi04  DB      0xd1 0xd3 0x3d 0x0a 0xd1 0xd3 0x3d 0x05 0xd1 0xd1 0x3e 0x2a
+                  DB      0xd1 0xa1 0x3f 0x2d 0xd1 0xdf 0x3e 0x05 0xd1 0xd2 0x3f 0x12
+                  DB      0xd1 0xd9 0x3f 0x06 0xd1 0xe8 0x3f 0x0a 0xd1 0xa5 0x3d 0x05
+                  DB      0xd1 0xf6 0x3f 0x05 0x47 0x92 0x4c 0xd1 0xa1 0x3e 0x05
+                  DB      0xd1 0xbf 0x3e 0x06 0xd1 0xa5 0x3d 0x07 0x40 0x2d 0x45
+                  DB      0xd1 0xa5 0x3d 0x07 0xd1 0xb7 0x40 0x0f 0x90 0x40 0x39 0x45 0xab
+                  DB      0x92 0x20 0x4c 0xab 0x88 0x92 0x45 0xab 0x92 0x4c 0x20 0xab 0x88 0x3c
+                  DB      0x92 0x45 0xab 0x92 0x4c 0xd0 0xa1 0x42
+
+music_a_2_Midi05  EQU     0x42a1
+music_a_2_Midi05  DB      0x20 0xd1 0xbe 0x3d 0x05 0xd1 0xed 0x41 0x06 0xa5 0x88 0xa5 0x38 0x3e
+                  DB      0x44 0xd1 0xe7 0x41 0x06 0x92 0x44 0xd1 0xef 0x41 0x06 0x91 0x3b 0x44
+                  DB      0xd1 0xef 0x41 0x05 0x92 0x20 0x44 0xa5 0x84 0xa5 0x92 0x20 0x4c 0xab
+                  DB      0x88 0x39 0x3c 0xd1 0xe6 0x41 0x0f 0x34 0xd1 0xe5 0x41 0x06 0xa5
+                  DB      0x92 0x20 0xa5 0x88 0x92 0x45 0xab 0x92 0x4c 0x20 0xa5 0x88 0xa5
+                  DB      0x91 0x38 0x44 0xd1 0xef 0x41 0x06 0x92 0x44 0xd1 0xef 0x41 0x06 0x3b
+                  DB      0x92 0x44 0xd1 0xef 0x41 0x05 0xd0 0xa1 0x43
+
+music_a_2_Midi06  EQU     0x43a1
+music_a_2_Midi06  DB      0xd1 0xc1 0x42 0x0c 0x40 0xd1 0xe6 0x41 0x0f 0x91 0x3c 0x45
+                  DB      0xd1 0xde 0x42 0x05 0x93 0x20 0xa5 0xd1 0xec 0x41 0x07
+                  DB      0xd1 0xaa 0x42 0x06 0xd1 0xe7 0x41 0x06 0x92 0x44 0xd1 0xef 0x41 0x06
+                  DB      0x91 0x3b 0x44 0xd1 0xef 0x41 0x05 0xd1 0xc1 0x42 0x0d
+                  DB      0xd1 0xe6 0x41 0x07 0x91 0x40 0x45 0xd1 0xef 0x41 0x06 0x91 0x45 0x45
+                  DB      0xd1 0xde 0x42 0x05 0x93 0x20 0xa5 0x88 0x91 0x45 0x45
+                  DB      0xd1 0xde 0x42 0x07 0x3e 0x44 0x44 0xd1 0xe7 0x41 0x06 0x92 0x44
+                  DB      0xd1 0xef 0x41 0x06 0xd0 0xa1 0x44
+
+music_a_2_Midi07  EQU     0x44a1
+music_a_2_Midi07  DB      0x92 0x44 0xd1 0xef 0x41 0x05 0xd1 0xc1 0x42 0x0a 0x83 0x92 0x47 0x4c
+                  DB      0xab 0x20 0x34 0xab 0x88 0x90 0x47 0x28 0x44 0xd1 0xaf 0x3d 0x0b
+                  DB      0xd1 0xa5 0x3d 0x05 0xd1 0xbe 0x3d 0x05 0x48 0x28 0x45
+                  DB      0xd1 0xc6 0x3d 0x17 0x90 0x48 0x39 0x45 0x20 0xab 0x88 0x4c 0x2d 0x48
+                  DB      0xd1 0xd2 0x3d 0x06 0xd1 0xeb 0x3d 0x10 0xd1 0xa1 0x3e 0x0a 0x90 0x48
+                  DB      0x38 0x45 0xd1 0xb4 0x3d 0x06 0xd1 0xa5 0x3d 0x05 0xd1 0xbe 0x3d 0x05
+                  DB      0x4c 0x28 0x47 0xd1 0xa5 0x3d 0x05 0xd0 0xa1 0x45
+
+music_a_2_Midi08  EQU     0x45a1
+music_a_2_Midi08  DB      0xd1 0xbf 0x3e 0x06 0xd1 0xd2 0x3d 0x0b 0xd1 0xd3 0x3d 0x0a
+                  DB      0xd1 0xd3 0x3d 0x05 0xd1 0xd1 0x3e 0x11 0x4a 0x41 0xd1 0xe4 0x3e 0x17
+                  DB      0xa5 0x88 0x4f 0x2d 0x47 0xab 0x90 0x4d 0x29 0x45 0xd1 0xab 0x3f 0x16
+                  DB      0x4c 0x92 0x43 0xab 0x91 0x24 0x45 0x20 0xa5 0x91 0x25 0x43 0xa5
+                  DB      0x90 0x20 0x26 0x41 0xd1 0xee 0x3d 0x05 0x27 0x48 0x40
+                  DB      0xd1 0xd9 0x3f 0x0b 0xd1 0xd9 0x3f 0x06 0x90 0x48 0x3b 0x45
+                  DB      0xd1 0xec 0x3f 0x06 0xd1 0xa5 0x3d 0x05 0xd1 0xf6 0x3f 0x05 0x47
+                  DB      0xd0 0xa1 0x46
+
+music_a_2_Midi09  EQU     0x46a1
+music_a_2_Midi09  DB      0x92 0x4c 0xd1 0xa1 0x3e 0x05 0xd1 0xbf 0x3e 0x06 0xd1 0xa5 0x3d 0x07
+                  DB      0x45 0x2d 0x40 0xd1 0xa5 0x3d 0x07 0x45 0x2d 0x40 0xd1 0xba 0x40 0x10
+                  DB      0xd1 0xa5 0x3d 0x12 0x4a 0x28 0x47 0xd1 0xa5 0x3d 0x05
+                  DB      0xd1 0xbe 0x3d 0x09 0x90 0x47 0x34 0x44 0xd1 0xcb 0x3d 0x19 0x4c 0x2d
+                  DB      0x48 0xd1 0xd2 0x3d 0x06 0x20 0x2d 0x4a 0x47 0xd1 0xef 0x3d 0x09 0x47
+                  DB      0x2c 0x44 0xd1 0xa1 0x3e 0x0d 0xd1 0xb3 0x3d 0x07 0xd1 0xa5 0x3d 0x05
+                  DB      0xd1 0xbe 0x3d 0x05 0x47 0xd1 0xa3 0x3d 0x07 0xd0 0xa1 0x47
+
+music_a_2_Midi10  EQU     0x47a1
+music_a_2_Midi10  DB      0xd1 0xbf 0x3e 0x06 0xd1 0xd2 0x3d 0x0b 0xd1 0xd3 0x3d 0x06 0x45 0x2d
+                  DB      0x40 0xd1 0xd2 0x3d 0x06 0xd1 0xd1 0x3e 0x0a 0x83 0xd0 0xa1 0x48
+
+
+bach_prelude_Midi00  EQU     0x48a1
+bach_prelude_Midi00  DB      0x90 0x30 0xaa 0x3c 0xaa 0x91 0x3f 0xaa 0x91 0x43 0xaa 0x81 0x91 0x3f
+                     DB      0xaa 0x82 0x90 0x3c 0xaa 0x90 0x3f 0xaa 0x90 0x3c 0xaa 0x90 0x37 0xaa
+                     DB      0x81 0x3c 0xaa 0x82 0x90 0x33 0xd1 0xbc 0x48 0x05 0x90 0x30
+                     DB      0xd1 0xa3 0x48 0x20 0xd1 0xbc 0x48 0x05 0x90 0x30 0xaa 0x3c 0xaa
+                     DB      0x91 0x41 0xaa 0x91 0x44 0xaa 0x81 0x91 0x41 0xd1 0xaf 0x48 0x05
+                     DB      0x90 0x41 0xaa 0x90 0x3c 0xaa 0x90 0x38 0xd1 0xbc 0x48 0x05 0x90 0x35
+                     DB      0xd1 0xbc 0x48 0x05 0xd1 0xd1 0x48 0x0e 0xd0 0xa1 0x49
+
+bach_prelude_Midi01  EQU     0x49a1
+bach_prelude_Midi01  DB      0xd1 0xaf 0x48 0x05 0xd1 0xe3 0x48 0x08 0xd1 0xbc 0x48 0x05 0x90 0x35
+                     DB      0xd1 0xbc 0x48 0x05 0x90 0x30 0xaa 0x3b 0xaa 0x91 0x3e 0xaa 0x91 0x41
+                     DB      0xaa 0x81 0x91 0x3e 0xaa 0x82 0x90 0x3b 0xaa 0x90 0x3e 0xaa 0x90 0x3b
+                     DB      0xaa 0x90 0x38 0xaa 0x81 0x3b 0xaa 0x82 0x90 0x35 0xd1 0xce 0x49 0x05
+                     DB      0xd1 0xb3 0x49 0x22 0xd1 0xce 0x49 0x05 0x90 0x30 0xaa 0x37 0xaa
+                     DB      0x91 0x3c 0xaa 0x91 0x3f 0xaa 0x81 0x91 0x3c 0xaa 0x82 0x90 0x37
+                     DB      0xd1 0xb6 0x48 0x07 0x90 0x33 0xaa 0x81 0xd0 0xa1 0x4a
+
+bach_prelude_Midi02  EQU     0x4aa1
+bach_prelude_Midi02  DB      0x37 0xaa 0x82 0x90 0x30 0xaa 0x81 0x37 0xaa 0x82 0x90 0x2e
+                     DB      0xd1 0xe3 0x49 0x10 0xd1 0xb6 0x48 0x07 0x90 0x33 0xd1 0xa6 0x4a 0x05
+                     DB      0xd1 0xa4 0x4a 0x07 0x90 0x2c 0xd1 0xe3 0x49 0x10 0xd1 0xb6 0x48 0x07
+                     DB      0x90 0x33 0xd1 0xa6 0x4a 0x05 0xd1 0xa4 0x4a 0x07 0x90 0x2b
+                     DB      0xd1 0xe3 0x49 0x10 0xd1 0xb6 0x48 0x07 0x90 0x33 0xd1 0xa6 0x4a 0x05
+                     DB      0xd1 0xa4 0x4a 0x07 0x90 0x2a 0xaa 0x39 0xd1 0xe5 0x49 0x0c 0x90 0x39
+                     DB      0xaa 0x90 0x3c 0xaa 0x90 0x39 0xaa 0x90 0x33 0xaa 0xd0 0xa1 0x4b
+
+bach_prelude_Midi03  EQU     0x4ba1
+bach_prelude_Midi03  DB      0x81 0x39 0xd1 0xa2 0x4a 0x06 0x39 0xaa 0x82 0x90 0x2a 0xaa 0x39
+                     DB      0xd1 0xe5 0x49 0x0c 0xd1 0xef 0x4a 0x09 0x90 0x36 0xaa 0x81 0x39 0xaa
+                     DB      0x82 0x90 0x32 0xd1 0xb8 0x4b 0x05 0x90 0x2b 0xaa 0x39 0xaa 0x91 0x3a
+                     DB      0xaa 0x91 0x3e 0xaa 0x81 0x91 0x3a 0xaa 0x82 0x90 0x39 0xaa 0x90 0x3a
+                     DB      0xaa 0x90 0x39 0xaa 0x90 0x32 0xd1 0xb8 0x4b 0x05 0x90 0x2e
+                     DB      0xd1 0xb8 0x4b 0x05 0x90 0x2b 0xaa 0x37 0xd1 0xc7 0x4b 0x0c 0x90 0x37
+                     DB      0xaa 0x90 0x3a 0xaa 0x90 0x37 0xaa 0x90 0x2e 0xd0 0xa1 0x4c
+
+bach_prelude_Midi04  EQU     0x4ca1
+bach_prelude_Midi04  DB      0xd1 0xa6 0x4a 0x05 0x90 0x2b 0xd1 0xa6 0x4a 0x05 0x90 0x27 0xaa 0x3a
+                     DB      0xaa 0x91 0x3e 0xd1 0xa8 0x48 0x05 0x91 0x3e 0xaa 0x82 0x90 0x3a 0xaa
+                     DB      0x90 0x3e 0xd1 0xf2 0x4b 0x07 0x81 0x3a 0xaa 0x82 0x90 0x33 0xaa 0x81
+                     DB      0x3a 0xd1 0xa2 0x4a 0x05 0x39 0xd1 0xa5 0x48 0x0c 0x90 0x39 0xaa
+                     DB      0x90 0x3f 0xaa 0x90 0x39 0xaa 0x90 0x30 0xd1 0xb8 0x4b 0x05 0x90 0x2d
+                     DB      0xd1 0xb8 0x4b 0x05 0x90 0x26 0xaa 0x39 0xaa 0x91 0x3c 0xaa 0x91 0x42
+                     DB      0xd1 0xeb 0x49 0x06 0xd0 0xa1 0x4d
+
+bach_prelude_Midi05  EQU     0x4da1
+bach_prelude_Midi05  DB      0xd1 0xef 0x4a 0x09 0x90 0x32 0xd1 0xb8 0x4b 0x05 0x90 0x2d
+                     DB      0xd1 0xb8 0x4b 0x05 0xd1 0xea 0x4c 0x0a 0xd1 0xeb 0x49 0x06
+                     DB      0xd1 0xef 0x4a 0x09 0x90 0x32 0xd1 0xb8 0x4b 0x05 0x90 0x2d
+                     DB      0xd1 0xb8 0x4b 0x05 0x90 0x26 0xd1 0xad 0x4c 0x05 0xd1 0xa8 0x48 0x05
+                     DB      0xd1 0xb6 0x4c 0x09 0xaa 0x90 0x3a 0xaa 0x90 0x32 0xaa 0x81 0x3a 0xaa
+                     DB      0x82 0x90 0x2e 0xd1 0xdd 0x4d 0x05 0x90 0x26 0xaa 0x3c 0xaa 0x91 0x42
+                     DB      0xaa 0x91 0x45 0xaa 0x81 0x91 0x42 0xd1 0xaf 0x48 0x05 0xd0 0xa1 0x4e
+
+bach_prelude_Midi06  EQU     0x4ea1
+bach_prelude_Midi06  DB      0x90 0x42 0xaa 0x90 0x3c 0xaa 0x90 0x33 0xd1 0xbc 0x48 0x05 0x90 0x30
+                     DB      0xd1 0xbc 0x48 0x05 0x90 0x26 0xaa 0x3e 0xaa 0x91 0x43 0xaa 0x91 0x46
+                     DB      0xaa 0x81 0x91 0x43 0xaa 0x82 0x90 0x3e 0xaa 0x90 0x43 0xaa 0x90 0x3e
+                     DB      0xd1 0xb9 0x48 0x05 0x3e 0xaa 0x82 0x90 0x32 0xaa 0x81 0x3e 0xaa 0x82
+                     DB      0xd1 0xb3 0x4e 0x05 0x91 0x42 0xaa 0x91 0x48 0xaa 0x81 0x91 0x42
+                     DB      0xd1 0xc1 0x4e 0x05 0x90 0x42 0xaa 0x90 0x3e 0xaa 0x90 0x39
+                     DB      0xd1 0xd4 0x4e 0x05 0x90 0x36 0xd0 0xa1 0x4f
+
+bach_prelude_Midi07  EQU     0x4fa1
+bach_prelude_Midi07  DB      0xd1 0xd4 0x4e 0x05 0x90 0x26 0xaa 0x3d 0xd1 0xb7 0x4e 0x0c 0x90 0x3d
+                     DB      0xaa 0x90 0x43 0xaa 0x90 0x3d 0xd1 0xb9 0x48 0x05 0x3d
+                     DB      0xd1 0xc5 0x4c 0x06 0x3d 0xaa 0x82 0xd1 0xe8 0x4d 0x05 0x91 0x3f
+                     DB      0xd1 0xef 0x4d 0x05 0xd1 0xad 0x48 0x0d 0x90 0x36 0xd1 0xbc 0x48 0x05
+                     DB      0x90 0x32 0xd1 0xbc 0x48 0x05 0x90 0x26 0xaa 0x3a 0xaa 0x91 0x40
+                     DB      0xd1 0xa8 0x48 0x05 0x91 0x40 0xd1 0xb8 0x4c 0x05 0x90 0x40 0xaa
+                     DB      0x90 0x3a 0xaa 0x90 0x34 0xd1 0xdd 0x4d 0x05 0x90 0x31 0xd0 0xa1 0x50
+
+bach_prelude_Midi08  EQU     0x50a1
+bach_prelude_Midi08  DB      0xd1 0xdd 0x4d 0x05 0xd1 0xea 0x4c 0x08 0x91 0x43 0xd1 0xeb 0x49 0x06
+                     DB      0xd1 0xef 0x4a 0x0c 0x81 0x39 0xd1 0xa2 0x4a 0x06 0x39 0xaa 0x82
+                     DB      0xd1 0xea 0x4c 0x0a 0xd1 0xeb 0x49 0x06 0xd1 0xef 0x4a 0x09 0x90 0x32
+                     DB      0xd1 0xb8 0x4b 0x05 0x90 0x2d 0xd1 0xb8 0x4b 0x05 0x90 0x26 0xaa 0x37
+                     DB      0xaa 0x91 0x3a 0xaa 0x91 0x40 0xd1 0xcd 0x4b 0x06 0xd1 0xf0 0x4b 0x09
+                     DB      0x90 0x31 0xd1 0xa6 0x4a 0x07 0xd1 0xa6 0x4a 0x05 0x90 0x26 0xaa 0x36
+                     DB      0xaa 0x91 0x39 0xd1 0xe8 0x49 0x05 0xd0 0xa1 0x51
+
+bach_prelude_Midi09  EQU     0x51a1
+bach_prelude_Midi09  DB      0x91 0x39 0xaa 0x82 0x90 0x36 0xaa 0x90 0x39 0xaa 0x90 0x36 0xaa
+                     DB      0x90 0x30 0xaa 0x81 0x36 0xaa 0x82 0x90 0x2d 0xd1 0xb0 0x51 0x05
+                     DB      0xd1 0xd4 0x50 0x08 0xd1 0xcb 0x4b 0x08 0xd1 0xf0 0x4b 0x0b
+                     DB      0xd1 0xa6 0x4a 0x05 0x90 0x2b 0xd1 0xa6 0x4a 0x05 0xd1 0xd4 0x50 0x05
+                     DB      0x91 0x39 0xaa 0x91 0x3c 0xaa 0x81 0x91 0x39 0xaa 0x82 0x90 0x37 0xaa
+                     DB      0x90 0x39 0xaa 0x90 0x37 0xaa 0x90 0x33 0xd1 0xa6 0x4a 0x05
+                     DB      0xd1 0xa4 0x4a 0x07 0xd1 0xf0 0x50 0x07 0xd1 0xd7 0x51 0x09
+                     DB      0xd0 0xa1 0x52
+
+bach_prelude_Midi10  EQU     0x52a1
+bach_prelude_Midi10  DB      0xd1 0xa5 0x51 0x09 0x90 0x32 0xd1 0xb0 0x51 0x07 0xd1 0xb0 0x51 0x05
+                     DB      0x90 0x2b 0xd1 0xf2 0x50 0x05 0xd1 0xd7 0x51 0x09 0xd1 0xa5 0x51 0x09
+                     DB      0x90 0x33 0xd1 0xb0 0x51 0x05 0x90 0x30 0xd1 0xb0 0x51 0x05 0x90 0x2b
+                     DB      0xaa 0x37 0xaa 0xd1 0xd5 0x51 0x07 0x91 0x3b 0xd1 0xde 0x51 0x05
+                     DB      0x90 0x3b 0xaa 0x90 0x37 0xd1 0xda 0x4d 0x05 0x37 0xaa 0x82 0x90 0x2f
+                     DB      0xd1 0xa6 0x4a 0x05 0xd1 0xc3 0x4b 0x05 0xd1 0xef 0x4c 0x05
+                     DB      0xd1 0xeb 0x49 0x06 0xd1 0xef 0x4a 0x0c 0x81 0xd0 0xa1 0x53
+
+bach_prelude_Midi11  EQU     0x53a1
+bach_prelude_Midi11  DB      0x39 0xd1 0xa2 0x4a 0x06 0x39 0xaa 0x82 0x90 0x2b 0xd1 0xea 0x4d 0x0c
+                     DB      0xd1 0xaf 0x48 0x05 0xd1 0xa1 0x4e 0x08 0xd1 0xbc 0x48 0x05 0x90 0x30
+                     DB      0xd1 0xbc 0x48 0x05 0x90 0x2b 0xd1 0xb5 0x49 0x06 0x91 0x43
+                     DB      0xd1 0xbd 0x49 0x0f 0x90 0x37 0xd1 0xce 0x49 0x05 0x90 0x32
+                     DB      0xd1 0xce 0x49 0x05 0x90 0x2b 0xd1 0xb5 0x49 0x20 0xd1 0xce 0x49 0x05
+                     DB      0xd1 0xc9 0x52 0x05 0xd1 0xe6 0x49 0x0d 0xd1 0xb6 0x48 0x07 0x90 0x33
+                     DB      0xd1 0xa6 0x4a 0x05 0xd1 0xa4 0x4a 0x07 0x90 0x2b 0xd0 0xa1 0x54
+
+bach_prelude_Midi12  EQU     0x54a1
+bach_prelude_Midi12  DB      0xab 0x36 0xab 0x91 0x3c 0xab 0x91 0x3f 0xab 0x81 0x91 0x3c 0xab 0x82
+                     DB      0x90 0x36 0xab 0x90 0x3c 0xab 0x90 0x36 0xab 0x90 0x33 0xab 0x81 0x36
+                     DB      0xab 0x82 0x90 0x30 0xd1 0xba 0x54 0x05 0x90 0x2b 0xd1 0xa1 0x54 0x20
+                     DB      0xd1 0xba 0x54 0x05 0x90 0x2b 0xab 0x37 0xab 0x91 0x3b 0xab 0x91 0x3e
+                     DB      0xab 0x81 0x91 0x3b 0xac 0x82 0x90 0x37 0xac 0x90 0x3b 0xac 0x90 0x3e
+                     DB      0xac 0x90 0x3f 0xae 0x90 0x3c 0xae 0x90 0x39 0xb1 0x90 0x42 0xb1
+                     DB      0x90 0x3b 0x3e 0x43 0x2b 0xe0 0x7f 0xd0 0xa1 0x55
+
+bach_prelude_Midi13  EQU     0x55a1
+bach_prelude_Midi13  DB      0x8f 0xd0 0xa1 0x56
+
+
+music_cMidi00   EQU     0x56a1
+music_cMidi00   DB      0x90 0x45 0x36 0xac 0x82 0x90 0x49 0xac 0x90 0x4e 0x42
+                DB      0xd1 0xa4 0x56 0x05 0x90 0x44 0x41 0xd1 0xa4 0x56 0x05 0x90 0x45
+                DB      0xd1 0xa3 0x56 0x06 0x90 0x42 0x38 0xd1 0xa4 0x56 0x05 0x90 0x41 0x3d
+                DB      0xd1 0xa4 0x56 0x05 0x90 0x45 0x42 0xd1 0xa4 0x56 0x07 0x3e
+                DB      0xd1 0xa4 0x56 0x05 0x90 0x44 0x3d 0xd1 0xa4 0x56 0x05 0x90 0x45 0x42
+                DB      0xd1 0xa4 0x56 0x05 0x90 0x42 0x38 0xd1 0xa4 0x56 0x05 0x90 0x41 0x3d
+                DB      0xd1 0xa4 0x56 0x05 0x90 0x45 0xd1 0xa3 0x56 0x06 0x90 0x45
+                DB      0xd0 0xa1 0x57
+
+music_cMidi01   EQU     0x57a1
+music_cMidi01   DB      0x42 0xac 0x82 0x90 0x42 0xac 0x90 0x4a 0x3b 0xac 0x82 0x90 0x47 0xac
+                DB      0x90 0x44 0x34 0xd1 0xaa 0x57 0x07 0x40 0xac 0x82 0x90 0x40 0xac
+                DB      0x90 0x49 0x39 0xac 0x82 0x90 0x45 0xac 0x90 0x42 0x32
+                DB      0xd1 0xa4 0x56 0x05 0x90 0x47 0x3e 0xd1 0xbf 0x57 0x05 0x90 0x44 0x3b
+                DB      0xd1 0xa2 0x57 0x05 0x90 0x41 0x3d 0xac 0x90 0x3e 0x3d 0xac 0x90 0x3d
+                DB      0x41 0xac 0x90 0x3b 0x44 0xac 0x90 0x39 0x49 0xac 0x90 0x38 0x47 0xac
+                DB      0x90 0x36 0x45 0xd1 0xa4 0x56 0x08 0xd0 0xa1 0x58
+
+music_cMidi02   EQU     0x58a1
+music_cMidi02   DB      0xd1 0xa4 0x56 0x05 0x90 0x44 0x41 0xd1 0xa4 0x56 0x05 0x90 0x45
+                DB      0xd1 0xa3 0x56 0x06 0x90 0x42 0x38 0xd1 0xa4 0x56 0x05 0x90 0x41 0x3d
+                DB      0xd1 0xa4 0x56 0x05 0x90 0x45 0x42 0xd1 0xa4 0x56 0x07 0x3e
+                DB      0xd1 0xa4 0x56 0x05 0x90 0x44 0x3d 0xd1 0xa4 0x56 0x05 0x90 0x45 0x42
+                DB      0xd1 0xa4 0x56 0x05 0x90 0x42 0x38 0xd1 0xa4 0x56 0x05 0x90 0x41 0x3d
+                DB      0xd1 0xa4 0x56 0x05 0x90 0x45 0xd1 0xa3 0x56 0x06 0x90 0x45
+                DB      0xd1 0xa1 0x57 0x11 0xd1 0xaa 0x57 0x07 0xd0 0xa1 0x59
+
+music_cMidi03   EQU     0x59a1
+music_cMidi03   DB      0xd1 0xb6 0x57 0x06 0x90 0x4c 0x38 0xd1 0xaa 0x57 0x05
+                DB      0xd1 0xbc 0x57 0x05 0x90 0x4c 0xac 0x90 0x49 0x3d 0xd1 0xbf 0x57 0x05
+                DB      0x90 0x40 0x3d 0xac 0x82 0x90 0x44 0xac 0x90 0x45 0x39 0xac 0x82 0xac
+                DB      0x91 0x34 0xac 0x82 0xac 0x91 0x2d 0xac 0x82 0xac 0x90 0x3d 0x4c 0xac
+                DB      0x90 0x40 0x4a 0xac 0x90 0x45 0x49 0xac 0x90 0x40 0x47 0xac 0x90 0x3b
+                DB      0x45 0xac 0x90 0x40 0x44 0xac 0x90 0x3d 0x45 0xd1 0xdd 0x59 0x05
+                DB      0x90 0x39 0x49 0xac 0x90 0x40 0x45 0xd0 0xa1 0x5a
+
+music_cMidi04   EQU     0x5aa1
+music_cMidi04   DB      0xd1 0xec 0x57 0x05 0x90 0x40 0x4a 0xd1 0xe8 0x57 0x05
+                DB      0xd1 0xd6 0x59 0x06 0x4c 0xd1 0xb7 0x57 0x05 0x90 0x3b 0x44
+                DB      0xd1 0xb7 0x57 0x05 0x90 0x3d 0x45 0xac 0x90 0x47 0x40 0xac 0x90 0x49
+                DB      0x39 0xd1 0xb7 0x57 0x05 0x90 0x38 0x47 0xd1 0xb7 0x57 0x05 0x90 0x3d
+                DB      0x49 0xd1 0xb7 0x57 0x05 0x90 0x3d 0x4e 0xac 0x82 0x90 0x39 0xac
+                DB      0x90 0x42 0x4b 0xac 0x82 0x90 0x3f 0xac 0x90 0x3c 0x4e 0xac 0x90 0x50
+                DB      0x3f 0xac 0x90 0x51 0x38 0xd1 0xe4 0x5a 0x07 0x50 0xd0 0xa1 0x5b
+
+music_cMidi05   EQU     0x5ba1
+music_cMidi05   DB      0xd1 0xe4 0x5a 0x05 0xd1 0xd9 0x5a 0x05 0x90 0x4c 0xac 0x90 0x4b 0x44
+                DB      0xd1 0xa4 0x56 0x05 0x90 0x4b 0x38 0xac 0x82 0x90 0x48 0xac 0x90 0x49
+                DB      0x3d 0xac 0x91 0x40 0xac 0x91 0x44 0xac 0x91 0x40 0xac 0x91 0x3b 0xac
+                DB      0x91 0x40 0xac 0x90 0x4c 0x3a 0xac 0x91 0x3d 0xac 0x91 0x36 0xac
+                DB      0x90 0x4e 0x3d 0xa5 0x90 0x4f 0xa5 0x90 0x3a 0x4e 0xac 0x90 0x3d 0xac
+                DB      0x90 0x4c 0x3b 0xac 0x82 0x90 0x4a 0xac 0x90 0x4c 0xac 0x90 0x49 0xac
+                DB      0x90 0x4a 0xac 0x90 0x47 0xac 0xd0 0xa1 0x5c
+
+music_cMidi06   EQU     0x5ca1
+music_cMidi06   DB      0x90 0x4e 0x3c 0xac 0x91 0x3f 0xac 0x91 0x38 0xac 0x90 0x50 0x3f 0xa5
+                DB      0x90 0x51 0xa5 0x90 0x3c 0x50 0xac 0x90 0x3f 0xac 0x90 0x4e 0x3d 0xac
+                DB      0x82 0x90 0x4d 0xac 0x90 0x4e 0xac 0x90 0x4b 0xac 0x90 0x4d 0xac
+                DB      0x90 0x49 0xac 0x90 0x50 0xd1 0xbb 0x5c 0x06 0x90 0x49 0x38
+                DB      0xd1 0xbc 0x5c 0x05 0x90 0x50 0x35 0xac 0x82 0x90 0x53 0xac 0x90 0x56
+                DB      0x31 0xd1 0xbc 0x5c 0x05 0x90 0x55 0x33 0xd1 0xbc 0x5c 0x05 0x90 0x53
+                DB      0x35 0xd1 0xbc 0x5c 0x05 0x90 0x51 0x39 0xac 0xd0 0xa1 0x5d
+
+music_cMidi07   EQU     0x5da1
+music_cMidi07   DB      0x83 0xac 0x90 0x3b 0x53 0xac 0x82 0x90 0x51 0xac 0x90 0x50 0x3d
+                DB      0xd1 0xa6 0x5d 0x05 0x90 0x4e 0x36 0xa2 0x90 0x50 0xa2 0x90 0x4e
+                DB      0xe0 0x47 0x83 0xd0 0xa1 0x35
@@ -0,0 +1,129 @@
+
+/*
+ *  Default interface bindings, a copy of interface.json for ROMv1..v3.
+ *  Used when no interface file is loaded with compileBindings().
+ */
+
+struct binding {
+  const char *name;
+  int value;
+};
+
+static const struct binding defaultBindings[] = {
+  { "romTypeValue_ROMv1",    0x001c },
+  { "romTypeValue_ROMv2",    0x0020 },
+  { "romTypeValue_ROMv3",    0x0028 },
+  { "memSize",               0x0001 },
+  { "bootCount",             0x0004 },
+  { "entropy",               0x0006 },
+  { "videoY",                0x0009 },
+  { "frameCount",            0x000e },
+  { "serialRaw",             0x000f },
+  { "buttonState",           0x0011 },
+  { "xoutMask",              0x0014 },
+  { "vPC",                   0x0016 },
+  { "vAC",                   0x0018 },
+  { "vACH",                  0x0019 },
+  { "vLR",                   0x001a },
+  { "vSP",                   0x001c },
+  { "romType",               0x0021 },
+  { "sysFn",                 0x0022 },
+  { "sysArgs0",              0x0024 },
+  { "sysArgs1",              0x0025 },
+  { "sysArgs2",              0x0026 },
+  { "sysArgs3",              0x0027 },
+  { "sysArgs4",              0x0028 },
+  { "sysArgs5",              0x0029 },
+  { "sysArgs6",              0x002a },
+  { "sysArgs7",              0x002b },
+  { "soundTimer",            0x002c },
+  { "ledTimer",              0x002d },
+  { "ledState_v2",           0x002e },
+  { "ledTempo",              0x002f },
+  { "userVars",              0x0030 },
+  { "videoTable",            0x0100 },
+  { "vReset",                0x01f0 },
+  { "userCode",              0x0200 },
+  { "soundTable",            0x0700 },
+  { "screenMemory",          0x0800 },
+  { "channel1",              0x0100 },
+  { "channel2",              0x0200 },
+  { "channel3",              0x0300 },
+  { "channel4",              0x0400 },
+  { "wavA",                  250 },
+  { "wavX",                  251 },
+  { "keyL",                  252 },
+  { "keyH",                  253 },
+  { "oscL",                  254 },
+  { "oscH",                  255 },
+  { "maxTicks",              14 },
+  { "LDWI",                  0x0311 },
+  { "LD",                    0x031a },
+  { "LDW",                   0x0321 },
+  { "STW",                   0x032b },
+  { "BCC",                   0x0335 },
+  { "EQ",                    0x033f },
+  { "GT",                    0x034d },
+  { "LT",                    0x0350 },
+  { "GE",                    0x0353 },
+  { "LE",                    0x0356 },
+  { "LDI",                   0x0359 },
+  { "ST",                    0x035e },
+  { "POP",                   0x0363 },
+  { "NE",                    0x0372 },
+  { "PUSH",                  0x0375 },
+  { "LUP",                   0x037f },
+  { "ANDI",                  0x0382 },
+  { "ORI",                   0x0388 },
+  { "XORI",                  0x038c },
+  { "BRA",                   0x0390 },
+  { "INC",                   0x0393 },
+  { "ADDW",                  0x0399 },
+  { "PEEK",                  0x03ad },
+  { "SYS",                   0x03b4 },
+  { "SUBW",                  0x03b8 },
+  { "DEF",                   0x03cd },
+  { "CALL",                  0x03cf },
+  { "ALLOC",                 0x03df },
+  { "ADDI",                  0x03e3 },
+  { "SUBI",                  0x03e6 },
+  { "LSLW",                  0x03e9 },
+  { "STLW",                  0x03ec },
+  { "LDLW",                  0x03ee },
+  { "POKE",                  0x03f0 },
+  { "DOKE",                  0x03f3 },
+  { "DEEK",                  0x03f6 },
+  { "ANDW",                  0x03f8 },
+  { "ORW",                   0x03fa },
+  { "XORW",                  0x03fc },
+  { "RET",                   0x03ff },
+  { "SYS_Exec_88",           0x00ad },
+  { "SYS_Out_22",            0x00f4 },
+  { "SYS_In_24",             0x00f9 },
+  { "SYS_Random_34",         0x04a7 },
+  { "SYS_LSRW7_30",          0x04b9 },
+  { "SYS_LSRW8_24",          0x04c6 },
+  { "SYS_LSLW8_24",          0x04cd },
+  { "SYS_Draw4_30",          0x04d4 },
+  { "SYS_VDrawBits_134",     0x04e1 },
+  { "SYS_LSRW1_48",          0x0600 },
+  { "SYS_LSRW2_52",          0x0619 },
+  { "SYS_LSRW3_52",          0x0636 },
+  { "SYS_LSRW4_50",          0x0652 },
+  { "SYS_LSRW5_50",          0x066d },
+  { "SYS_LSRW6_48",          0x0687 },
+  { "SYS_LSLW4_46",          0x06a0 },
+  { "SYS_Read3_40",          0x06b9 },
+  { "SYS_Unpack_56",         0x06c0 },
+  { "font32up",              0x0700 },
+  { "font82up",              0x0800 },
+  { "notesTable",            0x0900 },
+  { "invTable",              0x0a00 },
+  { "SYS_SetMode_v2_80",     0x0b00 },
+  { "SYS_SetMemory_v2_54",   0x0b03 },
+  { "SYS_SendSerial1_v3_80", 0x0b06 },
+  { "SYS_Sprite6_v3_64",     0x0c00 },
+  { "SYS_Sprite6x_v3_64",    0x0c40 },
+  { "SYS_Sprite6y_v3_64",    0x0c80 },
+  { "SYS_Sprite6xy_v3_64",   0x0cc0 },
+};
@@ -1,7 +1,9 @@
 
 #include <ctype.h>
+#include <stdarg.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "bindings.h"
@@ -13,258 +15,741 @@
  |      Definitions                                                     |
  +----------------------------------------------------------------------*/
 
-typedef enum {
-  endType, openType, closeType, wordType, condType, loopType
-} WordType_t;
+#define maxName     64
+#define maxSymbols  4096
+#define maxRefs     8192
+#define maxVars     128
+#define maxBlocks   4096
+#define maxDepth    64
+#define maxWord     256
+#define maxObject   0x20000
+
+#define programName "Main"  // Same as compilegcl.py, for label names
+
+// Symbol from the interface bindings or a label defined by the compiler
+struct symbol {
+  char name[maxName];
+  int value;
+};
+
+// Forward reference to a symbol, low byte is xor'ed in at the end
+struct ref {
+  char name[maxName];
+  int where;
+};
 
-// Disected word 
+struct var {
+  char name[maxName];
+  int address;
+};
+
+// Disected word, see parseWord()
 struct word {
-  char prefix;      // optional
-  char *name;       // null in case of a number
-  int number;       // length in case of a name
-  char operator[3]; // or a conditional
+  char *name;       // Named variable, or null
+  bool hasIndex;    // Unnamed variable ('%' prefix)
+  int index;
+  bool hasNumber;   // Constant
+  int number;
+  char *operator;   // Everything after the name or number
 };
 
 /*----------------------------------------------------------------------+
  |      Variables                                                       |
  +----------------------------------------------------------------------*/
 
-char *cursor;
 char *compileError;
-int blockDepth;
-
-int base, offset, size;
-unsigned char page[256];
+static char errorBuffer[256];
+
+static struct symbol symbols[maxSymbols];
+static int symbolCount, bindingCount;
+static struct ref refs[maxRefs];
+static int refCount;
+static struct var vars[maxVars];
+static int varCount;
+
+static unsigned char object[maxObject];
+static int objectSize;
+
+static int lineNumber;
+static int comment;                     // Nesting level
+static int blocks[maxDepth], blockCount, blockId;
+static int loops[maxBlocks];            // block -> address of last do
+static int conds[maxBlocks];            // block -> label of continuation
+static int defs[maxBlocks];             // block -> address of last def
+static bool haveVersion;
+static bool needPatch;
+
+static int segStart, segEnd, segId;
+static int vPC;
+static int execute;
+static int zpSize;
 
 /*----------------------------------------------------------------------+
  |      Internal functions                                              |
  +----------------------------------------------------------------------*/
 
-/*
- *  Get the next word skipping whitespace and nested comments.
- *  Classify the word according to its structure.
- *  Generate an error message if malformed.
- *  Most work is done here already.
- */
-static WordType_t nextWord(struct word *word)
+static int error(const char *format, ...)
 {
-  #define hasMore\
-    (isprint(*cursor) && !strchr("[{", *cursor))
-
-  #define error(s)\
-    ((compileError = (s)), -1)
+  // Keep the first error only
+  if (compileError)
+    return -1;
+
+  int n = snprintf(errorBuffer, sizeof errorBuffer, "line %d: ", lineNumber);
+  va_list args;
+  va_start(args, format);
+  vsnprintf(errorBuffer + n, sizeof errorBuffer - n, format, args);
+  va_end(args);
+  compileError = errorBuffer;
+  return -1;
+}
 
-  memset(word, 0, sizeof *word);
+static struct symbol *findSymbol(const char *name)
+{
+  for (int i=symbolCount-1; i>=0; i--)
+    if (strcmp(symbols[i].name, name) == 0)
+      return &symbols[i];
+  return null;
+}
 
-  // Whitespace
-  while (1) {
-    // Spaces or newlines
-    if (strchr(" \n", *cursor) || strncmp("\r\n", cursor, 2)==0) {
-      cursor++;
-      continue;
-    }
-    // Comments
-    if (*cursor == '{') {
-      cursor++;
-      int depth = 1;
-      do {
-        if (*cursor == 0)      return error("Comment without end");
-        if (!isprint(*cursor)) return error("Invalid byte");
-        if (*cursor == '{')    depth++;
-        if (*cursor == '}')    depth--;
-        cursor++;
-      } while (depth > 0);
-      continue;
-    }
-    break;
+static int define(const char *name, int value)
+{
+  struct symbol *s = findSymbol(name);
+  if (!s) {
+    if (symbolCount >= maxSymbols)
+      return error("Too many symbols");
+    s = &symbols[symbolCount++];
+    snprintf(s->name, sizeof s->name, "%s", name);
   }
+  s->value = value;
+  return 0;
+}
 
-  // End of file/line
-  if (*cursor == 0) return endType;
+static int symbol(const char *name, int *value)
+{
+  struct symbol *s = findSymbol(name);
+  if (!s)
+    return error("Undefined symbol '%s'", name);
+  *value = s->value;
+  return 0;
+}
 
-  // Blocks
-  if (*cursor == '[') return cursor++, openType;
-  if (*cursor == ']') return cursor++, closeType;
+static int put(int byte)
+{
+  if (objectSize >= maxObject)
+    return error("Object too large");
+  object[objectSize++] = byte;
+  return 0;
+}
 
-  // Prefix
-  if (strchr("<>\\%", *cursor))
-    word->prefix = *cursor++;
+// Placeholder for the low byte of a symbol that is resolved in compileEnd()
+static int lo(const char *name)
+{
+  if (refCount >= maxRefs)
+    return error("Too many references");
+  snprintf(refs[refCount].name, maxName, "%s", name);
+  refs[refCount++].where = objectSize;
+  return put(0);
+}
 
-  // Word or number
-  char *s = strchr("-+", *cursor);
-  char sign = s ? *cursor++ : 0;
-  if (isdigit(*cursor)) {
-    // Decimal number (ignore overflows)
-    int n = 0;
-    do {
-      n = 10 * n + (*cursor - '0');
-      cursor++;
-    } while (isdigit(*cursor));
-    word->number = (sign == '-') ? -n : n;
-  } else if (*cursor == '$') {
-    // Hexadecimal number (ignore overflows)
-    int n = 0;
-    s = ++cursor;
-    while (1) {
-      if (isdigit(*cursor))
-        n = 16 * n + (*cursor - '0');
-      else if ('a' <= *cursor && *cursor <= 'f')
-        n = 16 * n + (*cursor - 'a');
-      else if ('A' <= *cursor && *cursor <= 'F')
-        n = 16 * n + (*cursor - 'A');
-      else
-        break;
-      cursor++;
-    }
-    if (cursor == s)
-      return error("Missing hex");
-    word->number = (sign == '-') ? -n : n;
-  } else if (sign)
-    return error("Sign without number");
-  else if (isalpha(*cursor)) {
-    // Name
-    word->name = cursor++;
-    while (isalnum(*cursor) || *cursor == '_')
-      cursor++;
-    word->number = cursor - word->name;
-  } else
-    return error("Invalid word");
-
-  // Conditionals
-  if (strncmp("if", word->name, 2)==0 && word->number == 2 &&
-      !word->prefix && !sign) {
-    int i = 0;
-    if (*cursor == '<')        word->operator[i++] = *cursor++;
-    if (*cursor == '>')        word->operator[i++] = *cursor++;
-    if (*cursor == '=' && i<2) word->operator[i++] = *cursor++;
-    if (i > 0 && *cursor++ == '0') {
-      if (strncmp(cursor, "loop", 4)==0)
-        cursor += 4;
-      if (!hasMore)
-        return condType;
-    }
-    return error("Invalid conditional");
+// Compiler generated label names
+static char *label(const char *kind, int a, int b)
+{
+  static char name[maxName];
+  if (b < 0)
+    snprintf(name, sizeof name, "$%s.%s.%d", programName, kind, a);
+  else
+    snprintf(name, sizeof name, "$%s.%s.%d.%d", programName, kind, a, b);
+  return name;
+}
+
+// Take vPC two bytes back, wrap around if needed to stay on page
+static int prev(int address, int step)
+{
+  return (address & 0xff00) | ((address - step) & 0x00ff);
+}
+
+static int zpByte(int len)
+{
+  int s = zpSize;
+  if (s <= 0x80 && 0x80 < s + len)
+    s = 0x81; // Keep 0x80 reserved
+  zpSize = s + len;
+  if (zpSize > 0x100)
+    return error("Out of zero page");
+  return s;
+}
+
+static int thisBlock(void)
+{
+  return blocks[blockCount-1];
+}
+
+static int closeSegment(void)
+{
+  if (blockCount > 1)
+    return error("Unterminated block");
+  if (vPC != segStart) {
+    if (define(label("seg", segId, -1), vPC - segStart))
+      return -1;
+    segId++;
   }
+  return 0;
+}
+
+static int org(int address)
+{
+  if (closeSegment())
+    return -1;
+  segStart = address;
+  vPC = address;
+  int page = address & ~255;
+  segEnd = page + ((0x100 <= page && page <= 0x400) ? 250 : 256);
+  return 0;
+}
+
+static int openSegment(void)
+{
+  int address = segStart;
+  if (execute < 0)
+    execute = address;
+  if (segId != 0 && address>>8 == 0)
+    return error("Zero-page segment can only be first");
+  if (put(address>>8) || put(address&255))
+    return -1;
+  return lo(label("seg", segId, -1));
+}
+
+static int emit(int byte)
+{
+  if (vPC >= segEnd)
+    return error("Out of code space");
+  if (byte < 0 || byte >= 256)
+    return error("Value out of range %d (must be 0..255)", byte);
+  if (segStart == vPC && openSegment())
+    return -1;
+  vPC++;
+  return put(byte);
+}
+
+// Next program byte is the low byte of a label
+static int emitLo(const char *name)
+{
+  if (vPC >= segEnd)
+    return error("Out of code space");
+  if (segStart == vPC && openSegment())
+    return -1;
+  vPC++;
+  return lo(name);
+}
 
-  // Operator
-  s = strchr("+-&|^=.,:;?!<", *cursor);
-  if (s) {
-    word->operator[0] = *cursor++;
-    if (cursor[-1] == cursor[0] && strchr("+-<", *cursor))
-      word->operator[1] = *cursor++; // ++ -- <<
+static int opcode(const char *ins)
+{
+  int value = 0;
+  if (vPC >= segEnd)
+    return error("Out of code space");
+  if (segStart == vPC && openSegment())
+    return -1;
+  if (symbol(ins, &value))
+    return -1;
+  vPC++;
+  return put(value & 255);
+}
+
+static int getAddress(struct word *w)
+{
+  if (w->name) {
+    for (int i=0; i<varCount; i++)
+      if (strcmp(vars[i].name, w->name) == 0)
+        return vars[i].address;
+    if (varCount >= maxVars)
+      return error("Too many variables");
+    snprintf(vars[varCount].name, maxName, "%s", w->name);
+    vars[varCount].address = zpByte(2);
+    return vars[varCount++].address;
   }
+  if (w->index < 0 || w->index > 255)
+    return error("Index out of range %d", w->index);
+  return w->index;
+}
 
-  if (hasMore)
-    return error("Invalid word");
-  return wordType;
+// Emit an opcode with a variable's address (plus offset) as operand
+static int opcodeVar(const char *ins, struct word *w, int offset)
+{
+  if (opcode(ins))
+    return -1;
+  int address = getAddress(w);
+  return (address < 0) ? -1 : emit(address + offset);
 }
 
-static int compileWord(struct word *w)
+static int opcodeCon(const char *ins, int con)
 {
-  return 0;
+  return opcode(ins) || emit(con);
+}
+
+// Innermost block that has a 'do'
+static int loopTarget(int *to)
+{
+  for (int i=blockCount-1; i>=0; i--) {
+    if (loops[blocks[i]] >= 0) {
+      *to = prev(loops[blocks[i]], 2);
+      if (vPC>>8 != *to>>8)
+        return error("Loop outside page");
+      return 0;
+    }
+  }
+  return error("Loop without do");
 }
 
-static void emit(int byte)
+static int emitIf(const char *cond)
 {
-  if (offset < size)
-    page[offset] = byte;
-  offset++;
+  int block = thisBlock();
+  if (opcode("BCC") || opcode(cond))
+    return -1;
+  conds[block] = 0;
+  return emitLo(label("if", block, 0));
 }
 
-static int emitIf(int cond)
+static int emitIfLoop(const char *cond)
 {
-  emit(BCC);
-  emit(cond);
-  return 0;
+  int to = 0;
+  if (loopTarget(&to))
+    return -1;
+  return opcode("BCC") || opcode(cond) || emit(to&255);
 }
 
-static int emitIfLoop(int cond)
+/*
+ *  Break word into pieces, same rules as gcl0x.py:
+ *  [%] [-+] ( $hex | decimal | \symbol | name ) operator
+ */
+static int parseWord(char *word, struct word *w)
 {
-  emit(BCC);
-  emit(cond);
+  memset(w, 0, sizeof *w);
+
+  bool unnamed = false;
+  char sign = 0;
+  int ix = 0, number = 0;
+  bool hasNumber = true;
+
+  if (word[ix] == '%')
+    unnamed = true, ix++;
+
+  if (word[ix] && strchr("-+", word[ix]))
+    sign = word[ix++];
+
+  if (word[ix] == '$') {
+    // Hexadecimal number?
+    int jx = ix + 1;
+    for (;; jx++) {
+      char c = word[jx];
+      if ('0' <= c && c <= '9')      number = 16*number + c - '0';
+      else if ('a' <= c && c <= 'f') number = 16*number + 10 + c - 'a';
+      else if ('A' <= c && c <= 'F') number = 16*number + 10 + c - 'A';
+      else break;
+    }
+    ix = (jx-ix > 1) ? jx : 0;
+  } else if (isdigit((unsigned char)word[ix])) {
+    // Decimal number
+    while (isdigit((unsigned char)word[ix]))
+      number = 10*number + word[ix++] - '0';
+  } else if (word[ix] == '\\') {
+    // Interface symbol
+    char sym[maxName];
+    int n = 0;
+    ix++;
+    while ((isalnum((unsigned char)word[ix]) || word[ix] == '_') && n < maxName-1)
+      sym[n++] = word[ix++];
+    sym[n] = 0;
+    if (symbol(sym, &number))
+      return -1;
+  } else {
+    // Named variable?
+    hasNumber = false;
+    if (unnamed || sign)
+      ix = 0; // Reset
+    else {
+      int jx = ix;
+      while (isalnum((unsigned char)word[jx]) || word[jx] == '_')
+        jx++;
+      if (jx > ix) {
+        // Split the name from the operator, the operator is moved one place right
+        memmove(word+jx+1, word+jx, strlen(word+jx)+1);
+        word[jx] = 0;
+        w->name = word + ix;
+        ix = jx + 1;
+      }
+    }
+  }
+
+  if (hasNumber) {
+    if (sign == '-')
+      number = -number;
+    if (unnamed)
+      w->hasIndex = true, w->index = number;
+    else
+      w->hasNumber = true, w->number = number;
+  }
+
+  w->operator = word + ix;
   return 0;
 }
 
-static int compileCond(struct word *w)
+static int compileWord(char *word)
 {
-  if (strcmp(w->operator, "<")==0) return emitIf(GE);
-  if (strcmp(w->operator, ">")==0) return emitIf(LE);
-  if (strcmp(w->operator, "=")==0) return emitIf(NE);
-  if (strcmp(w->operator, "<>")==0) return emitIf(EQ);
-  if (strcmp(w->operator, "<=")==0) return emitIf(GT);
-  if (strcmp(w->operator, ">=")==0) return emitIf(LT);
-  return -1;
+  #define is(s) (strcmp(word, (s)) == 0)
+
+  if (!haveVersion) {
+    if (!is("gcl0x"))
+      return error("Invalid GCL version '%s'", word);
+    haveVersion = true;
+    return 0;
+  }
+
+  if (is("loop")) {
+    int to = 0;
+    return loopTarget(&to) || opcode("BRA") || emit(to&255);
+  }
+  if (is("def")) {
+    int pc = vPC; // Just an identifier
+    if (opcode("DEF"))
+      return -1;
+    defs[thisBlock()] = pc;
+    return emitLo(label("def", pc, -1));
+  }
+  if (is("do")) {
+    loops[thisBlock()] = vPC;
+    return 0;
+  }
+  if (is("if<>0"))     return emitIf("EQ");
+  if (is("if=0"))      return emitIf("NE");
+  if (is("if>=0"))     return emitIf("LT");
+  if (is("if<=0"))     return emitIf("GT");
+  if (is("if>0"))      return emitIf("LE");
+  if (is("if<0"))      return emitIf("GE");
+  if (is("if<>0loop")) return emitIfLoop("NE");
+  if (is("if=0loop"))  return emitIfLoop("EQ");
+  if (is("if>0loop"))  return emitIfLoop("GT");
+  if (is("if<0loop"))  return emitIfLoop("LT");
+  if (is("if>=0loop")) return emitIfLoop("GE");
+  if (is("if<=0loop")) return emitIfLoop("LE");
+  if (is("else")) {
+    int block = thisBlock();
+    if (conds[block] < 0)
+      return error("Unexpected 'else'");
+    if (conds[block] > 0)
+      return error("Too many 'else'");
+    if (opcode("BRA") || emitLo(label("if", block, 1)))
+      return -1;
+    conds[block] = 1;
+    return define(label("if", block, 0), prev(vPC, 2));
+  }
+  if (is("push")) return opcode("PUSH");
+  if (is("pop"))  return opcode("POP");
+  if (is("ret")) {
+    if (blockCount == 1)
+      needPatch = true; // Top-level use of 'ret' --> apply patch
+    return opcode("RET");
+  }
+  if (is("call")) {
+    int vAC;
+    return symbol("vAC", &vAC) || opcodeCon("CALL", vAC);
+  }
+  if (is("peek")) return opcode("PEEK");
+  if (is("deek")) return opcode("DEEK");
+
+  char copy[maxWord+2]; // parseWord() inserts a terminator
+  snprintf(copy, sizeof copy, "%s", word);
+  struct word w;
+  if (parseWord(copy, &w))
+    return -1;
+
+  char *op = w.operator;
+  bool var = w.name || (w.hasIndex && w.index != 0);
+  bool con = w.hasNumber;
+  int n = w.number;
+  #define isOp(s) (strcmp(op, (s)) == 0)
+
+  if (*op == 0) {
+    if (var)
+      return opcodeVar("LDW", &w, 0);
+    if (!con)
+      return error("Invalid word '%s'", word);
+    if (0 <= n && n < 256)
+      return opcodeCon("LDI", n);
+    return opcode("LDWI") || emit(n & 0xff) || emit((n>>8) & 0xff);
+  }
+
+  if (isOp(";") && con)   return opcodeCon("LDW", n);
+  if (isOp(":") && con && n > 0xff) return org(n);
+  if (isOp(":") && con)   return opcodeCon("STW", n);
+  if (isOp("=") && con)   return opcodeCon("STW", n);
+  if (isOp(".") && con)   return opcodeCon("ST", n);
+  if (isOp(",") && con)   return opcodeCon("LD", n);
+  if (isOp("=") && var)   return opcodeVar("STW", &w, 0);
+  if (isOp("+") && var)   return opcodeVar("ADDW", &w, 0);
+  if (isOp("+") && con)   return opcodeCon("ADDI", n);
+  if (isOp("-") && var)   return opcodeVar("SUBW", &w, 0);
+  if (isOp("-") && con)   return opcodeCon("SUBI", n);
+  if (isOp("<<") && con) {
+    for (int i=0; i<n; i++)
+      if (opcode("LSLW"))
+        return -1;
+    return 0;
+  }
+  if (isOp("--") && con)  return opcodeCon("ALLOC", -n & 255);
+  if (isOp("++") && con)  return opcodeCon("ALLOC", n);
+  if (isOp("%=") && con)  return opcodeCon("STLW", n);
+  if (isOp("%") && con)   return opcodeCon("LDLW", n);
+  if (isOp("#") && con)   return emit(n & 255);
+  if (isOp("?") && con)   return opcodeCon("LUP", n);
+  if (isOp("&") && var)   return opcodeVar("ANDW", &w, 0);
+  if (isOp("&") && con)   return opcodeCon("ANDI", n);
+  if (isOp("|") && var)   return opcodeVar("ORW", &w, 0);
+  if (isOp("|") && con)   return opcodeCon("ORI", n);
+  if (isOp("^") && var)   return opcodeVar("XORW", &w, 0);
+  if (isOp("^") && con)   return opcodeCon("XORI", n);
+  if (isOp(".") && var)   return opcodeVar("POKE", &w, 0);
+  if (isOp(":") && var)   return opcodeVar("DOKE", &w, 0);
+  if (isOp("<.") && var)  return opcodeVar("ST", &w, 0);
+  if (isOp(">.") && var)  return opcodeVar("ST", &w, 1);
+  if (isOp(",") && var)   return opcodeVar("LDW", &w, 0) || opcode("PEEK");
+  if (isOp(";") && var)   return opcodeVar("LDW", &w, 0) || opcode("DEEK");
+  if (isOp("<++") && var) return opcodeVar("INC", &w, 0);
+  if (isOp("<++") && con) return opcodeCon("INC", n);
+  if (isOp(">++") && var) return opcodeVar("INC", &w, 1);
+  if (isOp(">++") && con) return opcodeCon("INC", n+1);
+  if (isOp("<,") && var)  return opcodeVar("LD", &w, 0);
+  if (isOp(">,") && var)  return opcodeVar("LD", &w, 1);
+  if (isOp("!") && var)   return opcodeVar("CALL", &w, 0);
+  if (isOp("!") && con) {
+    int maxTicks;
+    if (n & 1)
+      return error("Invalid value %d (must be even)", n);
+    if (symbol("maxTicks", &maxTicks))
+      return -1;
+    int extraTicks = n/2 - maxTicks;
+    return opcodeCon("SYS", (extraTicks > 0) ? 256 - extraTicks : 0);
+  }
+  return error("Invalid word '%s'", word);
 }
 
-static int compileLoop(struct word *w)
+// Words are separated by whitespace and by the characters {}[]()
+static int endWord(char *word, int *len)
 {
-  if (strcmp(w->operator, "<")==0) return emitIfLoop(LT);
-  if (strcmp(w->operator, ">")==0) return emitIfLoop(GT);
-  if (strcmp(w->operator, "=")==0) return emitIfLoop(EQ);
-  if (strcmp(w->operator, "<>")==0) return emitIfLoop(NE);
-  if (strcmp(w->operator, "<=")==0) return emitIfLoop(LE);
-  if (strcmp(w->operator, ">=")==0) return emitIfLoop(GE);
-  return -1;
+  if (*len == 0)
+    return 0;
+  word[*len] = 0;
+  *len = 0;
+  return compileWord(word) ? -1 : 0;
+}
+
+static int openBlock(void)
+{
+  if (blockCount >= maxDepth)
+    return error("Blocks nested too deep");
+  if (blockId >= maxBlocks)
+    return error("Too many blocks");
+  blocks[blockCount++] = blockId++;
+  return 0;
+}
+
+static int closeBlock(void)
+{
+  if (blockCount <= 1)
+    return error("Unexpected ']'");
+  int block = blocks[--blockCount];
+  if (conds[block] >= 0) {
+    // There was an if-statement in this block
+    // Define the label to jump here
+    if (define(label("if", block, conds[block]), prev(vPC, 2)))
+      return -1;
+    conds[block] = -1;
+  }
+  if (defs[block] >= 0) {
+    if (define(label("def", defs[block], -1), prev(vPC, 2)))
+      return -1;
+    defs[block] = -1;
+  }
+  return 0;
 }
 
 /*----------------------------------------------------------------------+
  |      External functions                                              |
  +----------------------------------------------------------------------*/
 
+/*
+ *  Load interface bindings from a JSON file such as interface.json.
+ *  Only the flat { "name" : value, ... } form is understood, values
+ *  are either numbers or strings holding a number.
+ */
+int compileBindings(const char *filename)
+{
+  FILE *fp = fopen(filename, "rb");
+  if (!fp) {
+    compileError = "Can't open interface file";
+    return -1;
+  }
+
+  symbolCount = bindingCount = 0;
+  int c;
+  while ((c = fgetc(fp)) != EOF) {
+    if (c != '"')
+      continue;
+
+    // Name
+    char name[maxName];
+    int n = 0;
+    while ((c = fgetc(fp)) != EOF && c != '"')
+      if (n < maxName-1)
+        name[n++] = c;
+    name[n] = 0;
+
+    // Colon
+    while ((c = fgetc(fp)) != EOF && isspace(c))
+      ;
+    if (c != ':')
+      continue;
+
+    // Value, quoted or not
+    char value[maxName];
+    n = 0;
+    while ((c = fgetc(fp)) != EOF && (isspace(c) || c == '"'))
+      ;
+    while (c != EOF && isalnum(c) && n < maxName-1) {
+      value[n++] = c;
+      c = fgetc(fp);
+    }
+    value[n] = 0;
+
+    if (symbolCount < maxSymbols) {
+      snprintf(symbols[symbolCount].name, maxName, "%s", name);
+      symbols[symbolCount++].value = (int) strtol(value, null, 0);
+    }
+  }
+  fclose(fp);
+
+  bindingCount = symbolCount;
+  return 0;
+}
+
 void compileBegin(void)
 {
+  // Fall back to the built-in bindings, compiler labels are dropped
+  if (bindingCount == 0) {
+    int n = sizeof defaultBindings / sizeof defaultBindings[0];
+    for (int i=0; i<n; i++) {
+      snprintf(symbols[i].name, maxName, "%s", defaultBindings[i].name);
+      symbols[i].value = defaultBindings[i].value;
+    }
+    bindingCount = n;
+  }
+  symbolCount = bindingCount;
+
+  compileError = null;
+  lineNumber = 0;
+  comment = 0;
+  refCount = 0;
+  varCount = 0;
+  objectSize = 0;
+
+  blocks[0] = 0;
+  blockCount = 1;
+  blockId = 1;
+  for (int i=0; i<maxBlocks; i++)
+    loops[i] = conds[i] = defs[i] = -1;
+
+  haveVersion = false;
+  needPatch = false;
+  segId = 0;
+  execute = -1;
+
+  int userCode = 0x0200, userVars = 0x0030;
+  symbol("userCode", &userCode);
+  symbol("userVars", &userVars);
   compileError = null;
-  blockDepth = 0;
 
-  base = 0x0200;
-  offset = 0;
-  size = 250;
+  segStart = vPC = userCode;
+  org(userCode);
+  zpSize = userVars;
 }
 
 int compileLine(char *line)
 {
-  cursor = line;
-  struct word w;
-  while (1) {
-    switch (nextWord(&w)) {
-    case endType:
-      break;
-    case openType:
-      blockDepth++;
-      continue;
-    case closeType:
-      if (blockDepth <= 0)
-        return error("Close block without open");
-      blockDepth--;
-      continue;
-    case wordType:
-      if (compileWord(&w))
-        return -1;
-      continue;
-    case condType:
-      if (compileCond(&w))
-        return -1;
-      continue;
-    case loopType:
-      if (compileLoop(&w))
+  char word[maxWord+1];
+  int len = 0;
+
+  lineNumber++;
+
+  for (char *cursor=line; *cursor; cursor++) {
+    char c = *cursor;
+    if (comment > 0) {
+      // Inside comments anything goes
+      if (c == '{') comment++;
+      if (c == '}') comment--;
+    } else if (!strchr("{}[]()", c)) {
+      if (isspace((unsigned char)c)) {
+        if (endWord(word, &len))
+          return -1;
+      } else {
+        if (len >= maxWord)
+          return error("Word too long");
+        word[len++] = c;
+      }
+    } else {
+      if (endWord(word, &len))
         return -1;
-      continue;
-    default:
-      return -1;
+      if (c == '{') comment++;
+      if (c == '}') return error("Spurious '}'");
+      if (c == '[' && openBlock())  return -1;
+      if (c == ']' && closeBlock()) return -1;
     }
-    break;
   }
-  return 0;
+  return endWord(word, &len);
 }
 
 int compileEnd(void)
 {
-  if (blockDepth > 0)
-    return error("Open block without close");
-  return 0;
+  if (comment > 0)
+    return error("Unterminated comment");
+  if (closeSegment() || put(0)) // Zero marks the end of stream
+    return -1;
+
+  // Resolve symbols
+  for (int i=0; i<refCount; i++) {
+    int value = 0;
+    if (symbol(refs[i].name, &value))
+      return -1;
+    object[refs[i].where] ^= value & 255;
+  }
+
+  // Inject patch for reliable start using ROM v1 Loader application
+  // See: https://forum.gigatron.io/viewtopic.php?p=27#p27
+  int address = execute;
+  if (needPatch) {
+    int patchArea = 0x5b86; // Somewhere after the ROMv1 Loader's buffer
+    unsigned char patch[] = {
+      patchArea>>8, patchArea&255, 6,   // Patch segment, 6 bytes at $5b86
+      0x11, address&255, address>>8,    // LDWI address
+      0x2b, 0x1a,                       // STW  vLR
+      0xff,                             // RET
+      0x00
+    };
+    objectSize--; // Remove terminating zero
+    for (int i=0; i<(int) sizeof patch; i++)
+      if (put(patch[i]))
+        return -1;
+    address = patchArea;
+  }
+
+  // Final two bytes are execution address
+  return put(address>>8) || put(address&255);
+}
+
+unsigned char *compileObject(int *size)
+{
+  *size = objectSize;
+  return object;
 }
 
 /*----------------------------------------------------------------------+
  |                                                                      |
  +----------------------------------------------------------------------*/
-
@@ -1,6 +1,16 @@
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 extern char *compileError;
+int compileBindings(const char *filename);
 void compileBegin(void);
 int compileLine(char *line);
 int compileEnd(void);
+unsigned char *compileObject(int *size);
+
+#ifdef __cplusplus
+}
+#endif
 
@@ -3,31 +3,35 @@
 
 #include "gcl.h"
 
-int main(void)
+// Usage: gcl [interface.json] < file.gcl > file.gt1
+int main(int argc, char *argv[])
 {
+  if (argc > 1 && compileBindings(argv[1])) {
+    fprintf(stderr, "Error: %s\n", compileError);
+    return 1;
+  }
+
   compileBegin();
 
-  while (1) {
-    size_t len;
-    char *line = fgetln(stdin, &len);
-    if (!line)
-      break;
-    if (line[len-1] != '\n') {
-      fprintf(stderr, "Incomplete line\n");
-      break;
-    }
+  char line[4096];
+  while (fgets(line, sizeof line, stdin)) {
     if (compileLine(line)) {
       fprintf(stderr, "Compile error\n");
       break;
     }
   }
 
-  if (compileEnd())
+  if (!compileError && compileEnd())
     fprintf(stderr, "Compile error\n");
 
-  if (compileError)
+  if (compileError) {
     fprintf(stderr, "Error: %s\n", compileError);
+    return 1;
+  }
 
+  int size;
+  unsigned char *object = compileObject(&size);
+  fwrite(object, 1, size, stdout);
   return 0;
 }
 